@@ -130,6 +130,11 @@ struct CppArgTraits <_out<T>>
     static_assert(std::is_lvalue_reference<T>::value
         && !std::is_const<typename std::remove_reference<T>::type>::value,
         "argument with out spec must be non-const reference type");
+    // there is no Lua value to refer to, so the result is held and pushed
+    // by value, a reference would point to the holder once the call returns
+    using Type = typename std::decay<T>::type;
+    using ValueType = Type;
+    using HolderType = CppArgHolder<ValueType>;
     static constexpr bool isInput = false;
     static constexpr bool isOutput = true;
 };
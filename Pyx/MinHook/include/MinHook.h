@@ -87,6 +87,10 @@ MH_STATUS;
 // MH_QueueEnableHook or MH_QueueDisableHook.
 #define MH_ALL_HOOKS NULL
 
+// Fills pThreadIds with up to capacity IDs of the threads of the current
+// process except the calling one, and returns the total count of them.
+typedef UINT (WINAPI *MH_THREAD_ENUMERATOR)(LPDWORD pThreadIds, UINT capacity);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -177,6 +181,11 @@ extern "C" {
     // Applies all queued changes in one go.
     MH_STATUS WINAPI MH_ApplyQueued(VOID);
 
+    // Replaces the Toolhelp32 snapshot used to find the threads to freeze.
+    // Parameters:
+    //   pEnumerator [in] The enumerator, NULL restores the default one.
+    MH_STATUS WINAPI MH_SetThreadEnumerator(MH_THREAD_ENUMERATOR pEnumerator);
+
     // Translates the MH_STATUS to its name as a string.
     const char * WINAPI MH_StatusToString(MH_STATUS status);
 
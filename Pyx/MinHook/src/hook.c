@@ -94,6 +94,9 @@ volatile LONG g_isLocked = FALSE;
 // Private heap handle. If not NULL, this library is initialized.
 HANDLE g_hHeap = NULL;
 
+// Thread enumerator set by MH_SetThreadEnumerator(), NULL for the snapshot.
+MH_THREAD_ENUMERATOR g_pThreadEnumerator = NULL;
+
 // Hook entries.
 struct
 {
@@ -264,6 +267,31 @@ static void ProcessThreadIPs(HANDLE hThread, UINT pos, UINT action)
 //-------------------------------------------------------------------------
 static VOID EnumerateThreads(PFROZEN_THREADS pThreads)
 {
+    if (g_pThreadEnumerator != NULL)
+    {
+        UINT count = g_pThreadEnumerator(NULL, 0);
+        while (count > 0)
+        {
+            LPDWORD p = (LPDWORD)HeapAlloc(g_hHeap, 0, count * sizeof(DWORD));
+            if (p == NULL)
+                return;
+
+            pThreads->pItems   = p;
+            pThreads->capacity = count;
+            pThreads->size     = g_pThreadEnumerator(p, count);
+            if (pThreads->size <= count)
+                return;
+
+            // Threads were created in between, retry with the new count.
+            count = pThreads->size;
+            HeapFree(g_hHeap, 0, p);
+            pThreads->pItems   = NULL;
+            pThreads->capacity = 0;
+            pThreads->size     = 0;
+        }
+        return;
+    }
+
     HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
     if (hSnapshot != INVALID_HANDLE_VALUE)
     {
@@ -861,6 +889,16 @@ MH_STATUS WINAPI MH_CreateHookApi(
    return MH_CreateHookApiEx(pszModule, pszProcName, pDetour, ppOriginal, NULL);
 }
 
+//-------------------------------------------------------------------------
+MH_STATUS WINAPI MH_SetThreadEnumerator(MH_THREAD_ENUMERATOR pEnumerator)
+{
+    EnterSpinLock();
+    g_pThreadEnumerator = pEnumerator;
+    LeaveSpinLock();
+
+    return MH_OK;
+}
+
 //-------------------------------------------------------------------------
 const char * WINAPI MH_StatusToString(MH_STATUS status)
 {
@@ -0,0 +1,174 @@
+#include <Pyx/Graphics/FrameStats.h>
+#include <algorithm>
+
+size_t Pyx::Graphics::FrameHistogram::GetBucket(uint64_t value)
+{
+    if (value < SubBucketCount)
+        return static_cast<size_t>(value);
+    size_t octave = SubBucketBits;
+    while (octave < 63 && (value >> (octave + 1)) != 0)
+        octave++;
+    size_t bucket = (octave - SubBucketBits + 1) * SubBucketCount + static_cast<size_t>((value >> (octave - SubBucketBits)) & (SubBucketCount - 1));
+    return bucket < BucketCount ? bucket : BucketCount - 1;
+}
+
+uint64_t Pyx::Graphics::FrameHistogram::GetBucketLowerBound(size_t bucket)
+{
+    if (bucket < SubBucketCount)
+        return bucket;
+    size_t octave = bucket / SubBucketCount - 1 + SubBucketBits;
+    return static_cast<uint64_t>(SubBucketCount + bucket % SubBucketCount) << (octave - SubBucketBits);
+}
+
+uint64_t Pyx::Graphics::FrameHistogram::GetPercentile(const uint64_t* pCounts, double percentile)
+{
+    uint64_t totalCount = 0;
+    for (size_t i = 0; i < BucketCount; i++)
+        totalCount += pCounts[i];
+    if (totalCount == 0)
+        return 0;
+
+    uint64_t rank = static_cast<uint64_t>((std::min)((std::max)(percentile, 0.0), 100.0) / 100.0 * (totalCount - 1));
+    uint64_t count = 0;
+    for (size_t i = 0; i < BucketCount; i++)
+    {
+        count += pCounts[i];
+        if (count > rank)
+            return GetBucketLowerBound(i + 1);
+    }
+    return GetBucketLowerBound(BucketCount);
+}
+
+Pyx::Graphics::FrameHistogram::FrameHistogram()
+{
+    Reset();
+}
+
+void Pyx::Graphics::FrameHistogram::Record(uint64_t value)
+{
+    m_counts[GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+    if (value > m_max.load(std::memory_order_relaxed))
+        m_max.store(value, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Pyx::Graphics::FrameHistogram::Reset()
+{
+    for (auto& count : m_counts)
+        count.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+void Pyx::Graphics::FrameHistogram::AddCounts(uint64_t* pCounts) const
+{
+    for (size_t i = 0; i < BucketCount; i++)
+        pCounts[i] += m_counts[i].load(std::memory_order_relaxed);
+}
+
+Pyx::Graphics::FrameStats::FrameStats(uint64_t windowDuration)
+    : m_currentWindow(0),
+    m_historyPosition(0),
+    m_windowDuration(windowDuration),
+    m_windowStart(0),
+    m_lastPresent(0),
+    m_frameCount(0),
+    m_averageInterval(0.0)
+{
+    Reset();
+}
+
+void Pyx::Graphics::FrameStats::OnPresent(uint64_t time)
+{
+    uint64_t lastPresent = m_lastPresent;
+    m_lastPresent = time;
+    if (lastPresent == 0 || time < lastPresent)
+    {
+        m_windowStart = time;
+        return;
+    }
+
+    if (time - m_windowStart >= m_windowDuration)
+    {
+        uint32_t nextWindow = 1 - m_currentWindow.load(std::memory_order_relaxed);
+        m_windows[nextWindow].Intervals.Reset();
+        m_windows[nextWindow].Overhead.store(0, std::memory_order_relaxed);
+        m_windows[nextWindow].HitchCount.store(0, std::memory_order_relaxed);
+        m_currentWindow.store(nextWindow, std::memory_order_relaxed);
+        m_windowStart = time;
+    }
+
+    uint64_t interval = time - lastPresent;
+    auto& window = m_windows[m_currentWindow.load(std::memory_order_relaxed)];
+    window.Intervals.Record(interval);
+
+    // Compared to an exponential average of the previous frames, a single
+    // long frame is a hitch while a steady low framerate isn't
+    if (m_frameCount >= WarmUpFrameCount && interval > HitchFactor * m_averageInterval)
+        window.HitchCount.fetch_add(1, std::memory_order_relaxed);
+    m_averageInterval = m_frameCount == 0 ? interval : m_averageInterval + (interval - m_averageInterval) / 16.0;
+    m_frameCount++;
+
+    uint64_t historyPosition = m_historyPosition.load(std::memory_order_relaxed);
+    m_history[historyPosition % HistorySize].store(interval / 1000.0f, std::memory_order_relaxed);
+    m_historyPosition.store(historyPosition + 1, std::memory_order_release);
+}
+
+void Pyx::Graphics::FrameStats::AddOverhead(uint64_t duration)
+{
+    m_windows[m_currentWindow.load(std::memory_order_relaxed)].Overhead.fetch_add(duration, std::memory_order_relaxed);
+}
+
+void Pyx::Graphics::FrameStats::Reset()
+{
+    for (auto& window : m_windows)
+    {
+        window.Intervals.Reset();
+        window.Overhead.store(0, std::memory_order_relaxed);
+        window.HitchCount.store(0, std::memory_order_relaxed);
+    }
+    for (auto& value : m_history)
+        value.store(0.0f, std::memory_order_relaxed);
+    m_historyPosition.store(0, std::memory_order_release);
+}
+
+Pyx::Graphics::FrameStatsSummary Pyx::Graphics::FrameStats::GetSummary() const
+{
+    uint64_t counts[FrameHistogram::BucketCount] = {};
+    uint64_t frameCount = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+    uint64_t overhead = 0;
+    uint64_t hitchCount = 0;
+    for (auto& window : m_windows)
+    {
+        window.Intervals.AddCounts(counts);
+        frameCount += window.Intervals.GetCount();
+        sum += window.Intervals.GetSum();
+        max = (std::max)(max, window.Intervals.GetMax());
+        overhead += window.Overhead.load(std::memory_order_relaxed);
+        hitchCount += window.HitchCount.load(std::memory_order_relaxed);
+    }
+
+    FrameStatsSummary summary;
+    summary.FrameCount = frameCount;
+    summary.Average = frameCount != 0 ? sum / 1000.0 / frameCount : 0.0;
+    summary.P50 = FrameHistogram::GetPercentile(counts, 50.0) / 1000.0;
+    summary.P95 = FrameHistogram::GetPercentile(counts, 95.0) / 1000.0;
+    summary.P99 = FrameHistogram::GetPercentile(counts, 99.0) / 1000.0;
+    summary.Max = max / 1000.0;
+    summary.OverheadShare = sum != 0 ? (std::min)(static_cast<double>(overhead) / sum, 1.0) : 0.0;
+    summary.HitchCount = hitchCount;
+    return summary;
+}
+
+void Pyx::Graphics::FrameStats::GetHistory(std::vector<float>& history) const
+{
+    uint64_t historyPosition = m_historyPosition.load(std::memory_order_acquire);
+    uint64_t firstPosition = historyPosition > HistorySize ? historyPosition - HistorySize : 0;
+    history.clear();
+    for (uint64_t position = firstPosition; position < historyPosition; position++)
+        history.push_back(m_history[position % HistorySize].load(std::memory_order_relaxed));
+}
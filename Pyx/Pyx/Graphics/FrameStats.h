@@ -0,0 +1,104 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Pyx
+{
+    namespace Graphics
+    {
+        // Log-linear (HDR style) histogram of microsecond values : exact below
+        // SubBucketCount, then SubBucketCount linear buckets per power of two,
+        // so every value is known within ~6%. One thread records, any thread
+        // can read without locking.
+        class FrameHistogram
+        {
+
+        public:
+            static const size_t SubBucketBits = 4;
+            static const size_t SubBucketCount = 1 << SubBucketBits;
+            static const size_t MaxValueBits = 26; // ~67 seconds
+            static const size_t BucketCount = (MaxValueBits - SubBucketBits + 1) * SubBucketCount;
+
+        public:
+            static size_t GetBucket(uint64_t value);
+            static uint64_t GetBucketLowerBound(size_t bucket);
+            // Upper bound of the bucket holding the value of the given rank
+            static uint64_t GetPercentile(const uint64_t* pCounts, double percentile);
+
+        private:
+            std::atomic<uint64_t> m_counts[BucketCount];
+            std::atomic<uint64_t> m_count;
+            std::atomic<uint64_t> m_sum;
+            std::atomic<uint64_t> m_max;
+
+        public:
+            explicit FrameHistogram();
+            void Record(uint64_t value);
+            void Reset();
+            void AddCounts(uint64_t* pCounts) const;
+            uint64_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+            uint64_t GetSum() const { return m_sum.load(std::memory_order_relaxed); }
+            uint64_t GetMax() const { return m_max.load(std::memory_order_relaxed); }
+
+        };
+
+        struct FrameStatsSummary
+        {
+            uint64_t FrameCount;
+            double Average;         // Milliseconds
+            double P50;
+            double P95;
+            double P99;
+            double Max;
+            double OverheadShare;   // Part of the frame time spent in our present hook, 0 to 1
+            uint64_t HitchCount;
+        };
+
+        // Frame pacing from present to present. Time is given by the caller in
+        // microseconds so the statistics don't depend on the platform. Two
+        // windows are kept and the older one is cleared when a window is over,
+        // summaries cover between one and two window durations.
+        class FrameStats
+        {
+
+        public:
+            static const size_t HistorySize = 256;
+            static const uint64_t DefaultWindowDuration = 5000000;
+            // A frame is a hitch when it takes this many times the recent average
+            static const uint32_t HitchFactor = 2;
+            static const uint32_t WarmUpFrameCount = 16;
+
+        private:
+            struct Window
+            {
+                FrameHistogram Intervals;
+                std::atomic<uint64_t> Overhead;
+                std::atomic<uint64_t> HitchCount;
+            };
+
+        private:
+            Window m_windows[2];
+            std::atomic<uint32_t> m_currentWindow;
+            std::atomic<float> m_history[HistorySize];
+            std::atomic<uint64_t> m_historyPosition;
+            uint64_t m_windowDuration;
+            // Only used by the thread calling OnPresent
+            uint64_t m_windowStart;
+            uint64_t m_lastPresent;
+            uint64_t m_frameCount;
+            double m_averageInterval;
+
+        public:
+            explicit FrameStats(uint64_t windowDuration = DefaultWindowDuration);
+            void OnPresent(uint64_t time);
+            void AddOverhead(uint64_t duration);
+            void Reset();
+            FrameStatsSummary GetSummary() const;
+            // Frame times in milliseconds, oldest first
+            void GetHistory(std::vector<float>& history) const;
+
+        };
+    }
+}
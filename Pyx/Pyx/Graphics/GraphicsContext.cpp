@@ -3,6 +3,7 @@
 #include <Pyx/Graphics/Gui/IGui.h>
 #include <Pyx/Graphics/Renderer/IRenderer.h>
 #include <Pyx/PyxContext.h>
+#include <Pyx/Scripting/Script.h>
 
 Pyx::Graphics::GraphicsContext& Pyx::Graphics::GraphicsContext::GetInstance()
 {
@@ -10,8 +11,45 @@ Pyx::Graphics::GraphicsContext& Pyx::Graphics::GraphicsContext::GetInstance()
     return ctx;
 }
 
+void Pyx::Graphics::GraphicsContext::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+    LuaBinding(pScript->GetLuaState())
+        .beginModule("Pyx")
+        .beginModule("Graphics")
+        .addFunction("GetFrameStats", [](lua_State* L)
+        {
+            auto& frameStats = GetInstance().GetFrameStats();
+            auto summary = frameStats.GetSummary();
+            auto table = LuaRef::createTable(L);
+            table.set("FrameCount", summary.FrameCount);
+            table.set("Average", summary.Average);
+            table.set("P50", summary.P50);
+            table.set("P95", summary.P95);
+            table.set("P99", summary.P99);
+            table.set("Max", summary.Max);
+            table.set("OverheadShare", summary.OverheadShare);
+            table.set("HitchCount", summary.HitchCount);
+            std::vector<float> history;
+            frameStats.GetHistory(history);
+            table.set("History", history);
+            return table;
+        }, LUA_ARGS(lua_State*))
+        .addFunction("ResetFrameStats", []() { GetInstance().GetFrameStats().Reset(); })
+        .endModule()
+        .endModule();
+}
+
+uint64_t Pyx::Graphics::GraphicsContext::GetTime()
+{
+    static LARGE_INTEGER frequency = []() { LARGE_INTEGER value; QueryPerformanceFrequency(&value); return value; }();
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<uint64_t>(counter.QuadPart / frequency.QuadPart * 1000000 + counter.QuadPart % frequency.QuadPart * 1000000 / frequency.QuadPart);
+}
+
 Pyx::Graphics::GraphicsContext::GraphicsContext()
-    : m_pMainRenderer(nullptr)
+    : m_pMainRenderer(nullptr),
+    m_presentStartTime(0)
 {
 
 }
@@ -25,7 +63,19 @@ void Pyx::Graphics::GraphicsContext::SetMainRenderer(Renderer::IRenderer* pRende
 {
     PYX_ASSERT_A(pRenderer != nullptr);
     m_pMainRenderer = pRenderer;
-    PyxContext::GetInstance().Log("[Graphics] Using renderer : " + std::string(pRenderer->GetRendererTypeString()));
+    PYX_LOG_INFO(Graphics, "[Graphics] Using renderer : %s", pRenderer->GetRendererTypeString());
 	auto pGui = GuiContext::GetInstance().GetGui();
 	if (pGui) pGui->ToggleVisibility(true);
 }
+
+void Pyx::Graphics::GraphicsContext::OnPresentStart()
+{
+    m_presentStartTime = GetTime();
+    m_frameStats.OnPresent(m_presentStartTime);
+}
+
+void Pyx::Graphics::GraphicsContext::OnPresentEnd()
+{
+    if (m_presentStartTime != 0)
+        m_frameStats.AddOverhead(GetTime() - m_presentStartTime);
+}
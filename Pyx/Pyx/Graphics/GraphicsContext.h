@@ -1,8 +1,14 @@
 #pragma once
+#include <Pyx/Graphics/FrameStats.h>
+#include <cstdint>
 
 namespace Pyx
 {
     class PyxContext;
+    namespace Scripting
+    {
+        class Script;
+    }
     namespace Graphics
     {
         namespace Renderer
@@ -16,15 +22,24 @@ namespace Pyx
 
         public:
             static GraphicsContext& GetInstance();
+            static void BindWithScript(Scripting::Script* pScript);
+            static uint64_t GetTime(); // Microseconds
 
         private:
             Renderer::IRenderer* m_pMainRenderer;
+            FrameStats m_frameStats;
+            uint64_t m_presentStartTime;
 
         public:
             explicit GraphicsContext();
             ~GraphicsContext();
             Renderer::IRenderer* GetMainRenderer() const { return m_pMainRenderer; }
             void SetMainRenderer(Renderer::IRenderer* pRenderer);
+            // Called by the present hooks around our own work, before the
+            // original present
+            void OnPresentStart();
+            void OnPresentEnd();
+            FrameStats& GetFrameStats() { return m_frameStats; }
         };
     }
 }
\ No newline at end of file
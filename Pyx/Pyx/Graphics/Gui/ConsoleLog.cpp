@@ -0,0 +1,279 @@
+#include <Pyx/Graphics/Gui/ConsoleLog.h>
+#include <Pyx/Logging/LogContext.h>
+#include <algorithm>
+
+namespace
+{
+    void ToLower(std::string& text)
+    {
+        for (auto& c : text)
+        {
+            if (c >= 'A' && c <= 'Z')
+                c += 'a' - 'A';
+        }
+    }
+}
+
+Pyx::Graphics::Gui::ConsoleLog& Pyx::Graphics::Gui::ConsoleLog::GetInstance()
+{
+    static ConsoleLog instance;
+    return instance;
+}
+
+Pyx::Graphics::Gui::ConsoleLog::ConsoleLog()
+    : m_firstLine(0),
+    m_nextLine(0),
+    m_arenaPosition(0),
+    m_filterLevel(LogLevel::Trace),
+    m_filterGeneration(0),
+    m_matchesGeneration(0),
+    m_scannedLine(0),
+    m_isFilterPending(false),
+    m_hFilterThread(nullptr),
+    m_hStopEvent(nullptr),
+    m_hFilterEvent(nullptr)
+{
+}
+
+Pyx::Graphics::Gui::ConsoleLog::~ConsoleLog()
+{
+}
+
+void Pyx::Graphics::Gui::ConsoleLog::StartWorker()
+{
+    if (!m_hFilterThread)
+    {
+        m_hStopEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        m_hFilterEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        m_hFilterThread = CreateThread(nullptr, 0, FilterThread, this, NULL, nullptr);
+    }
+}
+
+void Pyx::Graphics::Gui::ConsoleLog::StopWorker()
+{
+    if (m_hFilterThread)
+    {
+        SetEvent(m_hStopEvent);
+        WaitForSingleObject(m_hFilterThread, INFINITE);
+        CloseHandle(m_hFilterThread);
+        CloseHandle(m_hFilterEvent);
+        CloseHandle(m_hStopEvent);
+        m_hFilterThread = nullptr;
+        m_hFilterEvent = nullptr;
+        m_hStopEvent = nullptr;
+    }
+}
+
+void Pyx::Graphics::Gui::ConsoleLog::AddLine(LogLevel level, const std::string& text)
+{
+    Append(level, false, 0, 0, text.data(), text.size());
+}
+
+void Pyx::Graphics::Gui::ConsoleLog::AddRecord(LogLevel level, uint64_t time, uint64_t formatId, const uint8_t* pArgs, size_t argsSize)
+{
+    Append(level, true, time, formatId, pArgs, argsSize);
+}
+
+void Pyx::Graphics::Gui::ConsoleLog::Append(LogLevel level, bool isRecord, uint64_t time, uint64_t formatId, const void* pData, size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_pLines)
+    {
+        m_pLines.reset(new Line[MaxLines]);
+        m_pArena.reset(new char[ArenaSize]);
+    }
+
+    // Data is never split at the end of the arena, lines whose bytes are
+    // about to be overwritten are evicted along with the oldest ones
+    size = (std::min)(size, ArenaSize / 16);
+    uint64_t position = m_arenaPosition;
+    if (position % ArenaSize + size > ArenaSize)
+        position += ArenaSize - position % ArenaSize;
+    uint64_t end = position + size;
+
+    while (m_firstLine != m_nextLine && (m_nextLine - m_firstLine >= MaxLines || m_pLines[m_firstLine % MaxLines].ArenaPosition + ArenaSize < end))
+    {
+        if (m_pLines[m_firstLine % MaxLines].IsRecord)
+            m_renderedRecords.erase(m_firstLine);
+        m_firstLine++;
+    }
+
+    memcpy(m_pArena.get() + position % ArenaSize, pData, size);
+    m_pLines[m_nextLine % MaxLines] = Line{ position, static_cast<uint32_t>(size), level, isRecord, time, formatId };
+    m_nextLine++;
+    m_arenaPosition = end;
+
+    if (IsFiltered() && m_hFilterEvent && !m_isFilterPending.exchange(true))
+        SetEvent(m_hFilterEvent);
+}
+
+std::string Pyx::Graphics::Gui::ConsoleLog::GetText(uint64_t lineIndex)
+{
+    const Line& line = m_pLines[lineIndex % MaxLines];
+    const char* pData = m_pArena.get() + line.ArenaPosition % ArenaSize;
+    if (!line.IsRecord)
+        return std::string(pData, line.Size);
+
+    return Logging::LogContext::GetInstance().RenderRecord(line.Time, line.FormatId, reinterpret_cast<const uint8_t*>(pData), line.Size);
+}
+
+size_t Pyx::Graphics::Gui::ConsoleLog::GetFirstMatch() const
+{
+    return std::lower_bound(m_matches.begin(), m_matches.end(), m_firstLine) - m_matches.begin();
+}
+
+void Pyx::Graphics::Gui::ConsoleLog::SetFilter(const std::string& text, LogLevel minLevel)
+{
+    std::string filterText = text;
+    ToLower(filterText);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (filterText == m_filterText && minLevel == m_filterLevel)
+        return;
+
+    m_filterText = filterText;
+    m_filterLevel = minLevel;
+    m_filterGeneration++;
+    if (IsFiltered() && m_hFilterEvent)
+    {
+        m_isFilterPending = true;
+        SetEvent(m_hFilterEvent);
+    }
+}
+
+void Pyx::Graphics::Gui::ConsoleLog::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_firstLine = m_nextLine;
+    m_renderedRecords.clear();
+    m_matches.clear();
+}
+
+size_t Pyx::Graphics::Gui::ConsoleLog::GetLineCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(m_nextLine - m_firstLine);
+}
+
+size_t Pyx::Graphics::Gui::ConsoleLog::GetVisibleCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!IsFiltered())
+        return static_cast<size_t>(m_nextLine - m_firstLine);
+    if (m_matchesGeneration != m_filterGeneration)
+        return 0;
+    return m_matches.size() - GetFirstMatch();
+}
+
+void Pyx::Graphics::Gui::ConsoleLog::GetVisibleLines(size_t first, size_t count, std::vector<VisibleLine>& lines)
+{
+    lines.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    bool isFiltered = IsFiltered();
+    size_t firstMatch = GetFirstMatch();
+    for (size_t i = first; i < first + count; i++)
+    {
+        uint64_t lineIndex;
+        if (!isFiltered)
+        {
+            lineIndex = m_firstLine + i;
+            if (lineIndex >= m_nextLine)
+                break;
+        }
+        else
+        {
+            if (m_matchesGeneration != m_filterGeneration || firstMatch + i >= m_matches.size())
+                break;
+            lineIndex = m_matches[firstMatch + i];
+        }
+
+        const Line& line = m_pLines[lineIndex % MaxLines];
+        if (!line.IsRecord)
+        {
+            lines.push_back(VisibleLine{ line.Level, GetText(lineIndex) });
+            continue;
+        }
+
+        // Rendered records are kept while they stay in the history, the cache
+        // is only reset when scrolling through a lot of them
+        auto it = m_renderedRecords.find(lineIndex);
+        if (it == m_renderedRecords.end())
+        {
+            if (m_renderedRecords.size() >= 4096)
+                m_renderedRecords.clear();
+            it = m_renderedRecords.emplace(lineIndex, GetText(lineIndex)).first;
+        }
+        lines.push_back(VisibleLine{ line.Level, it->second });
+    }
+}
+
+bool Pyx::Graphics::Gui::ConsoleLog::FilterPending()
+{
+    std::vector<std::pair<uint64_t, std::string>> candidates;
+    std::string filterText;
+    uint32_t generation;
+    uint64_t lastLine;
+    bool hasMore;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isFilterPending = false;
+        if (!IsFiltered())
+            return false;
+
+        generation = m_filterGeneration;
+        filterText = m_filterText;
+        uint64_t firstLine = m_matchesGeneration == generation ? (std::max)(m_scannedLine, m_firstLine) : m_firstLine;
+        lastLine = (std::min)(m_nextLine, firstLine + FilterChunkSize);
+        hasMore = lastLine != m_nextLine;
+
+        // Texts are copied so the search itself doesn't block the writer
+        for (uint64_t lineIndex = firstLine; lineIndex < lastLine; lineIndex++)
+        {
+            if (m_pLines[lineIndex % MaxLines].Level >= m_filterLevel)
+                candidates.emplace_back(lineIndex, filterText.empty() ? std::string() : GetText(lineIndex));
+        }
+    }
+
+    std::vector<uint64_t> matches;
+    for (auto& candidate : candidates)
+    {
+        ToLower(candidate.second);
+        if (candidate.second.find(filterText) != std::string::npos)
+            matches.push_back(candidate.first);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (generation != m_filterGeneration)
+        return true;
+
+    if (m_matchesGeneration != generation)
+    {
+        m_matches.clear();
+        m_matchesGeneration = generation;
+    }
+    m_matches.insert(m_matches.end(), matches.begin(), matches.end());
+    m_scannedLine = lastLine;
+
+    size_t firstMatch = GetFirstMatch();
+    if (firstMatch > 1024 && firstMatch > m_matches.size() / 2)
+        m_matches.erase(m_matches.begin(), m_matches.begin() + firstMatch);
+    return hasMore;
+}
+
+DWORD Pyx::Graphics::Gui::ConsoleLog::FilterThread(LPVOID pData)
+{
+    auto* pConsoleLog = static_cast<ConsoleLog*>(pData);
+    HANDLE handles[] = { pConsoleLog->m_hStopEvent, pConsoleLog->m_hFilterEvent };
+
+    while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0 + 1)
+    {
+        while (pConsoleLog->FilterPending())
+        {
+            if (WaitForSingleObject(pConsoleLog->m_hStopEvent, 0) == WAIT_OBJECT_0)
+                return 0;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <Windows.h>
+#include <Pyx/Pyx.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Pyx
+{
+    namespace Graphics
+    {
+        namespace Gui
+        {
+            // Console history : lines are appended by the log worker into a fixed
+            // arena and evicted oldest first, the gui only reads the rows it shows.
+            // Searches are run by a background thread which keeps the list of the
+            // matching lines up to date while new ones come in.
+            class ConsoleLog
+            {
+
+            public:
+                static const size_t MaxLines = 128 * 1024;
+                static const size_t ArenaSize = 16 * 1024 * 1024;
+                static const size_t FilterChunkSize = 4096;
+
+                struct VisibleLine
+                {
+                    LogLevel Level;
+                    std::string Text;
+                };
+
+            private:
+                // Binary log records keep their raw arguments and are only
+                // rendered when shown or searched
+                struct Line
+                {
+                    uint64_t ArenaPosition;
+                    uint32_t Size;
+                    LogLevel Level;
+                    bool IsRecord;
+                    uint64_t Time;
+                    uint64_t FormatId;
+                };
+
+            private:
+                static DWORD WINAPI FilterThread(LPVOID pData);
+
+            public:
+                static ConsoleLog& GetInstance();
+
+            private:
+                mutable std::mutex m_mutex;
+                std::unique_ptr<Line[]> m_pLines;
+                std::unique_ptr<char[]> m_pArena;
+                uint64_t m_firstLine;
+                uint64_t m_nextLine;
+                uint64_t m_arenaPosition;
+                std::unordered_map<uint64_t, std::string> m_renderedRecords;
+                std::string m_filterText;
+                LogLevel m_filterLevel;
+                uint32_t m_filterGeneration;
+                std::vector<uint64_t> m_matches;
+                uint32_t m_matchesGeneration;
+                uint64_t m_scannedLine;
+                std::atomic<bool> m_isFilterPending;
+                HANDLE m_hFilterThread;
+                HANDLE m_hStopEvent;
+                HANDLE m_hFilterEvent;
+
+            private:
+                explicit ConsoleLog();
+                ~ConsoleLog();
+                void Append(LogLevel level, bool isRecord, uint64_t time, uint64_t formatId, const void* pData, size_t size);
+                std::string GetText(uint64_t lineIndex);
+                bool IsFiltered() const { return !m_filterText.empty() || m_filterLevel != LogLevel::Trace; }
+                size_t GetFirstMatch() const;
+                bool FilterPending();
+
+            public:
+                void StartWorker();
+                void StopWorker();
+                void AddLine(LogLevel level, const std::string& text);
+                void AddRecord(LogLevel level, uint64_t time, uint64_t formatId, const uint8_t* pArgs, size_t argsSize);
+                void SetFilter(const std::string& text, LogLevel minLevel);
+                void Clear();
+                size_t GetLineCount() const;
+                size_t GetVisibleCount() const;
+                void GetVisibleLines(size_t first, size_t count, std::vector<VisibleLine>& lines);
+
+            };
+        }
+    }
+}
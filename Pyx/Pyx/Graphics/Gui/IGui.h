@@ -40,7 +40,8 @@ namespace Pyx
 				virtual bool IsVisible() const = 0;
 				virtual void ToggleVisibility(bool bVisible) = 0;
                 virtual bool OnWindowMessage(const MSG* lpMsg) { return false; }
-                virtual void Logger_OnWriteLine(const std::wstring& line) { }
+                virtual void Logger_OnWriteLine(LogLevel level, const std::wstring& line) { }
+                virtual void Logger_OnWriteRecord(LogLevel level, uint64_t time, uint64_t formatId, const uint8_t* pArgs, size_t argsSize) { }
                 virtual bool OnGetCursorPos(LPPOINT lpPoint) { return false; }
 
             };
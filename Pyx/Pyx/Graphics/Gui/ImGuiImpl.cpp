@@ -10,6 +10,19 @@
 #include <MaterialDesign/IconsMaterialDesign.h>
 #include <Pyx/Input/InputContext.h>
 #include <ImGui/imgui_internal.h>
+#include <Pyx/Memory/MemoryWatcher.h>
+#include <Pyx/Math/PathfindingContext.h>
+#include <Pyx/Threading/Future.h>
+#include <Pyx/Scripting/PulseScheduler.h>
+#include <Pyx/Logging/LogContext.h>
+#include <Pyx/Profiling/Profiler.h>
+#include <algorithm>
+
+namespace
+{
+    // Set on the render thread between NewFrame and Render
+    thread_local bool t_isBuildingFrame = false;
+}
 
 Pyx::Graphics::Gui::ImGuiImpl& Pyx::Graphics::Gui::ImGuiImpl::GetInstance()
 {
@@ -17,10 +30,15 @@ Pyx::Graphics::Gui::ImGuiImpl& Pyx::Graphics::Gui::ImGuiImpl::GetInstance()
     return instance;
 }
 
-Pyx::Graphics::Gui::ImGuiImpl::ImGuiImpl()
-    : IGui(), m_isResourcesCreated(false), m_isInitialized(false), m_showDebugWindow(false)
+bool Pyx::Graphics::Gui::ImGuiImpl::IsBuildingFrame()
 {
+    return t_isBuildingFrame;
+}
 
+Pyx::Graphics::Gui::ImGuiImpl::ImGuiImpl()
+    : IGui(), m_isResourcesCreated(false), m_isInitialized(false), m_showDebugWindow(false), m_logScrollToEnd(false)
+{
+    m_logFilterText[0] = '\0';
 }
 
 Pyx::Graphics::Gui::ImGuiImpl::~ImGuiImpl()
@@ -159,6 +177,7 @@ void Pyx::Graphics::Gui::ImGuiImpl::CreateResources()
 
 void Pyx::Graphics::Gui::ImGuiImpl::OnFrame()
 {
+    PYX_PROFILE_SCOPE("ImGuiImpl::OnFrame");
     if (m_isInitialized)
     {
 
@@ -204,6 +223,12 @@ void Pyx::Graphics::Gui::ImGuiImpl::OnFrame()
                     return;
                 }
 
+                t_isBuildingFrame = true;
+                Memory::MemoryWatcher::GetInstance().DispatchPendingChanges();
+                Math::PathfindingContext::GetInstance().DispatchCompletedPaths();
+                Threading::Future::DispatchCompleted();
+                RunPendingScriptActions();
+
 				if (m_isVisible)
 				{
 
@@ -215,12 +240,19 @@ void Pyx::Graphics::Gui::ImGuiImpl::OnFrame()
 					if (m_showDebugWindow)
 						BuildDebugWindow();
 
-					GetOnRenderCallbacks().Run(this);
-					Scripting::ScriptingContext::GetInstance().FireCallbacks(L"ImGui.OnRender");
+					{
+						PYX_PROFILE_SCOPE("ImGui.OnRender");
+						GetOnRenderCallbacks().Run(this);
+						Scripting::ScriptingContext::GetInstance().TryFireCallbacks(L"ImGui.OnRender");
+					}
 
-					ImGui::Render();
+					{
+						PYX_PROFILE_SCOPE("ImGui::Render");
+						ImGui::Render();
+					}
 
 				}
+				t_isBuildingFrame = false;
 
             }
 
@@ -332,12 +364,17 @@ bool Pyx::Graphics::Gui::ImGuiImpl::OnWindowMessage(const MSG* lpMsg)
     return false;
 }
 
-void Pyx::Graphics::Gui::ImGuiImpl::Logger_OnWriteLine(const std::wstring& line)
+void Pyx::Graphics::Gui::ImGuiImpl::Logger_OnWriteLine(LogLevel level, const std::wstring& line)
 {
-    if (m_logsItems.size() > 100)
-        m_logsItems.erase(m_logsItems.begin());
+    // Called from the log worker thread
+    ConsoleLog::GetInstance().AddLine(level, Utility::String::utf8_encode(line));
+    m_logScrollToEnd = true;
+}
 
-    m_logsItems.push_back(Utility::String::utf8_encode(line));
+void Pyx::Graphics::Gui::ImGuiImpl::Logger_OnWriteRecord(LogLevel level, uint64_t time, uint64_t formatId, const uint8_t* pArgs, size_t argsSize)
+{
+    // Called from the log worker thread
+    ConsoleLog::GetInstance().AddRecord(level, time, formatId, pArgs, argsSize);
     m_logScrollToEnd = true;
 }
 
@@ -439,42 +476,76 @@ void Pyx::Graphics::Gui::ImGuiImpl::ToggleVisibility(bool bVisible)
 
 void Pyx::Graphics::Gui::ImGuiImpl::BuildMainMenuBar()
 {
+    PYX_PROFILE_SCOPE("ImGuiImpl::BuildMainMenuBar");
 	ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.95f);
     if (ImGui::BeginMainMenuBar())
     {
 
-        if (ImGui::BeginMenu((std::string(ICON_MD_HOME) + XorStringA(" Pyx")).c_str()))
+        if (ImGui::BeginMenu(XorStringStaticA(ICON_MD_HOME " Pyx")))
         {
-			ImGui::MenuItem((std::string(ICON_MD_FORMAT_LIST_BULLETED) + XorStringA(" Show console")).c_str(), nullptr, &m_showConsole);
-			ImGui::MenuItem((std::string(ICON_MD_BUILD) + XorStringA(" Show debug window")).c_str(), nullptr, &m_showDebugWindow);
+			ImGui::MenuItem(XorStringStaticA(ICON_MD_FORMAT_LIST_BULLETED " Show console"), nullptr, &m_showConsole);
+			ImGui::MenuItem(XorStringStaticA(ICON_MD_BUILD " Show debug window"), nullptr, &m_showDebugWindow);
 			ImGui::Separator();
-            if (ImGui::MenuItem((std::string(ICON_MD_EXIT_TO_APP) + XorStringA(" Unload")).c_str())) { PyxContext::GetInstance().RequestShutdown(); }
+            if (ImGui::MenuItem(XorStringStaticA(ICON_MD_EXIT_TO_APP " Unload"))) { PyxContext::GetInstance().RequestShutdown(); }
             ImGui::EndMenu();
         }
 
-        if (ImGui::BeginMenu((std::string(ICON_MD_EXTENSION) + XorStringA(" Scripts")).c_str()))
+        if (ImGui::BeginMenu(XorStringStaticA(ICON_MD_EXTENSION " Scripts")))
         {    
             
             for (auto* pScript : Scripting::ScriptingContext::GetInstance().GetScripts())
             {
                 auto& name = pScript->GetName();
                 if (ImGui::MenuItem((std::string(pScript->IsRunning() ? ICON_MD_CLEAR : ICON_MD_PLAY_CIRCLE_OUTLINE) + " " + Utility::String::utf8_encode(name)).c_str(), pScript->IsRunning() ? "(running)" : "(stopped)"))
-                    pScript->IsRunning() ? pScript->Stop() : pScript->Start();
+                {
+                    m_pendingScriptToggles.push_back(name);
+                }
             }
 
             ImGui::Separator();
-            if (ImGui::MenuItem((std::string(ICON_MD_REPLAY) + XorStringA(" Reload scripts")).c_str())) { Scripting::ScriptingContext::GetInstance().ReloadScripts(); }
+            if (ImGui::MenuItem(XorStringStaticA(ICON_MD_REPLAY " Reload scripts"))) { m_isScriptReloadPending = true; }
             ImGui::EndMenu();
         }
         
         GetOnDrawMainMenuBarCallbacks().Run(this);
-        Scripting::ScriptingContext::GetInstance().FireCallbacks(L"ImGui.OnRenderMainMenuBar");
+        Scripting::ScriptingContext::GetInstance().TryFireCallbacks(L"ImGui.OnRenderMainMenuBar");
 
         ImGui::EndMainMenuBar();
     }
 	ImGui::PopStyleVar();
 }
 
+void Pyx::Graphics::Gui::ImGuiImpl::RunPendingScriptActions()
+{
+    if (m_pendingScriptToggles.empty() && !m_isScriptReloadPending)
+        return;
+
+    // The pulse thread holds the scripting context for a whole pulse, the
+    // actions are retried on the next frame instead of stalling this one
+    auto& scriptingContext = Scripting::ScriptingContext::GetInstance();
+    std::unique_lock<std::recursive_mutex> lock(scriptingContext.GetMutex(), std::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+
+    if (m_isScriptReloadPending)
+    {
+        m_isScriptReloadPending = false;
+        m_pendingScriptToggles.clear();
+        scriptingContext.ReloadScripts();
+        return;
+    }
+
+    for (auto& name : m_pendingScriptToggles)
+    {
+        for (auto* pScript : scriptingContext.GetScripts())
+        {
+            if (pScript->GetName() == name)
+                pScript->IsRunning() ? pScript->Stop() : pScript->Start();
+        }
+    }
+    m_pendingScriptToggles.clear();
+}
+
 void Pyx::Graphics::Gui::ImGuiImpl::BuildDebugWindow()
 {
     if (GImGui)
@@ -484,18 +555,109 @@ void Pyx::Graphics::Gui::ImGuiImpl::BuildDebugWindow()
         {
             auto& io = ImGui::GetIO();
             ImGui::Text("Performance : %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+            auto& frameStats = GraphicsContext::GetInstance().GetFrameStats();
+            auto frameSummary = frameStats.GetSummary();
+            ImGui::Text("Frame time : p50 %.2f, p95 %.2f, p99 %.2f, max %.2f ms", frameSummary.P50, frameSummary.P95, frameSummary.P99, frameSummary.Max);
+            ImGui::Text("Present hook : %.1f%% of the frame time, %llu hitches", frameSummary.OverheadShare * 100.0, frameSummary.HitchCount);
+            frameStats.GetHistory(m_frameTimeHistory);
+            if (!m_frameTimeHistory.empty())
+            {
+                // Scaled on the recent percentiles so a single hitch doesn't flatten the plot
+                float scaleMax = (std::max)(static_cast<float>(frameSummary.P99) * 1.5f, 1.0f);
+                ImGui::PlotLines("##pyx_frame_times", m_frameTimeHistory.data(), static_cast<int>(m_frameTimeHistory.size()), 0, nullptr, 0.0f, scaleMax, ImVec2(ImGui::GetContentRegionAvailWidth(), 60.0f));
+            }
             ImGui::Text("Renderer : %s", GraphicsContext::GetInstance().GetMainRenderer()->GetRendererTypeString());
+            auto& pulseScheduler = Scripting::PulseScheduler::GetInstance();
+            ImGui::Text("Pulse : %u Hz (%llu pulses, %llu dropped)", pulseScheduler.GetRate(), pulseScheduler.GetPulseCount(), pulseScheduler.GetDroppedCount());
             ImGui::Text("Cursor visible : %d", Input::InputContext::GetInstance().CursorIsVisible());
             ImGui::Text("Cursor position : %.0f, %.0f", io.MousePos.x, io.MousePos.y);
             ImGui::Text("WantCaptureMouse : %d", io.WantCaptureMouse);
             ImGui::Text("WantCaptureKeyboard : %d", io.WantCaptureKeyboard);
             ImGui::Text("WantTextInput : %d", io.WantTextInput);
             ImGui::Text("HoveredWindow : %s", g.HoveredWindow ? g.HoveredWindow->Name : "<null>");
+            auto logStats = Logging::LogContext::GetInstance().GetStats();
+            ImGui::Text("Logs : %llu written, %llu dropped", logStats.Written, logStats.Dropped);
+            ImGui::Text("Console : %u lines", static_cast<unsigned int>(ConsoleLog::GetInstance().GetLineCount()));
+            if (ImGui::CollapsingHeader("Profiler##pyx_profiler"))
+                BuildProfilerView();
         }
         ImGui::End();
     }
 }
 
+void Pyx::Graphics::Gui::ImGuiImpl::BuildProfilerView()
+{
+    auto& profiler = Profiling::Profiler::GetInstance();
+    bool isEnabled = profiler.IsEnabled();
+    if (ImGui::Checkbox("Capture##pyx_profiler_capture", &isEnabled))
+        profiler.SetEnabled(isEnabled);
+    ImGui::SameLine();
+    ImGui::Checkbox("Pause##pyx_profiler_pause", &m_profilePaused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export trace##pyx_profiler_export"))
+    {
+        const auto& settings = PyxContext::GetInstance().GetSettings();
+        auto fileName = settings.RootDirectory + settings.ProfileTraceFile;
+        if (profiler.ExportChromeTrace(fileName))
+            PYX_LOG_INFO(General, L"[Profiler] Trace written to \"%s\"", fileName.c_str());
+        else
+            PYX_LOG_ERROR(General, L"[Profiler] Unable to write the trace to \"%s\"", fileName.c_str());
+    }
+
+    if (isEnabled && !m_profilePaused)
+        profiler.CaptureLastFrame(m_profileCapture);
+
+    auto& capture = m_profileCapture;
+    if (capture.Threads.empty() || capture.End <= capture.Begin)
+    {
+        ImGui::TextDisabled("No frame captured");
+        return;
+    }
+
+    const double ticksPerMillisecond = capture.TicksPerMicrosecond * 1000.0;
+    ImGui::Text("Frame : %.3f ms", (capture.End - capture.Begin) / ticksPerMillisecond);
+
+    // One lane per thread, scopes are stacked by depth and scaled to the frame
+    auto* pDrawList = ImGui::GetWindowDrawList();
+    const float width = (std::max)(ImGui::GetContentRegionAvailWidth(), 100.0f);
+    const float rowHeight = ImGui::GetTextLineHeight() + 2.0f;
+    const double ticksPerPixel = static_cast<double>(capture.End - capture.Begin) / width;
+    for (auto& thread : capture.Threads)
+    {
+        uint32_t maxDepth = 0;
+        for (auto& event : thread.Events)
+            maxDepth = (std::max)(maxDepth, event.Depth);
+
+        ImGui::Text("Thread %u", static_cast<unsigned int>(thread.ThreadId));
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImVec2 size(width, rowHeight * (maxDepth + 1));
+        pDrawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), ImColor(30, 30, 30, 200));
+
+        for (auto& event : thread.Events)
+        {
+            uint64_t begin = (std::max)(event.Begin, capture.Begin) - capture.Begin;
+            uint64_t end = (std::min)(event.End, capture.End) - capture.Begin;
+            float x0 = origin.x + static_cast<float>(begin / ticksPerPixel);
+            float x1 = (std::max)(x0 + 1.0f, origin.x + static_cast<float>(end / ticksPerPixel));
+            float y0 = origin.y + event.Depth * rowHeight;
+            float y1 = y0 + rowHeight - 1.0f;
+
+            // Names live as long as the process, their address gives a stable color
+            float hue = static_cast<float>(((reinterpret_cast<uintptr_t>(event.Name) >> 4) * 2654435761u) % 360) / 360.0f;
+            pDrawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ImColor::HSV(hue, 0.5f, 0.6f));
+            if (x1 - x0 > 8.0f)
+            {
+                ImVec4 clipRect(x0, y0, x1, y1);
+                pDrawList->AddText(ImGui::GetFont(), ImGui::GetFontSize(), ImVec2(x0 + 2.0f, y0 + 1.0f), ImColor(255, 255, 255), event.Name, nullptr, 0.0f, &clipRect);
+            }
+            if (ImGui::IsMouseHoveringRect(ImVec2(x0, y0), ImVec2(x1, y1)))
+                ImGui::SetTooltip("%s\n%.3f ms", event.Name, (event.End - event.Begin) / ticksPerMillisecond);
+        }
+
+        ImGui::Dummy(size);
+    }
+}
+
 void Pyx::Graphics::Gui::ImGuiImpl::BuildLogsWindow()
 {
     static bool logVisible = true;
@@ -510,18 +672,42 @@ void Pyx::Graphics::Gui::ImGuiImpl::BuildLogsWindow()
             ImGui::SetWindowPos(ImVec2(0, g.FontBaseSize + g.Style.FramePadding.y * 2.0f));
             ImGui::SetWindowSize(ImVec2(ImGui::GetIO().DisplaySize.x, ImGui::GetWindowHeight()));
 
-            for (std::string& item : m_logsItems)
+            ImGui::PushItemWidth(ImGui::GetWindowContentRegionWidth() - 100);
+            ImGui::InputText("##pyx_log_filter", m_logFilterText, sizeof(m_logFilterText));
+            ImGui::PopItemWidth();
+            ImGui::SameLine();
+            ImGui::PushItemWidth(-1);
+            ImGui::Combo("##pyx_log_level", &m_logFilterLevel, "Trace\0Debug\0Info\0Warning\0Error\0");
+            ImGui::PopItemWidth();
+            ConsoleLog::GetInstance().SetFilter(m_logFilterText, static_cast<LogLevel>(m_logFilterLevel));
+
+            ImGui::BeginChild("##pyx_console_lines");
+            bool isAtEnd = ImGui::GetScrollY() >= ImGui::GetScrollMaxY();
+
+            // Only the rows in view are fetched from the console history
+            ImGuiListClipper clipper(static_cast<int>(ConsoleLog::GetInstance().GetVisibleCount()), ImGui::GetTextLineHeightWithSpacing());
+            ConsoleLog::GetInstance().GetVisibleLines(clipper.DisplayStart, clipper.DisplayEnd - clipper.DisplayStart, m_logVisibleLines);
+            for (auto& line : m_logVisibleLines)
             {
-                ImVec4 col = ImColor(255, 255, 255);
-                ImGui::PushStyleColor(ImGuiCol_Text, col);
-                ImGui::TextUnformatted(item.c_str());
-                ImGui::PopStyleColor();
+                bool hasColor = true;
+                switch (line.Level)
+                {
+                case LogLevel::Trace:
+                case LogLevel::Debug: ImGui::PushStyleColor(ImGuiCol_Text, ImColor(160, 160, 160)); break;
+                case LogLevel::Warning: ImGui::PushStyleColor(ImGuiCol_Text, ImColor(255, 220, 80)); break;
+                case LogLevel::Error: ImGui::PushStyleColor(ImGuiCol_Text, ImColor(255, 90, 90)); break;
+                default: hasColor = false; break;
+                }
+                ImGui::TextUnformatted(line.Text.c_str(), line.Text.c_str() + line.Text.size());
+                if (hasColor) ImGui::PopStyleColor();
             }
+            for (int i = clipper.DisplayStart + static_cast<int>(m_logVisibleLines.size()); i < clipper.DisplayEnd; i++)
+                ImGui::TextUnformatted("");
+            clipper.End();
 
-            if (m_logScrollToEnd) ImGui::SetScrollHere();
-            m_logScrollToEnd = false;
-
-
+            // New lines only pull the view down when it was already at the end
+            if (m_logScrollToEnd.exchange(false) && isAtEnd) ImGui::SetScrollHere();
+            ImGui::EndChild();
         }
         ImGui::End();
 		ImGui::PopStyleVar(3);
@@ -2,7 +2,9 @@
 #include <Pyx/Graphics/GraphicsContext.h>
 #include <Pyx/Pyx.h>
 #include "IGui.h"
-#include <mutex>
+#include <Pyx/Graphics/Gui/ConsoleLog.h>
+#include <Pyx/Profiling/Profiler.h>
+#include <atomic>
 #include <vector>
 
 namespace Pyx
@@ -21,6 +23,8 @@ namespace Pyx
 
             public:
                 static ImGuiImpl& GetInstance();
+                // ImGui can only be used by the render thread while it builds a frame
+                static bool IsBuildingFrame();
 
 			private:
 				static void SetupStyle();
@@ -30,12 +34,23 @@ namespace Pyx
                 bool m_isInitialized;
                 bool m_showDebugWindow;
 				bool m_showConsole = true;
-                std::vector<std::string> m_logsItems;
-                bool m_logScrollToEnd = false;
+                std::atomic<bool> m_logScrollToEnd;
+                char m_logFilterText[128];
+                int m_logFilterLevel = 0;
+                std::vector<ConsoleLog::VisibleLine> m_logVisibleLines;
+                std::vector<float> m_frameTimeHistory;
+                bool m_profilePaused = false;
+                Profiling::ProfileCapture m_profileCapture;
 				bool m_isVisible = false;
                 POINT m_lastValidMousePosition;
                 Utility::Callbacks<tOnRender> m_OnRenderCallbacks;
                 Utility::Callbacks<tOnDrawMainMenuBar> m_OnDrawMainMenuBarCallbacks;
+                // Script menu actions, applied once the pulse thread releases the scripts
+                std::vector<std::wstring> m_pendingScriptToggles;
+                bool m_isScriptReloadPending = false;
+
+            private:
+                void RunPendingScriptActions();
 
             public:
                 explicit ImGuiImpl();
@@ -49,12 +64,14 @@ namespace Pyx
                 void CreateResources() override;
                 void OnFrame() override;
                 bool OnWindowMessage(const MSG* lpMsg) override;
-                void Logger_OnWriteLine(const std::wstring& line) override;
+                void Logger_OnWriteLine(LogLevel level, const std::wstring& line) override;
+                void Logger_OnWriteRecord(LogLevel level, uint64_t time, uint64_t formatId, const uint8_t* pArgs, size_t argsSize) override;
                 bool OnGetCursorPos(LPPOINT lpPoint) override;
 				bool IsVisible() const override { return m_isVisible; }
 				void ToggleVisibility(bool bVisible) override;
                 void BuildMainMenuBar();
                 void BuildDebugWindow();
+                void BuildProfilerView();
                 void BuildLogsWindow();
                 Utility::Callbacks<tOnRender>& GetOnRenderCallbacks() { return m_OnRenderCallbacks; }
                 Utility::Callbacks<tOnDrawMainMenuBar>& GetOnDrawMainMenuBarCallbacks() { return m_OnDrawMainMenuBarCallbacks; }
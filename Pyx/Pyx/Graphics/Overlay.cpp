@@ -0,0 +1,161 @@
+#include <Pyx/Graphics/Overlay.h>
+#include <Pyx/Scripting/LuaModules/ImGui.h>
+#include <algorithm>
+#include <cmath>
+
+Pyx::Graphics::Overlay& Pyx::Graphics::Overlay::GetInstance()
+{
+    static Overlay instance;
+    return instance;
+}
+
+void Pyx::Graphics::Overlay::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+    using namespace LuaIntf;
+    using namespace Pyx::Math;
+    LuaBinding(pScript->GetLuaState())
+        .beginModule("Pyx")
+        .beginModule("Graphics")
+        .beginModule("Overlay")
+        .addFunction("DrawBoxes", [](const Matrix4& viewProjection, const Vector3Array& positions, float height, const ImVec4& color, float thickness, float widthRatio)
+        {
+            return GetInstance().DrawBoxes(viewProjection, positions, height, widthRatio, ImGui::ColorConvertFloat4ToU32(color), thickness);
+        }, LUA_ARGS(const Matrix4&, const Vector3Array&, float, const ImVec4&, _def<float, 1>, _def<float, 1, 2>))
+        .addFunction("DrawLabels", [](const Matrix4& viewProjection, const Vector3Array& positions, LuaRef labels, const ImVec4& color, float heightOffset)
+        {
+            std::vector<std::string> texts(positions.GetSize());
+            for (size_t i = 0; i < texts.size(); i++)
+                texts[i] = labels.get<std::string>(i + 1);
+            return GetInstance().DrawLabels(viewProjection, positions, texts, heightOffset, ImGui::ColorConvertFloat4ToU32(color));
+        }, LUA_ARGS(const Matrix4&, const Vector3Array&, LuaRef, const ImVec4&, _def<float, 0>))
+        .addFunction("DrawLines", [](const Matrix4& viewProjection, const Vector3Array& from, const Vector3Array& to, const ImVec4& color, float thickness)
+        {
+            return GetInstance().DrawLines(viewProjection, from, to, ImGui::ColorConvertFloat4ToU32(color), thickness);
+        }, LUA_ARGS(const Matrix4&, const Vector3Array&, const Vector3Array&, const ImVec4&, _def<float, 1>))
+        .endModule()
+        .endModule()
+        .endModule();
+    LuaModules::ImGuiLua::RestrictToFrame(pScript->GetLuaState(), "Pyx.Graphics.Overlay");
+}
+
+Pyx::Graphics::Overlay::Overlay()
+{
+}
+
+Pyx::Graphics::Overlay::~Overlay()
+{
+}
+
+ImDrawList* Pyx::Graphics::Overlay::BeginLayer()
+{
+    // Every layer appends to the same borderless window, it is never focused
+    // so it stays behind the other windows and doesn't take any input
+    auto& io = ImGui::GetIO();
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("##pyx_overlay", nullptr, io.DisplaySize, 0.0f,
+        ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollbar |
+        ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoBringToFrontOnFocus);
+    auto* pDrawList = ImGui::GetWindowDrawList();
+    pDrawList->PushClipRectFullScreen();
+    return pDrawList;
+}
+
+void Pyx::Graphics::Overlay::EndLayer()
+{
+    ImGui::GetWindowDrawList()->PopClipRect();
+    ImGui::End();
+}
+
+size_t Pyx::Graphics::Overlay::DrawBoxes(const Math::Matrix4& viewProjection, const Math::Vector3Array& positions, float height, float widthRatio, ImU32 color, float thickness)
+{
+    auto& io = ImGui::GetIO();
+    viewProjection.ProjectArray(positions, Math::Vector3(), io.DisplaySize.x, io.DisplaySize.y, m_screen, m_flags);
+    viewProjection.ProjectArray(positions, Math::Vector3(0.0f, height, 0.0f), io.DisplaySize.x, io.DisplaySize.y, m_screenEnd, m_flagsEnd);
+
+    const float* pBaseX = m_screen.GetX();
+    const float* pBaseY = m_screen.GetY();
+    const float* pTopX = m_screenEnd.GetX();
+    const float* pTopY = m_screenEnd.GetY();
+    size_t count = 0;
+
+    auto* pDrawList = BeginLayer();
+    for (size_t i = 0; i < m_flags.size(); i++)
+    {
+        uint8_t flags = m_flags[i] & m_flagsEnd[i];
+        if (!(flags & Math::Matrix4::InFront) || !((m_flags[i] | m_flagsEnd[i]) & Math::Matrix4::InFrustum))
+            continue;
+
+        float centerX = (pBaseX[i] + pTopX[i]) * 0.5f;
+        float halfWidth = fabsf(pBaseY[i] - pTopY[i]) * widthRatio * 0.5f;
+        ImVec2 min(centerX - halfWidth, (std::min)(pBaseY[i], pTopY[i]));
+        ImVec2 max(centerX + halfWidth, (std::max)(pBaseY[i], pTopY[i]));
+        pDrawList->AddRect(min, max, color, 0.0f, 0x0F, thickness);
+        count++;
+    }
+    EndLayer();
+
+    return count;
+}
+
+size_t Pyx::Graphics::Overlay::DrawLabels(const Math::Matrix4& viewProjection, const Math::Vector3Array& positions, const std::vector<std::string>& labels, float heightOffset, ImU32 color)
+{
+    auto& io = ImGui::GetIO();
+    viewProjection.ProjectArray(positions, Math::Vector3(0.0f, heightOffset, 0.0f), io.DisplaySize.x, io.DisplaySize.y, m_screen, m_flags);
+
+    const float* pX = m_screen.GetX();
+    const float* pY = m_screen.GetY();
+    const size_t size = (std::min)(m_flags.size(), labels.size());
+    size_t count = 0;
+
+    auto* pDrawList = BeginLayer();
+    for (size_t i = 0; i < size; i++)
+    {
+        if (!(m_flags[i] & Math::Matrix4::InFrustum) || labels[i].empty())
+            continue;
+
+        const char* pBegin = labels[i].c_str();
+        const char* pEnd = pBegin + labels[i].size();
+        ImVec2 textSize = ImGui::CalcTextSize(pBegin, pEnd);
+        pDrawList->AddText(ImVec2(floorf(pX[i] - textSize.x * 0.5f), floorf(pY[i] - textSize.y)), color, pBegin, pEnd);
+        count++;
+    }
+    EndLayer();
+
+    return count;
+}
+
+size_t Pyx::Graphics::Overlay::DrawLines(const Math::Matrix4& viewProjection, const Math::Vector3Array& from, const Math::Vector3Array& to, ImU32 color, float thickness)
+{
+    // A single start position is shared by every line, which is what snap
+    // lines from the local player need
+    const bool isSharedFrom = from.GetSize() == 1;
+    if (!isSharedFrom && from.GetSize() != to.GetSize())
+        return 0;
+
+    auto& io = ImGui::GetIO();
+    viewProjection.ProjectArray(from, Math::Vector3(), io.DisplaySize.x, io.DisplaySize.y, m_screen, m_flags);
+    viewProjection.ProjectArray(to, Math::Vector3(), io.DisplaySize.x, io.DisplaySize.y, m_screenEnd, m_flagsEnd);
+
+    const float* pFromX = m_screen.GetX();
+    const float* pFromY = m_screen.GetY();
+    const float* pToX = m_screenEnd.GetX();
+    const float* pToY = m_screenEnd.GetY();
+    size_t count = 0;
+
+    // Lines are not clipped against the near plane, the ones with an end
+    // behind the camera are skipped and the rest is scissored by ImGui
+    auto* pDrawList = BeginLayer();
+    for (size_t i = 0; i < m_flagsEnd.size(); i++)
+    {
+        size_t j = isSharedFrom ? 0 : i;
+        if (!(m_flags[j] & m_flagsEnd[i] & Math::Matrix4::InFront))
+            continue;
+
+        pDrawList->AddLine(ImVec2(pFromX[j], pFromY[j]), ImVec2(pToX[i], pToY[i]), color, thickness);
+        count++;
+    }
+    EndLayer();
+
+    return count;
+}
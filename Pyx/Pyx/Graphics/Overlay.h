@@ -0,0 +1,44 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Matrix4.h>
+#include <Pyx/Math/Vector3Array.h>
+#include <ImGui/imgui.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Pyx
+{
+    namespace Graphics
+    {
+        // Draws world space overlays (boxes, labels, lines) a whole layer at a
+        // time : the positions are projected in one batch and the primitives of
+        // the visible ones go straight into a full screen ImGui draw list.
+        // Must be used while the gui is rendering, like every ImGui call.
+        class Overlay
+        {
+
+        public:
+            static Overlay& GetInstance();
+            static void BindWithScript(Pyx::Scripting::Script* pScript);
+
+        private:
+            Math::Vector3Array m_screen;
+            Math::Vector3Array m_screenEnd;
+            std::vector<uint8_t> m_flags;
+            std::vector<uint8_t> m_flagsEnd;
+
+        private:
+            ImDrawList* BeginLayer();
+            void EndLayer();
+
+        public:
+            explicit Overlay();
+            ~Overlay();
+            size_t DrawBoxes(const Math::Matrix4& viewProjection, const Math::Vector3Array& positions, float height, float widthRatio, ImU32 color, float thickness);
+            size_t DrawLabels(const Math::Matrix4& viewProjection, const Math::Vector3Array& positions, const std::vector<std::string>& labels, float heightOffset, ImU32 color);
+            size_t DrawLines(const Math::Matrix4& viewProjection, const Math::Vector3Array& from, const Math::Vector3Array& to, ImU32 color, float thickness);
+
+        };
+    }
+}
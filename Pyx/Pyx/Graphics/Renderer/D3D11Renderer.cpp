@@ -5,6 +5,7 @@
 #include <Pyx/Graphics/GraphicsContext.h>
 #include <Pyx/Graphics/Gui/IGui.h>
 #include <Pyx/Patch/Detour.h>
+#include <Pyx/Profiling/Profiler.h>
 
 typedef void(WINAPI *tID3D11DeviceContext__OMSetRenderTargets)(ID3D11DeviceContext* pContext, unsigned int numViews, ID3D11RenderTargetView** ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView);
 
@@ -124,7 +125,7 @@ void Pyx::Graphics::Renderer::D3D11Renderer::SetDevice(ID3D11Device* pDevice, ID
     if (pDevice != m_pDevice || pSwapChain != m_pSwapChain)
     {
 
-        PyxContext::GetInstance().Log("[D3D11Renderer] Device 0x%X, SwapChain 0x%X", pDevice, pSwapChain);
+        PYX_LOG_DEBUG(Graphics, "[D3D11Renderer] Device 0x%X, SwapChain 0x%X", pDevice, pSwapChain);
 
         ApplyDevicesHook();
 
@@ -187,6 +188,7 @@ void Pyx::Graphics::Renderer::D3D11Renderer::OnOMSetRenderTargets(ID3D11DeviceCo
 
 void Pyx::Graphics::Renderer::D3D11Renderer::OnPresent(ID3D11Device* pDevice, IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags)
 {
+    PYX_PROFILE_SCOPE("D3D11Renderer::OnPresent");
     SetDevice(pDevice, pSwapChain);
 
     if (!m_isResourceCreated)
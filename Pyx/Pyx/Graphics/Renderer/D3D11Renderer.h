@@ -36,11 +36,11 @@ namespace Pyx
                 D3D11StateBlock* m_pStateBlockOriginal;
                 D3D11StateBlock* m_pStateBlockCustom;
                 ID3D11BlendState* m_pDefaultBlendState;
-                Utility::Callbacks<tOnDeviceChanged> m_OnDeviceChangedCallbacks;
-                Utility::Callbacks<tOnPresent> m_OnPresentCallbacks;
-                Utility::Callbacks<tOnResizeBuffers> m_OnResizeBuffersCallbacks;
-                Utility::Callbacks<tOnResizeTarget> m_OnResizeTargetCallbacks;
-                Utility::Callbacks<tOnOMSetRenderTargets> m_OnOMSetRenderTargetsCallbacks;
+                Utility::Callbacks<tOnDeviceChanged, Utility::CallbacksMode::Snapshot> m_OnDeviceChangedCallbacks;
+                Utility::Callbacks<tOnPresent, Utility::CallbacksMode::Snapshot> m_OnPresentCallbacks;
+                Utility::Callbacks<tOnResizeBuffers, Utility::CallbacksMode::Snapshot> m_OnResizeBuffersCallbacks;
+                Utility::Callbacks<tOnResizeTarget, Utility::CallbacksMode::Snapshot> m_OnResizeTargetCallbacks;
+                Utility::Callbacks<tOnOMSetRenderTargets, Utility::CallbacksMode::Snapshot> m_OnOMSetRenderTargetsCallbacks;
 
             public:
                 explicit D3D11Renderer();
@@ -60,11 +60,11 @@ namespace Pyx
                 void OnResizeBuffers(ID3D11Device* pDevice, IDXGISwapChain* pSwapChain, UINT bufferCount, UINT width, UINT height, DXGI_FORMAT newFormat, UINT swapChainFlags);
                 void OnResizeTarget(ID3D11Device* pDevice, IDXGISwapChain* pSwapChain, DXGI_MODE_DESC *pNewTargetParameters);
                 void OnOMSetRenderTargets(ID3D11DeviceContext* pContext, unsigned int numViews, ID3D11RenderTargetView** ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView);
-                Utility::Callbacks<tOnDeviceChanged>& GetOnDeviceChangedCallbacks() { return m_OnDeviceChangedCallbacks; }
-                Utility::Callbacks<tOnPresent>& GetOnPresentCallbacks() { return m_OnPresentCallbacks; }
-                Utility::Callbacks<tOnResizeBuffers>& GetOnResizeBuffersCallbacks() { return m_OnResizeBuffersCallbacks; }
-                Utility::Callbacks<tOnResizeTarget>& GetOnResizeTargetCallbacks() { return m_OnResizeTargetCallbacks; }
-                Utility::Callbacks<tOnOMSetRenderTargets>& GetOnOMSetRenderTargetsCallbacks() { return m_OnOMSetRenderTargetsCallbacks; }
+                Utility::Callbacks<tOnDeviceChanged, Utility::CallbacksMode::Snapshot>& GetOnDeviceChangedCallbacks() { return m_OnDeviceChangedCallbacks; }
+                Utility::Callbacks<tOnPresent, Utility::CallbacksMode::Snapshot>& GetOnPresentCallbacks() { return m_OnPresentCallbacks; }
+                Utility::Callbacks<tOnResizeBuffers, Utility::CallbacksMode::Snapshot>& GetOnResizeBuffersCallbacks() { return m_OnResizeBuffersCallbacks; }
+                Utility::Callbacks<tOnResizeTarget, Utility::CallbacksMode::Snapshot>& GetOnResizeTargetCallbacks() { return m_OnResizeTargetCallbacks; }
+                Utility::Callbacks<tOnOMSetRenderTargets, Utility::CallbacksMode::Snapshot>& GetOnOMSetRenderTargetsCallbacks() { return m_OnOMSetRenderTargetsCallbacks; }
 
             };
         }
@@ -4,12 +4,17 @@
 #include <Pyx/Graphics/Gui/IGui.h>
 #include <Pyx/Utility/String.h>
 #include <Pyx/Patch/PatchContext.h>
+#include <Pyx/Profiling/Profiler.h>
+#include <Pyx/Telemetry/TelemetryContext.h>
+#include <Pyx/Graphics/GraphicsContext.h>
 
 typedef HRESULT(WINAPI *tIDirect3DDevice9__Present)(IDirect3DDevice9*, const RECT*, const RECT*, HWND, const RGNDATA*);
 typedef HRESULT(WINAPI *tIDirect3DDevice9__Reset)(IDirect3DDevice9*, D3DPRESENT_PARAMETERS*);
 
 Pyx::Patch::Detour<tIDirect3DDevice9__Present>* g_pIDirect3DDevice9__PresentDetour;
 Pyx::Patch::Detour<tIDirect3DDevice9__Reset>* g_pIDirect3DDevice9__ResetDetour;
+tIDirect3DDevice9__Present g_pIDirect3DDevice9__Present = nullptr;
+tIDirect3DDevice9__Reset g_pIDirect3DDevice9__Reset = nullptr;
 
 HRESULT WINAPI IDirect3DDevice9__ResetDetour(IDirect3DDevice9* pDevice, D3DPRESENT_PARAMETERS* pPresentParameters)
 {
@@ -22,13 +27,17 @@ HRESULT WINAPI IDirect3DDevice9__ResetDetour(IDirect3DDevice9* pDevice, D3DPRESE
 HRESULT WINAPI IDirect3DDevice9__PresentDetour(IDirect3DDevice9* pDevice,
     const RECT* pSourceRect, const RECT* pDestRect, HWND hDestWindowOverride, const RGNDATA* pDirtyRegion)
 {
+    PYX_PROFILE_FRAME();
     if (Pyx::PyxContext::GetInstance().IsShutdownedRequested())
     {
         auto result = g_pIDirect3DDevice9__PresentDetour->GetTrampoline()(pDevice, pSourceRect, pDestRect, hDestWindowOverride, pDirtyRegion);
         Pyx::PyxContext::GetInstance().Shutdown();
         return result;
     }
+    Pyx::Telemetry::TelemetryContext::GetInstance().OnPresent();
+    Pyx::Graphics::GraphicsContext::GetInstance().OnPresentStart();
     Pyx::Graphics::Renderer::D3D9Renderer::GetInstance().OnPresent(pDevice, pSourceRect, pDestRect, hDestWindowOverride, pDirtyRegion);
+    Pyx::Graphics::GraphicsContext::GetInstance().OnPresentEnd();
     auto result = g_pIDirect3DDevice9__PresentDetour->GetTrampoline()(pDevice, pSourceRect, pDestRect, hDestWindowOverride, pDirtyRegion);
     g_pIDirect3DDevice9__PresentDetour->EnsureApply();
     return result;
@@ -45,8 +54,15 @@ Pyx::Graphics::Renderer::D3D9Renderer::~D3D9Renderer()
 
 }
 
+void Pyx::Graphics::Renderer::D3D9Renderer::Prepare()
+{
+    if (!g_pIDirect3DDevice9__Present)
+        ResolveHookTargets();
+}
+
 void Pyx::Graphics::Renderer::D3D9Renderer::Initialize()
 {
+    Prepare();
     if (ApplyHooks())
     {
         
@@ -114,7 +130,7 @@ void Pyx::Graphics::Renderer::D3D9Renderer::SetDevice(IDirect3DDevice9* pDevice)
     if (pDevice != m_pDevice)
     {
 
-        PyxContext::GetInstance().Log("[D3D9Renderer] Device 0x%X", pDevice);
+        PYX_LOG_DEBUG(Graphics, "[D3D9Renderer] Device 0x%X", pDevice);
 
         ReleaseResources();
         m_pDevice = pDevice;
@@ -144,6 +160,7 @@ void Pyx::Graphics::Renderer::D3D9Renderer::OnResetDevice(IDirect3DDevice9* pDev
 void Pyx::Graphics::Renderer::D3D9Renderer::OnPresent(IDirect3DDevice9* pDevice, const RECT* pSourceRect, const RECT* pDestRect, HWND hDestWindowOverride, const RGNDATA* pDirtyRegion)
 {
 
+    PYX_PROFILE_SCOPE("D3D9Renderer::OnPresent");
     SetDevice(pDevice);
 
     if (!m_isResourceCreated)
@@ -211,7 +228,7 @@ void Pyx::Graphics::Renderer::D3D9Renderer::OnPresent(IDirect3DDevice9* pDevice,
 
 }
 
-bool Pyx::Graphics::Renderer::D3D9Renderer::ApplyHooks()
+bool Pyx::Graphics::Renderer::D3D9Renderer::ResolveHookTargets()
 {
 
     auto className = Utility::String::GetRandomString(20);
@@ -254,21 +271,34 @@ bool Pyx::Graphics::Renderer::D3D9Renderer::ApplyHooks()
     }
 
     void** ppVtable = *reinterpret_cast<void***>(pDevice);
+    g_pIDirect3DDevice9__Reset = static_cast<tIDirect3DDevice9__Reset>(ppVtable[16]);
+    g_pIDirect3DDevice9__Present = static_cast<tIDirect3DDevice9__Present>(ppVtable[17]);
+
+    pDevice->Release();
+    pIDirect3D9->Release();
+    DestroyWindow(hWnd);
+    return true;
+
+}
+
+bool Pyx::Graphics::Renderer::D3D9Renderer::ApplyHooks()
+{
+
+    if (!g_pIDirect3DDevice9__Present || !g_pIDirect3DDevice9__Reset)
+        return false;
+
     auto& patchContext = Pyx::Patch::PatchContext::GetInstance();
 
     patchContext.CreateAndApplyDetour<tIDirect3DDevice9__Reset>(
-        static_cast<tIDirect3DDevice9__Reset>(ppVtable[16]),
+        g_pIDirect3DDevice9__Reset,
         reinterpret_cast<tIDirect3DDevice9__Reset>(IDirect3DDevice9__ResetDetour),
         &g_pIDirect3DDevice9__ResetDetour);
 
     patchContext.CreateAndApplyDetour<tIDirect3DDevice9__Present>(
-        static_cast<tIDirect3DDevice9__Present>(ppVtable[17]),
+        g_pIDirect3DDevice9__Present,
         reinterpret_cast<tIDirect3DDevice9__Present>(IDirect3DDevice9__PresentDetour),
         &g_pIDirect3DDevice9__PresentDetour);
 
-    pDevice->Release();
-    pIDirect3D9->Release();
-    DestroyWindow(hWnd);
     return true;
 
 }
@@ -21,6 +21,7 @@ namespace Pyx
                     D3DPRESENT_PARAMETERS* pPresentationParameters);
 
             private:
+                static bool ResolveHookTargets();
                 static bool ApplyHooks();
 
             public:
@@ -31,13 +32,16 @@ namespace Pyx
                 IDirect3DDevice9* m_pDevice; 
                 IDirect3DStateBlock9* m_pStateBlockOriginal;
                 IDirect3DStateBlock9* m_pStateBlockCustom;
-                Utility::Callbacks<tOnIDirect3DDevice9__PresentCallback> m_OnIDirect3DDevice9__PresentCallbacks;
-                Utility::Callbacks<tOnIDirect3DDevice9__ResetCallback> m_OnIDirect3DDevice9__ResetCallbacks;
-                Utility::Callbacks<tOnIDirect3DDevice9Changed> m_OnIDirect3DDevice9ChangedCallbacks;
+                Utility::Callbacks<tOnIDirect3DDevice9__PresentCallback, Utility::CallbacksMode::Snapshot> m_OnIDirect3DDevice9__PresentCallbacks;
+                Utility::Callbacks<tOnIDirect3DDevice9__ResetCallback, Utility::CallbacksMode::Snapshot> m_OnIDirect3DDevice9__ResetCallbacks;
+                Utility::Callbacks<tOnIDirect3DDevice9Changed, Utility::CallbacksMode::Snapshot> m_OnIDirect3DDevice9ChangedCallbacks;
 
             public:
                 explicit D3D9Renderer();
                 ~D3D9Renderer() override;
+                // Prepare creates a dummy device to find the methods to hook, it
+                // doesn't need the process to be frozen unlike Initialize
+                void Prepare();
                 void Initialize();
                 void Shutdown();
                 RendererType GetRendererType() const override { return RendererType::D3D9; }
@@ -50,9 +54,9 @@ namespace Pyx
                 void SetDevice(IDirect3DDevice9* pDevice);
                 void OnPresent(IDirect3DDevice9* pDevice, const RECT* pSourceRect, const RECT* pDestRect, HWND hDestWindowOverride, const RGNDATA* pDirtyRegion);
                 void OnResetDevice(IDirect3DDevice9* pDevice, D3DPRESENT_PARAMETERS* pPresentationParameters);
-                Utility::Callbacks<tOnIDirect3DDevice9__PresentCallback>& GetOnIDirect3DDevice9__PresentCallbacks() { return m_OnIDirect3DDevice9__PresentCallbacks; }
-                Utility::Callbacks<tOnIDirect3DDevice9__ResetCallback>& GetOnIDirect3DDevice9__ResetCallbacks() { return m_OnIDirect3DDevice9__ResetCallbacks; }
-                Utility::Callbacks<tOnIDirect3DDevice9Changed>& GetOnIDirect3DDevice9ChangedCallbacks() { return m_OnIDirect3DDevice9ChangedCallbacks; }
+                Utility::Callbacks<tOnIDirect3DDevice9__PresentCallback, Utility::CallbacksMode::Snapshot>& GetOnIDirect3DDevice9__PresentCallbacks() { return m_OnIDirect3DDevice9__PresentCallbacks; }
+                Utility::Callbacks<tOnIDirect3DDevice9__ResetCallback, Utility::CallbacksMode::Snapshot>& GetOnIDirect3DDevice9__ResetCallbacks() { return m_OnIDirect3DDevice9__ResetCallbacks; }
+                Utility::Callbacks<tOnIDirect3DDevice9Changed, Utility::CallbacksMode::Snapshot>& GetOnIDirect3DDevice9ChangedCallbacks() { return m_OnIDirect3DDevice9ChangedCallbacks; }
             
             };
         }
@@ -5,6 +5,9 @@
 #include <Pyx/Graphics/Renderer/D3D11Renderer.h>
 #include <Pyx/Patch/Detour.h>
 #include <Pyx/Graphics/Renderer/DXGI.h>
+#include <Pyx/Profiling/Profiler.h>
+#include <Pyx/Telemetry/TelemetryContext.h>
+#include <Pyx/Graphics/GraphicsContext.h>
 #include <Pyx/Utility/String.h>
 #include <Pyx/Patch/PatchContext.h>
 #pragma comment(lib, "d3d10.lib")
@@ -17,9 +20,13 @@ typedef HRESULT(WINAPI *tIDXGISwapChain__ResizeTarget)(IDXGISwapChain* pSwapChai
 Pyx::Patch::Detour<tIDXGISwapChain__Present>* g_pIDXGISwapChain__PresentDetour;
 Pyx::Patch::Detour<tIDXGISwapChain__ResizeBuffers>* g_pIDXGISwapChain__ResizeBuffersDetour;
 Pyx::Patch::Detour<tIDXGISwapChain__ResizeTarget>* g_pIDXGISwapChain__ResizeTargetDetour;
+tIDXGISwapChain__Present g_pIDXGISwapChain__Present = nullptr;
+tIDXGISwapChain__ResizeBuffers g_pIDXGISwapChain__ResizeBuffers = nullptr;
+tIDXGISwapChain__ResizeTarget g_pIDXGISwapChain__ResizeTarget = nullptr;
 
 HRESULT WINAPI IDXGISwapChain__PresentDetour(struct IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags)
 {
+    PYX_PROFILE_FRAME();
     if (Pyx::PyxContext::GetInstance().IsShutdownedRequested())
     {
         auto result = g_pIDXGISwapChain__PresentDetour->GetTrampoline()(pSwapChain, SyncInterval, Flags);
@@ -27,6 +34,9 @@ HRESULT WINAPI IDXGISwapChain__PresentDetour(struct IDXGISwapChain* pSwapChain,
         return result;
     }
 
+    Pyx::Telemetry::TelemetryContext::GetInstance().OnPresent();
+    Pyx::Graphics::GraphicsContext::GetInstance().OnPresentStart();
+
     ID3D10Device* pD3D10Device = nullptr;
     ID3D11Device* pD3D11Device = nullptr;
 
@@ -37,6 +47,7 @@ HRESULT WINAPI IDXGISwapChain__PresentDetour(struct IDXGISwapChain* pSwapChain,
     }
 
     if (pD3D11Device) pD3D11Device->Release();
+    Pyx::Graphics::GraphicsContext::GetInstance().OnPresentEnd();
 
     auto result = g_pIDXGISwapChain__PresentDetour->GetTrampoline()(pSwapChain, SyncInterval, Flags);
     g_pIDXGISwapChain__PresentDetour->EnsureApply();
@@ -81,8 +92,15 @@ HRESULT WINAPI IDXGISwapChain__ResizeTargetDetour(IDXGISwapChain* pSwapChain, DX
     return result;
 }
 
+void Pyx::Graphics::Renderer::DXGI::Prepare()
+{
+    if (!g_pIDXGISwapChain__Present)
+        ResolveHookTargets();
+}
+
 void Pyx::Graphics::Renderer::DXGI::Initialize()
 {
+    Prepare();
     if (ApplyHooks())
     {
         
@@ -102,7 +120,7 @@ Pyx::Graphics::Renderer::DXGI& Pyx::Graphics::Renderer::DXGI::GetInstance()
     return instance;
 }
 
-bool Pyx::Graphics::Renderer::DXGI::ApplyHooks()
+bool Pyx::Graphics::Renderer::DXGI::ResolveHookTargets()
 {
 
     auto className = Utility::String::GetRandomString(20);
@@ -147,26 +165,40 @@ bool Pyx::Graphics::Renderer::DXGI::ApplyHooks()
     }
 
     void** ppVtable = *reinterpret_cast<void***>(pSwapChain);
+    g_pIDXGISwapChain__Present = static_cast<tIDXGISwapChain__Present>(ppVtable[8]);
+    g_pIDXGISwapChain__ResizeBuffers = static_cast<tIDXGISwapChain__ResizeBuffers>(ppVtable[13]);
+    g_pIDXGISwapChain__ResizeTarget = static_cast<tIDXGISwapChain__ResizeTarget>(ppVtable[14]);
+
+    if (pSwapChain) pSwapChain->Release();
+    if (pDevice) pDevice->Release();
+    DestroyWindow(hWnd);
+    return true;
+
+}
+
+bool Pyx::Graphics::Renderer::DXGI::ApplyHooks()
+{
+
+    if (!g_pIDXGISwapChain__Present || !g_pIDXGISwapChain__ResizeBuffers || !g_pIDXGISwapChain__ResizeTarget)
+        return false;
+
     auto& patchContext = Pyx::Patch::PatchContext::GetInstance();
 
     patchContext.CreateAndApplyDetour<tIDXGISwapChain__Present>(
-        static_cast<tIDXGISwapChain__Present>(ppVtable[8]),
+        g_pIDXGISwapChain__Present,
         reinterpret_cast<tIDXGISwapChain__Present>(IDXGISwapChain__PresentDetour),
         &g_pIDXGISwapChain__PresentDetour);
 
     patchContext.CreateAndApplyDetour<tIDXGISwapChain__ResizeBuffers>(
-        static_cast<tIDXGISwapChain__ResizeBuffers>(ppVtable[13]),
+        g_pIDXGISwapChain__ResizeBuffers,
         reinterpret_cast<tIDXGISwapChain__ResizeBuffers>(IDXGISwapChain__ResizeBuffersDetour),
         &g_pIDXGISwapChain__ResizeBuffersDetour);
 
     patchContext.CreateAndApplyDetour<tIDXGISwapChain__ResizeTarget>(
-        static_cast<tIDXGISwapChain__ResizeTarget>(ppVtable[14]),
+        g_pIDXGISwapChain__ResizeTarget,
         reinterpret_cast<tIDXGISwapChain__ResizeTarget>(IDXGISwapChain__ResizeTargetDetour),
         &g_pIDXGISwapChain__ResizeTargetDetour);
 
-    if (pSwapChain) pSwapChain->Release();
-    if (pDevice) pDevice->Release();
-    DestroyWindow(hWnd);
     return true;
 
 }
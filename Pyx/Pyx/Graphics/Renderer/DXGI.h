@@ -17,9 +17,11 @@ namespace Pyx
                 static DXGI& GetInstance();
 
             private:
+                static bool ResolveHookTargets();
                 static bool ApplyHooks();
 
             public:
+                void Prepare();
                 void Initialize();
                 void Shutdown();
 
@@ -0,0 +1,363 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace Pyx
+{
+    namespace Logging
+    {
+        // Binary log records : the format string is only stored once per file
+        // (keyed by its hash) and messages carry the raw argument bytes, the
+        // text is rendered later by the gui or offline by PyxCli.
+        // This header is shared with the tools and must only depend on the STL.
+        class BinaryLog
+        {
+
+        public:
+            static const uint32_t Magic = 0x4C585950; // "PYXL"
+            static const uint32_t Version = 2;
+            static const uint64_t TextFormatId = 0; // Single preformatted string argument
+            static const size_t MaxRecordSize = 0xFFF8;
+            static const size_t MaxStringLength = 1024;
+
+            enum class RecordType : uint8_t
+            {
+                Padding = 0,
+                Message = 1,
+                Format = 2
+            };
+
+            enum class ArgType : uint8_t
+            {
+                Int64 = 1,
+                UInt64 = 2,
+                Double = 3,
+                Pointer = 4,
+                String = 5,
+                WString = 6
+            };
+
+#pragma pack(push, 1)
+            struct FileHeader
+            {
+                uint32_t Magic;
+                uint32_t Version;
+                uint32_t ProcessId;
+                uint32_t Reserved;
+            };
+
+            // Records are padded to 8 bytes, Size includes the header and the
+            // payload (format string or type tagged arguments)
+            struct RecordHeader
+            {
+                uint16_t Size;
+                RecordType Type;
+                uint8_t Level; // Pyx::LogLevel
+                uint32_t ThreadId;
+                uint64_t Time;
+                uint64_t FormatId;
+            };
+#pragma pack(pop)
+
+        private:
+            template<typename T, typename Enable = void>
+            struct ArgTraits;
+
+        public:
+            // Wide formats are hashed per code unit and stored as UTF-8
+            template<typename TChar>
+            static uint64_t GetFormatId(const TChar* format)
+            {
+                uint64_t hash = 14695981039346656037ULL;
+                for (const TChar* p = format; *p; p++)
+                    hash = (hash ^ static_cast<uint64_t>(*p)) * 1099511628211ULL;
+                return hash != TextFormatId ? hash : 1;
+            }
+
+            static size_t Align(size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+
+            template<typename ... Args>
+            static size_t GetArgsSize(const Args& ... args)
+            {
+                size_t size = 0;
+                int expand[] = { 0, (size += 1 + ArgTraits<Args>::GetSize(args), 0)... };
+                (void)expand;
+                return size;
+            }
+
+            template<typename ... Args>
+            static uint8_t* WriteArgs(uint8_t* pData, const Args& ... args)
+            {
+                int expand[] = { 0, (pData = WriteArg(pData, args), 0)... };
+                (void)expand;
+                return pData;
+            }
+
+            // Renders a message with printf semantics, every conversion takes
+            // the next argument and is adapted to the type it was recorded with
+            static std::string RenderMessage(const char* format, const uint8_t* pArgs, size_t argsSize)
+            {
+                std::string result;
+                const uint8_t* pEnd = pArgs + argsSize;
+                const char* p = format;
+
+                while (*p)
+                {
+                    if (*p != '%')
+                    {
+                        const char* pNext = strchr(p, '%');
+                        size_t length = pNext ? static_cast<size_t>(pNext - p) : strlen(p);
+                        result.append(p, length);
+                        p += length;
+                        continue;
+                    }
+                    if (p[1] == '%')
+                    {
+                        result += '%';
+                        p += 2;
+                        continue;
+                    }
+
+                    // %[flags][width][.precision][length]conversion
+                    std::string spec = "%";
+                    p++;
+                    while (*p && strchr("-+ #0", *p))
+                        spec += *p++;
+                    for (int part = 0; part < 2; part++)
+                    {
+                        if (part == 1)
+                        {
+                            if (*p != '.')
+                                break;
+                            spec += *p++;
+                        }
+                        if (*p == '*')
+                        {
+                            std::string value;
+                            pArgs = ReadArg(pArgs, pEnd, 'd', "%", value);
+                            spec += value;
+                            p++;
+                        }
+                        while (*p >= '0' && *p <= '9')
+                            spec += *p++;
+                    }
+                    while (*p && strchr("hlLjztwI0123456789", *p))
+                        p++;
+                    if (!*p)
+                        break;
+
+                    char conversion = *p++;
+                    if (conversion == 'n')
+                        continue;
+                    std::string value;
+                    pArgs = ReadArg(pArgs, pEnd, conversion, spec, value);
+                    result += value;
+                }
+
+                return result;
+            }
+
+        private:
+            static std::string ToUtf8(const uint16_t* pChars, size_t length)
+            {
+                std::string result;
+                result.reserve(length);
+                for (size_t i = 0; i < length; i++)
+                {
+                    uint32_t c = pChars[i];
+                    if (c >= 0xD800 && c < 0xDC00 && i + 1 < length && pChars[i + 1] >= 0xDC00 && pChars[i + 1] < 0xE000)
+                        c = 0x10000 + ((c - 0xD800) << 10) + (pChars[++i] - 0xDC00);
+                    if (c < 0x80)
+                        result += static_cast<char>(c);
+                    else if (c < 0x800)
+                    {
+                        result += static_cast<char>(0xC0 | (c >> 6));
+                        result += static_cast<char>(0x80 | (c & 0x3F));
+                    }
+                    else if (c < 0x10000)
+                    {
+                        result += static_cast<char>(0xE0 | (c >> 12));
+                        result += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                        result += static_cast<char>(0x80 | (c & 0x3F));
+                    }
+                    else
+                    {
+                        result += static_cast<char>(0xF0 | (c >> 18));
+                        result += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+                        result += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                        result += static_cast<char>(0x80 | (c & 0x3F));
+                    }
+                }
+                return result;
+            }
+
+            template<typename T>
+            static uint8_t* WriteArg(uint8_t* pData, const T& arg)
+            {
+                *pData++ = static_cast<uint8_t>(ArgTraits<T>::Type);
+                return ArgTraits<T>::Write(pData, arg);
+            }
+
+            static const uint8_t* ReadArg(const uint8_t* pArgs, const uint8_t* pEnd, char conversion, const std::string& spec, std::string& value)
+            {
+                char buffer[512];
+                if (pArgs >= pEnd)
+                {
+                    value = "<missing>";
+                    return pArgs;
+                }
+
+                auto type = static_cast<ArgType>(*pArgs++);
+                uint64_t bits = 0;
+                std::string text;
+                switch (type)
+                {
+                case ArgType::Int64:
+                case ArgType::UInt64:
+                case ArgType::Double:
+                case ArgType::Pointer:
+                    if (pEnd - pArgs < 8)
+                        return pEnd;
+                    memcpy(&bits, pArgs, 8);
+                    pArgs += 8;
+                    break;
+                case ArgType::String:
+                case ArgType::WString:
+                {
+                    uint16_t length;
+                    size_t unitSize = type == ArgType::String ? 1 : 2;
+                    if (pEnd - pArgs < 2)
+                        return pEnd;
+                    memcpy(&length, pArgs, 2);
+                    pArgs += 2;
+                    if (static_cast<size_t>(pEnd - pArgs) < length * unitSize)
+                        return pEnd;
+                    if (type == ArgType::String)
+                        text.assign(reinterpret_cast<const char*>(pArgs), length);
+                    else
+                    {
+                        std::basic_string<uint16_t> chars(length, 0);
+                        memcpy(&chars[0], pArgs, length * 2);
+                        text = ToUtf8(chars.data(), length);
+                    }
+                    pArgs += length * unitSize;
+                    break;
+                }
+                default:
+                    value = "<invalid>";
+                    return pEnd;
+                }
+
+                bool isString = type == ArgType::String || type == ArgType::WString;
+                if (strchr("sS", conversion) || isString)
+                {
+                    if (type == ArgType::Int64)
+                        text = std::to_string(static_cast<long long>(bits));
+                    else if (type == ArgType::Double)
+                    {
+                        double d;
+                        memcpy(&d, &bits, 8);
+                        text = std::to_string(d);
+                    }
+                    else if (!isString)
+                        text = std::to_string(static_cast<unsigned long long>(bits));
+                    snprintf(buffer, sizeof(buffer), (spec + "s").c_str(), text.c_str());
+                }
+                else if (strchr("fFeEgGaA", conversion))
+                {
+                    double d;
+                    if (type == ArgType::Double)
+                        memcpy(&d, &bits, 8);
+                    else
+                        d = type == ArgType::Int64 ? static_cast<double>(static_cast<int64_t>(bits)) : static_cast<double>(bits);
+                    snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(), d);
+                }
+                else if (conversion == 'p')
+                    snprintf(buffer, sizeof(buffer), (spec + "p").c_str(), reinterpret_cast<void*>(static_cast<uintptr_t>(bits)));
+                else
+                {
+                    if (type == ArgType::Double)
+                    {
+                        double d;
+                        memcpy(&d, &bits, 8);
+                        bits = static_cast<uint64_t>(static_cast<int64_t>(d));
+                    }
+                    if (conversion == 'c')
+                        snprintf(buffer, sizeof(buffer), (spec + "c").c_str(), static_cast<int>(bits));
+                    else if (conversion == 'd' || conversion == 'i')
+                        snprintf(buffer, sizeof(buffer), (spec + "lld").c_str(), static_cast<long long>(bits));
+                    else
+                        snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(), static_cast<unsigned long long>(bits));
+                }
+                value = buffer;
+                return pArgs;
+            }
+
+        };
+
+        template<typename T>
+        struct BinaryLog::ArgTraits<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type>
+        {
+            static const ArgType Type = std::is_signed<T>::value ? ArgType::Int64 : ArgType::UInt64;
+            static size_t GetSize(const T&) { return 8; }
+            static uint8_t* Write(uint8_t* pData, const T& arg)
+            {
+                uint64_t bits = std::is_signed<T>::value ? static_cast<uint64_t>(static_cast<int64_t>(arg)) : static_cast<uint64_t>(arg);
+                memcpy(pData, &bits, 8);
+                return pData + 8;
+            }
+        };
+
+        template<typename T>
+        struct BinaryLog::ArgTraits<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+        {
+            static const ArgType Type = ArgType::Double;
+            static size_t GetSize(const T&) { return 8; }
+            static uint8_t* Write(uint8_t* pData, const T& arg)
+            {
+                double d = static_cast<double>(arg);
+                memcpy(pData, &d, 8);
+                return pData + 8;
+            }
+        };
+
+        template<typename T>
+        struct BinaryLog::ArgTraits<T*, typename std::enable_if<!std::is_same<typename std::remove_cv<T>::type, char>::value && !std::is_same<typename std::remove_cv<T>::type, wchar_t>::value>::type>
+        {
+            static const ArgType Type = ArgType::Pointer;
+            static size_t GetSize(T* const&) { return 8; }
+            static uint8_t* Write(uint8_t* pData, T* const& arg)
+            {
+                uint64_t bits = reinterpret_cast<uintptr_t>(arg);
+                memcpy(pData, &bits, 8);
+                return pData + 8;
+            }
+        };
+
+        template<typename T>
+        struct BinaryLog::ArgTraits<T*, typename std::enable_if<std::is_same<typename std::remove_cv<T>::type, char>::value || std::is_same<typename std::remove_cv<T>::type, wchar_t>::value>::type>
+        {
+            static const ArgType Type = sizeof(T) == 1 ? ArgType::String : ArgType::WString;
+            static size_t GetLength(T* const& arg)
+            {
+                size_t length = 0;
+                if (arg)
+                    while (length < MaxStringLength && arg[length])
+                        length++;
+                return length;
+            }
+            static size_t GetSize(T* const& arg) { return 2 + GetLength(arg) * sizeof(T); }
+            static uint8_t* Write(uint8_t* pData, T* const& arg)
+            {
+                uint16_t length = static_cast<uint16_t>(GetLength(arg));
+                memcpy(pData, &length, 2);
+                if (length)
+                    memcpy(pData + 2, arg, length * sizeof(T));
+                return pData + 2 + length * sizeof(T);
+            }
+        };
+    }
+}
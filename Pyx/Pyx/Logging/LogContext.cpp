@@ -0,0 +1,595 @@
+#include <Pyx/Logging/LogContext.h>
+#include <Pyx/PyxInitSettings.h>
+#include <Pyx/Graphics/GuiContext.h>
+#include <Pyx/Graphics/Gui/IGui.h>
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Utility/String.h>
+#include <Pyx/Utility/Utf8.h>
+#include <algorithm>
+#include <vector>
+
+Pyx::Logging::LogContext& Pyx::Logging::LogContext::GetInstance()
+{
+    static LogContext ctx;
+    return ctx;
+}
+
+void Pyx::Logging::LogContext::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+    using namespace LuaIntf;
+    LuaBinding(pScript->GetLuaState())
+        .beginModule("Pyx")
+        .beginModule("Logging")
+        .beginModule("Level")
+        .addConstant("Trace", static_cast<int>(LogLevel::Trace))
+        .addConstant("Debug", static_cast<int>(LogLevel::Debug))
+        .addConstant("Info", static_cast<int>(LogLevel::Info))
+        .addConstant("Warning", static_cast<int>(LogLevel::Warning))
+        .addConstant("Error", static_cast<int>(LogLevel::Error))
+        .addConstant("None", static_cast<int>(LogLevel::None))
+        .endModule()
+        .beginModule("Category")
+        .addConstant("General", static_cast<int>(LogCategory::General))
+        .addConstant("Scripting", static_cast<int>(LogCategory::Scripting))
+        .addConstant("Script", static_cast<int>(LogCategory::Script))
+        .addConstant("Graphics", static_cast<int>(LogCategory::Graphics))
+        .addConstant("Gui", static_cast<int>(LogCategory::Gui))
+        .addConstant("Input", static_cast<int>(LogCategory::Input))
+        .addConstant("Patch", static_cast<int>(LogCategory::Patch))
+        .addConstant("Memory", static_cast<int>(LogCategory::Memory))
+        .endModule()
+        .addFunction("GetLevel", [](int category)
+        {
+            return category >= 0 && category < static_cast<int>(LogCategory::Count) ? static_cast<int>(GetInstance().GetLevel(static_cast<LogCategory>(category))) : -1;
+        })
+        .addFunction("SetLevel", [](int category, int level)
+        {
+            if (category >= 0 && category < static_cast<int>(LogCategory::Count) && level >= 0 && level <= static_cast<int>(LogLevel::None))
+                GetInstance().SetLevel(static_cast<LogCategory>(category), static_cast<LogLevel>(level));
+        })
+        .addFunction("GetScriptLevel", [pScript]() { return static_cast<int>(pScript->GetLogLevel()); })
+        .addFunction("SetScriptLevel", [pScript](int level)
+        {
+            if (level >= 0 && level <= static_cast<int>(LogLevel::None))
+                pScript->SetLogLevel(static_cast<LogLevel>(level));
+        })
+        .addFunction("Write", [pScript](int level, const std::string& text)
+        {
+            if (level >= 0 && level < static_cast<int>(LogLevel::None) && pScript->IsLogEnabled(static_cast<LogLevel>(level)))
+                PyxContext::GetInstance().Log(static_cast<LogLevel>(level), L"[%s] %s", pScript->GetName().c_str(), Utility::String::utf8_decode(text).c_str());
+        })
+        .endModule()
+        .endModule();
+}
+
+Pyx::Logging::LogContext::LogContext()
+    : m_queue(QueueCapacity),
+    m_overflowPolicy(LogOverflowPolicy::Drop),
+    m_hWorkerThread(nullptr),
+    m_hStopEvent(CreateEvent(nullptr, TRUE, FALSE, nullptr)),
+    m_hWakeEvent(CreateEvent(nullptr, FALSE, FALSE, nullptr)),
+    m_workerThreadId(0),
+    m_isWorkerRunning(false),
+    m_isWorkerIdle(false),
+    m_submittedCount(0),
+    m_writtenCount(0),
+    m_droppedCount(0),
+    m_lastTimestampSecond(0),
+    m_isBinary(false)
+{
+    m_timestamp[0] = L'\0';
+    SetLevel(LogLevel::Info);
+}
+
+Pyx::Logging::LogContext::~LogContext()
+{
+    CloseHandle(m_hWakeEvent);
+    CloseHandle(m_hStopEvent);
+}
+
+void Pyx::Logging::LogContext::Initialize(const PyxInitSettings& settings)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    m_overflowPolicy = settings.LogOverflowPolicy;
+    m_isBinary = settings.LogFileFormat == LogFileFormat::Binary;
+    SetLevel(settings.LogLevel);
+    if (settings.LogToFile && !m_fileStream.is_open() && !m_binaryFileStream.is_open() && !m_segmentFile.IsOpen())
+    {
+        std::wstring logsDirectory = settings.RootDirectory + settings.LogDirectory;
+        std::wstring logFileName = logsDirectory + L"\\logs_" + std::to_wstring(GetCurrentProcessId());
+        CreateDirectoryW(logsDirectory.c_str(), nullptr);
+        if (settings.LogSegmentSize != 0)
+            m_segmentFile.Open(logFileName, m_isBinary ? LogSegmentFile::Format::Binary : LogSegmentFile::Format::Text, settings.LogSegmentSize, settings.LogSegmentCount);
+        else if (m_isBinary)
+        {
+            m_binaryFileStream.open((logFileName + L".pyxlog").c_str(), std::ofstream::out | std::ofstream::binary);
+            BinaryLog::FileHeader header{ BinaryLog::Magic, BinaryLog::Version, GetCurrentProcessId(), 0 };
+            m_binaryFileStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        else
+            m_fileStream.open((logFileName + L".log").c_str(), std::ofstream::out);
+    }
+}
+
+void Pyx::Logging::LogContext::SetLevel(LogLevel level)
+{
+    for (auto& categoryLevel : m_categoryLevels)
+        categoryLevel = static_cast<int>(level);
+}
+
+void Pyx::Logging::LogContext::StartWorker()
+{
+    if (!m_hWorkerThread)
+    {
+        ResetEvent(m_hStopEvent);
+        m_isWorkerIdle = false;
+        m_hWorkerThread = CreateThread(nullptr, 0, WorkerThread, this, NULL, &m_workerThreadId);
+        m_isWorkerRunning = m_hWorkerThread != nullptr;
+    }
+}
+
+void Pyx::Logging::LogContext::StopWorker()
+{
+    if (m_hWorkerThread)
+    {
+        m_isWorkerRunning = false;
+        SetEvent(m_hStopEvent);
+        WaitForSingleObject(m_hWorkerThread, INFINITE);
+        CloseHandle(m_hWorkerThread);
+        m_hWorkerThread = nullptr;
+        m_workerThreadId = 0;
+    }
+
+    // Lines pushed while the worker was stopping are written right away
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    while (WritePending() != 0);
+}
+
+void Pyx::Logging::LogContext::Shutdown()
+{
+    StopWorker();
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    if (m_fileStream.is_open())
+        m_fileStream.close();
+    if (m_binaryFileStream.is_open())
+        m_binaryFileStream.close();
+    m_segmentFile.Close();
+}
+
+void Pyx::Logging::LogContext::Write(LogLevel level, std::wstring line)
+{
+    Record record{ GetTime(), level, std::move(line) };
+    m_submittedCount++;
+
+    if (m_isBinary)
+    {
+        WriteBinaryText(level, Utility::String::utf8_encode(record.Line));
+        return;
+    }
+
+    if (m_isWorkerRunning)
+    {
+        bool isPushed = m_queue.TryPush(std::move(record));
+
+        // Waiting is bounded so a stuck worker can't freeze the game, and the
+        // worker itself never waits for room it is supposed to make
+        if (!isPushed && m_overflowPolicy == LogOverflowPolicy::Wait && GetCurrentThreadId() != m_workerThreadId)
+        {
+            for (int i = 0; !isPushed && i < 100 && m_isWorkerRunning; i++)
+            {
+                SetEvent(m_hWakeEvent);
+                Sleep(1);
+                isPushed = m_queue.TryPush(std::move(record));
+            }
+        }
+
+        if (isPushed)
+        {
+            OnRecordPushed();
+            return;
+        }
+
+        if (m_isWorkerRunning)
+        {
+            m_droppedCount++;
+            return;
+        }
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    while (WritePending() != 0);
+    WriteRecords(&record, 1);
+}
+
+Pyx::Logging::LogStats Pyx::Logging::LogContext::GetStats() const
+{
+    return LogStats{ m_submittedCount.load(), m_writtenCount.load(), m_droppedCount.load() };
+}
+
+const wchar_t* Pyx::Logging::LogContext::FormatTimestamp(uint64_t time)
+{
+    uint64_t second = time / 10000000;
+    if (second != m_lastTimestampSecond)
+    {
+        FILETIME fileTime{ static_cast<DWORD>(time), static_cast<DWORD>(time >> 32) };
+        FILETIME localFileTime;
+        SYSTEMTIME systemTime;
+        FileTimeToLocalFileTime(&fileTime, &localFileTime);
+        FileTimeToSystemTime(&localFileTime, &systemTime);
+        swprintf_s(m_timestamp, L"[%02u:%02u:%02u] ", systemTime.wHour, systemTime.wMinute, systemTime.wSecond);
+        m_lastTimestampSecond = second;
+    }
+    return m_timestamp;
+}
+
+void Pyx::Logging::LogContext::WriteRecords(Record* pRecords, size_t count)
+{
+    std::wstring batch;
+    for (size_t i = 0; i < count; i++)
+    {
+        pRecords[i].Line.insert(0, FormatTimestamp(pRecords[i].Time));
+        batch += pRecords[i].Line;
+        batch += L'\n';
+    }
+
+    if (m_fileStream.is_open())
+    {
+        m_fileStream << batch;
+        m_fileStream.flush();
+    }
+    else if (m_segmentFile.IsOpen())
+    {
+        std::string line;
+        for (size_t i = 0; i < count; i++)
+        {
+            auto& text = pRecords[i].Line;
+            line.resize(Utility::Utf8::GetMaxEncodedSize(text.size()));
+            line.resize(Utility::Utf8::Encode(text.data(), text.size(), &line[0], line.size()));
+            WriteSegmentChunk(line.data(), line.size());
+        }
+    }
+
+    auto* pGui = Graphics::GuiContext::GetInstance().GetGui();
+    if (pGui)
+    {
+        for (size_t i = 0; i < count; i++)
+            pGui->Logger_OnWriteLine(pRecords[i].Level, pRecords[i].Line);
+    }
+
+    m_writtenCount += count;
+}
+
+size_t Pyx::Logging::LogContext::WritePending()
+{
+    std::vector<Record> batch;
+    Record record;
+    while (batch.size() < MaxBatchSize && m_queue.TryPop(record))
+        batch.push_back(std::move(record));
+    if (!batch.empty())
+        WriteRecords(batch.data(), batch.size());
+    return m_isBinary ? batch.size() + WritePendingBinary() : batch.size();
+}
+
+void Pyx::Logging::LogContext::OnRecordPushed()
+{
+    if (m_isWorkerRunning)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_isWorkerIdle.load(std::memory_order_relaxed) && m_isWorkerIdle.exchange(false))
+            SetEvent(m_hWakeEvent);
+    }
+    else
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+        while (WritePending() != 0);
+    }
+}
+
+Pyx::Logging::LogContext::ThreadBuffer& Pyx::Logging::LogContext::GetThreadBuffer()
+{
+    // Buffers are never released, a thread may log again at any time and
+    // the threads of the process are expected to be long lived
+    static thread_local ThreadBuffer* t_pBuffer = nullptr;
+    if (!t_pBuffer)
+    {
+        std::unique_ptr<ThreadBuffer> pBuffer(new ThreadBuffer());
+        pBuffer->ThreadId = GetCurrentThreadId();
+        pBuffer->pData.reset(new uint8_t[ThreadBufferSize]);
+        pBuffer->WritePosition = 0;
+        pBuffer->ReadPosition = 0;
+        pBuffer->PendingPosition = 0;
+        t_pBuffer = pBuffer.get();
+        std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+        m_threadBuffers.push_back(std::move(pBuffer));
+    }
+    return *t_pBuffer;
+}
+
+uint8_t* Pyx::Logging::LogContext::ReserveRecord(ThreadBuffer& buffer, size_t size)
+{
+    if (size > ThreadBufferSize / 2)
+    {
+        m_droppedCount++;
+        return nullptr;
+    }
+
+    for (int attempt = 0;; attempt++)
+    {
+        size_t writePosition = buffer.WritePosition.load(std::memory_order_relaxed);
+        size_t readPosition = buffer.ReadPosition.load(std::memory_order_acquire);
+        size_t offset = writePosition & (ThreadBufferSize - 1);
+        size_t tail = ThreadBufferSize - offset;
+        size_t needed = size <= tail ? size : tail + size;
+
+        if (ThreadBufferSize - (writePosition - readPosition) >= needed)
+        {
+            // Records are never split, the end of the ring is skipped instead
+            if (size > tail)
+            {
+                uint16_t paddingSize = static_cast<uint16_t>(tail);
+                memcpy(buffer.pData.get() + offset, &paddingSize, sizeof(paddingSize));
+                buffer.pData[offset + 2] = static_cast<uint8_t>(BinaryLog::RecordType::Padding);
+                writePosition += tail;
+                offset = 0;
+            }
+            buffer.PendingPosition = writePosition + size;
+            return buffer.pData.get() + offset;
+        }
+
+        if (!m_isWorkerRunning && attempt == 0)
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+            while (WritePending() != 0);
+            continue;
+        }
+
+        if (m_isWorkerRunning && m_overflowPolicy == LogOverflowPolicy::Wait && attempt < 100 && GetCurrentThreadId() != m_workerThreadId)
+        {
+            SetEvent(m_hWakeEvent);
+            Sleep(1);
+            continue;
+        }
+
+        m_droppedCount++;
+        return nullptr;
+    }
+}
+
+void Pyx::Logging::LogContext::CommitRecord(ThreadBuffer& buffer)
+{
+    buffer.WritePosition.store(buffer.PendingPosition, std::memory_order_release);
+    OnRecordPushed();
+}
+
+bool Pyx::Logging::LogContext::DefineFormat(ThreadBuffer& buffer, uint64_t formatId, const char* format, uint64_t time)
+{
+    size_t length = (std::min)(strlen(format), MaxTextLength);
+    size_t size = BinaryLog::Align(sizeof(BinaryLog::RecordHeader) + length + 1);
+    uint8_t* pRecord = ReserveRecord(buffer, size);
+    if (!pRecord)
+        return false;
+
+    auto* pHeader = reinterpret_cast<BinaryLog::RecordHeader*>(pRecord);
+    pHeader->Size = static_cast<uint16_t>(size);
+    pHeader->Type = BinaryLog::RecordType::Format;
+    pHeader->Level = 0;
+    pHeader->ThreadId = buffer.ThreadId;
+    pHeader->Time = time;
+    pHeader->FormatId = formatId;
+    memset(pRecord + sizeof(BinaryLog::RecordHeader), 0, size - sizeof(BinaryLog::RecordHeader));
+    memcpy(pRecord + sizeof(BinaryLog::RecordHeader), format, length);
+    CommitRecord(buffer);
+    buffer.KnownFormats.insert(formatId);
+    return true;
+}
+
+bool Pyx::Logging::LogContext::DefineFormat(ThreadBuffer& buffer, uint64_t formatId, const wchar_t* format, uint64_t time)
+{
+    return DefineFormat(buffer, formatId, Utility::String::utf8_encode(format).c_str(), time);
+}
+
+void Pyx::Logging::LogContext::WriteBinaryText(LogLevel level, const std::string& text)
+{
+    auto& buffer = GetThreadBuffer();
+    uint16_t length = static_cast<uint16_t>((std::min)(text.size(), MaxTextLength));
+    size_t size = BinaryLog::Align(sizeof(BinaryLog::RecordHeader) + 3 + length);
+    uint8_t* pRecord = ReserveRecord(buffer, size);
+    if (!pRecord)
+        return;
+
+    auto* pHeader = reinterpret_cast<BinaryLog::RecordHeader*>(pRecord);
+    pHeader->Size = static_cast<uint16_t>(size);
+    pHeader->Type = BinaryLog::RecordType::Message;
+    pHeader->Level = static_cast<uint8_t>(level);
+    pHeader->ThreadId = buffer.ThreadId;
+    pHeader->Time = GetTime();
+    pHeader->FormatId = BinaryLog::TextFormatId;
+    uint8_t* pArgs = pRecord + sizeof(BinaryLog::RecordHeader);
+    pArgs[0] = static_cast<uint8_t>(BinaryLog::ArgType::String);
+    memcpy(pArgs + 1, &length, sizeof(length));
+    memcpy(pArgs + 3, text.data(), length);
+    CommitRecord(buffer);
+}
+
+size_t Pyx::Logging::LogContext::WritePendingBinary()
+{
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+        for (auto& pBuffer : m_threadBuffers)
+            buffers.push_back(pBuffer.get());
+    }
+
+    std::vector<uint8_t> definitions;
+    std::vector<uint8_t> messages;
+    std::vector<std::pair<uint64_t, size_t>> entries;
+    size_t definitionCount = 0;
+
+    for (auto* pBuffer : buffers)
+    {
+        size_t readPosition = pBuffer->ReadPosition.load(std::memory_order_relaxed);
+        size_t writePosition = pBuffer->WritePosition.load(std::memory_order_acquire);
+        while (readPosition != writePosition)
+        {
+            const uint8_t* pRecord = pBuffer->pData.get() + (readPosition & (ThreadBufferSize - 1));
+            uint16_t size;
+            memcpy(&size, pRecord, sizeof(size));
+            auto type = static_cast<BinaryLog::RecordType>(pRecord[2]);
+            readPosition += size;
+            if (type == BinaryLog::RecordType::Padding)
+                continue;
+
+            BinaryLog::RecordHeader header;
+            memcpy(&header, pRecord, sizeof(header));
+            if (type == BinaryLog::RecordType::Format)
+            {
+                const char* pFormat = reinterpret_cast<const char*>(pRecord + sizeof(header));
+                std::lock_guard<std::mutex> lock(m_formatsMutex);
+                m_formats[header.FormatId].assign(pFormat, strnlen(pFormat, size - sizeof(header)));
+                definitions.insert(definitions.end(), pRecord, pRecord + size);
+                definitionCount++;
+            }
+            else
+            {
+                entries.emplace_back(header.Time, messages.size());
+                messages.insert(messages.end(), pRecord, pRecord + size);
+            }
+        }
+        pBuffer->ReadPosition.store(readPosition, std::memory_order_release);
+    }
+
+    if (definitionCount == 0 && entries.empty())
+        return 0;
+
+    // Every thread buffer is in order, merging them by time is enough
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const std::pair<uint64_t, size_t>& lhs, const std::pair<uint64_t, size_t>& rhs) { return lhs.first < rhs.first; });
+
+    if (m_binaryFileStream.is_open())
+    {
+        m_binaryFileStream.write(reinterpret_cast<const char*>(definitions.data()), definitions.size());
+        for (auto& entry : entries)
+        {
+            const uint8_t* pRecord = messages.data() + entry.second;
+            uint16_t size;
+            memcpy(&size, pRecord, sizeof(size));
+            m_binaryFileStream.write(reinterpret_cast<const char*>(pRecord), size);
+        }
+        m_binaryFileStream.flush();
+    }
+    else if (m_segmentFile.IsOpen())
+    {
+        for (const uint8_t* pRecord = definitions.data(); pRecord < definitions.data() + definitions.size();)
+        {
+            uint16_t size;
+            memcpy(&size, pRecord, sizeof(size));
+            WriteSegmentChunk(pRecord, size);
+            pRecord += size;
+        }
+        for (auto& entry : entries)
+        {
+            const uint8_t* pRecord = messages.data() + entry.second;
+            uint16_t size;
+            memcpy(&size, pRecord, sizeof(size));
+            WriteSegmentChunk(pRecord, size);
+        }
+    }
+
+    auto* pGui = Graphics::GuiContext::GetInstance().GetGui();
+    if (pGui)
+    {
+        for (auto& entry : entries)
+        {
+            const uint8_t* pRecord = messages.data() + entry.second;
+            BinaryLog::RecordHeader header;
+            memcpy(&header, pRecord, sizeof(header));
+            pGui->Logger_OnWriteRecord(static_cast<LogLevel>(header.Level), header.Time, header.FormatId, pRecord + sizeof(header), header.Size - sizeof(header));
+        }
+    }
+
+    m_writtenCount += entries.size();
+    return definitionCount + entries.size();
+}
+
+void Pyx::Logging::LogContext::WriteSegmentChunk(const void* pData, size_t size)
+{
+    // Old segments get deleted, a binary segment must define every format
+    // its messages may use
+    if (!m_segmentFile.HasSpace(size) && m_segmentFile.Rotate() && m_isBinary)
+        WriteSegmentFormats();
+    m_segmentFile.Write(pData, size);
+}
+
+void Pyx::Logging::LogContext::WriteSegmentFormats()
+{
+    std::vector<uint8_t> record;
+    std::lock_guard<std::mutex> lock(m_formatsMutex);
+    for (auto& format : m_formats)
+    {
+        size_t length = (std::min)(format.second.size(), MaxTextLength);
+        record.assign(BinaryLog::Align(sizeof(BinaryLog::RecordHeader) + length + 1), 0);
+        BinaryLog::RecordHeader header{ static_cast<uint16_t>(record.size()), BinaryLog::RecordType::Format, 0, 0, 0, format.first };
+        memcpy(record.data(), &header, sizeof(header));
+        memcpy(record.data() + sizeof(header), format.second.data(), length);
+        if (!m_segmentFile.Write(record.data(), record.size()))
+            break;
+    }
+}
+
+std::string Pyx::Logging::LogContext::RenderRecord(uint64_t time, uint64_t formatId, const uint8_t* pArgs, size_t argsSize)
+{
+    FILETIME fileTime{ static_cast<DWORD>(time), static_cast<DWORD>(time >> 32) };
+    FILETIME localFileTime;
+    SYSTEMTIME systemTime;
+    FileTimeToLocalFileTime(&fileTime, &localFileTime);
+    FileTimeToSystemTime(&localFileTime, &systemTime);
+    char timestamp[16];
+    snprintf(timestamp, sizeof(timestamp), "[%02u:%02u:%02u] ", systemTime.wHour, systemTime.wMinute, systemTime.wSecond);
+
+    std::string format = "%s";
+    if (formatId != BinaryLog::TextFormatId)
+    {
+        std::lock_guard<std::mutex> lock(m_formatsMutex);
+        auto it = m_formats.find(formatId);
+        format = it != m_formats.end() ? it->second : "<unknown format>";
+    }
+    return timestamp + BinaryLog::RenderMessage(format.c_str(), pArgs, argsSize);
+}
+
+DWORD Pyx::Logging::LogContext::WorkerThread(LPVOID pData)
+{
+    auto* pContext = static_cast<LogContext*>(pData);
+    HANDLE handles[] = { pContext->m_hStopEvent, pContext->m_hWakeEvent };
+
+    for (;;)
+    {
+        size_t count;
+        {
+            std::lock_guard<std::recursive_mutex> lock(pContext->m_writeMutex);
+            count = pContext->WritePending();
+        }
+        if (count != 0)
+            continue;
+
+        // Producers only signal the wake event when they see the worker idle,
+        // the queue is checked once more after publishing it to not miss a line
+        pContext->m_isWorkerIdle = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::recursive_mutex> lock(pContext->m_writeMutex);
+            count = pContext->WritePending();
+        }
+        if (count != 0)
+        {
+            pContext->m_isWorkerIdle = false;
+            continue;
+        }
+
+        if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0)
+            break;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(pContext->m_writeMutex);
+    while (pContext->WritePending() != 0);
+    return 0;
+}
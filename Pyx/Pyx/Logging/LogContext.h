@@ -0,0 +1,167 @@
+#pragma once
+#include <Windows.h>
+#include <Pyx/Pyx.h>
+#include <Pyx/Logging/BinaryLog.h>
+#include <Pyx/Logging/LogSegmentFile.h>
+#include <Pyx/Threading/MpscRing.h>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Pyx
+{
+    struct PyxInitSettings;
+    namespace Scripting
+    {
+        class Script;
+    }
+    namespace Logging
+    {
+        struct LogStats
+        {
+            uint64_t Submitted;
+            uint64_t Written;
+            uint64_t Dropped;
+        };
+
+        // Log lines are pushed to a lock free ring and a background thread
+        // does the timestamping, the file writes (one per batch) and the gui
+        // fan-out. While the worker isn't running (process frozen during
+        // initialization or shutdown) lines are written on the caller thread.
+        // In binary mode formatted calls only copy their arguments to a per
+        // thread buffer, the text is rendered when displayed or decoded.
+        class LogContext
+        {
+
+        public:
+            static const size_t QueueCapacity = 8192;
+            static const size_t MaxBatchSize = 256;
+            static const size_t ThreadBufferSize = 64 * 1024;
+            static const size_t MaxTextLength = 8 * 1024;
+
+        private:
+            struct Record
+            {
+                uint64_t Time;
+                LogLevel Level;
+                std::wstring Line;
+            };
+
+            // Single producer byte ring, only the owning thread writes to it
+            struct ThreadBuffer
+            {
+                DWORD ThreadId;
+                std::unique_ptr<uint8_t[]> pData;
+                std::atomic<size_t> WritePosition;
+                std::atomic<size_t> ReadPosition;
+                size_t PendingPosition;
+                std::unordered_set<uint64_t> KnownFormats;
+            };
+
+        private:
+            static DWORD WINAPI WorkerThread(LPVOID pData);
+            static uint64_t GetTime()
+            {
+                FILETIME fileTime;
+                GetSystemTimeAsFileTime(&fileTime);
+                return (static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime;
+            }
+
+        public:
+            static LogContext& GetInstance();
+            static void BindWithScript(Scripting::Script* pScript);
+
+        private:
+            Threading::MpscRing<Record> m_queue;
+            LogOverflowPolicy m_overflowPolicy;
+            HANDLE m_hWorkerThread;
+            // Created with the context and only closed with it, producers may
+            // still signal the wake event while the worker is being stopped
+            HANDLE m_hStopEvent;
+            HANDLE m_hWakeEvent;
+            DWORD m_workerThreadId;
+            std::atomic<bool> m_isWorkerRunning;
+            std::atomic<bool> m_isWorkerIdle;
+            std::atomic<uint64_t> m_submittedCount;
+            std::atomic<uint64_t> m_writtenCount;
+            std::atomic<uint64_t> m_droppedCount;
+            std::recursive_mutex m_writeMutex;
+            std::wofstream m_fileStream;
+            std::atomic<bool> m_isBinary;
+            std::ofstream m_binaryFileStream;
+            LogSegmentFile m_segmentFile;
+            std::mutex m_threadBuffersMutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+            std::mutex m_formatsMutex;
+            std::unordered_map<uint64_t, std::string> m_formats;
+            std::atomic<int> m_categoryLevels[static_cast<size_t>(LogCategory::Count)];
+            uint64_t m_lastTimestampSecond;
+            wchar_t m_timestamp[16];
+
+        private:
+            const wchar_t* FormatTimestamp(uint64_t time);
+            void WriteRecords(Record* pRecords, size_t count);
+            size_t WritePending();
+            void OnRecordPushed();
+            ThreadBuffer& GetThreadBuffer();
+            uint8_t* ReserveRecord(ThreadBuffer& buffer, size_t size);
+            void CommitRecord(ThreadBuffer& buffer);
+            bool DefineFormat(ThreadBuffer& buffer, uint64_t formatId, const char* format, uint64_t time);
+            bool DefineFormat(ThreadBuffer& buffer, uint64_t formatId, const wchar_t* format, uint64_t time);
+            void WriteBinaryText(LogLevel level, const std::string& text);
+            size_t WritePendingBinary();
+            void WriteSegmentChunk(const void* pData, size_t size);
+            void WriteSegmentFormats();
+
+        public:
+            explicit LogContext();
+            ~LogContext();
+            void Initialize(const PyxInitSettings& settings);
+            void StartWorker();
+            void StopWorker();
+            void Shutdown();
+            void Write(LogLevel level, std::wstring line);
+            LogStats GetStats() const;
+            bool IsBinary() const { return m_isBinary; }
+            bool IsEnabled(LogCategory category, LogLevel level) const { return static_cast<int>(level) >= m_categoryLevels[static_cast<size_t>(category)].load(std::memory_order_relaxed); }
+            LogLevel GetLevel(LogCategory category) const { return static_cast<LogLevel>(m_categoryLevels[static_cast<size_t>(category)].load()); }
+            void SetLevel(LogCategory category, LogLevel level) { m_categoryLevels[static_cast<size_t>(category)] = static_cast<int>(level); }
+            void SetLevel(LogLevel level);
+            std::string RenderRecord(uint64_t time, uint64_t formatId, const uint8_t* pArgs, size_t argsSize);
+
+            template<typename TChar, typename ... Args>
+            void WriteBinary(LogLevel level, const TChar* format, const Args& ... args)
+            {
+                const size_t size = BinaryLog::Align(sizeof(BinaryLog::RecordHeader) + BinaryLog::GetArgsSize(args...));
+                const uint64_t formatId = BinaryLog::GetFormatId(format);
+                const uint64_t time = GetTime();
+                auto& buffer = GetThreadBuffer();
+                m_submittedCount++;
+
+                if (buffer.KnownFormats.count(formatId) == 0 && !DefineFormat(buffer, formatId, format, time))
+                    return;
+
+                uint8_t* pRecord = ReserveRecord(buffer, size);
+                if (!pRecord)
+                    return;
+
+                auto* pHeader = reinterpret_cast<BinaryLog::RecordHeader*>(pRecord);
+                pHeader->Size = static_cast<uint16_t>(size);
+                pHeader->Type = BinaryLog::RecordType::Message;
+                pHeader->Level = static_cast<uint8_t>(level);
+                pHeader->ThreadId = buffer.ThreadId;
+                pHeader->Time = time;
+                pHeader->FormatId = formatId;
+                BinaryLog::WriteArgs(pRecord + sizeof(BinaryLog::RecordHeader), args...);
+                CommitRecord(buffer);
+            }
+
+        };
+    }
+}
@@ -0,0 +1,128 @@
+#include <Pyx/Logging/LogSegmentFile.h>
+#include <algorithm>
+
+Pyx::Logging::LogSegmentFile::LogSegmentFile()
+    : m_format(Format::Text),
+    m_segmentSize(0),
+    m_segmentCount(0),
+    m_sequence(0),
+    m_hFile(INVALID_HANDLE_VALUE),
+    m_hMapping(nullptr),
+    m_pView(nullptr)
+{
+}
+
+Pyx::Logging::LogSegmentFile::~LogSegmentFile()
+{
+    Close();
+}
+
+bool Pyx::Logging::LogSegmentFile::Open(const std::wstring& baseFileName, Format format, size_t segmentSize, uint32_t segmentCount)
+{
+    Close();
+    m_baseFileName = baseFileName;
+    m_format = format;
+    m_segmentSize = (std::max)(segmentSize, MinSegmentSize);
+    m_segmentCount = (std::max)(segmentCount, 1U);
+    m_sequence = 0;
+    return OpenSegment();
+}
+
+void Pyx::Logging::LogSegmentFile::Close()
+{
+    CloseSegment();
+    m_fileNames.clear();
+}
+
+bool Pyx::Logging::LogSegmentFile::Rotate()
+{
+    if (!IsOpen())
+        return false;
+
+    CloseSegment();
+    m_sequence++;
+    while (m_fileNames.size() >= m_segmentCount)
+    {
+        DeleteFileW(m_fileNames.front().c_str());
+        m_fileNames.pop_front();
+    }
+    return OpenSegment();
+}
+
+bool Pyx::Logging::LogSegmentFile::HasSpace(size_t size) const
+{
+    if (!m_pView)
+        return false;
+    auto* pHeader = reinterpret_cast<const SegmentHeader*>(m_pView);
+    return pHeader->WritePosition + sizeof(ChunkHeader) + size <= m_segmentSize;
+}
+
+bool Pyx::Logging::LogSegmentFile::Write(const void* pData, size_t size)
+{
+    if (!HasSpace(size))
+        return false;
+
+    // The payload goes first and the write position last, a crash in the
+    // middle leaves a chunk with a bad checksum which readers stop at
+    auto* pHeader = reinterpret_cast<SegmentHeader*>(m_pView);
+    uint8_t* pChunk = m_pView + pHeader->WritePosition;
+    memcpy(pChunk + sizeof(ChunkHeader), pData, size);
+    ChunkHeader chunk{ static_cast<uint32_t>(size), GetChecksum(pData, size) };
+    memcpy(pChunk, &chunk, sizeof(chunk));
+    pHeader->WritePosition += sizeof(ChunkHeader) + size;
+    return true;
+}
+
+bool Pyx::Logging::LogSegmentFile::OpenSegment()
+{
+    std::wstring fileName = m_baseFileName + L"." + std::to_wstring(m_sequence) + L".pyxseg";
+    m_hFile = CreateFileW(fileName.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    uint64_t size = m_segmentSize;
+    m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+    if (m_hMapping)
+        m_pView = static_cast<uint8_t*>(MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, m_segmentSize));
+
+    if (!m_pView)
+    {
+        CloseSegment();
+        DeleteFileW(fileName.c_str());
+        return false;
+    }
+
+    SegmentHeader header{ Magic, Version, GetCurrentProcessId(), m_format, m_sequence, 0, size, sizeof(SegmentHeader) };
+    memcpy(m_pView, &header, sizeof(header));
+    m_fileNames.push_back(fileName);
+    return true;
+}
+
+void Pyx::Logging::LogSegmentFile::CloseSegment()
+{
+    uint64_t usedSize = 0;
+    if (m_pView)
+    {
+        usedSize = reinterpret_cast<const SegmentHeader*>(m_pView)->WritePosition;
+        UnmapViewOfFile(m_pView);
+        m_pView = nullptr;
+    }
+    if (m_hMapping)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+    if (m_hFile != INVALID_HANDLE_VALUE)
+    {
+        // Segments closed normally don't keep their unused preallocated space
+        if (usedSize != 0)
+        {
+            LARGE_INTEGER position;
+            position.QuadPart = static_cast<LONGLONG>(usedSize);
+            if (SetFilePointerEx(m_hFile, position, nullptr, FILE_BEGIN))
+                SetEndOfFile(m_hFile);
+        }
+        CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+}
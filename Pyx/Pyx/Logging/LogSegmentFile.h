@@ -0,0 +1,91 @@
+#pragma once
+#include <Windows.h>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+namespace Pyx
+{
+    namespace Logging
+    {
+        // Log sink writing chunks into pre-sized memory mapped files. Pages of a
+        // mapped file belong to the system cache, everything written before a
+        // crash of the process is still persisted. Once a segment is full the
+        // next one is created and the oldest are deleted past the segment count.
+        // The layout is shared with PyxCli, nothing else than the declarations
+        // below is needed to read a segment.
+        class LogSegmentFile
+        {
+
+        public:
+            static const uint32_t Magic = 0x52585950; // "PYXR"
+            static const uint32_t Version = 1;
+            static const size_t MinSegmentSize = 64 * 1024;
+
+            enum class Format : uint32_t
+            {
+                Text = 0,  // UTF-8 line per chunk
+                Binary = 1 // BinaryLog record per chunk
+            };
+
+#pragma pack(push, 1)
+            struct SegmentHeader
+            {
+                uint32_t Magic;
+                uint32_t Version;
+                uint32_t ProcessId;
+                Format ChunkFormat;
+                uint32_t Sequence;
+                uint32_t Reserved;
+                uint64_t Size;
+                uint64_t WritePosition;
+            };
+
+            // A chunk is valid when its checksum matches, the rest of a segment
+            // is zero filled so the first invalid chunk is where writing stopped
+            struct ChunkHeader
+            {
+                uint32_t Size;
+                uint32_t Checksum;
+            };
+#pragma pack(pop)
+
+        public:
+            static uint32_t GetChecksum(const void* pData, size_t size)
+            {
+                uint32_t hash = 2166136261U;
+                auto* pBytes = static_cast<const uint8_t*>(pData);
+                for (size_t i = 0; i < size; i++)
+                    hash = (hash ^ pBytes[i]) * 16777619U;
+                return hash != 0 ? hash : 1;
+            }
+
+        private:
+            std::wstring m_baseFileName;
+            Format m_format;
+            size_t m_segmentSize;
+            uint32_t m_segmentCount;
+            uint32_t m_sequence;
+            std::deque<std::wstring> m_fileNames;
+            HANDLE m_hFile;
+            HANDLE m_hMapping;
+            uint8_t* m_pView;
+
+        private:
+            bool OpenSegment();
+            void CloseSegment();
+
+        public:
+            explicit LogSegmentFile();
+            ~LogSegmentFile();
+            bool Open(const std::wstring& baseFileName, Format format, size_t segmentSize, uint32_t segmentCount);
+            void Close();
+            bool Rotate();
+            bool HasSpace(size_t size) const;
+            bool Write(const void* pData, size_t size);
+            bool IsOpen() const { return m_pView != nullptr; }
+            uint32_t GetSequence() const { return m_sequence; }
+
+        };
+    }
+}
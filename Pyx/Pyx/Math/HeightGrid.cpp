@@ -0,0 +1,497 @@
+#include <Pyx/Math/HeightGrid.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+void Pyx::Math::HeightGrid::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+	using namespace LuaIntf;
+	LuaBinding(pScript->GetLuaState())
+		.beginModule("Pyx")
+		.beginModule("Math")
+		.beginClass<HeightGrid>("HeightGrid")
+		.addConstructor(LUA_SP(std::shared_ptr<HeightGrid>), LUA_ARGS(_def<float, 1>))
+		.addStaticFunction("Open", &HeightGrid::Open)
+		.addPropertyReadOnly("CellSize", &HeightGrid::GetCellSize)
+		.addPropertyReadOnly("TileCount", &HeightGrid::GetTileCount)
+		.addFunction("Save", &HeightGrid::Save)
+		.addFunction("ImportRawHeights", &HeightGrid::ImportRawHeights)
+		.addFunction("Record", [](HeightGrid* pGrid, const Vector3& position, bool isWalkable)
+		{
+			pGrid->Record(position, isWalkable);
+		}, LUA_ARGS(const Vector3&, _def<bool, true>))
+		.addFunction("RecordArray", [](HeightGrid* pGrid, const Vector3Array& positions, bool isWalkable)
+		{
+			pGrid->Record(positions, isWalkable);
+		}, LUA_ARGS(const Vector3Array&, _def<bool, true>))
+		.addFunction("GetHeight", &HeightGrid::GetHeight, LUA_ARGS(float, float, _out<float&>))
+		.addFunction("IsWalkable", [](const HeightGrid* pGrid, const Vector3& position, float maxStep)
+		{
+			return pGrid->IsWalkable(position, maxStep);
+		}, LUA_ARGS(const Vector3&, _def<float, 0>))
+		.addFunction("AreWalkable", [](const HeightGrid* pGrid, lua_State* L, const Vector3Array& positions, float maxStep)
+		{
+			std::vector<uint8_t> results;
+			pGrid->IsWalkable(positions, maxStep, results);
+			auto table = LuaRef::createTable(L, static_cast<int>(results.size()));
+			for (size_t i = 0; i < results.size(); i++)
+				table.set(i + 1, results[i] != 0);
+			return table;
+		}, LUA_ARGS(lua_State*, const Vector3Array&, _def<float, 0>))
+		.addFunction("Raycast", [](const HeightGrid* pGrid, const Vector3& from, const Vector3& to, Vector3& hit)
+		{
+			float fraction;
+			bool isHit = pGrid->Raycast(from, to, fraction);
+			hit = from + (to - from) * fraction;
+			return isHit;
+		}, LUA_ARGS(const Vector3&, const Vector3&, _out<Vector3&>))
+		.addFunction("RaycastArray", [](const HeightGrid* pGrid, const Vector3Array& from, const Vector3Array& to)
+		{
+			std::vector<float> fractions;
+			pGrid->Raycast(from, to, fractions);
+			return fractions;
+		})
+		.addFunction("HasLineOfSight", [](const HeightGrid* pGrid, lua_State* L, const Vector3Array& from, const Vector3Array& to)
+		{
+			std::vector<float> fractions;
+			pGrid->Raycast(from, to, fractions);
+			auto table = LuaRef::createTable(L, static_cast<int>(fractions.size()));
+			for (size_t i = 0; i < fractions.size(); i++)
+				table.set(i + 1, fractions[i] >= 1.0f);
+			return table;
+		})
+		.endClass();
+}
+
+std::shared_ptr<Pyx::Math::HeightGrid> Pyx::Math::HeightGrid::Open(const std::wstring& fileName)
+{
+	HANDLE hFile = CreateFileW(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER fileSize;
+	FileHeader header;
+	DWORD bytesRead = 0;
+	if (GetFileSizeEx(hFile, &fileSize) == FALSE
+		|| ReadFile(hFile, &header, sizeof(header), &bytesRead, nullptr) == FALSE || bytesRead != sizeof(header)
+		|| header.Magic != Magic || header.Version != Version || header.TileSize != TileSize || !(header.CellSize > 0.0f)
+		|| header.TileCount > (static_cast<uint64_t>(fileSize.QuadPart) - sizeof(FileHeader)) / sizeof(FileTile)
+		|| header.TileCount > MAXDWORD / sizeof(FileTile))
+	{
+		CloseHandle(hFile);
+		return nullptr;
+	}
+
+	std::vector<FileTile> table(header.TileCount);
+	DWORD tableSize = static_cast<DWORD>(table.size() * sizeof(FileTile));
+	if (tableSize > 0 && (ReadFile(hFile, &table[0], tableSize, &bytesRead, nullptr) == FALSE || bytesRead != tableSize))
+	{
+		CloseHandle(hFile);
+		return nullptr;
+	}
+
+	// Tiles are only mapped on demand, so every one of them has to be inside
+	// the file before the grid is handed out
+	const uint64_t tileBytes = TileCellCount * (sizeof(float) + sizeof(uint8_t));
+	const uint64_t size = static_cast<uint64_t>(fileSize.QuadPart);
+	for (auto& tile : table)
+	{
+		if (tile.FileOffset > size || tileBytes > size - tile.FileOffset)
+		{
+			CloseHandle(hFile);
+			return nullptr;
+		}
+	}
+
+	HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!hMapping)
+	{
+		CloseHandle(hFile);
+		return nullptr;
+	}
+
+	auto pGrid = std::make_shared<HeightGrid>(header.CellSize);
+	pGrid->m_fileName = fileName;
+	pGrid->m_hFile = hFile;
+	pGrid->m_hMapping = hMapping;
+	pGrid->m_fileSize = size;
+	for (auto& tile : table)
+		pGrid->m_mappedTiles[GetTileKey(tile.X, tile.Z)] = MappedTile{ tile.FileOffset, nullptr };
+
+	return pGrid;
+}
+
+Pyx::Math::HeightGrid::HeightGrid(float cellSize)
+	: m_cellSize(cellSize > 0.0f ? cellSize : 1.0f),
+	m_hFile(INVALID_HANDLE_VALUE),
+	m_hMapping(nullptr),
+	m_fileSize(0)
+{
+}
+
+Pyx::Math::HeightGrid::~HeightGrid()
+{
+	Close();
+}
+
+void Pyx::Math::HeightGrid::Close()
+{
+	for (auto& tile : m_mappedTiles)
+	{
+		if (tile.second.pView)
+			UnmapViewOfFile(tile.second.pView);
+	}
+	m_mappedTiles.clear();
+
+	if (m_hMapping)
+	{
+		CloseHandle(m_hMapping);
+		m_hMapping = nullptr;
+	}
+
+	if (m_hFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_hFile);
+		m_hFile = INVALID_HANDLE_VALUE;
+	}
+
+	m_fileName.clear();
+	m_fileSize = 0;
+}
+
+uint64_t Pyx::Math::HeightGrid::GetTileKey(int32_t x, int32_t z)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+}
+
+int32_t Pyx::Math::HeightGrid::FloorDiv(int32_t value, int32_t divisor)
+{
+	return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+bool Pyx::Math::HeightGrid::GetCellCoord(float value, int32_t& coord) const
+{
+	// Casting a NaN or an out of range float to an integer is undefined
+	if (!std::isfinite(value))
+		return false;
+
+	float cell = floorf(value / m_cellSize);
+	cell = (std::max)(cell, static_cast<float>(-MaxCellCoord));
+	cell = (std::min)(cell, static_cast<float>(MaxCellCoord));
+	coord = static_cast<int32_t>(cell);
+	return true;
+}
+
+size_t Pyx::Math::HeightGrid::GetTileCount() const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	size_t count = m_mappedTiles.size();
+	for (auto& tile : m_tiles)
+	{
+		if (m_mappedTiles.count(tile.first) == 0)
+			count++;
+	}
+	return count;
+}
+
+bool Pyx::Math::HeightGrid::GetTile(uint64_t key, TileView& view) const
+{
+	auto owned = m_tiles.find(key);
+	if (owned != m_tiles.end())
+	{
+		view.pHeights = &owned->second.Heights[0];
+		view.pFlags = &owned->second.Flags[0];
+		return true;
+	}
+
+	auto mapped = m_mappedTiles.find(key);
+	if (mapped == m_mappedTiles.end())
+		return false;
+
+	// Views have to start on the allocation granularity, so map from the
+	// closest boundary before the tile and skip the leading bytes
+	static const DWORD allocationGranularity = []
+	{
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo(&systemInfo);
+		return systemInfo.dwAllocationGranularity;
+	}();
+	const uint64_t offset = mapped->second.FileOffset;
+	const uint64_t viewOffset = offset - offset % allocationGranularity;
+	const size_t viewSize = static_cast<size_t>(offset - viewOffset) + TileCellCount * (sizeof(float) + sizeof(uint8_t));
+
+	if (!mapped->second.pView)
+	{
+		mapped->second.pView = MapViewOfFile(m_hMapping, FILE_MAP_READ,
+			static_cast<DWORD>(viewOffset >> 32), static_cast<DWORD>(viewOffset & 0xFFFFFFFF), viewSize);
+		if (!mapped->second.pView)
+			return false;
+	}
+
+	auto* pData = static_cast<const uint8_t*>(mapped->second.pView) + (offset - viewOffset);
+	view.pHeights = reinterpret_cast<const float*>(pData);
+	view.pFlags = pData + TileCellCount * sizeof(float);
+	return true;
+}
+
+Pyx::Math::HeightGrid::Tile& Pyx::Math::HeightGrid::GetWritableTile(uint64_t key)
+{
+	auto owned = m_tiles.find(key);
+	if (owned != m_tiles.end())
+		return owned->second;
+
+	Tile tile;
+	TileView view;
+	if (GetTile(key, view))
+	{
+		tile.Heights.assign(view.pHeights, view.pHeights + TileCellCount);
+		tile.Flags.assign(view.pFlags, view.pFlags + TileCellCount);
+	}
+	else
+	{
+		tile.Heights.assign(TileCellCount, NAN);
+		tile.Flags.assign(TileCellCount, static_cast<uint8_t>(CellFlags::Unknown));
+	}
+	return m_tiles[key] = std::move(tile);
+}
+
+bool Pyx::Math::HeightGrid::GetCell(int32_t x, int32_t z, float& height, CellFlags& flags) const
+{
+	int32_t tileX = FloorDiv(x, TileSize);
+	int32_t tileZ = FloorDiv(z, TileSize);
+	TileView view;
+	if (!GetTile(GetTileKey(tileX, tileZ), view))
+		return false;
+
+	uint32_t index = static_cast<uint32_t>(z - tileZ * static_cast<int32_t>(TileSize)) * TileSize
+		+ static_cast<uint32_t>(x - tileX * static_cast<int32_t>(TileSize));
+	height = view.pHeights[index];
+	flags = static_cast<CellFlags>(view.pFlags[index]);
+	return true;
+}
+
+void Pyx::Math::HeightGrid::SetCell(int32_t x, int32_t z, float height, CellFlags flags)
+{
+	int32_t tileX = FloorDiv(x, TileSize);
+	int32_t tileZ = FloorDiv(z, TileSize);
+	auto& tile = GetWritableTile(GetTileKey(tileX, tileZ));
+
+	uint32_t index = static_cast<uint32_t>(z - tileZ * static_cast<int32_t>(TileSize)) * TileSize
+		+ static_cast<uint32_t>(x - tileX * static_cast<int32_t>(TileSize));
+	tile.Heights[index] = height;
+	tile.Flags[index] = static_cast<uint8_t>(flags);
+}
+
+bool Pyx::Math::HeightGrid::Save(const std::wstring& fileName)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::vector<uint64_t> keys;
+	for (auto& tile : m_mappedTiles)
+		keys.push_back(tile.first);
+	for (auto& tile : m_tiles)
+	{
+		if (m_mappedTiles.count(tile.first) == 0)
+			keys.push_back(tile.first);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	// The mapped file can't be rewritten while views are open on it, pull
+	// everything in memory first when saving over it
+	if (!m_fileName.empty() && _wcsicmp(fileName.c_str(), m_fileName.c_str()) == 0)
+	{
+		for (auto key : keys)
+			GetWritableTile(key);
+		Close();
+	}
+
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+
+	FileHeader header = { Magic, Version, m_cellSize, TileSize, static_cast<uint32_t>(keys.size()), 0 };
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	const uint64_t tileBytes = TileCellCount * (sizeof(float) + sizeof(uint8_t));
+	uint64_t offset = sizeof(FileHeader) + keys.size() * sizeof(FileTile);
+	for (auto key : keys)
+	{
+		FileTile entry = { static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & 0xFFFFFFFF), offset };
+		file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+		offset += tileBytes;
+	}
+
+	for (auto key : keys)
+	{
+		TileView view;
+		if (!GetTile(key, view))
+			return false;
+		file.write(reinterpret_cast<const char*>(view.pHeights), TileCellCount * sizeof(float));
+		file.write(reinterpret_cast<const char*>(view.pFlags), TileCellCount * sizeof(uint8_t));
+	}
+
+	return file.good();
+}
+
+bool Pyx::Math::HeightGrid::ImportRawHeights(const std::wstring& fileName, float originX, float originZ, uint32_t columns, uint32_t rows)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file)
+		return false;
+
+	int32_t cellX, cellZ;
+	if (!GetCellCoord(originX, cellX) || !GetCellCoord(originZ, cellZ))
+		return false;
+
+	std::vector<float> row(columns);
+
+	for (uint32_t z = 0; z < rows; z++)
+	{
+		if (columns > 0 && !file.read(reinterpret_cast<char*>(&row[0]), columns * sizeof(float)))
+			return false;
+
+		for (uint32_t x = 0; x < columns; x++)
+		{
+			if (std::isnan(row[x]))
+				continue;
+
+			// Terrain dumps only carry heights, keep whatever was recorded about
+			// walkability for the cell
+			float height;
+			CellFlags flags = CellFlags::Unknown;
+			int32_t cx = cellX + static_cast<int32_t>(x);
+			int32_t cz = cellZ + static_cast<int32_t>(z);
+			GetCell(cx, cz, height, flags);
+			SetCell(cx, cz, row[x], flags);
+		}
+	}
+	return true;
+}
+
+void Pyx::Math::HeightGrid::Record(const Vector3& position, bool isWalkable)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	int32_t x, z;
+	if (position.IsNan() || position.IsInfinity() || !GetCellCoord(position.X, x) || !GetCellCoord(position.Z, z))
+		return;
+
+	SetCell(x, z, position.Y, isWalkable ? CellFlags::Walkable : CellFlags::Blocked);
+}
+
+void Pyx::Math::HeightGrid::Record(const Vector3Array& positions, bool isWalkable)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	for (size_t i = 0; i < positions.GetSize(); i++)
+		Record(positions.Get(i), isWalkable);
+}
+
+bool Pyx::Math::HeightGrid::GetHeight(float x, float z, float& height) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	int32_t cellX, cellZ;
+	CellFlags flags;
+	return GetCellCoord(x, cellX) && GetCellCoord(z, cellZ)
+		&& GetCell(cellX, cellZ, height, flags) && !std::isnan(height);
+}
+
+bool Pyx::Math::HeightGrid::IsWalkable(const Vector3& position, float maxStep) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	int32_t x, z;
+	float height;
+	CellFlags flags;
+	if (!GetCellCoord(position.X, x) || !GetCellCoord(position.Z, z)
+		|| !GetCell(x, z, height, flags) || flags != CellFlags::Walkable)
+		return false;
+	return maxStep <= 0.0f || fabsf(height - position.Y) <= maxStep;
+}
+
+void Pyx::Math::HeightGrid::IsWalkable(const Vector3Array& positions, float maxStep, std::vector<uint8_t>& results) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	results.resize(positions.GetSize());
+	for (size_t i = 0; i < positions.GetSize(); i++)
+		results[i] = IsWalkable(positions.Get(i), maxStep) ? 1 : 0;
+}
+
+bool Pyx::Math::HeightGrid::Raycast(const Vector3& from, const Vector3& to, float& fraction) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	// Amanatides & Woo grid traversal on the XZ plane. Each visited cell is
+	// compared against the lowest point of the ray segment crossing it
+	const float dx = to.X - from.X;
+	const float dy = to.Y - from.Y;
+	const float dz = to.Z - from.Z;
+
+	int32_t x, z, endX, endZ;
+	if (!GetCellCoord(from.X, x) || !GetCellCoord(from.Z, z) || !GetCellCoord(to.X, endX) || !GetCellCoord(to.Z, endZ))
+	{
+		fraction = 1.0f;
+		return false;
+	}
+
+	const int32_t stepX = dx > 0.0f ? 1 : -1;
+	const int32_t stepZ = dz > 0.0f ? 1 : -1;
+	const float deltaX = dx != 0.0f ? m_cellSize / fabsf(dx) : INFINITY;
+	const float deltaZ = dz != 0.0f ? m_cellSize / fabsf(dz) : INFINITY;
+	float nextX = dx != 0.0f ? ((x + (stepX > 0 ? 1 : 0)) * m_cellSize - from.X) / dx : INFINITY;
+	float nextZ = dz != 0.0f ? ((z + (stepZ > 0 ? 1 : 0)) * m_cellSize - from.Z) / dz : INFINITY;
+	float t = 0.0f;
+
+	const uint32_t maxSteps = static_cast<uint32_t>(std::abs(endX - x)) + static_cast<uint32_t>(std::abs(endZ - z)) + 1;
+	for (uint32_t step = 0; step < maxSteps; step++)
+	{
+		float tExit = (std::min)((std::min)(nextX, nextZ), 1.0f);
+
+		// The cells holding both ends are skipped, rays usually start and end
+		// right on the ground and would otherwise always hit it
+		bool isEndpoint = (step == 0) || (x == endX && z == endZ);
+		float height;
+		CellFlags flags;
+		if (!isEndpoint && GetCell(x, z, height, flags))
+		{
+			if (flags == CellFlags::Blocked)
+			{
+				fraction = t;
+				return true;
+			}
+
+			float yEnter = from.Y + dy * t;
+			float yExit = from.Y + dy * tExit;
+			if (!std::isnan(height) && height > (std::min)(yEnter, yExit))
+			{
+				fraction = yEnter <= height ? t : t + (yEnter - height) / (yEnter - yExit) * (tExit - t);
+				return true;
+			}
+		}
+
+		if (tExit >= 1.0f)
+			break;
+
+		if (nextX < nextZ)
+		{
+			x += stepX;
+			t = nextX;
+			nextX += deltaX;
+		}
+		else
+		{
+			z += stepZ;
+			t = nextZ;
+			nextZ += deltaZ;
+		}
+	}
+
+	fraction = 1.0f;
+	return false;
+}
+
+void Pyx::Math::HeightGrid::Raycast(const Vector3Array& from, const Vector3Array& to, std::vector<float>& fractions) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	const size_t count = (std::min)(from.GetSize(), to.GetSize());
+	fractions.resize(count);
+	for (size_t i = 0; i < count; i++)
+		Raycast(from.Get(i), to.Get(i), fractions[i]);
+}
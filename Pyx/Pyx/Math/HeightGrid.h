@@ -0,0 +1,121 @@
+#pragma once
+#include <Windows.h>
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Vector3.h>
+#include <Pyx/Math/Vector3Array.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		// Tiled heightfield over the XZ plane with a walkability flag per cell.
+		// Tiles saved on disk are mapped one at a time the first time a query
+		// touches them; recorded or imported tiles live in memory until saved.
+		class HeightGrid
+		{
+
+		public:
+			static const uint32_t Magic = 0x48585950; // "PYXH"
+			static const uint32_t Version = 1;
+			static const uint32_t TileSize = 64;
+			static const uint32_t TileCellCount = TileSize * TileSize;
+			// Cell coordinates are clamped to this range so the tile and ray
+			// traversal arithmetic can't overflow
+			static const int32_t MaxCellCoord = 1 << 28;
+
+			enum class CellFlags : uint8_t
+			{
+				Unknown = 0,
+				Walkable = 1,
+				Blocked = 2
+			};
+
+#pragma pack(push, 1)
+			struct FileHeader
+			{
+				uint32_t Magic;
+				uint32_t Version;
+				float CellSize;
+				uint32_t TileSize;
+				uint32_t TileCount;
+				uint32_t Reserved;
+			};
+
+			struct FileTile
+			{
+				int32_t X;
+				int32_t Z;
+				uint64_t FileOffset;
+			};
+#pragma pack(pop)
+
+		private:
+			struct TileView
+			{
+				const float* pHeights;
+				const uint8_t* pFlags;
+			};
+
+			struct Tile
+			{
+				std::vector<float> Heights;
+				std::vector<uint8_t> Flags;
+			};
+
+			struct MappedTile
+			{
+				uint64_t FileOffset;
+				void* pView;
+			};
+
+		public:
+			static void BindWithScript(Pyx::Scripting::Script* pScript);
+			static std::shared_ptr<HeightGrid> Open(const std::wstring& fileName);
+
+		private:
+			float m_cellSize;
+			std::wstring m_fileName;
+			HANDLE m_hFile;
+			HANDLE m_hMapping;
+			uint64_t m_fileSize;
+			mutable std::unordered_map<uint64_t, MappedTile> m_mappedTiles;
+			std::unordered_map<uint64_t, Tile> m_tiles;
+			// Tiles are mapped on first use by const queries, and grids can be
+			// used by scripts running on the pulse and the render thread
+			mutable std::recursive_mutex m_mutex;
+
+		private:
+			static uint64_t GetTileKey(int32_t x, int32_t z);
+			static int32_t FloorDiv(int32_t value, int32_t divisor);
+			bool GetCellCoord(float value, int32_t& coord) const;
+			bool GetTile(uint64_t key, TileView& view) const;
+			Tile& GetWritableTile(uint64_t key);
+			bool GetCell(int32_t x, int32_t z, float& height, CellFlags& flags) const;
+			void SetCell(int32_t x, int32_t z, float height, CellFlags flags);
+			void Close();
+
+		public:
+			explicit HeightGrid(float cellSize);
+			~HeightGrid();
+			float GetCellSize() const { return m_cellSize; }
+			const std::wstring& GetFileName() const { return m_fileName; }
+			size_t GetTileCount() const;
+			bool Save(const std::wstring& fileName);
+			bool ImportRawHeights(const std::wstring& fileName, float originX, float originZ, uint32_t columns, uint32_t rows);
+			void Record(const Vector3& position, bool isWalkable);
+			void Record(const Vector3Array& positions, bool isWalkable);
+			bool GetHeight(float x, float z, float& height) const;
+			bool IsWalkable(const Vector3& position, float maxStep) const;
+			void IsWalkable(const Vector3Array& positions, float maxStep, std::vector<uint8_t>& results) const;
+			bool Raycast(const Vector3& from, const Vector3& to, float& fraction) const;
+			void Raycast(const Vector3Array& from, const Vector3Array& to, std::vector<float>& fractions) const;
+
+		};
+	}
+}
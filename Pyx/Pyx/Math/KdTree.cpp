@@ -0,0 +1,142 @@
+#include <Pyx/Math/KdTree.h>
+#include <algorithm>
+
+namespace
+{
+	float GetAxis(const Pyx::Math::Vector3& v, uint32_t axis)
+	{
+		return axis == 0 ? v.X : axis == 1 ? v.Y : v.Z;
+	}
+}
+
+Pyx::Math::KdTree::KdTree()
+{
+}
+
+Pyx::Math::KdTree::~KdTree()
+{
+}
+
+void Pyx::Math::KdTree::Build(const std::vector<Vector3>& points)
+{
+	m_nodes.resize(points.size());
+	for (size_t i = 0; i < points.size(); i++)
+		m_nodes[i] = Node{ points[i], static_cast<uint32_t>(i), 0 };
+
+	Build(0, m_nodes.size());
+}
+
+void Pyx::Math::KdTree::Build(size_t begin, size_t end)
+{
+	if (end - begin <= 1)
+		return;
+
+	// Split on the axis with the largest spread, worlds are mostly flat so this
+	// keeps Y splits rare and 2D queries prune almost as well as 3D ones
+	Vector3 lo = m_nodes[begin].Position;
+	Vector3 hi = lo;
+	for (size_t i = begin + 1; i < end; i++)
+	{
+		const auto& p = m_nodes[i].Position;
+		lo = Vector3((std::min)(lo.X, p.X), (std::min)(lo.Y, p.Y), (std::min)(lo.Z, p.Z));
+		hi = Vector3((std::max)(hi.X, p.X), (std::max)(hi.Y, p.Y), (std::max)(hi.Z, p.Z));
+	}
+
+	Vector3 spread = hi - lo;
+	uint32_t axis = spread.X >= spread.Y && spread.X >= spread.Z ? 0 : spread.Y >= spread.Z ? 1 : 2;
+	size_t mid = begin + (end - begin) / 2;
+
+	std::nth_element(m_nodes.begin() + begin, m_nodes.begin() + mid, m_nodes.begin() + end,
+		[axis](const Node& a, const Node& b) { return GetAxis(a.Position, axis) < GetAxis(b.Position, axis); });
+	m_nodes[mid].Axis = axis;
+
+	Build(begin, mid);
+	Build(mid + 1, end);
+}
+
+void Pyx::Math::KdTree::FindNearest(const Vector3& point, size_t count, bool is2D, std::vector<uint32_t>& result) const
+{
+	result.clear();
+	if (m_nodes.empty() || count == 0)
+		return;
+
+	std::vector<std::pair<float, uint32_t>> heap;
+	heap.reserve(count + 1);
+	FindNearest(0, m_nodes.size(), point, count, is2D, heap);
+
+	std::sort_heap(heap.begin(), heap.end());
+	for (auto& entry : heap)
+		result.push_back(entry.second);
+}
+
+void Pyx::Math::KdTree::FindNearest(size_t begin, size_t end, const Vector3& point, size_t count, bool is2D,
+	std::vector<std::pair<float, uint32_t>>& heap) const
+{
+	if (begin >= end)
+		return;
+
+	size_t mid = begin + (end - begin) / 2;
+	const auto& node = m_nodes[mid];
+
+	float distance = GetDistanceSquared(point, node.Position, is2D);
+	if (heap.size() < count || distance < heap.front().first)
+	{
+		heap.emplace_back(distance, node.Index);
+		std::push_heap(heap.begin(), heap.end());
+		if (heap.size() > count)
+		{
+			std::pop_heap(heap.begin(), heap.end());
+			heap.pop_back();
+		}
+	}
+
+	if (end - begin == 1)
+		return;
+
+	float delta = GetAxis(point, node.Axis) - GetAxis(node.Position, node.Axis);
+	bool isLeftFirst = delta < 0.0f;
+	if (isLeftFirst)
+		FindNearest(begin, mid, point, count, is2D, heap);
+	else
+		FindNearest(mid + 1, end, point, count, is2D, heap);
+
+	// Y splits can't be used to prune when the metric ignores height
+	bool canPrune = !(is2D && node.Axis == 1);
+	if (!canPrune || heap.size() < count || delta * delta < heap.front().first)
+	{
+		if (isLeftFirst)
+			FindNearest(mid + 1, end, point, count, is2D, heap);
+		else
+			FindNearest(begin, mid, point, count, is2D, heap);
+	}
+}
+
+void Pyx::Math::KdTree::FindInRadius(const Vector3& point, float radius, bool is2D, std::vector<uint32_t>& result) const
+{
+	result.clear();
+	if (!m_nodes.empty())
+		FindInRadius(0, m_nodes.size(), point, radius * radius, is2D, result);
+}
+
+void Pyx::Math::KdTree::FindInRadius(size_t begin, size_t end, const Vector3& point, float radiusSquared, bool is2D,
+	std::vector<uint32_t>& result) const
+{
+	if (begin >= end)
+		return;
+
+	size_t mid = begin + (end - begin) / 2;
+	const auto& node = m_nodes[mid];
+
+	if (GetDistanceSquared(point, node.Position, is2D) <= radiusSquared)
+		result.push_back(node.Index);
+
+	if (end - begin == 1)
+		return;
+
+	float delta = GetAxis(point, node.Axis) - GetAxis(node.Position, node.Axis);
+	bool canPrune = !(is2D && node.Axis == 1);
+	if (!canPrune || delta <= 0.0f || delta * delta <= radiusSquared)
+		FindInRadius(begin, mid, point, radiusSquared, is2D, result);
+	if (!canPrune || delta >= 0.0f || delta * delta <= radiusSquared)
+		FindInRadius(mid + 1, end, point, radiusSquared, is2D, result);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <Pyx/Math/Vector3.h>
+#include <cstdint>
+#include <vector>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		// Static k-d tree over a set of points, stored as a flat array where each
+		// range's median is its node. Results are indices into the built points.
+		class KdTree
+		{
+
+		private:
+			struct Node
+			{
+				Vector3 Position;
+				uint32_t Index;
+				uint32_t Axis;
+			};
+
+		public:
+			static float GetDistanceSquared(const Vector3& a, const Vector3& b, bool is2D)
+			{
+				float dx = a.X - b.X;
+				float dy = is2D ? 0.0f : a.Y - b.Y;
+				float dz = a.Z - b.Z;
+				return dx * dx + dy * dy + dz * dz;
+			}
+
+		private:
+			std::vector<Node> m_nodes;
+
+		private:
+			void Build(size_t begin, size_t end);
+			void FindNearest(size_t begin, size_t end, const Vector3& point, size_t count, bool is2D,
+				std::vector<std::pair<float, uint32_t>>& heap) const;
+			void FindInRadius(size_t begin, size_t end, const Vector3& point, float radiusSquared, bool is2D,
+				std::vector<uint32_t>& result) const;
+
+		public:
+			explicit KdTree();
+			~KdTree();
+			void Build(const std::vector<Vector3>& points);
+			void Clear() { m_nodes.clear(); }
+			size_t GetSize() const { return m_nodes.size(); }
+			void FindNearest(const Vector3& point, size_t count, bool is2D, std::vector<uint32_t>& result) const;
+			void FindInRadius(const Vector3& point, float radius, bool is2D, std::vector<uint32_t>& result) const;
+
+		};
+	}
+}
@@ -0,0 +1,440 @@
+#include <Pyx/Math/Matrix4.h>
+#include <Pyx/Math/Quaternion.h>
+#include <Pyx/Math/Vector3Array.h>
+#include <limits>
+#include <sstream>
+
+void Pyx::Math::Matrix4::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+	using namespace LuaIntf;
+	LuaBinding(pScript->GetLuaState())
+		.beginModule("Pyx")
+		.beginModule("Math")
+		.beginClass<Matrix4>("Matrix4")
+		.addConstructor(LUA_ARGS())
+		.addStaticFunction("Identity", &Matrix4::Identity)
+		.addStaticFunction("Translation", &Matrix4::Translation)
+		.addStaticFunction("Scaling", &Matrix4::Scaling)
+		.addStaticFunction("RotationX", &Matrix4::RotationX)
+		.addStaticFunction("RotationY", &Matrix4::RotationY)
+		.addStaticFunction("RotationZ", &Matrix4::RotationZ)
+		.addStaticFunction("RotationAxis", &Matrix4::RotationAxis)
+		.addStaticFunction("RotationQuaternion", &Matrix4::RotationQuaternion)
+		.addStaticFunction("LookAtLH", &Matrix4::LookAtLH)
+		.addStaticFunction("PerspectiveFovLH", &Matrix4::PerspectiveFovLH)
+		.addStaticFunction("OrthographicLH", &Matrix4::OrthographicLH)
+		// Lua side indices are 1 based like everything else in Lua
+		.addFunction("Get", [](const Matrix4* m, int row, int col) { return m->M[(row - 1) & 3][(col - 1) & 3]; })
+		.addFunction("Set", [](Matrix4* m, int row, int col, float value) { m->M[(row - 1) & 3][(col - 1) & 3] = value; })
+		.addFunction("GetRow", [](const Matrix4* m, int row) { return m->GetRow((row - 1) & 3); })
+		.addPropertyReadOnly("Determinant", &Matrix4::GetDeterminant)
+		.addFunction("Transposed", &Matrix4::Transposed)
+		.addFunction("Inverted", &Matrix4::Inverted)
+		.addFunction("Transform", &Matrix4::Transform)
+		.addFunction("TransformCoord", &Matrix4::TransformCoord)
+		.addFunction("TransformNormal", &Matrix4::TransformNormal)
+		.addFunction("Project", &Matrix4::Project, LUA_ARGS(const Vector3&, float, float, _out<Vector3&>))
+		.addFunction("ProjectArray", [](const Matrix4* m, lua_State* L, const Vector3Array& world, float width, float height, Vector3Array& screen)
+		{
+			std::vector<uint8_t> flags;
+			m->ProjectArray(world, Vector3(), width, height, screen, flags);
+			auto table = LuaRef::createTable(L, static_cast<int>(flags.size()));
+			for (size_t i = 0; i < flags.size(); i++)
+				table.set(i + 1, (flags[i] & InFrustum) != 0);
+			return table;
+		}, LUA_ARGS(lua_State*, const Vector3Array&, float, float, Vector3Array&))
+		.addFunction("__mul", [](const Matrix4* a, const Matrix4& b) { return *a * b; })
+		.addFunction("__eq", [](const Matrix4* a, const Matrix4& b) { return *a == b; })
+		.addFunction("__tostring", &Matrix4::ToString)
+		.endClass();
+}
+
+Pyx::Math::Matrix4::Matrix4()
+{
+	*this = Identity();
+}
+
+Pyx::Math::Matrix4::Matrix4(float m00, float m01, float m02, float m03,
+	float m10, float m11, float m12, float m13,
+	float m20, float m21, float m22, float m23,
+	float m30, float m31, float m32, float m33)
+{
+	M[0][0] = m00; M[0][1] = m01; M[0][2] = m02; M[0][3] = m03;
+	M[1][0] = m10; M[1][1] = m11; M[1][2] = m12; M[1][3] = m13;
+	M[2][0] = m20; M[2][1] = m21; M[2][2] = m22; M[2][3] = m23;
+	M[3][0] = m30; M[3][1] = m31; M[3][2] = m32; M[3][3] = m33;
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::Identity()
+{
+	return Matrix4(
+		1, 0, 0, 0,
+		0, 1, 0, 0,
+		0, 0, 1, 0,
+		0, 0, 0, 1);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::Translation(const Vector3& translation)
+{
+	return Matrix4(
+		1, 0, 0, 0,
+		0, 1, 0, 0,
+		0, 0, 1, 0,
+		translation.X, translation.Y, translation.Z, 1);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::Scaling(const Vector3& scale)
+{
+	return Matrix4(
+		scale.X, 0, 0, 0,
+		0, scale.Y, 0, 0,
+		0, 0, scale.Z, 0,
+		0, 0, 0, 1);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::RotationX(float radians)
+{
+	float c = cosf(radians), s = sinf(radians);
+	return Matrix4(
+		1, 0, 0, 0,
+		0, c, s, 0,
+		0, -s, c, 0,
+		0, 0, 0, 1);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::RotationY(float radians)
+{
+	float c = cosf(radians), s = sinf(radians);
+	return Matrix4(
+		c, 0, -s, 0,
+		0, 1, 0, 0,
+		s, 0, c, 0,
+		0, 0, 0, 1);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::RotationZ(float radians)
+{
+	float c = cosf(radians), s = sinf(radians);
+	return Matrix4(
+		c, s, 0, 0,
+		-s, c, 0, 0,
+		0, 0, 1, 0,
+		0, 0, 0, 1);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::RotationAxis(const Vector3& axis, float radians)
+{
+	return RotationQuaternion(Quaternion::FromAxisAngle(axis, radians));
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::RotationQuaternion(const Quaternion& q)
+{
+	float xx = q.X * q.X, yy = q.Y * q.Y, zz = q.Z * q.Z;
+	float xy = q.X * q.Y, xz = q.X * q.Z, yz = q.Y * q.Z;
+	float wx = q.W * q.X, wy = q.W * q.Y, wz = q.W * q.Z;
+	return Matrix4(
+		1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy), 0,
+		2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx), 0,
+		2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy), 0,
+		0, 0, 0, 1);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::LookAtLH(const Vector3& eye, const Vector3& at, const Vector3& up)
+{
+	Vector3 zAxis = (at - eye).Normalized();
+	Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
+	Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
+	return Matrix4(
+		xAxis.X, yAxis.X, zAxis.X, 0,
+		xAxis.Y, yAxis.Y, zAxis.Y, 0,
+		xAxis.Z, yAxis.Z, zAxis.Z, 0,
+		-Vector3::Dot(xAxis, eye), -Vector3::Dot(yAxis, eye), -Vector3::Dot(zAxis, eye), 1);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::PerspectiveFovLH(float fovY, float aspect, float zNear, float zFar)
+{
+	float yScale = 1.0f / tanf(fovY / 2.0f);
+	float xScale = yScale / aspect;
+	float q = zFar / (zFar - zNear);
+	return Matrix4(
+		xScale, 0, 0, 0,
+		0, yScale, 0, 0,
+		0, 0, q, 1,
+		0, 0, -zNear * q, 0);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::OrthographicLH(float width, float height, float zNear, float zFar)
+{
+	float q = 1.0f / (zFar - zNear);
+	return Matrix4(
+		2.0f / width, 0, 0, 0,
+		0, 2.0f / height, 0, 0,
+		0, 0, q, 0,
+		0, 0, -zNear * q, 1);
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::operator*(const Matrix4& other) const
+{
+	Matrix4 result;
+#if PYX_MATH_SSE
+	__m128 b0 = _mm_loadu_ps(other.M[0]);
+	__m128 b1 = _mm_loadu_ps(other.M[1]);
+	__m128 b2 = _mm_loadu_ps(other.M[2]);
+	__m128 b3 = _mm_loadu_ps(other.M[3]);
+	for (int i = 0; i < 4; i++)
+	{
+		__m128 r = _mm_mul_ps(_mm_set1_ps(M[i][0]), b0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(M[i][1]), b1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(M[i][2]), b2));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(M[i][3]), b3));
+		_mm_storeu_ps(result.M[i], r);
+	}
+#else
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 4; j++)
+			result.M[i][j] = M[i][0] * other.M[0][j] + M[i][1] * other.M[1][j] + M[i][2] * other.M[2][j] + M[i][3] * other.M[3][j];
+#endif
+	return result;
+}
+
+bool Pyx::Math::Matrix4::operator==(const Matrix4& rhs) const
+{
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 4; j++)
+			if (M[i][j] != rhs.M[i][j])
+				return false;
+	return true;
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::Transposed() const
+{
+	Matrix4 result = *this;
+#if PYX_MATH_SSE
+	__m128 r0 = _mm_loadu_ps(M[0]), r1 = _mm_loadu_ps(M[1]), r2 = _mm_loadu_ps(M[2]), r3 = _mm_loadu_ps(M[3]);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	_mm_storeu_ps(result.M[0], r0);
+	_mm_storeu_ps(result.M[1], r1);
+	_mm_storeu_ps(result.M[2], r2);
+	_mm_storeu_ps(result.M[3], r3);
+#else
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 4; j++)
+			result.M[i][j] = M[j][i];
+#endif
+	return result;
+}
+
+float Pyx::Math::Matrix4::GetDeterminant() const
+{
+	float s0 = M[0][0] * M[1][1] - M[1][0] * M[0][1];
+	float s1 = M[0][0] * M[1][2] - M[1][0] * M[0][2];
+	float s2 = M[0][0] * M[1][3] - M[1][0] * M[0][3];
+	float s3 = M[0][1] * M[1][2] - M[1][1] * M[0][2];
+	float s4 = M[0][1] * M[1][3] - M[1][1] * M[0][3];
+	float s5 = M[0][2] * M[1][3] - M[1][2] * M[0][3];
+	float c5 = M[2][2] * M[3][3] - M[3][2] * M[2][3];
+	float c4 = M[2][1] * M[3][3] - M[3][1] * M[2][3];
+	float c3 = M[2][1] * M[3][2] - M[3][1] * M[2][2];
+	float c2 = M[2][0] * M[3][3] - M[3][0] * M[2][3];
+	float c1 = M[2][0] * M[3][2] - M[3][0] * M[2][2];
+	float c0 = M[2][0] * M[3][1] - M[3][0] * M[2][1];
+	return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+bool Pyx::Math::Matrix4::Invert(Matrix4& result) const
+{
+	float s0 = M[0][0] * M[1][1] - M[1][0] * M[0][1];
+	float s1 = M[0][0] * M[1][2] - M[1][0] * M[0][2];
+	float s2 = M[0][0] * M[1][3] - M[1][0] * M[0][3];
+	float s3 = M[0][1] * M[1][2] - M[1][1] * M[0][2];
+	float s4 = M[0][1] * M[1][3] - M[1][1] * M[0][3];
+	float s5 = M[0][2] * M[1][3] - M[1][2] * M[0][3];
+	float c5 = M[2][2] * M[3][3] - M[3][2] * M[2][3];
+	float c4 = M[2][1] * M[3][3] - M[3][1] * M[2][3];
+	float c3 = M[2][1] * M[3][2] - M[3][1] * M[2][2];
+	float c2 = M[2][0] * M[3][3] - M[3][0] * M[2][3];
+	float c1 = M[2][0] * M[3][2] - M[3][0] * M[2][2];
+	float c0 = M[2][0] * M[3][1] - M[3][0] * M[2][1];
+
+	float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	if (det == 0.0f)
+		return false;
+
+	float invDet = 1.0f / det;
+	result.M[0][0] = (M[1][1] * c5 - M[1][2] * c4 + M[1][3] * c3) * invDet;
+	result.M[0][1] = (-M[0][1] * c5 + M[0][2] * c4 - M[0][3] * c3) * invDet;
+	result.M[0][2] = (M[3][1] * s5 - M[3][2] * s4 + M[3][3] * s3) * invDet;
+	result.M[0][3] = (-M[2][1] * s5 + M[2][2] * s4 - M[2][3] * s3) * invDet;
+	result.M[1][0] = (-M[1][0] * c5 + M[1][2] * c2 - M[1][3] * c1) * invDet;
+	result.M[1][1] = (M[0][0] * c5 - M[0][2] * c2 + M[0][3] * c1) * invDet;
+	result.M[1][2] = (-M[3][0] * s5 + M[3][2] * s2 - M[3][3] * s1) * invDet;
+	result.M[1][3] = (M[2][0] * s5 - M[2][2] * s2 + M[2][3] * s1) * invDet;
+	result.M[2][0] = (M[1][0] * c4 - M[1][1] * c2 + M[1][3] * c0) * invDet;
+	result.M[2][1] = (-M[0][0] * c4 + M[0][1] * c2 - M[0][3] * c0) * invDet;
+	result.M[2][2] = (M[3][0] * s4 - M[3][1] * s2 + M[3][3] * s0) * invDet;
+	result.M[2][3] = (-M[2][0] * s4 + M[2][1] * s2 - M[2][3] * s0) * invDet;
+	result.M[3][0] = (-M[1][0] * c3 + M[1][1] * c1 - M[1][2] * c0) * invDet;
+	result.M[3][1] = (M[0][0] * c3 - M[0][1] * c1 + M[0][2] * c0) * invDet;
+	result.M[3][2] = (-M[3][0] * s3 + M[3][1] * s1 - M[3][2] * s0) * invDet;
+	result.M[3][3] = (M[2][0] * s3 - M[2][1] * s1 + M[2][2] * s0) * invDet;
+	return true;
+}
+
+Pyx::Math::Matrix4 Pyx::Math::Matrix4::Inverted() const
+{
+	Matrix4 result;
+	if (!Invert(result))
+		return Identity();
+	return result;
+}
+
+Pyx::Math::Vector4 Pyx::Math::Matrix4::Transform(const Vector4& v) const
+{
+#if PYX_MATH_SSE
+	__m128 r = _mm_mul_ps(_mm_set1_ps(v.X), _mm_loadu_ps(M[0]));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.Y), _mm_loadu_ps(M[1])));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.Z), _mm_loadu_ps(M[2])));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.W), _mm_loadu_ps(M[3])));
+	return Vector4(r);
+#else
+	return Vector4(
+		v.X * M[0][0] + v.Y * M[1][0] + v.Z * M[2][0] + v.W * M[3][0],
+		v.X * M[0][1] + v.Y * M[1][1] + v.Z * M[2][1] + v.W * M[3][1],
+		v.X * M[0][2] + v.Y * M[1][2] + v.Z * M[2][2] + v.W * M[3][2],
+		v.X * M[0][3] + v.Y * M[1][3] + v.Z * M[2][3] + v.W * M[3][3]);
+#endif
+}
+
+Pyx::Math::Vector3 Pyx::Math::Matrix4::TransformCoord(const Vector3& v) const
+{
+	Vector4 r = Transform(Vector4(v, 1.0f));
+	if (fabsf(r.W) < Epsilon)
+		return Vector3(r.X, r.Y, r.Z);
+	float invW = 1.0f / r.W;
+	return Vector3(r.X * invW, r.Y * invW, r.Z * invW);
+}
+
+Pyx::Math::Vector3 Pyx::Math::Matrix4::TransformNormal(const Vector3& v) const
+{
+	return Transform(Vector4(v, 0.0f)).ToVector3();
+}
+
+bool Pyx::Math::Matrix4::Project(const Vector3& world, float width, float height, Vector3& screen) const
+{
+	Vector4 clip = Transform(Vector4(world, 1.0f));
+	if (clip.W < Epsilon)
+		return false;
+
+	float invW = 1.0f / clip.W;
+	float x = clip.X * invW, y = clip.Y * invW, z = clip.Z * invW;
+	screen = Vector3((x + 1.0f) * 0.5f * width, (1.0f - y) * 0.5f * height, z);
+	return x >= -1.0f && x <= 1.0f && y >= -1.0f && y <= 1.0f && z >= 0.0f && z <= 1.0f;
+}
+
+size_t Pyx::Math::Matrix4::ProjectArray(const Vector3Array& world, const Vector3& offset, float width, float height, Vector3Array& screen, std::vector<uint8_t>& flags) const
+{
+	const size_t size = world.GetSize();
+	screen.Resize(size);
+	flags.resize(size);
+
+	const float* pX = world.GetX();
+	const float* pY = world.GetY();
+	const float* pZ = world.GetZ();
+	float* pScreenX = screen.GetX();
+	float* pScreenY = screen.GetY();
+	float* pScreenZ = screen.GetZ();
+	const float halfWidth = width * 0.5f;
+	const float halfHeight = height * 0.5f;
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	size_t visibleCount = 0;
+	size_t i = 0;
+
+	// Entries behind the camera get NaN screen coordinates, entries in front
+	// of it but outside of the frustum are still projected so lines and boxes
+	// crossing the screen edges can be drawn
+#if PYX_MATH_SSE
+	{
+		__m128 m[4][4];
+		for (int row = 0; row < 4; row++)
+			for (int col = 0; col < 4; col++)
+				m[row][col] = _mm_set1_ps(M[row][col]);
+		const __m128 ox = _mm_set1_ps(offset.X);
+		const __m128 oy = _mm_set1_ps(offset.Y);
+		const __m128 oz = _mm_set1_ps(offset.Z);
+		const __m128 hw = _mm_set1_ps(halfWidth);
+		const __m128 hh = _mm_set1_ps(halfHeight);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 minusOne = _mm_set1_ps(-1.0f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 epsilon = _mm_set1_ps(Epsilon);
+		const __m128 nans = _mm_set1_ps(nan);
+		for (; i + 4 <= size; i += 4)
+		{
+			__m128 x = _mm_add_ps(_mm_loadu_ps(pX + i), ox);
+			__m128 y = _mm_add_ps(_mm_loadu_ps(pY + i), oy);
+			__m128 z = _mm_add_ps(_mm_loadu_ps(pZ + i), oz);
+			__m128 c[4];
+			for (int col = 0; col < 4; col++)
+			{
+				c[col] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m[0][col]), _mm_mul_ps(y, m[1][col])),
+					_mm_add_ps(_mm_mul_ps(z, m[2][col]), m[3][col]));
+			}
+
+			__m128 inFront = _mm_cmpgt_ps(c[3], epsilon);
+			__m128 invW = _mm_div_ps(one, c[3]);
+			__m128 nx = _mm_mul_ps(c[0], invW);
+			__m128 ny = _mm_mul_ps(c[1], invW);
+			__m128 nz = _mm_mul_ps(c[2], invW);
+			__m128 inside = _mm_and_ps(inFront, _mm_and_ps(
+				_mm_and_ps(_mm_cmpge_ps(nx, minusOne), _mm_cmple_ps(nx, one)),
+				_mm_and_ps(_mm_and_ps(_mm_cmpge_ps(ny, minusOne), _mm_cmple_ps(ny, one)),
+					_mm_and_ps(_mm_cmpge_ps(nz, zero), _mm_cmple_ps(nz, one)))));
+
+			__m128 sx = _mm_add_ps(_mm_mul_ps(nx, hw), hw);
+			__m128 sy = _mm_sub_ps(hh, _mm_mul_ps(ny, hh));
+			_mm_storeu_ps(pScreenX + i, _mm_or_ps(_mm_and_ps(inFront, sx), _mm_andnot_ps(inFront, nans)));
+			_mm_storeu_ps(pScreenY + i, _mm_or_ps(_mm_and_ps(inFront, sy), _mm_andnot_ps(inFront, nans)));
+			_mm_storeu_ps(pScreenZ + i, _mm_or_ps(_mm_and_ps(inFront, nz), _mm_andnot_ps(inFront, nans)));
+
+			int frontMask = _mm_movemask_ps(inFront);
+			int insideMask = _mm_movemask_ps(inside);
+			for (int lane = 0; lane < 4; lane++)
+			{
+				int isInside = (insideMask >> lane) & 1;
+				flags[i + lane] = static_cast<uint8_t>(((frontMask >> lane) & 1) * InFront | isInside * InFrustum);
+				visibleCount += isInside;
+			}
+		}
+	}
+#endif
+	for (; i < size; i++)
+	{
+		Vector4 clip = Transform(Vector4(pX[i] + offset.X, pY[i] + offset.Y, pZ[i] + offset.Z, 1.0f));
+		if (!(clip.W > Epsilon))
+		{
+			pScreenX[i] = pScreenY[i] = pScreenZ[i] = nan;
+			flags[i] = 0;
+			continue;
+		}
+
+		float invW = 1.0f / clip.W;
+		float x = clip.X * invW, y = clip.Y * invW, z = clip.Z * invW;
+		pScreenX[i] = x * halfWidth + halfWidth;
+		pScreenY[i] = halfHeight - y * halfHeight;
+		pScreenZ[i] = z;
+		bool isInside = x >= -1.0f && x <= 1.0f && y >= -1.0f && y <= 1.0f && z >= 0.0f && z <= 1.0f;
+		flags[i] = static_cast<uint8_t>(InFront | (isInside ? InFrustum : 0));
+		if (isInside)
+			visibleCount++;
+	}
+
+	return visibleCount;
+}
+
+std::string Pyx::Math::Matrix4::ToString() const
+{
+	std::stringstream ss;
+	for (int i = 0; i < 4; i++)
+		ss << (i ? " | " : "") << M[i][0] << ", " << M[i][1] << ", " << M[i][2] << ", " << M[i][3];
+	return ss.str();
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Simd.h>
+#include <Pyx/Math/Vector3.h>
+#include <Pyx/Math/Vector4.h>
+#include <cstdint>
+#include <vector>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		struct Quaternion;
+		class Vector3Array;
+
+		// Row major, row vector convention (v * M) like Direct3D
+		struct PYX_MATH_ALIGN Matrix4
+		{
+
+		public:
+			enum ProjectionFlags : uint8_t
+			{
+				InFront = 1,
+				InFrustum = 2
+			};
+
+		public:
+			float M[4][4];
+
+		public:
+			static void BindWithScript(Pyx::Scripting::Script* pScript);
+			static Matrix4 Identity();
+			static Matrix4 Translation(const Vector3& translation);
+			static Matrix4 Scaling(const Vector3& scale);
+			static Matrix4 RotationX(float radians);
+			static Matrix4 RotationY(float radians);
+			static Matrix4 RotationZ(float radians);
+			static Matrix4 RotationAxis(const Vector3& axis, float radians);
+			static Matrix4 RotationQuaternion(const Quaternion& rotation);
+			static Matrix4 LookAtLH(const Vector3& eye, const Vector3& at, const Vector3& up);
+			static Matrix4 PerspectiveFovLH(float fovY, float aspect, float zNear, float zFar);
+			static Matrix4 OrthographicLH(float width, float height, float zNear, float zFar);
+
+		public:
+			Matrix4();
+			Matrix4(float m00, float m01, float m02, float m03,
+				float m10, float m11, float m12, float m13,
+				float m20, float m21, float m22, float m23,
+				float m30, float m31, float m32, float m33);
+			Matrix4 operator*(const Matrix4& other) const;
+			Matrix4& operator*=(const Matrix4& other) { return *this = *this * other; }
+			bool operator==(const Matrix4& rhs) const;
+			bool operator!=(const Matrix4& rhs) const { return !operator==(rhs); }
+			Matrix4 Transposed() const;
+			Matrix4 Inverted() const;
+			bool Invert(Matrix4& result) const;
+			float GetDeterminant() const;
+			Vector4 Transform(const Vector4& v) const;
+			Vector3 TransformCoord(const Vector3& v) const;
+			Vector3 TransformNormal(const Vector3& v) const;
+			bool Project(const Vector3& world, float width, float height, Vector3& screen) const;
+			size_t ProjectArray(const Vector3Array& world, const Vector3& offset, float width, float height, Vector3Array& screen, std::vector<uint8_t>& flags) const;
+			Vector4 GetRow(int row) const { return Vector4(M[row][0], M[row][1], M[row][2], M[row][3]); }
+			std::string ToString() const;
+
+		};
+	}
+}
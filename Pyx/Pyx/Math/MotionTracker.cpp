@@ -0,0 +1,177 @@
+#include <Pyx/Math/MotionTracker.h>
+#include <Windows.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void Pyx::Math::MotionTracker::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+	using namespace LuaIntf;
+	LuaBinding(pScript->GetLuaState())
+		.beginModule("Pyx")
+		.beginModule("Math")
+		.beginClass<MotionTracker>("MotionTracker")
+		.addConstructor(LUA_ARGS(_def<float, 1, 2>))
+		.addStaticFunction("GetTime", &MotionTracker::GetTime)
+		.addProperty("Alpha", &MotionTracker::GetAlpha, &MotionTracker::SetAlpha)
+		.addProperty("MaxExtrapolation", &MotionTracker::GetMaxExtrapolation, &MotionTracker::SetMaxExtrapolation)
+		.addProperty("ResetDistance", &MotionTracker::GetResetDistance, &MotionTracker::SetResetDistance)
+		.addPropertyReadOnly("Size", &MotionTracker::GetSize)
+		.addFunction("Clear", &MotionTracker::Clear)
+		.addFunction("Remove", &MotionTracker::Remove)
+		.addFunction("RemoveStale", &MotionTracker::RemoveStale)
+		.addFunction("Contains", &MotionTracker::Contains)
+		.addFunction("Update", [](MotionTracker* pTracker, uint64_t id, const Vector3& position, double time)
+		{
+			pTracker->Update(id, position, time);
+		})
+		.addFunction("UpdateArray", [](MotionTracker* pTracker, const std::vector<uint64_t>& ids, const Vector3Array& positions, double time)
+		{
+			pTracker->Update(ids, positions, time);
+		})
+		.addFunction("PredictPosition", &MotionTracker::PredictPosition, LUA_ARGS(uint64_t, double, _out<Vector3&>))
+		.addFunction("PredictPositions", &MotionTracker::PredictPositions)
+		.addFunction("TryGetVelocity", &MotionTracker::TryGetVelocity, LUA_ARGS(uint64_t, _out<Vector3&>))
+		.endClass();
+}
+
+double Pyx::Math::MotionTracker::GetTime()
+{
+	static LARGE_INTEGER frequency = []() { LARGE_INTEGER f; QueryPerformanceFrequency(&f); return f; }();
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return static_cast<double>(counter.QuadPart) / static_cast<double>(frequency.QuadPart);
+}
+
+Pyx::Math::MotionTracker::MotionTracker(float alpha)
+	: m_maxExtrapolation(1.0f),
+	m_resetDistance(0.0f)
+{
+	SetAlpha(alpha);
+}
+
+Pyx::Math::MotionTracker::~MotionTracker()
+{
+}
+
+void Pyx::Math::MotionTracker::SetAlpha(float alpha)
+{
+	// Beta and gamma follow the optimal gains for a given alpha from
+	// Gray & Murray, so the filter only has one smoothing knob
+	m_alpha = (std::min)((std::max)(alpha, 0.01f), 1.0f);
+	m_beta = 2.0f * (2.0f - m_alpha) - 4.0f * sqrtf(1.0f - m_alpha);
+	m_gamma = m_beta * m_beta / (2.0f * m_alpha);
+}
+
+size_t Pyx::Math::MotionTracker::RemoveStale(double time, float maxAge)
+{
+	size_t count = 0;
+	for (auto it = m_tracks.begin(); it != m_tracks.end();)
+	{
+		if (time - it->second.Time > maxAge)
+		{
+			it = m_tracks.erase(it);
+			count++;
+		}
+		else
+			++it;
+	}
+	return count;
+}
+
+void Pyx::Math::MotionTracker::Update(uint64_t id, const Vector3& position, double time)
+{
+	auto it = m_tracks.find(id);
+	if (it == m_tracks.end())
+	{
+		m_tracks.emplace(id, Track{ position, Vector3(), Vector3(), time, 1 });
+		return;
+	}
+
+	auto& track = it->second;
+	float dt = static_cast<float>(time - track.Time);
+	if (dt <= 0.0f)
+	{
+		track.Position = position;
+		return;
+	}
+
+	// A gap longer than the extrapolation window or a jump further than the
+	// reset distance (teleport, respawn) restarts the track from scratch
+	Vector3 predicted = Predict(track, time);
+	Vector3 residual = position - predicted;
+	if ((m_maxExtrapolation > 0.0f && dt > m_maxExtrapolation) ||
+		(m_resetDistance > 0.0f && residual.LengthSquared() > m_resetDistance * m_resetDistance))
+	{
+		track = Track{ position, Vector3(), Vector3(), time, 1 };
+		return;
+	}
+
+	if (track.SampleCount == 1)
+	{
+		track.Velocity = (position - track.Position) * (1.0f / dt);
+		track.Acceleration = Vector3();
+		track.Position = position;
+	}
+	else
+	{
+		Vector3 predictedVelocity = track.Velocity + track.Acceleration * dt;
+		track.Position = predicted + residual * m_alpha;
+		track.Velocity = predictedVelocity + residual * (m_beta / dt);
+		track.Acceleration = track.Acceleration + residual * (2.0f * m_gamma / (dt * dt));
+	}
+	track.Time = time;
+	track.SampleCount++;
+}
+
+void Pyx::Math::MotionTracker::Update(const std::vector<uint64_t>& ids, const Vector3Array& positions, double time)
+{
+	const size_t size = (std::min)(ids.size(), positions.GetSize());
+	const float* pX = positions.GetX();
+	const float* pY = positions.GetY();
+	const float* pZ = positions.GetZ();
+	for (size_t i = 0; i < size; i++)
+	{
+		// Entries that couldn't be read are NaN and leave their track as is
+		if (pX[i] == pX[i])
+			Update(ids[i], Vector3(pX[i], pY[i], pZ[i]), time);
+	}
+}
+
+Pyx::Math::Vector3 Pyx::Math::MotionTracker::Predict(const Track& track, double time) const
+{
+	float dt = static_cast<float>(time - track.Time);
+	dt = (std::max)(dt, 0.0f);
+	if (m_maxExtrapolation > 0.0f)
+		dt = (std::min)(dt, m_maxExtrapolation);
+	return track.Position + track.Velocity * dt + track.Acceleration * (0.5f * dt * dt);
+}
+
+bool Pyx::Math::MotionTracker::PredictPosition(uint64_t id, double time, Vector3& position) const
+{
+	auto it = m_tracks.find(id);
+	if (it == m_tracks.end())
+		return false;
+	position = Predict(it->second, time);
+	return true;
+}
+
+void Pyx::Math::MotionTracker::PredictPositions(const std::vector<uint64_t>& ids, double time, Vector3Array& positions) const
+{
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	positions.Resize(ids.size());
+	for (size_t i = 0; i < ids.size(); i++)
+	{
+		auto it = m_tracks.find(ids[i]);
+		positions.Set(i, it != m_tracks.end() ? Predict(it->second, time) : Vector3(nan, nan, nan));
+	}
+}
+
+bool Pyx::Math::MotionTracker::TryGetVelocity(uint64_t id, Vector3& velocity) const
+{
+	auto it = m_tracks.find(id);
+	if (it == m_tracks.end())
+		return false;
+	velocity = it->second.Velocity;
+	return true;
+}
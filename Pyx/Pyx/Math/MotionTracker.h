@@ -0,0 +1,66 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Vector3.h>
+#include <Pyx/Math/Vector3Array.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		// Alpha-beta-gamma filter per entity id : positions sampled at a low
+		// rate refine a velocity and acceleration estimate, which is then used
+		// to extrapolate the position at any time between two samples.
+		class MotionTracker
+		{
+
+		private:
+			struct Track
+			{
+				Vector3 Position;
+				Vector3 Velocity;
+				Vector3 Acceleration;
+				double Time;
+				uint32_t SampleCount;
+			};
+
+		public:
+			static void BindWithScript(Pyx::Scripting::Script* pScript);
+			static double GetTime();
+
+		private:
+			float m_alpha;
+			float m_beta;
+			float m_gamma;
+			float m_maxExtrapolation;
+			float m_resetDistance;
+			std::unordered_map<uint64_t, Track> m_tracks;
+
+		private:
+			Vector3 Predict(const Track& track, double time) const;
+
+		public:
+			explicit MotionTracker(float alpha);
+			~MotionTracker();
+			float GetAlpha() const { return m_alpha; }
+			void SetAlpha(float alpha);
+			float GetMaxExtrapolation() const { return m_maxExtrapolation; }
+			void SetMaxExtrapolation(float seconds) { m_maxExtrapolation = seconds; }
+			float GetResetDistance() const { return m_resetDistance; }
+			void SetResetDistance(float distance) { m_resetDistance = distance; }
+			size_t GetSize() const { return m_tracks.size(); }
+			void Clear() { m_tracks.clear(); }
+			bool Remove(uint64_t id) { return m_tracks.erase(id) != 0; }
+			size_t RemoveStale(double time, float maxAge);
+			bool Contains(uint64_t id) const { return m_tracks.count(id) != 0; }
+			void Update(uint64_t id, const Vector3& position, double time);
+			void Update(const std::vector<uint64_t>& ids, const Vector3Array& positions, double time);
+			bool PredictPosition(uint64_t id, double time, Vector3& position) const;
+			void PredictPositions(const std::vector<uint64_t>& ids, double time, Vector3Array& positions) const;
+			bool TryGetVelocity(uint64_t id, Vector3& velocity) const;
+
+		};
+	}
+}
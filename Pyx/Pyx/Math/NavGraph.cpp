@@ -0,0 +1,219 @@
+#include <Pyx/Math/NavGraph.h>
+#include <Pyx/Math/PathfindingContext.h>
+#include <algorithm>
+#include <fstream>
+#ifndef _WIN32
+#include <codecvt>
+#include <locale>
+#endif
+
+namespace
+{
+	// MSVC streams take wide paths, other systems expect UTF-8
+#ifdef _WIN32
+	const std::wstring& GetStreamPath(const std::wstring& fileName)
+	{
+		return fileName;
+	}
+#else
+	std::string GetStreamPath(const std::wstring& fileName)
+	{
+		return std::wstring_convert<std::codecvt_utf8<wchar_t>>().to_bytes(fileName);
+	}
+#endif
+}
+
+void Pyx::Math::NavGraph::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+	using namespace LuaIntf;
+	LuaBinding(pScript->GetLuaState())
+		.beginModule("Pyx")
+		.beginModule("Math")
+		.beginClass<NavGraph>("NavGraph")
+		.addStaticFunction("Load", [](const std::wstring& fileName) { return NavGraph::Load(fileName); })
+		.addStaticFunction("FromWaypoints", [](const std::vector<Vector3>& positions, const std::vector<std::vector<uint32_t>>& links, bool isBidirectional)
+		{
+			std::vector<Link> graphLinks;
+			for (auto& link : links)
+			{
+				if (link.size() < 2 || link[0] < 1 || link[1] < 1 || link[0] > positions.size() || link[1] > positions.size())
+					continue;
+				uint32_t from = link[0] - 1;
+				uint32_t to = link[1] - 1;
+				float cost = static_cast<float>(positions[from].GetDistance3D(const_cast<Vector3&>(positions[to])));
+				graphLinks.push_back(Link{ from, to, cost, Portal() });
+				if (isBidirectional)
+					graphLinks.push_back(Link{ to, from, cost, Portal() });
+			}
+			return NavGraph::Build(positions, std::move(graphLinks), false);
+		}, LUA_ARGS(const std::vector<Vector3>&, const std::vector<std::vector<uint32_t>>&, _def<bool, true>))
+		.addPropertyReadOnly("NodeCount", &NavGraph::GetNodeCount)
+		.addPropertyReadOnly("EdgeCount", &NavGraph::GetEdgeCount)
+		.addPropertyReadOnly("HasPortals", &NavGraph::HasPortals)
+		.addFunction("Save", &NavGraph::Save)
+		.addFunction("GetNearestNode", [](const NavGraph* pGraph, const Vector3& position)
+		{
+			auto node = pGraph->GetNearestNode(position);
+			return node != InvalidNode ? node + 1 : 0;
+		})
+		.addFunction("GetNodePosition", [](const NavGraph* pGraph, uint32_t node)
+		{
+			return node >= 1 && node <= pGraph->GetNodeCount() ? pGraph->GetNode(node - 1).Position : Vector3();
+		})
+		.addFunction("FindPath", [](const NavGraph* pGraph, const Vector3& start, const Vector3& end, bool smooth)
+		{
+			std::vector<Vector3> path;
+			PathfindingContext::GetInstance().FindPath(*pGraph, start, end, smooth, path);
+			return path;
+		}, LUA_ARGS(const Vector3&, const Vector3&, _def<bool, true>))
+		.addFunction("FindPathAsync", [pScript](const NavGraph* pGraph, const Vector3& start, const Vector3& end, const std::wstring& eventName, bool smooth)
+		{
+			return PathfindingContext::GetInstance().FindPathAsync(pScript, pGraph->shared_from_this(), start, end, smooth, eventName);
+		}, LUA_ARGS(const Vector3&, const Vector3&, const std::wstring&, _def<bool, true>))
+		.addStaticFunction("CancelPath", [](size_t requestId) { PathfindingContext::GetInstance().Cancel(requestId); })
+		.endClass();
+}
+
+std::shared_ptr<Pyx::Math::NavGraph> Pyx::Math::NavGraph::Load(const std::wstring& fileName)
+{
+	std::ifstream file(GetStreamPath(fileName), std::ios::binary);
+	if (!file)
+		return nullptr;
+
+	FileHeader header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+		|| header.Magic != Magic || header.Version != Version)
+		return nullptr;
+
+	bool hasPortals = (header.Flags & static_cast<uint32_t>(FileFlags::HasPortals)) != 0;
+
+	// The counts are checked against what is left in the file before anything
+	// is allocated, so a corrupt header can't request gigabytes
+	const std::streamoff headerEnd = file.tellg();
+	file.seekg(0, std::ios::end);
+	const std::streamoff fileEnd = file.tellg();
+	file.seekg(headerEnd);
+	if (headerEnd < 0 || fileEnd < headerEnd)
+		return nullptr;
+
+	const uint64_t linkSize = sizeof(Link::From) + sizeof(Link::To) + sizeof(Link::Cost) + (hasPortals ? sizeof(Link::PortalSegment) : 0);
+	const uint64_t dataSize = static_cast<uint64_t>(header.NodeCount) * sizeof(Vector3) + static_cast<uint64_t>(header.EdgeCount) * linkSize;
+	if (dataSize > static_cast<uint64_t>(fileEnd - headerEnd))
+		return nullptr;
+
+	std::vector<Vector3> positions(header.NodeCount);
+	std::vector<Link> links(header.EdgeCount);
+
+	if (header.NodeCount > 0 && !file.read(reinterpret_cast<char*>(&positions[0]), positions.size() * sizeof(Vector3)))
+		return nullptr;
+
+	for (auto& link : links)
+	{
+		if (!file.read(reinterpret_cast<char*>(&link.From), sizeof(link.From))
+			|| !file.read(reinterpret_cast<char*>(&link.To), sizeof(link.To))
+			|| !file.read(reinterpret_cast<char*>(&link.Cost), sizeof(link.Cost)))
+			return nullptr;
+		if (hasPortals && !file.read(reinterpret_cast<char*>(&link.PortalSegment), sizeof(link.PortalSegment)))
+			return nullptr;
+	}
+
+	return Build(positions, std::move(links), hasPortals);
+}
+
+std::shared_ptr<Pyx::Math::NavGraph> Pyx::Math::NavGraph::Build(const std::vector<Vector3>& positions, std::vector<Link> links, bool hasPortals)
+{
+	auto pGraph = std::make_shared<NavGraph>();
+	const uint32_t nodeCount = static_cast<uint32_t>(positions.size());
+
+	links.erase(std::remove_if(links.begin(), links.end(), [nodeCount](const Link& link)
+	{
+		return link.From >= nodeCount || link.To >= nodeCount || !(link.Cost >= 0.0f);
+	}), links.end());
+	std::stable_sort(links.begin(), links.end(), [](const Link& a, const Link& b) { return a.From < b.From; });
+
+	pGraph->m_nodes.resize(nodeCount);
+	for (uint32_t i = 0; i < nodeCount; i++)
+		pGraph->m_nodes[i] = Node{ positions[i], 0, 0 };
+
+	pGraph->m_edges.reserve(links.size());
+	if (hasPortals)
+		pGraph->m_portals.reserve(links.size());
+
+	for (uint32_t i = 0; i < links.size(); i++)
+	{
+		const auto& link = links[i];
+		auto& node = pGraph->m_nodes[link.From];
+		if (node.EdgeCount == 0)
+			node.FirstEdge = i;
+		node.EdgeCount++;
+		pGraph->m_edges.push_back(Edge{ link.To, link.Cost });
+
+		if (hasPortals)
+		{
+			// The funnel expects portals seen from the polygon being left, with
+			// Left on the left hand side when walking towards the next polygon
+			Portal portal = link.PortalSegment;
+			const auto& from = node.Position;
+			float area = (portal.Right.X - from.X) * (portal.Left.Z - from.Z) - (portal.Left.X - from.X) * (portal.Right.Z - from.Z);
+			if (area < 0.0f)
+				std::swap(portal.Left, portal.Right);
+			pGraph->m_portals.push_back(portal);
+		}
+	}
+
+	pGraph->BuildNodeTree();
+	return pGraph;
+}
+
+Pyx::Math::NavGraph::NavGraph()
+{
+}
+
+Pyx::Math::NavGraph::~NavGraph()
+{
+}
+
+void Pyx::Math::NavGraph::BuildNodeTree()
+{
+	std::vector<Vector3> positions;
+	positions.reserve(m_nodes.size());
+	for (auto& node : m_nodes)
+		positions.push_back(node.Position);
+	m_nodeTree.Build(positions);
+}
+
+bool Pyx::Math::NavGraph::Save(const std::wstring& fileName) const
+{
+	std::ofstream file(GetStreamPath(fileName), std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+
+	FileHeader header = { Magic, Version, static_cast<uint32_t>(m_nodes.size()), static_cast<uint32_t>(m_edges.size()),
+		HasPortals() ? static_cast<uint32_t>(FileFlags::HasPortals) : 0u, 0 };
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	for (auto& node : m_nodes)
+		file.write(reinterpret_cast<const char*>(&node.Position), sizeof(node.Position));
+
+	for (uint32_t from = 0; from < m_nodes.size(); from++)
+	{
+		const auto& node = m_nodes[from];
+		for (uint32_t i = node.FirstEdge; i < node.FirstEdge + node.EdgeCount; i++)
+		{
+			file.write(reinterpret_cast<const char*>(&from), sizeof(from));
+			file.write(reinterpret_cast<const char*>(&m_edges[i].Target), sizeof(m_edges[i].Target));
+			file.write(reinterpret_cast<const char*>(&m_edges[i].Cost), sizeof(m_edges[i].Cost));
+			if (HasPortals())
+				file.write(reinterpret_cast<const char*>(&m_portals[i]), sizeof(m_portals[i]));
+		}
+	}
+
+	return file.good();
+}
+
+uint32_t Pyx::Math::NavGraph::GetNearestNode(const Vector3& position) const
+{
+	std::vector<uint32_t> nearest;
+	m_nodeTree.FindNearest(position, 1, false, nearest);
+	return nearest.empty() ? InvalidNode : nearest[0];
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Vector3.h>
+#include <Pyx/Math/KdTree.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		// Immutable navigation graph. Nodes are either waypoints or navmesh
+		// polygons (positioned at their centroid), in which case every edge also
+		// carries the portal segment shared by the two polygons.
+		class NavGraph : public std::enable_shared_from_this<NavGraph>
+		{
+
+		public:
+			static const uint32_t Magic = 0x4E585950; // "PYXN"
+			static const uint32_t Version = 1;
+			static const uint32_t InvalidNode = 0xFFFFFFFF;
+
+			enum class FileFlags : uint32_t
+			{
+				HasPortals = 1 << 0
+			};
+
+#pragma pack(push, 1)
+			struct FileHeader
+			{
+				uint32_t Magic;
+				uint32_t Version;
+				uint32_t NodeCount;
+				uint32_t EdgeCount;
+				uint32_t Flags;
+				uint32_t Reserved;
+			};
+#pragma pack(pop)
+
+			struct Node
+			{
+				Vector3 Position;
+				uint32_t FirstEdge;
+				uint32_t EdgeCount;
+			};
+
+			struct Edge
+			{
+				uint32_t Target;
+				float Cost;
+			};
+
+			struct Portal
+			{
+				Vector3 Left;
+				Vector3 Right;
+			};
+
+			struct Link
+			{
+				uint32_t From;
+				uint32_t To;
+				float Cost;
+				Portal PortalSegment;
+			};
+
+		public:
+			static void BindWithScript(Pyx::Scripting::Script* pScript);
+			static std::shared_ptr<NavGraph> Load(const std::wstring& fileName);
+			static std::shared_ptr<NavGraph> Build(const std::vector<Vector3>& positions, std::vector<Link> links, bool hasPortals);
+
+		private:
+			std::vector<Node> m_nodes;
+			std::vector<Edge> m_edges;
+			std::vector<Portal> m_portals;
+			KdTree m_nodeTree;
+
+		private:
+			void BuildNodeTree();
+
+		public:
+			explicit NavGraph();
+			~NavGraph();
+			bool Save(const std::wstring& fileName) const;
+			size_t GetNodeCount() const { return m_nodes.size(); }
+			size_t GetEdgeCount() const { return m_edges.size(); }
+			bool HasPortals() const { return !m_portals.empty(); }
+			const Node& GetNode(uint32_t index) const { return m_nodes[index]; }
+			const Edge& GetEdge(uint32_t index) const { return m_edges[index]; }
+			const Portal& GetPortal(uint32_t edgeIndex) const { return m_portals[edgeIndex]; }
+			uint32_t GetNearestNode(const Vector3& position) const;
+
+		};
+	}
+}
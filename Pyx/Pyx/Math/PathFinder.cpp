@@ -0,0 +1,222 @@
+#include <Pyx/Math/PathFinder.h>
+#include <algorithm>
+
+namespace
+{
+	float TriangleArea2D(const Pyx::Math::Vector3& a, const Pyx::Math::Vector3& b, const Pyx::Math::Vector3& c)
+	{
+		return (c.X - a.X) * (b.Z - a.Z) - (b.X - a.X) * (c.Z - a.Z);
+	}
+
+	float GetDistance(const Pyx::Math::Vector3& a, const Pyx::Math::Vector3& b)
+	{
+		float dx = a.X - b.X;
+		float dy = a.Y - b.Y;
+		float dz = a.Z - b.Z;
+		return sqrtf(dx * dx + dy * dy + dz * dz);
+	}
+
+	bool IsSamePoint(const Pyx::Math::Vector3& a, const Pyx::Math::Vector3& b)
+	{
+		float dx = a.X - b.X;
+		float dz = a.Z - b.Z;
+		return dx * dx + dz * dz < 1e-6f;
+	}
+}
+
+Pyx::Math::PathFinder::PathFinder()
+	: m_generation(0)
+{
+}
+
+Pyx::Math::PathFinder::~PathFinder()
+{
+}
+
+Pyx::Math::PathFinder::NodeState& Pyx::Math::PathFinder::GetState(uint32_t node)
+{
+	auto& state = m_states[node];
+	if (state.Generation != m_generation)
+	{
+		state.Cost = INFINITY;
+		state.Parent = NavGraph::InvalidNode;
+		state.ParentEdge = NavGraph::InvalidNode;
+		state.Generation = m_generation;
+		state.IsClosed = false;
+	}
+	return state;
+}
+
+bool Pyx::Math::PathFinder::Search(const NavGraph& graph, uint32_t startNode, uint32_t endNode)
+{
+	if (m_states.size() < graph.GetNodeCount())
+	{
+		m_states.assign(graph.GetNodeCount(), NodeState{ 0.0f, 0, 0, 0, false });
+		m_generation = 0;
+	}
+
+	// Generation 0 marks never used slots, skip it when the counter wraps
+	if (++m_generation == 0)
+	{
+		for (auto& state : m_states)
+			state.Generation = 0;
+		m_generation = 1;
+	}
+
+	const Vector3& goal = graph.GetNode(endNode).Position;
+	m_open.clear();
+	GetState(startNode).Cost = 0.0f;
+	m_open.push_back(OpenEntry{ GetDistance(graph.GetNode(startNode).Position, goal), startNode });
+
+	while (!m_open.empty())
+	{
+		std::pop_heap(m_open.begin(), m_open.end());
+		OpenEntry current = m_open.back();
+		m_open.pop_back();
+
+		// Nodes are pushed again instead of being decreased in place, so stale
+		// entries for already expanded nodes are skipped here
+		auto& currentState = GetState(current.Node);
+		if (currentState.IsClosed)
+			continue;
+		currentState.IsClosed = true;
+
+		if (current.Node == endNode)
+			break;
+
+		const auto& node = graph.GetNode(current.Node);
+		for (uint32_t i = node.FirstEdge; i < node.FirstEdge + node.EdgeCount; i++)
+		{
+			const auto& edge = graph.GetEdge(i);
+			auto& targetState = GetState(edge.Target);
+			float cost = currentState.Cost + edge.Cost;
+			if (targetState.IsClosed || cost >= targetState.Cost)
+				continue;
+
+			targetState.Cost = cost;
+			targetState.Parent = current.Node;
+			targetState.ParentEdge = i;
+			m_open.push_back(OpenEntry{ cost + GetDistance(graph.GetNode(edge.Target).Position, goal), edge.Target });
+			std::push_heap(m_open.begin(), m_open.end());
+		}
+	}
+
+	if (!GetState(endNode).IsClosed)
+		return false;
+
+	m_nodes.clear();
+	m_edges.clear();
+	for (uint32_t node = endNode; node != NavGraph::InvalidNode; node = m_states[node].Parent)
+	{
+		m_nodes.push_back(node);
+		if (m_states[node].ParentEdge != NavGraph::InvalidNode)
+			m_edges.push_back(m_states[node].ParentEdge);
+	}
+	std::reverse(m_nodes.begin(), m_nodes.end());
+	std::reverse(m_edges.begin(), m_edges.end());
+	return true;
+}
+
+bool Pyx::Math::PathFinder::FindPath(const NavGraph& graph, const Vector3& start, const Vector3& end, bool smooth, std::vector<Vector3>& path)
+{
+	path.clear();
+
+	uint32_t startNode = graph.GetNearestNode(start);
+	uint32_t endNode = graph.GetNearestNode(end);
+	if (startNode == NavGraph::InvalidNode || endNode == NavGraph::InvalidNode || !Search(graph, startNode, endNode))
+		return false;
+
+	if (!graph.HasPortals())
+	{
+		path.push_back(start);
+		for (auto node : m_nodes)
+			path.push_back(graph.GetNode(node).Position);
+		path.push_back(end);
+		return true;
+	}
+
+	if (!smooth)
+	{
+		path.push_back(start);
+		for (auto edge : m_edges)
+		{
+			const auto& portal = graph.GetPortal(edge);
+			path.push_back((portal.Left + portal.Right) * 0.5f);
+		}
+		path.push_back(end);
+		return true;
+	}
+
+	std::vector<NavGraph::Portal> portals;
+	portals.reserve(m_edges.size() + 2);
+	portals.push_back(NavGraph::Portal{ start, start });
+	for (auto edge : m_edges)
+		portals.push_back(graph.GetPortal(edge));
+	portals.push_back(NavGraph::Portal{ end, end });
+	StringPull(portals, path);
+	return true;
+}
+
+void Pyx::Math::PathFinder::StringPull(const std::vector<NavGraph::Portal>& portals, std::vector<Vector3>& path)
+{
+	// Simple stupid funnel algorithm on the XZ plane, the funnel is narrowed
+	// portal after portal and a corner is emitted each time its sides cross
+	Vector3 apex = portals[0].Left;
+	Vector3 left = portals[0].Left;
+	Vector3 right = portals[0].Right;
+	size_t apexIndex = 0;
+	size_t leftIndex = 0;
+	size_t rightIndex = 0;
+
+	path.push_back(apex);
+
+	for (size_t i = 1; i < portals.size(); i++)
+	{
+		const auto& portalLeft = portals[i].Left;
+		const auto& portalRight = portals[i].Right;
+
+		if (TriangleArea2D(apex, right, portalRight) <= 0.0f)
+		{
+			if (IsSamePoint(apex, right) || TriangleArea2D(apex, left, portalRight) > 0.0f)
+			{
+				right = portalRight;
+				rightIndex = i;
+			}
+			else
+			{
+				apex = left;
+				apexIndex = leftIndex;
+				if (!IsSamePoint(path.back(), apex))
+					path.push_back(apex);
+				right = left = apex;
+				rightIndex = leftIndex = apexIndex;
+				i = apexIndex;
+				continue;
+			}
+		}
+
+		if (TriangleArea2D(apex, left, portalLeft) >= 0.0f)
+		{
+			if (IsSamePoint(apex, left) || TriangleArea2D(apex, right, portalLeft) < 0.0f)
+			{
+				left = portalLeft;
+				leftIndex = i;
+			}
+			else
+			{
+				apex = right;
+				apexIndex = rightIndex;
+				if (!IsSamePoint(path.back(), apex))
+					path.push_back(apex);
+				right = left = apex;
+				rightIndex = leftIndex = apexIndex;
+				i = apexIndex;
+				continue;
+			}
+		}
+	}
+
+	const auto& end = portals.back().Left;
+	if (!IsSamePoint(path.back(), end))
+		path.push_back(end);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <Pyx/Math/NavGraph.h>
+#include <cstdint>
+#include <vector>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		// A* search state for one thread. The per node arena is reused between
+		// searches and tagged with a generation so it never has to be cleared.
+		// Edge costs are expected to be at least the distance between their
+		// nodes, otherwise the straight line heuristic may miss the best path.
+		class PathFinder
+		{
+
+		private:
+			struct NodeState
+			{
+				float Cost;
+				uint32_t Parent;
+				uint32_t ParentEdge;
+				uint32_t Generation;
+				bool IsClosed;
+			};
+
+			struct OpenEntry
+			{
+				float Score;
+				uint32_t Node;
+				bool operator<(const OpenEntry& rhs) const { return Score > rhs.Score; }
+			};
+
+		private:
+			static void StringPull(const std::vector<NavGraph::Portal>& portals, std::vector<Vector3>& path);
+
+		private:
+			std::vector<NodeState> m_states;
+			std::vector<OpenEntry> m_open;
+			std::vector<uint32_t> m_nodes;
+			std::vector<uint32_t> m_edges;
+			uint32_t m_generation;
+
+		private:
+			NodeState& GetState(uint32_t node);
+			bool Search(const NavGraph& graph, uint32_t startNode, uint32_t endNode);
+
+		public:
+			explicit PathFinder();
+			~PathFinder();
+			bool FindPath(const NavGraph& graph, const Vector3& start, const Vector3& end, bool smooth, std::vector<Vector3>& path);
+
+		};
+	}
+}
@@ -0,0 +1,156 @@
+#include <Pyx/Math/PathfindingContext.h>
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Threading/JobSystem.h>
+#include <algorithm>
+
+Pyx::Math::PathfindingContext& Pyx::Math::PathfindingContext::GetInstance()
+{
+	static PathfindingContext instance;
+	return instance;
+}
+
+Pyx::Math::PathfindingContext::PathfindingContext()
+	: m_nextRequestId(1)
+{
+}
+
+Pyx::Math::PathfindingContext::~PathfindingContext()
+{
+}
+
+void Pyx::Math::PathfindingContext::Shutdown()
+{
+	// Called once the JobSystem is stopped, no request can still be running
+	std::lock_guard<std::mutex> requestsLock(m_requestsMutex);
+	std::lock_guard<std::mutex> resultsLock(m_resultsMutex);
+	m_requests.clear();
+	m_results.clear();
+}
+
+bool Pyx::Math::PathfindingContext::FindPath(const NavGraph& graph, const Vector3& start, const Vector3& end, bool smooth, std::vector<Vector3>& path)
+{
+	// Called from both the pulse and the render thread
+	std::lock_guard<std::mutex> lock(m_pathFinderMutex);
+	return m_pathFinder.FindPath(graph, start, end, smooth, path);
+}
+
+size_t Pyx::Math::PathfindingContext::FindPathAsync(Scripting::Script* pScript, const std::shared_ptr<const NavGraph>& pGraph, const Vector3& start, const Vector3& end, bool smooth, const std::wstring& eventName)
+{
+	// Jobs scheduled once the JobSystem is stopped run on the calling thread
+	if (!pGraph || !Threading::JobSystem::GetInstance().IsRunning())
+		return 0;
+
+	size_t id;
+	{
+		std::lock_guard<std::mutex> lock(m_requestsMutex);
+		id = m_nextRequestId++;
+		m_requests.push_back(Request{ id, pScript });
+	}
+
+	Threading::JobSystem::GetInstance().Schedule([this, id, pScript, pGraph, start, end, smooth, eventName]()
+	{
+		RunRequest(id, pScript, pGraph, start, end, smooth, eventName);
+	});
+	return id;
+}
+
+void Pyx::Math::PathfindingContext::Cancel(size_t requestId)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_requestsMutex);
+		m_requests.erase(std::remove_if(m_requests.begin(), m_requests.end(),
+			[requestId](const Request& request) { return request.Id == requestId; }), m_requests.end());
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_resultsMutex);
+		m_results.erase(std::remove_if(m_results.begin(), m_results.end(),
+			[requestId](const Result& result) { return result.Id == requestId; }), m_results.end());
+	}
+}
+
+void Pyx::Math::PathfindingContext::CancelAll(Scripting::Script* pScript)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_requestsMutex);
+		m_requests.erase(std::remove_if(m_requests.begin(), m_requests.end(),
+			[pScript](const Request& request) { return request.pScript == pScript; }), m_requests.end());
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_resultsMutex);
+		m_results.erase(std::remove_if(m_results.begin(), m_results.end(),
+			[pScript](const Result& result) { return result.pScript == pScript; }), m_results.end());
+	}
+}
+
+void Pyx::Math::PathfindingContext::DispatchCompletedPaths()
+{
+	// Called from the render thread, the results of the scripts busy with a
+	// pulse stay queued for the next frame
+	Scripting::ScriptLockSet scriptLocks;
+	std::vector<Result> results;
+	{
+		std::lock_guard<std::mutex> lock(m_resultsMutex);
+		if (m_results.empty())
+			return;
+
+		std::vector<Result> busyResults;
+		for (auto& result : m_results)
+		{
+			if (scriptLocks.TryLock(result.pScript))
+				results.push_back(std::move(result));
+			else
+				busyResults.push_back(std::move(result));
+		}
+		m_results.swap(busyResults);
+	}
+
+	for (auto& result : results)
+	{
+		if (result.pScript->IsRunning())
+			result.pScript->FireCallback(result.EventName, result.Id, result.IsFound, result.Path);
+	}
+}
+
+bool Pyx::Math::PathfindingContext::IsPending(size_t requestId)
+{
+	std::lock_guard<std::mutex> lock(m_requestsMutex);
+	return std::any_of(m_requests.begin(), m_requests.end(), [requestId](const Request& request) { return request.Id == requestId; });
+}
+
+void Pyx::Math::PathfindingContext::RunRequest(size_t requestId, Scripting::Script* pScript, const std::shared_ptr<const NavGraph>& pGraph, const Vector3& start, const Vector3& end, bool smooth, const std::wstring& eventName)
+{
+	// Requests cancelled while they were queued aren't computed
+	if (!IsPending(requestId))
+		return;
+
+	std::unique_ptr<PathFinder> pPathFinder;
+	{
+		std::lock_guard<std::mutex> lock(m_pathFinderPoolMutex);
+		if (!m_pathFinderPool.empty())
+		{
+			pPathFinder = std::move(m_pathFinderPool.back());
+			m_pathFinderPool.pop_back();
+		}
+	}
+	if (!pPathFinder)
+		pPathFinder.reset(new PathFinder());
+
+	Result result{ requestId, pScript, eventName, false, {} };
+	result.IsFound = pPathFinder->FindPath(*pGraph, start, end, smooth, result.Path);
+
+	{
+		std::lock_guard<std::mutex> lock(m_pathFinderPoolMutex);
+		m_pathFinderPool.push_back(std::move(pPathFinder));
+	}
+
+	// Cancellation of the request being computed is checked once it is done,
+	// the search itself is short enough not to be interrupted
+	std::lock_guard<std::mutex> lock(m_requestsMutex);
+	auto it = std::find_if(m_requests.begin(), m_requests.end(), [requestId](const Request& request) { return request.Id == requestId; });
+	if (it == m_requests.end())
+		return;
+	m_requests.erase(it);
+
+	std::lock_guard<std::mutex> resultsLock(m_resultsMutex);
+	m_results.push_back(std::move(result));
+}
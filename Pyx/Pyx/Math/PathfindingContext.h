@@ -0,0 +1,70 @@
+#pragma once
+#include <Pyx/Math/NavGraph.h>
+#include <Pyx/Math/PathFinder.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Pyx
+{
+	class PyxContext;
+	namespace Scripting
+	{
+		class Script;
+	}
+	namespace Math
+	{
+		// Runs the path queries of the scripts. Synchronous queries share one
+		// path finder, asynchronous ones are jobs of the JobSystem which take a
+		// path finder from a pool so that several can run at the same time.
+		class PathfindingContext
+		{
+
+		private:
+			struct Request
+			{
+				size_t Id;
+				Scripting::Script* pScript;
+			};
+
+			struct Result
+			{
+				size_t Id;
+				Scripting::Script* pScript;
+				std::wstring EventName;
+				bool IsFound;
+				std::vector<Vector3> Path;
+			};
+
+		public:
+			static PathfindingContext& GetInstance();
+
+		private:
+			std::mutex m_requestsMutex;
+			std::mutex m_resultsMutex;
+			std::vector<Request> m_requests;
+			std::vector<Result> m_results;
+			size_t m_nextRequestId;
+			std::mutex m_pathFinderMutex;
+			PathFinder m_pathFinder;
+			std::mutex m_pathFinderPoolMutex;
+			std::vector<std::unique_ptr<PathFinder>> m_pathFinderPool;
+
+		private:
+			bool IsPending(size_t requestId);
+			void RunRequest(size_t requestId, Scripting::Script* pScript, const std::shared_ptr<const NavGraph>& pGraph, const Vector3& start, const Vector3& end, bool smooth, const std::wstring& eventName);
+
+		public:
+			explicit PathfindingContext();
+			~PathfindingContext();
+			void Shutdown();
+			bool FindPath(const NavGraph& graph, const Vector3& start, const Vector3& end, bool smooth, std::vector<Vector3>& path);
+			size_t FindPathAsync(Scripting::Script* pScript, const std::shared_ptr<const NavGraph>& pGraph, const Vector3& start, const Vector3& end, bool smooth, const std::wstring& eventName);
+			void Cancel(size_t requestId);
+			void CancelAll(Scripting::Script* pScript);
+			void DispatchCompletedPaths();
+
+		};
+	}
+}
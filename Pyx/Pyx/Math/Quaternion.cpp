@@ -0,0 +1,170 @@
+#include <Pyx/Math/Quaternion.h>
+#include <sstream>
+
+void Pyx::Math::Quaternion::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+	using namespace LuaIntf;
+	LuaBinding(pScript->GetLuaState())
+		.beginModule("Pyx")
+		.beginModule("Math")
+		.beginClass<Quaternion>("Quaternion")
+		.addConstructor(LUA_ARGS(_def<float, 0>, _def<float, 0>, _def<float, 0>, _def<float, 1>))
+		.addStaticFunction("Identity", &Quaternion::Identity)
+		.addStaticFunction("FromAxisAngle", &Quaternion::FromAxisAngle)
+		.addStaticFunction("FromYawPitchRoll", &Quaternion::FromYawPitchRoll)
+		.addStaticFunction("LookRotation", &Quaternion::LookRotation)
+		.addStaticFunction("Dot", &Quaternion::Dot)
+		.addStaticFunction("Slerp", &Quaternion::Slerp)
+		.addVariable("X", &Quaternion::X)
+		.addVariable("Y", &Quaternion::Y)
+		.addVariable("Z", &Quaternion::Z)
+		.addVariable("W", &Quaternion::W)
+		.addPropertyReadOnly("Length", &Quaternion::Length)
+		.addPropertyReadOnly("Yaw", &Quaternion::GetYaw)
+		.addFunction("Normalized", &Quaternion::Normalized)
+		.addFunction("Normalize", &Quaternion::Normalize)
+		.addFunction("Conjugate", &Quaternion::Conjugate)
+		.addFunction("Inverted", &Quaternion::Inverted)
+		.addFunction("Rotate", &Quaternion::Rotate)
+		.addFunction("__mul", [](const Quaternion* a, const Quaternion& b) { return *a * b; })
+		.addFunction("__eq", [](const Quaternion* a, const Quaternion& b) { return *a == b; })
+		.addFunction("__tostring", &Quaternion::ToString)
+		.endClass();
+}
+
+Pyx::Math::Quaternion Pyx::Math::Quaternion::FromAxisAngle(const Vector3& axis, float radians)
+{
+	Vector3 n = axis.Normalized();
+	float s = sinf(radians * 0.5f);
+	return Quaternion(n.X * s, n.Y * s, n.Z * s, cosf(radians * 0.5f));
+}
+
+Pyx::Math::Quaternion Pyx::Math::Quaternion::FromYawPitchRoll(float yaw, float pitch, float roll)
+{
+	// Yaw around Y, pitch around X, roll around Z, same order as Direct3D
+	float cy = cosf(yaw * 0.5f), sy = sinf(yaw * 0.5f);
+	float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+	float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+	return Quaternion(
+		cy * sp * cr + sy * cp * sr,
+		sy * cp * cr - cy * sp * sr,
+		cy * cp * sr - sy * sp * cr,
+		cy * cp * cr + sy * sp * sr);
+}
+
+Pyx::Math::Quaternion Pyx::Math::Quaternion::LookRotation(const Vector3& forward, const Vector3& up)
+{
+	Vector3 f = forward.Normalized();
+	Vector3 r = Vector3::Cross(up, f).Normalized();
+	Vector3 u = Vector3::Cross(f, r);
+
+	float trace = r.X + u.Y + f.Z;
+	if (trace > 0.0f)
+	{
+		float s = 0.5f / sqrtf(trace + 1.0f);
+		return Quaternion((u.Z - f.Y) * s, (f.X - r.Z) * s, (r.Y - u.X) * s, 0.25f / s);
+	}
+	if (r.X > u.Y && r.X > f.Z)
+	{
+		float s = 2.0f * sqrtf(1.0f + r.X - u.Y - f.Z);
+		return Quaternion(0.25f * s, (u.X + r.Y) / s, (f.X + r.Z) / s, (u.Z - f.Y) / s);
+	}
+	if (u.Y > f.Z)
+	{
+		float s = 2.0f * sqrtf(1.0f + u.Y - r.X - f.Z);
+		return Quaternion((u.X + r.Y) / s, 0.25f * s, (f.Y + u.Z) / s, (f.X - r.Z) / s);
+	}
+	float s = 2.0f * sqrtf(1.0f + f.Z - r.X - u.Y);
+	return Quaternion((f.X + r.Z) / s, (f.Y + u.Z) / s, 0.25f * s, (r.Y - u.X) / s);
+}
+
+float Pyx::Math::Quaternion::Dot(const Quaternion& a, const Quaternion& b)
+{
+#if PYX_MATH_SSE
+	__m128 m = _mm_mul_ps(_mm_loadu_ps(&a.X), _mm_loadu_ps(&b.X));
+	__m128 s = _mm_add_ps(m, _mm_movehl_ps(m, m));
+	s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(s);
+#else
+	return a.X * b.X + a.Y * b.Y + a.Z * b.Z + a.W * b.W;
+#endif
+}
+
+Pyx::Math::Quaternion Pyx::Math::Quaternion::Slerp(const Quaternion& from, const Quaternion& to, float amount)
+{
+	float cosTheta = Dot(from, to);
+	Quaternion target = to;
+	if (cosTheta < 0.0f)
+	{
+		cosTheta = -cosTheta;
+		target = Quaternion(-to.X, -to.Y, -to.Z, -to.W);
+	}
+
+	float a, b;
+	if (cosTheta > 1.0f - Epsilon)
+	{
+		a = 1.0f - amount;
+		b = amount;
+	}
+	else
+	{
+		float theta = acosf(cosTheta);
+		float invSin = 1.0f / sinf(theta);
+		a = sinf((1.0f - amount) * theta) * invSin;
+		b = sinf(amount * theta) * invSin;
+	}
+
+	return Quaternion(
+		a * from.X + b * target.X,
+		a * from.Y + b * target.Y,
+		a * from.Z + b * target.Z,
+		a * from.W + b * target.W).Normalized();
+}
+
+Pyx::Math::Quaternion Pyx::Math::Quaternion::Normalized() const
+{
+	float length = Length();
+	if (length < Epsilon)
+		return Identity();
+	float inv = 1.0f / length;
+	return Quaternion(X * inv, Y * inv, Z * inv, W * inv);
+}
+
+Pyx::Math::Quaternion Pyx::Math::Quaternion::Inverted() const
+{
+	float lengthSquared = Dot(*this, *this);
+	if (lengthSquared < Epsilon)
+		return Identity();
+	float inv = 1.0f / lengthSquared;
+	return Quaternion(-X * inv, -Y * inv, -Z * inv, W * inv);
+}
+
+Pyx::Math::Vector3 Pyx::Math::Quaternion::Rotate(const Vector3& v) const
+{
+	// v' = v + 2w(q x v) + 2(q x (q x v))
+	Vector3 q(X, Y, Z);
+	Vector3 t = Vector3::Cross(q, v) * 2.0f;
+	return v + t * W + Vector3::Cross(q, t);
+}
+
+float Pyx::Math::Quaternion::GetYaw() const
+{
+	return atan2f(2.0f * (W * Y + X * Z), 1.0f - 2.0f * (X * X + Y * Y));
+}
+
+Pyx::Math::Quaternion Pyx::Math::Quaternion::operator*(const Quaternion& q) const
+{
+	// Same convention as Direct3D : a * b applies a then b
+	return Quaternion(
+		q.W * X + q.X * W + q.Y * Z - q.Z * Y,
+		q.W * Y - q.X * Z + q.Y * W + q.Z * X,
+		q.W * Z + q.X * Y - q.Y * X + q.Z * W,
+		q.W * W - q.X * X - q.Y * Y - q.Z * Z);
+}
+
+std::string Pyx::Math::Quaternion::ToString() const
+{
+	std::stringstream ss;
+	ss << X << ", " << Y << ", " << Z << ", " << W;
+	return ss.str();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Simd.h>
+#include <Pyx/Math/Vector3.h>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		struct PYX_MATH_ALIGN Quaternion
+		{
+
+		public:
+			float X, Y, Z, W;
+
+		public:
+			static void BindWithScript(Pyx::Scripting::Script* pScript);
+			static Quaternion Identity() { return Quaternion(0.0f, 0.0f, 0.0f, 1.0f); }
+			static Quaternion FromAxisAngle(const Vector3& axis, float radians);
+			static Quaternion FromYawPitchRoll(float yaw, float pitch, float roll);
+			static Quaternion LookRotation(const Vector3& forward, const Vector3& up);
+			static float Dot(const Quaternion& a, const Quaternion& b);
+			static Quaternion Slerp(const Quaternion& from, const Quaternion& to, float amount);
+
+		public:
+			constexpr Quaternion() : X(0.0f), Y(0.0f), Z(0.0f), W(1.0f) { }
+			constexpr Quaternion(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) { }
+			float Length() const { return sqrtf(Dot(*this, *this)); }
+			Quaternion Normalized() const;
+			void Normalize() { *this = Normalized(); }
+			Quaternion Conjugate() const { return Quaternion(-X, -Y, -Z, W); }
+			Quaternion Inverted() const;
+			Vector3 Rotate(const Vector3& v) const;
+			float GetYaw() const;
+			Quaternion operator*(const Quaternion& q) const;
+			Quaternion& operator*=(const Quaternion& q) { return *this = *this * q; }
+			bool operator==(const Quaternion& rhs) const { return X == rhs.X && Y == rhs.Y && Z == rhs.Z && W == rhs.W; }
+			bool operator!=(const Quaternion& rhs) const { return !operator==(rhs); }
+			std::string ToString() const;
+
+		};
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cmath>
+
+// SSE is part of every x64 target and of x86 builds using /arch:SSE or higher,
+// anything else falls back to the plain scalar code paths.
+#if !defined(PYX_MATH_NO_SIMD) && (defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__))
+#define PYX_MATH_SSE 1
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#else
+#define PYX_MATH_SSE 0
+#endif
+
+// AVX2 is only used by the batch kernels and has to be enabled explicitly
+// with /arch:AVX2, the default build keeps running on any SSE2 capable CPU.
+#if PYX_MATH_SSE && defined(__AVX2__)
+#define PYX_MATH_AVX2 1
+#include <immintrin.h>
+#else
+#define PYX_MATH_AVX2 0
+#endif
+
+// Math types are 16 bytes aligned when used natively, but Lua userdata only
+// guarantees 8 bytes on x86, so every SSE load/store below is unaligned.
+#define PYX_MATH_ALIGN alignas(16)
+
+namespace Pyx
+{
+	namespace Math
+	{
+		const float Pi = 3.14159265358979323846f;
+		const float Epsilon = 1e-6f;
+
+		inline float ToRadians(float degrees) { return degrees * (Pi / 180.0f); }
+		inline float ToDegrees(float radians) { return radians * (180.0f / Pi); }
+	}
+}
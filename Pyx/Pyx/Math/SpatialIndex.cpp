@@ -0,0 +1,445 @@
+#include <Pyx/Math/SpatialIndex.h>
+#include <algorithm>
+#include <cmath>
+
+void Pyx::Math::SpatialIndex::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+	using namespace LuaIntf;
+	LuaBinding(pScript->GetLuaState())
+		.beginModule("Pyx")
+		.beginModule("Math")
+		.beginClass<SpatialIndex>("SpatialIndex")
+		.addConstructor(LUA_SP(std::shared_ptr<SpatialIndex>), LUA_ARGS(float, _def<bool, false>))
+		.addStaticFunction("Share", [pScript](const std::string& name, const std::shared_ptr<SpatialIndex>& pIndex)
+		{
+			Share(pScript, name, pIndex);
+		})
+		.addStaticFunction("GetShared", &SpatialIndex::GetShared)
+		.addStaticFunction("Unshare", &SpatialIndex::Unshare)
+		.addPropertyReadOnly("CellSize", &SpatialIndex::GetCellSize)
+		.addPropertyReadOnly("IsUsingKdTree", &SpatialIndex::IsUsingKdTree)
+		.addPropertyReadOnly("Version", &SpatialIndex::GetVersion)
+		.addPropertyReadOnly("Size", &SpatialIndex::GetSize)
+		.addFunction("Clear", &SpatialIndex::Clear)
+		.addFunction("Rebuild", &SpatialIndex::Rebuild, LUA_ARGS(const Vector3Array&, _opt<std::vector<uint64_t>>))
+		.addFunction("Update", &SpatialIndex::Update)
+		.addFunction("Remove", &SpatialIndex::Remove)
+		.addFunction("Contains", &SpatialIndex::Contains)
+		.addFunction("TryGetPosition", &SpatialIndex::TryGetPosition, LUA_ARGS(uint64_t, _out<Vector3&>))
+		.addFunction("QueryRadius", &SpatialIndex::QueryRadius, LUA_ARGS(const Vector3&, float, _def<bool, false>))
+		.addFunction("QueryNearest", &SpatialIndex::QueryNearest, LUA_ARGS(const Vector3&, _def<size_t, 1>, _def<bool, false>, _def<float, 0>))
+		.addFunction("QueryBox", &SpatialIndex::QueryBox)
+		.addFunction("QueryCone", &SpatialIndex::QueryCone, LUA_ARGS(const Vector3&, const Vector3&, float, float, _def<bool, false>))
+		.endClass();
+}
+
+Pyx::Math::SpatialIndex::SharedIndexes& Pyx::Math::SpatialIndex::GetSharedIndexes()
+{
+	static SharedIndexes sharedIndexes;
+	return sharedIndexes;
+}
+
+void Pyx::Math::SpatialIndex::Share(Pyx::Scripting::Script* pOwner, const std::string& name, const std::shared_ptr<SpatialIndex>& pIndex)
+{
+	if (!pIndex)
+	{
+		Unshare(name);
+		return;
+	}
+
+	auto& sharedIndexes = GetSharedIndexes();
+	std::lock_guard<std::mutex> lock(sharedIndexes.Mutex);
+	sharedIndexes.Indexes[name] = SharedIndex{ pOwner, pIndex };
+}
+
+std::shared_ptr<const Pyx::Math::SpatialIndex> Pyx::Math::SpatialIndex::GetShared(const std::string& name)
+{
+	auto& sharedIndexes = GetSharedIndexes();
+	std::lock_guard<std::mutex> lock(sharedIndexes.Mutex);
+	auto it = sharedIndexes.Indexes.find(name);
+	return it != sharedIndexes.Indexes.end() ? it->second.pIndex : nullptr;
+}
+
+void Pyx::Math::SpatialIndex::Unshare(const std::string& name)
+{
+	auto& sharedIndexes = GetSharedIndexes();
+	std::lock_guard<std::mutex> lock(sharedIndexes.Mutex);
+	sharedIndexes.Indexes.erase(name);
+}
+
+void Pyx::Math::SpatialIndex::UnshareAll(Pyx::Scripting::Script* pOwner)
+{
+	auto& sharedIndexes = GetSharedIndexes();
+	std::lock_guard<std::mutex> lock(sharedIndexes.Mutex);
+	auto& indexes = sharedIndexes.Indexes;
+	for (auto it = indexes.begin(); it != indexes.end();)
+	{
+		if (it->second.pOwner == pOwner)
+			it = indexes.erase(it);
+		else
+			++it;
+	}
+}
+
+Pyx::Math::SpatialIndex::SpatialIndex(float cellSize, bool useKdTree)
+	: m_cellSize(cellSize > 0.0f ? cellSize : 1.0f),
+	m_useKdTree(useKdTree),
+	m_version(0),
+	m_isKdTreeDirty(true)
+{
+}
+
+Pyx::Math::SpatialIndex::~SpatialIndex()
+{
+}
+
+uint32_t Pyx::Math::SpatialIndex::GetVersion() const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	return m_version;
+}
+
+size_t Pyx::Math::SpatialIndex::GetSize() const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+bool Pyx::Math::SpatialIndex::Contains(uint64_t id) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	return m_indexById.count(id) != 0;
+}
+
+int32_t Pyx::Math::SpatialIndex::GetCellCoord(float value) const
+{
+	return static_cast<int32_t>(floorf(value / m_cellSize));
+}
+
+uint64_t Pyx::Math::SpatialIndex::GetCellKey(int32_t x, int32_t z) const
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+}
+
+void Pyx::Math::SpatialIndex::AddToCell(uint32_t index)
+{
+	m_cells[m_entries[index].CellKey].push_back(index);
+}
+
+void Pyx::Math::SpatialIndex::RemoveFromCell(uint64_t cellKey, uint32_t index)
+{
+	auto it = m_cells.find(cellKey);
+	if (it == m_cells.end())
+		return;
+
+	auto& indices = it->second;
+	auto pos = std::find(indices.begin(), indices.end(), index);
+	if (pos != indices.end())
+	{
+		*pos = indices.back();
+		indices.pop_back();
+	}
+	if (indices.empty())
+		m_cells.erase(it);
+}
+
+void Pyx::Math::SpatialIndex::ReplaceInCell(uint64_t cellKey, uint32_t oldIndex, uint32_t newIndex)
+{
+	auto& indices = m_cells[cellKey];
+	std::replace(indices.begin(), indices.end(), oldIndex, newIndex);
+}
+
+template<typename Fn>
+void Pyx::Math::SpatialIndex::ForEachInArea(float minX, float minZ, float maxX, float maxZ, Fn fn) const
+{
+	int32_t x0 = GetCellCoord(minX);
+	int32_t z0 = GetCellCoord(minZ);
+	int32_t x1 = GetCellCoord(maxX);
+	int32_t z1 = GetCellCoord(maxZ);
+
+	// Walking more cells than are occupied is slower than just visiting every
+	// occupied one, the callback filters the entries either way
+	double cellCount = (static_cast<double>(x1) - x0 + 1) * (static_cast<double>(z1) - z0 + 1);
+	if (cellCount > static_cast<double>(m_cells.size()))
+	{
+		for (auto& cell : m_cells)
+			for (auto index : cell.second)
+				fn(index);
+		return;
+	}
+
+	for (int32_t x = x0; x <= x1; x++)
+	{
+		for (int32_t z = z0; z <= z1; z++)
+		{
+			auto it = m_cells.find(GetCellKey(x, z));
+			if (it == m_cells.end())
+				continue;
+			for (auto index : it->second)
+				fn(index);
+		}
+	}
+}
+
+void Pyx::Math::SpatialIndex::Invalidate()
+{
+	m_version++;
+	m_isKdTreeDirty = true;
+}
+
+const Pyx::Math::KdTree* Pyx::Math::SpatialIndex::GetKdTree() const
+{
+	if (!m_useKdTree)
+		return nullptr;
+
+	if (m_isKdTreeDirty)
+	{
+		std::vector<Vector3> positions;
+		positions.reserve(m_entries.size());
+		for (auto& entry : m_entries)
+			positions.push_back(entry.Position);
+		m_kdTree.Build(positions);
+		m_isKdTreeDirty = false;
+	}
+	return &m_kdTree;
+}
+
+std::vector<uint64_t> Pyx::Math::SpatialIndex::ToIds(const std::vector<uint32_t>& indices) const
+{
+	std::vector<uint64_t> ids;
+	ids.reserve(indices.size());
+	for (auto index : indices)
+		ids.push_back(m_entries[index].Id);
+	return ids;
+}
+
+void Pyx::Math::SpatialIndex::Clear()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	m_entries.clear();
+	m_indexById.clear();
+	m_cells.clear();
+	m_kdTree.Clear();
+	Invalidate();
+}
+
+void Pyx::Math::SpatialIndex::Rebuild(const Vector3Array& positions, const std::vector<uint64_t>& ids)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	Clear();
+	m_entries.reserve(positions.GetSize());
+	m_indexById.reserve(positions.GetSize());
+
+	// Without explicit ids entries are keyed by their 1-based position in the
+	// array, which is what Lua scripts index their entity lists with
+	for (size_t i = 0; i < positions.GetSize(); i++)
+	{
+		uint64_t id = i < ids.size() ? ids[i] : i + 1;
+		Update(id, positions.Get(i));
+	}
+}
+
+void Pyx::Math::SpatialIndex::Update(uint64_t id, const Vector3& position)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	if (position.IsNan() || position.IsInfinity())
+	{
+		Remove(id);
+		return;
+	}
+
+	uint64_t cellKey = GetCellKey(GetCellCoord(position.X), GetCellCoord(position.Z));
+	auto it = m_indexById.find(id);
+	if (it == m_indexById.end())
+	{
+		uint32_t index = static_cast<uint32_t>(m_entries.size());
+		m_entries.push_back(Entry{ id, position, cellKey });
+		m_indexById[id] = index;
+		AddToCell(index);
+	}
+	else
+	{
+		auto& entry = m_entries[it->second];
+		entry.Position = position;
+		if (entry.CellKey != cellKey)
+		{
+			RemoveFromCell(entry.CellKey, it->second);
+			entry.CellKey = cellKey;
+			AddToCell(it->second);
+		}
+	}
+	Invalidate();
+}
+
+bool Pyx::Math::SpatialIndex::Remove(uint64_t id)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	auto it = m_indexById.find(id);
+	if (it == m_indexById.end())
+		return false;
+
+	uint32_t index = it->second;
+	uint32_t last = static_cast<uint32_t>(m_entries.size() - 1);
+	RemoveFromCell(m_entries[index].CellKey, index);
+	m_indexById.erase(it);
+
+	if (index != last)
+	{
+		m_entries[index] = m_entries[last];
+		ReplaceInCell(m_entries[index].CellKey, last, index);
+		m_indexById[m_entries[index].Id] = index;
+	}
+	m_entries.pop_back();
+	Invalidate();
+	return true;
+}
+
+bool Pyx::Math::SpatialIndex::TryGetPosition(uint64_t id, Vector3& position) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	auto it = m_indexById.find(id);
+	if (it == m_indexById.end())
+		return false;
+	position = m_entries[it->second].Position;
+	return true;
+}
+
+std::vector<uint64_t> Pyx::Math::SpatialIndex::QueryRadius(const Vector3& point, float radius, bool is2D) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::vector<uint32_t> indices;
+	if (auto* pKdTree = GetKdTree())
+	{
+		pKdTree->FindInRadius(point, radius, is2D, indices);
+		return ToIds(indices);
+	}
+
+	const float radiusSquared = radius * radius;
+	ForEachInArea(point.X - radius, point.Z - radius, point.X + radius, point.Z + radius, [&](uint32_t index)
+	{
+		if (KdTree::GetDistanceSquared(point, m_entries[index].Position, is2D) <= radiusSquared)
+			indices.push_back(index);
+	});
+	return ToIds(indices);
+}
+
+std::vector<uint64_t> Pyx::Math::SpatialIndex::QueryNearest(const Vector3& point, size_t count, bool is2D, float maxDistance) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::vector<uint32_t> indices;
+	if (count == 0 || m_entries.empty())
+		return ToIds(indices);
+
+	const float maxDistanceSquared = maxDistance > 0.0f ? maxDistance * maxDistance : INFINITY;
+
+	if (auto* pKdTree = GetKdTree())
+	{
+		pKdTree->FindNearest(point, count, is2D, indices);
+		while (!indices.empty() && KdTree::GetDistanceSquared(point, m_entries[indices.back()].Position, is2D) > maxDistanceSquared)
+			indices.pop_back();
+		return ToIds(indices);
+	}
+
+	std::vector<std::pair<float, uint32_t>> heap;
+	auto consider = [&](uint32_t index)
+	{
+		float distance = KdTree::GetDistanceSquared(point, m_entries[index].Position, is2D);
+		if (distance > maxDistanceSquared || (heap.size() == count && distance >= heap.front().first))
+			return;
+		heap.emplace_back(distance, index);
+		std::push_heap(heap.begin(), heap.end());
+		if (heap.size() > count)
+		{
+			std::pop_heap(heap.begin(), heap.end());
+			heap.pop_back();
+		}
+	};
+
+	// Walk square rings of cells around the point. Everything beyond ring r is
+	// at least r cells away on the XZ plane, which also bounds the 3D distance
+	const int32_t cx = GetCellCoord(point.X);
+	const int32_t cz = GetCellCoord(point.Z);
+	size_t visited = 0;
+	auto visitCell = [&](int32_t x, int32_t z)
+	{
+		auto it = m_cells.find(GetCellKey(x, z));
+		if (it == m_cells.end())
+			return;
+		for (auto index : it->second)
+			consider(index);
+		visited += it->second.size();
+	};
+
+	for (int32_t ring = 0; visited < m_entries.size(); ring++)
+	{
+		if (static_cast<size_t>(ring) * 8 > m_cells.size())
+		{
+			heap.clear();
+			for (uint32_t index = 0; index < m_entries.size(); index++)
+				consider(index);
+			break;
+		}
+
+		if (ring == 0)
+		{
+			visitCell(cx, cz);
+		}
+		else
+		{
+			for (int32_t d = -ring; d <= ring; d++)
+			{
+				visitCell(cx + d, cz - ring);
+				visitCell(cx + d, cz + ring);
+			}
+			for (int32_t d = -ring + 1; d < ring; d++)
+			{
+				visitCell(cx - ring, cz + d);
+				visitCell(cx + ring, cz + d);
+			}
+		}
+
+		float reach = ring * m_cellSize;
+		if (reach * reach >= maxDistanceSquared || (heap.size() == count && heap.front().first <= reach * reach))
+			break;
+	}
+
+	std::sort_heap(heap.begin(), heap.end());
+	for (auto& entry : heap)
+		indices.push_back(entry.second);
+	return ToIds(indices);
+}
+
+std::vector<uint64_t> Pyx::Math::SpatialIndex::QueryBox(const Vector3& min, const Vector3& max) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::vector<uint32_t> indices;
+	ForEachInArea(min.X, min.Z, max.X, max.Z, [&](uint32_t index)
+	{
+		const auto& p = m_entries[index].Position;
+		if (p.X >= min.X && p.X <= max.X && p.Y >= min.Y && p.Y <= max.Y && p.Z >= min.Z && p.Z <= max.Z)
+			indices.push_back(index);
+	});
+	return ToIds(indices);
+}
+
+std::vector<uint64_t> Pyx::Math::SpatialIndex::QueryCone(const Vector3& origin, const Vector3& direction, float angle, float range, bool is2D) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	// angle is the full opening of the cone in radians
+	Vector3 axis = is2D ? Vector3(direction.X, 0.0f, direction.Z).Normalized() : direction.Normalized();
+	const float cosHalfAngle = cosf(angle * 0.5f);
+	const float rangeSquared = range * range;
+
+	std::vector<uint32_t> indices;
+	ForEachInArea(origin.X - range, origin.Z - range, origin.X + range, origin.Z + range, [&](uint32_t index)
+	{
+		const auto& p = m_entries[index].Position;
+		Vector3 delta(p.X - origin.X, is2D ? 0.0f : p.Y - origin.Y, p.Z - origin.Z);
+		float distanceSquared = delta.LengthSquared();
+		if (distanceSquared > rangeSquared)
+			return;
+		if (distanceSquared == 0.0f || Vector3::Dot(axis, delta) >= cosHalfAngle * sqrtf(distanceSquared))
+			indices.push_back(index);
+	});
+	return ToIds(indices);
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Vector3.h>
+#include <Pyx/Math/Vector3Array.h>
+#include <Pyx/Math/KdTree.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		// Uniform hash grid over the XZ plane, with an optional k-d tree built
+		// lazily for nearest and radius queries. Positions are keyed by a
+		// caller supplied id so entries can be moved or removed every frame.
+		class SpatialIndex
+		{
+
+		private:
+			struct Entry
+			{
+				uint64_t Id;
+				Vector3 Position;
+				uint64_t CellKey;
+			};
+
+			struct SharedIndex
+			{
+				Pyx::Scripting::Script* pOwner;
+				std::shared_ptr<SpatialIndex> pIndex;
+			};
+
+			struct SharedIndexes
+			{
+				std::mutex Mutex;
+				std::unordered_map<std::string, SharedIndex> Indexes;
+			};
+
+		public:
+			static void BindWithScript(Pyx::Scripting::Script* pScript);
+			static void Share(Pyx::Scripting::Script* pOwner, const std::string& name, const std::shared_ptr<SpatialIndex>& pIndex);
+			static std::shared_ptr<const SpatialIndex> GetShared(const std::string& name);
+			static void Unshare(const std::string& name);
+			static void UnshareAll(Pyx::Scripting::Script* pOwner);
+
+		private:
+			static SharedIndexes& GetSharedIndexes();
+
+		private:
+			float m_cellSize;
+			bool m_useKdTree;
+			uint32_t m_version;
+			std::vector<Entry> m_entries;
+			std::unordered_map<uint64_t, uint32_t> m_indexById;
+			std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+			mutable KdTree m_kdTree;
+			mutable bool m_isKdTreeDirty;
+			// Shared indexes are used by scripts running on the pulse and the
+			// render thread, and the k-d tree is rebuilt by const queries
+			mutable std::recursive_mutex m_mutex;
+
+		private:
+			int32_t GetCellCoord(float value) const;
+			uint64_t GetCellKey(int32_t x, int32_t z) const;
+			void AddToCell(uint32_t index);
+			void RemoveFromCell(uint64_t cellKey, uint32_t index);
+			void ReplaceInCell(uint64_t cellKey, uint32_t oldIndex, uint32_t newIndex);
+			template<typename Fn> void ForEachInArea(float minX, float minZ, float maxX, float maxZ, Fn fn) const;
+			void Invalidate();
+			const KdTree* GetKdTree() const;
+			std::vector<uint64_t> ToIds(const std::vector<uint32_t>& indices) const;
+
+		public:
+			explicit SpatialIndex(float cellSize, bool useKdTree);
+			~SpatialIndex();
+			float GetCellSize() const { return m_cellSize; }
+			bool IsUsingKdTree() const { return m_useKdTree; }
+			uint32_t GetVersion() const;
+			size_t GetSize() const;
+			void Clear();
+			void Rebuild(const Vector3Array& positions, const std::vector<uint64_t>& ids);
+			void Update(uint64_t id, const Vector3& position);
+			bool Remove(uint64_t id);
+			bool Contains(uint64_t id) const;
+			bool TryGetPosition(uint64_t id, Vector3& position) const;
+
+			std::vector<uint64_t> QueryRadius(const Vector3& point, float radius, bool is2D) const;
+			std::vector<uint64_t> QueryNearest(const Vector3& point, size_t count, bool is2D, float maxDistance) const;
+			std::vector<uint64_t> QueryBox(const Vector3& min, const Vector3& max) const;
+			std::vector<uint64_t> QueryCone(const Vector3& origin, const Vector3& direction, float angle, float range, bool is2D) const;
+
+		};
+	}
+}
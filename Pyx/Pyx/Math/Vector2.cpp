@@ -0,0 +1,55 @@
+#include <Pyx/Math/Vector2.h>
+#include <sstream>
+
+void Pyx::Math::Vector2::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+	using namespace LuaIntf;
+	LuaBinding(pScript->GetLuaState())
+		.beginModule("Pyx")
+		.beginModule("Math")
+		.beginClass<Vector2>("Vector2")
+		.addConstructor(LUA_ARGS(_opt<float>, _opt<float>))
+		.addStaticFunction("Dot", &Vector2::Dot)
+		.addStaticFunction("Cross", &Vector2::Cross)
+		.addStaticFunction("Lerp", &Vector2::Lerp)
+		.addStaticFunction("FromAngle", &Vector2::FromAngle)
+		.addVariable("X", &Vector2::X)
+		.addVariable("Y", &Vector2::Y)
+		.addPropertyReadOnly("Length", &Vector2::Length)
+		.addPropertyReadOnly("LengthSquared", &Vector2::LengthSquared)
+		.addPropertyReadOnly("Angle", &Vector2::GetAngle)
+		.addFunction("GetDistance", &Vector2::GetDistance)
+		.addFunction("GetAngleTo", &Vector2::GetAngleTo)
+		.addFunction("Rotate", &Vector2::Rotate)
+		.addFunction("Normalized", &Vector2::Normalized)
+		.addFunction("Normalize", &Vector2::Normalize)
+		.addFunction("__add", [](const Vector2* a, const Vector2& b) { return *a + b; })
+		.addFunction("__sub", [](const Vector2* a, const Vector2& b) { return *a - b; })
+		.addFunction("__mul", [](const Vector2* a, float s) { return *a * s; })
+		.addFunction("__unm", [](const Vector2* a) { return -*a; })
+		.addFunction("__eq", [](const Vector2* a, const Vector2& b) { return *a == b; })
+		.addFunction("__tostring", &Vector2::ToString)
+		.endClass();
+}
+
+Pyx::Math::Vector2 Pyx::Math::Vector2::Rotate(float radians) const
+{
+	float c = cosf(radians);
+	float s = sinf(radians);
+	return Vector2(X * c - Y * s, X * s + Y * c);
+}
+
+Pyx::Math::Vector2 Pyx::Math::Vector2::Normalized() const
+{
+	float length = Length();
+	if (length < Epsilon)
+		return *this;
+	return Vector2(X / length, Y / length);
+}
+
+std::string Pyx::Math::Vector2::ToString() const
+{
+	std::stringstream ss;
+	ss << X << ", " << Y;
+	return ss.str();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Simd.h>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		struct Vector2
+		{
+
+		public:
+			float X, Y;
+
+		public:
+			static void BindWithScript(Pyx::Scripting::Script* pScript);
+			static float Dot(const Vector2& a, const Vector2& b) { return a.X * b.X + a.Y * b.Y; }
+			static float Cross(const Vector2& a, const Vector2& b) { return a.X * b.Y - a.Y * b.X; }
+			static Vector2 Lerp(const Vector2& from, const Vector2& to, float amount) { return Vector2(from.X + (to.X - from.X) * amount, from.Y + (to.Y - from.Y) * amount); }
+			static Vector2 FromAngle(float radians) { return Vector2(cosf(radians), sinf(radians)); }
+
+		public:
+			constexpr Vector2() : X(0.0f), Y(0.0f) { }
+			constexpr Vector2(float x, float y) : X(x), Y(y) { }
+			float Length() const { return sqrtf(X * X + Y * Y); }
+			float LengthSquared() const { return X * X + Y * Y; }
+			float GetDistance(const Vector2& other) const { return (other - *this).Length(); }
+			float GetAngle() const { return atan2f(Y, X); }
+			float GetAngleTo(const Vector2& other) const { return atan2f(Cross(*this, other), Dot(*this, other)); }
+			Vector2 Rotate(float radians) const;
+			Vector2 Normalized() const;
+			void Normalize() { *this = Normalized(); }
+			bool operator==(const Vector2& rhs) const { return X == rhs.X && Y == rhs.Y; }
+			bool operator!=(const Vector2& rhs) const { return !operator==(rhs); }
+			Vector2& operator+=(const Vector2& v) { X += v.X; Y += v.Y; return *this; }
+			Vector2& operator-=(const Vector2& v) { X -= v.X; Y -= v.Y; return *this; }
+			Vector2& operator*=(const Vector2& v) { X *= v.X; Y *= v.Y; return *this; }
+			Vector2& operator/=(const Vector2& v) { X /= v.X; Y /= v.Y; return *this; }
+			Vector2& operator*=(float s) { X *= s; Y *= s; return *this; }
+			Vector2 operator+(const Vector2& v) const { return Vector2(X + v.X, Y + v.Y); }
+			Vector2 operator-(const Vector2& v) const { return Vector2(X - v.X, Y - v.Y); }
+			Vector2 operator*(const Vector2& v) const { return Vector2(X * v.X, Y * v.Y); }
+			Vector2 operator/(const Vector2& v) const { return Vector2(X / v.X, Y / v.Y); }
+			Vector2 operator*(float s) const { return Vector2(X * s, Y * s); }
+			Vector2 operator-() const { return Vector2(-X, -Y); }
+			std::string ToString() const;
+
+		};
+	}
+}
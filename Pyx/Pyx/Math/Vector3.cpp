@@ -1,4 +1,5 @@
 #include <Pyx/Math/Vector3.h>
+#include <sstream>
 
 void Pyx::Math::Vector3::BindWithScript(Pyx::Scripting::Script* script)
 {
@@ -8,6 +9,8 @@ void Pyx::Math::Vector3::BindWithScript(Pyx::Scripting::Script* script)
 		.beginModule("Math")
 		.beginClass<Vector3>("Vector3")
 		.addStaticFunction("Lerp", &Vector3::Lerp)
+		.addStaticFunction("Dot", &Vector3::Dot)
+		.addStaticFunction("Cross", &Vector3::Cross)
 		.addConstructor(LUA_ARGS(_opt<float>, _opt<float>, _opt<float>))
 		.addVariable("X", &Vector3::X)
 		.addVariable("Y", &Vector3::Y)
@@ -16,22 +19,32 @@ void Pyx::Math::Vector3::BindWithScript(Pyx::Scripting::Script* script)
 		.addFunction("GetDistance3D", &Vector3::GetDistance3D)
 		.addPropertyReadOnly("IsNan", &Vector3::IsNan)
 		.addPropertyReadOnly("IsInfinity", &Vector3::IsInfinity)
+		.addPropertyReadOnly("Length", &Vector3::Length)
+		.addPropertyReadOnly("LengthSquared", &Vector3::LengthSquared)
+		.addPropertyReadOnly("Heading", &Vector3::GetHeading)
+		.addFunction("Normalized", &Vector3::Normalized)
+		.addFunction("Normalize", &Vector3::Normalize)
+		.addFunction("__add", [](const Vector3* a, const Vector3& b) { return *a + b; })
+		.addFunction("__sub", [](const Vector3* a, const Vector3& b) { return *a - b; })
+		.addFunction("__mul", [](const Vector3* a, float s) { return *a * s; })
+		.addFunction("__unm", [](const Vector3* a) { return -*a; })
+		.addFunction("__eq", [](const Vector3* a, const Vector3& b) { return *a == b; })
 		.addFunction("__tostring", &Vector3::ToString)
 		.endClass();
 }
 
 double Pyx::Math::Vector3::GetDistance3D(Vector3& other) const
 {
-	float diffZ = Z - other.Z;
-	float diffY = Y - other.Y;
-	float diffX = X - other.X;
+	double diffZ = (double)Z - other.Z;
+	double diffY = (double)Y - other.Y;
+	double diffX = (double)X - other.X;
 	return sqrt((diffZ * diffZ) + (diffY * diffY) + (diffX * diffX));
 }
 
 double Pyx::Math::Vector3::GetDistance2D(Vector3& other) const
 {
-	float diffZ = Z - other.Z;
-	float diffX = X - other.X;
+	double diffZ = (double)Z - other.Z;
+	double diffX = (double)X - other.X;
 	return sqrt((diffZ * diffZ) + (diffX * diffX));
 }
 
@@ -71,6 +84,13 @@ void Pyx::Math::Vector3::Normalize()
 	}
 }
 
+Pyx::Math::Vector3 Pyx::Math::Vector3::Normalized() const
+{
+	Vector3 result = *this;
+	result.Normalize();
+	return result;
+}
+
 std::string Pyx::Math::Vector3::ToString() const
 {
 	std::stringstream ss;
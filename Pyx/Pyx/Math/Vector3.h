@@ -1,5 +1,6 @@
 #pragma once
 #include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Simd.h>
 
 namespace  Pyx
 {
@@ -34,18 +35,22 @@ namespace  Pyx
 
 		public:
 			static void BindWithScript(Pyx::Scripting::Script* pScript);
+			static float Dot(const Vector3& a, const Vector3& b) { return a.X * b.X + a.Y * b.Y + a.Z * b.Z; }
+			static Vector3 Cross(const Vector3& a, const Vector3& b) { return Vector3(a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X); }
 
 		public:
-			Vector3() { X = Y = Z = 0.0f; }
-			Vector3(float x, float y, float z) : X(x), Y(y), Z(z) { }
+			constexpr Vector3() : X(0.0f), Y(0.0f), Z(0.0f) { }
+			constexpr Vector3(float x, float y, float z) : X(x), Y(y), Z(z) { }
 			double GetDistance3D(Vector3& other) const;
 			double GetDistance2D(Vector3& other) const;
 			bool IsNan() const;
 			bool IsInfinity() const;
 			float Length() const;
+			float LengthSquared() const { return X * X + Y * Y + Z * Z; }
+			float GetHeading() const { return atan2f(X, Z); }
 			bool operator==(const Vector3& rhs) const;
 			bool operator!=(const Vector3& rhs) const;
-			Vector3& Vector3::operator+=(const Vector3& vector)
+			Vector3& operator+=(const Vector3& vector)
 			{
 				X += vector.X;
 				Y += vector.Y;
@@ -53,11 +58,11 @@ namespace  Pyx
 				return *this;
 			}
 
-			Vector3 Vector3::operator+(const Vector3& vector) const
+			Vector3 operator+(const Vector3& vector) const
 			{
 				return Vector3(X, Y, Z) += vector;
 			}
-			Vector3& Vector3::operator-=(const Vector3& vector)
+			Vector3& operator-=(const Vector3& vector)
 			{
 				X -= vector.X;
 				Y -= vector.Y;
@@ -65,11 +70,11 @@ namespace  Pyx
 				return *this;
 			}
 
-			Vector3 Vector3::operator-(const Vector3& vector) const
+			Vector3 operator-(const Vector3& vector) const
 			{
 				return Vector3(X, Y, Z) -= vector;
 			}
-			Vector3& Vector3::operator*=(const Vector3& vector)
+			Vector3& operator*=(const Vector3& vector)
 			{
 				X *= vector.X;
 				Y *= vector.Y;
@@ -77,11 +82,11 @@ namespace  Pyx
 				return *this;
 			}
 
-			Vector3 Vector3::operator*(const Vector3& vector) const
+			Vector3 operator*(const Vector3& vector) const
 			{
 				return Vector3(X, Y, Z) *= vector;
 			}
-			Vector3& Vector3::operator/=(const Vector3& vector)
+			Vector3& operator/=(const Vector3& vector)
 			{
 				X /= vector.X;
 				Y /= vector.Y;
@@ -89,11 +94,20 @@ namespace  Pyx
 				return *this;
 			}
 
-			Vector3 Vector3::operator/(const Vector3& vector) const
+			Vector3 operator/(const Vector3& vector) const
 			{
 				return Vector3(X, Y, Z) /= vector;
 			}
+			Vector3 operator*(float scalar) const
+			{
+				return Vector3(X * scalar, Y * scalar, Z * scalar);
+			}
+			Vector3 operator-() const
+			{
+				return Vector3(-X, -Y, -Z);
+			}
 			void Normalize();
+			Vector3 Normalized() const;
 
 			std::string ToString() const;
 		};
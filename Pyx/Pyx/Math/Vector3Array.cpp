@@ -0,0 +1,373 @@
+#include <Pyx/Math/Vector3Array.h>
+#include <Pyx/Memory/MemoryContext.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+void Pyx::Math::Vector3Array::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+	using namespace LuaIntf;
+	LuaBinding(pScript->GetLuaState())
+		.beginModule("Pyx")
+		.beginModule("Math")
+		.beginClass<Vector3Array>("Vector3Array")
+		.addConstructor(LUA_ARGS(_opt<size_t>))
+		.addPropertyReadOnly("Size", &Vector3Array::GetSize)
+		.addFunction("Resize", &Vector3Array::Resize)
+		.addFunction("Clear", &Vector3Array::Clear)
+		.addFunction("Push", &Vector3Array::Push)
+		.addFunction("Get", [](const Vector3Array* pArray, size_t index)
+		{
+			return index >= 1 && index <= pArray->GetSize() ? pArray->Get(index - 1) : Vector3();
+		})
+		.addFunction("Set", [](Vector3Array* pArray, size_t index, const Vector3& v)
+		{
+			if (index >= 1 && index <= pArray->GetSize())
+				pArray->Set(index - 1, v);
+		})
+		.addFunction("GetDistances", [](const Vector3Array* pArray, const Vector3& point, bool is2D)
+		{
+			return pArray->GetDistances(point, is2D);
+		}, LUA_ARGS(const Vector3&, _def<bool, false>))
+		.addFunction("FindInRadius", [](const Vector3Array* pArray, const Vector3& point, float radius, bool is2D)
+		{
+			auto result = pArray->FindInRadius(point, radius, is2D);
+			for (auto& index : result)
+				index++;
+			return result;
+		}, LUA_ARGS(const Vector3&, float, _def<bool, false>))
+		.addFunction("FindNearest", [](const Vector3Array* pArray, const Vector3& point, size_t count, bool is2D)
+		{
+			auto result = pArray->FindNearest(point, count, is2D);
+			for (auto& index : result)
+				index++;
+			return result;
+		}, LUA_ARGS(const Vector3&, _def<size_t, 1>, _def<bool, false>))
+		.addFunction("LerpTowards", &Vector3Array::LerpTowards)
+		.addFunction("GetBounds", &Vector3Array::GetBounds, LUA_ARGS(_out<Vector3&>, _out<Vector3&>))
+		.addFunction("ReadStrided", &Vector3Array::ReadStrided)
+		.addFunction("ReadFromPointers", &Vector3Array::ReadFromPointers, LUA_ARGS(uintptr_t, size_t, _def<uint32_t, 0>))
+		.addFunction("__len", [](const Vector3Array* pArray) { return pArray->GetSize(); })
+		.endClass();
+}
+
+Pyx::Math::Vector3Array::Vector3Array()
+{
+}
+
+Pyx::Math::Vector3Array::Vector3Array(size_t size)
+	: m_x(size), m_y(size), m_z(size)
+{
+}
+
+void Pyx::Math::Vector3Array::Resize(size_t size)
+{
+	m_x.resize(size);
+	m_y.resize(size);
+	m_z.resize(size);
+}
+
+void Pyx::Math::Vector3Array::Reserve(size_t size)
+{
+	m_x.reserve(size);
+	m_y.reserve(size);
+	m_z.reserve(size);
+}
+
+void Pyx::Math::Vector3Array::Clear()
+{
+	m_x.clear();
+	m_y.clear();
+	m_z.clear();
+}
+
+void Pyx::Math::Vector3Array::Push(const Vector3& v)
+{
+	m_x.push_back(v.X);
+	m_y.push_back(v.Y);
+	m_z.push_back(v.Z);
+}
+
+void Pyx::Math::Vector3Array::Set(size_t index, const Vector3& v)
+{
+	m_x[index] = v.X;
+	m_y[index] = v.Y;
+	m_z[index] = v.Z;
+}
+
+void Pyx::Math::Vector3Array::GetDistancesSquared(const Vector3& point, bool is2D, float* pOut) const
+{
+	const size_t size = GetSize();
+	const float* pX = m_x.data();
+	const float* pY = m_y.data();
+	const float* pZ = m_z.data();
+	const float yScale = is2D ? 0.0f : 1.0f;
+	size_t i = 0;
+
+#if PYX_MATH_AVX2
+	{
+		const __m256 px = _mm256_set1_ps(point.X);
+		const __m256 py = _mm256_set1_ps(point.Y);
+		const __m256 pz = _mm256_set1_ps(point.Z);
+		const __m256 ys = _mm256_set1_ps(yScale);
+		for (; i + 8 <= size; i += 8)
+		{
+			__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(pX + i), px);
+			__m256 dy = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(pY + i), py), ys);
+			__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(pZ + i), pz);
+			__m256 d = _mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dz, dz)));
+			_mm256_storeu_ps(pOut + i, d);
+		}
+	}
+#endif
+#if PYX_MATH_SSE
+	{
+		const __m128 px = _mm_set1_ps(point.X);
+		const __m128 py = _mm_set1_ps(point.Y);
+		const __m128 pz = _mm_set1_ps(point.Z);
+		const __m128 ys = _mm_set1_ps(yScale);
+		for (; i + 4 <= size; i += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(pX + i), px);
+			__m128 dy = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pY + i), py), ys);
+			__m128 dz = _mm_sub_ps(_mm_loadu_ps(pZ + i), pz);
+			__m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_add_ps(_mm_mul_ps(dy, dy), _mm_mul_ps(dz, dz)));
+			_mm_storeu_ps(pOut + i, d);
+		}
+	}
+#endif
+	for (; i < size; i++)
+	{
+		float dx = pX[i] - point.X;
+		float dy = (pY[i] - point.Y) * yScale;
+		float dz = pZ[i] - point.Z;
+		pOut[i] = dx * dx + dy * dy + dz * dz;
+	}
+}
+
+void Pyx::Math::Vector3Array::GetDistances(const Vector3& point, bool is2D, float* pOut) const
+{
+	const size_t size = GetSize();
+	GetDistancesSquared(point, is2D, pOut);
+	size_t i = 0;
+
+#if PYX_MATH_AVX2
+	for (; i + 8 <= size; i += 8)
+		_mm256_storeu_ps(pOut + i, _mm256_sqrt_ps(_mm256_loadu_ps(pOut + i)));
+#endif
+#if PYX_MATH_SSE
+	for (; i + 4 <= size; i += 4)
+		_mm_storeu_ps(pOut + i, _mm_sqrt_ps(_mm_loadu_ps(pOut + i)));
+#endif
+	for (; i < size; i++)
+		pOut[i] = sqrtf(pOut[i]);
+}
+
+std::vector<float> Pyx::Math::Vector3Array::GetDistances(const Vector3& point, bool is2D) const
+{
+	std::vector<float> result(GetSize());
+	if (!result.empty())
+		GetDistances(point, is2D, &result[0]);
+	return result;
+}
+
+std::vector<uint32_t> Pyx::Math::Vector3Array::FindInRadius(const Vector3& point, float radius, bool is2D) const
+{
+	std::vector<uint32_t> result;
+	const size_t size = GetSize();
+	if (size == 0)
+		return result;
+
+	std::vector<float> distances(size);
+	GetDistancesSquared(point, is2D, &distances[0]);
+	const float radiusSquared = radius * radius;
+	size_t i = 0;
+
+#if PYX_MATH_SSE
+	// Most entries are usually out of range, so test 4 of them at once and
+	// only walk the lanes of the blocks that had at least one hit
+	const __m128 r = _mm_set1_ps(radiusSquared);
+	for (; i + 4 <= size; i += 4)
+	{
+		int mask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&distances[i]), r));
+		for (; mask != 0; mask &= mask - 1)
+		{
+			uint32_t lane = mask & 1 ? 0 : mask & 2 ? 1 : mask & 4 ? 2 : 3;
+			result.push_back(static_cast<uint32_t>(i) + lane);
+		}
+	}
+#endif
+	for (; i < size; i++)
+	{
+		if (distances[i] <= radiusSquared)
+			result.push_back(static_cast<uint32_t>(i));
+	}
+	return result;
+}
+
+std::vector<uint32_t> Pyx::Math::Vector3Array::FindNearest(const Vector3& point, size_t count, bool is2D) const
+{
+	std::vector<uint32_t> result;
+	const size_t size = GetSize();
+	if (size == 0 || count == 0)
+		return result;
+
+	std::vector<float> distances(size);
+	GetDistancesSquared(point, is2D, &distances[0]);
+
+	// Entries that could not be read are NaN and never compare, skip them so
+	// the ordering below stays well defined
+	result.reserve(size);
+	for (size_t i = 0; i < size; i++)
+	{
+		if (distances[i] == distances[i])
+			result.push_back(static_cast<uint32_t>(i));
+	}
+
+	count = (std::min)(count, result.size());
+	auto byDistance = [&distances](uint32_t a, uint32_t b) { return distances[a] < distances[b]; };
+	std::partial_sort(result.begin(), result.begin() + count, result.end(), byDistance);
+	result.resize(count);
+	return result;
+}
+
+bool Pyx::Math::Vector3Array::LerpTowards(const Vector3Array& targets, float amount)
+{
+	const size_t size = GetSize();
+	if (targets.GetSize() != size)
+		return false;
+
+	float* arrays[] = { GetX(), GetY(), GetZ() };
+	const float* targetArrays[] = { targets.GetX(), targets.GetY(), targets.GetZ() };
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float* pFrom = arrays[axis];
+		const float* pTo = targetArrays[axis];
+		size_t i = 0;
+
+#if PYX_MATH_AVX2
+		const __m256 t8 = _mm256_set1_ps(amount);
+		for (; i + 8 <= size; i += 8)
+		{
+			__m256 from = _mm256_loadu_ps(pFrom + i);
+			_mm256_storeu_ps(pFrom + i, _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(pTo + i), from), t8, from));
+		}
+#endif
+#if PYX_MATH_SSE
+		const __m128 t4 = _mm_set1_ps(amount);
+		for (; i + 4 <= size; i += 4)
+		{
+			__m128 from = _mm_loadu_ps(pFrom + i);
+			_mm_storeu_ps(pFrom + i, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pTo + i), from), t4)));
+		}
+#endif
+		for (; i < size; i++)
+			pFrom[i] += (pTo[i] - pFrom[i]) * amount;
+	}
+	return true;
+}
+
+bool Pyx::Math::Vector3Array::GetBounds(Vector3& min, Vector3& max) const
+{
+	const size_t size = GetSize();
+	const float* arrays[] = { GetX(), GetY(), GetZ() };
+	float mins[3];
+	float maxs[3];
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const float* pValues = arrays[axis];
+		float lo = (std::numeric_limits<float>::infinity)();
+		float hi = -(std::numeric_limits<float>::infinity)();
+		size_t i = 0;
+
+#if PYX_MATH_SSE
+		// minps/maxps return their second operand when either one is NaN, keep
+		// the accumulator second so unreadable entries are ignored
+		__m128 lo4 = _mm_set1_ps(lo);
+		__m128 hi4 = _mm_set1_ps(hi);
+		for (; i + 4 <= size; i += 4)
+		{
+			__m128 v = _mm_loadu_ps(pValues + i);
+			lo4 = _mm_min_ps(v, lo4);
+			hi4 = _mm_max_ps(v, hi4);
+		}
+		lo4 = _mm_min_ps(lo4, _mm_movehl_ps(lo4, lo4));
+		lo4 = _mm_min_ss(lo4, _mm_shuffle_ps(lo4, lo4, _MM_SHUFFLE(1, 1, 1, 1)));
+		hi4 = _mm_max_ps(hi4, _mm_movehl_ps(hi4, hi4));
+		hi4 = _mm_max_ss(hi4, _mm_shuffle_ps(hi4, hi4, _MM_SHUFFLE(1, 1, 1, 1)));
+		lo = _mm_cvtss_f32(lo4);
+		hi = _mm_cvtss_f32(hi4);
+#endif
+		for (; i < size; i++)
+		{
+			if (pValues[i] < lo)
+				lo = pValues[i];
+			if (pValues[i] > hi)
+				hi = pValues[i];
+		}
+		mins[axis] = lo;
+		maxs[axis] = hi;
+	}
+
+	min = Vector3(mins[0], mins[1], mins[2]);
+	max = Vector3(maxs[0], maxs[1], maxs[2]);
+	return min.X <= max.X;
+}
+
+size_t Pyx::Math::Vector3Array::ReadStrided(uintptr_t address, size_t count, uint32_t stride)
+{
+	if (stride < sizeof(float) * 3)
+		stride = sizeof(float) * 3;
+
+	std::vector<uint8_t> buffer(count * stride);
+	if (count == 0 || !Memory::MemoryContext::GetInstance().Read(address, &buffer[0], buffer.size()))
+	{
+		Clear();
+		return 0;
+	}
+
+	Resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		const float* pValue = reinterpret_cast<const float*>(&buffer[i * stride]);
+		m_x[i] = pValue[0];
+		m_y[i] = pValue[1];
+		m_z[i] = pValue[2];
+	}
+	return count;
+}
+
+size_t Pyx::Math::Vector3Array::ReadFromPointers(uintptr_t pointerArray, size_t count, uint32_t offset)
+{
+	auto& memory = Memory::MemoryContext::GetInstance();
+	std::vector<uintptr_t> pointers(count);
+	if (count == 0 || !memory.Read(pointerArray, &pointers[0], count * sizeof(uintptr_t)))
+	{
+		Clear();
+		return 0;
+	}
+
+	// Keep one entry per pointer so indices still match the caller's list,
+	// entries that can't be read are left as NaN and skipped by the kernels
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	size_t readCount = 0;
+	Resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		float value[3];
+		if (pointers[i] != 0 && memory.Read(pointers[i] + offset, value, sizeof(value)))
+		{
+			m_x[i] = value[0];
+			m_y[i] = value[1];
+			m_z[i] = value[2];
+			readCount++;
+		}
+		else
+		{
+			m_x[i] = m_y[i] = m_z[i] = nan;
+		}
+	}
+	return readCount;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Simd.h>
+#include <Pyx/Math/Vector3.h>
+#include <cstdint>
+#include <vector>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		// Positions stored as separate X/Y/Z arrays so the batch kernels can
+		// process 4 (SSE) or 8 (AVX2) entries per instruction.
+		class Vector3Array
+		{
+
+		public:
+			static void BindWithScript(Pyx::Scripting::Script* pScript);
+
+		private:
+			std::vector<float> m_x;
+			std::vector<float> m_y;
+			std::vector<float> m_z;
+
+		public:
+			explicit Vector3Array();
+			explicit Vector3Array(size_t size);
+			size_t GetSize() const { return m_x.size(); }
+			bool IsEmpty() const { return m_x.empty(); }
+			void Resize(size_t size);
+			void Reserve(size_t size);
+			void Clear();
+			void Push(const Vector3& v);
+			Vector3 Get(size_t index) const { return Vector3(m_x[index], m_y[index], m_z[index]); }
+			void Set(size_t index, const Vector3& v);
+			const float* GetX() const { return m_x.data(); }
+			const float* GetY() const { return m_y.data(); }
+			const float* GetZ() const { return m_z.data(); }
+			float* GetX() { return m_x.data(); }
+			float* GetY() { return m_y.data(); }
+			float* GetZ() { return m_z.data(); }
+
+			void GetDistancesSquared(const Vector3& point, bool is2D, float* pOut) const;
+			void GetDistances(const Vector3& point, bool is2D, float* pOut) const;
+			std::vector<float> GetDistances(const Vector3& point, bool is2D) const;
+			std::vector<uint32_t> FindInRadius(const Vector3& point, float radius, bool is2D) const;
+			std::vector<uint32_t> FindNearest(const Vector3& point, size_t count, bool is2D) const;
+			bool LerpTowards(const Vector3Array& targets, float amount);
+			bool GetBounds(Vector3& min, Vector3& max) const;
+
+			size_t ReadStrided(uintptr_t address, size_t count, uint32_t stride);
+			size_t ReadFromPointers(uintptr_t pointerArray, size_t count, uint32_t offset);
+
+		};
+	}
+}
@@ -0,0 +1,119 @@
+#include <Pyx/Math/Vector4.h>
+#include <Pyx/Math/Vector3.h>
+#include <sstream>
+
+void Pyx::Math::Vector4::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+	using namespace LuaIntf;
+	LuaBinding(pScript->GetLuaState())
+		.beginModule("Pyx")
+		.beginModule("Math")
+		.beginClass<Vector4>("Vector4")
+		.addConstructor(LUA_ARGS(_opt<float>, _opt<float>, _opt<float>, _opt<float>))
+		.addStaticFunction("Dot", &Vector4::Dot)
+		.addStaticFunction("Lerp", &Vector4::Lerp)
+		.addStaticFunction("FromVector3", [](const Vector3& v, float w) { return Vector4(v, w); }, LUA_ARGS(const Vector3&, _def<float, 1>))
+		.addVariable("X", &Vector4::X)
+		.addVariable("Y", &Vector4::Y)
+		.addVariable("Z", &Vector4::Z)
+		.addVariable("W", &Vector4::W)
+		.addPropertyReadOnly("Length", &Vector4::Length)
+		.addPropertyReadOnly("LengthSquared", &Vector4::LengthSquared)
+		.addFunction("ToVector3", &Vector4::ToVector3)
+		.addFunction("Normalized", &Vector4::Normalized)
+		.addFunction("Normalize", &Vector4::Normalize)
+		.addFunction("__add", [](const Vector4* a, const Vector4& b) { return *a + b; })
+		.addFunction("__sub", [](const Vector4* a, const Vector4& b) { return *a - b; })
+		.addFunction("__mul", [](const Vector4* a, float s) { return *a * s; })
+		.addFunction("__unm", [](const Vector4* a) { return -*a; })
+		.addFunction("__eq", [](const Vector4* a, const Vector4& b) { return *a == b; })
+		.addFunction("__tostring", &Vector4::ToString)
+		.endClass();
+}
+
+Pyx::Math::Vector4::Vector4(const Vector3& v, float w)
+	: X(v.X), Y(v.Y), Z(v.Z), W(w)
+{
+}
+
+Pyx::Math::Vector3 Pyx::Math::Vector4::ToVector3() const
+{
+	return Vector3(X, Y, Z);
+}
+
+float Pyx::Math::Vector4::Dot(const Vector4& a, const Vector4& b)
+{
+#if PYX_MATH_SSE
+	__m128 m = _mm_mul_ps(a.Load(), b.Load());
+	__m128 s = _mm_add_ps(m, _mm_movehl_ps(m, m));
+	s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(s);
+#else
+	return a.X * b.X + a.Y * b.Y + a.Z * b.Z + a.W * b.W;
+#endif
+}
+
+Pyx::Math::Vector4 Pyx::Math::Vector4::Lerp(const Vector4& from, const Vector4& to, float amount)
+{
+	return from + (to - from) * amount;
+}
+
+Pyx::Math::Vector4 Pyx::Math::Vector4::Normalized() const
+{
+	float length = Length();
+	if (length < Epsilon)
+		return *this;
+	return *this * (1.0f / length);
+}
+
+Pyx::Math::Vector4 Pyx::Math::Vector4::operator+(const Vector4& v) const
+{
+#if PYX_MATH_SSE
+	return Vector4(_mm_add_ps(Load(), v.Load()));
+#else
+	return Vector4(X + v.X, Y + v.Y, Z + v.Z, W + v.W);
+#endif
+}
+
+Pyx::Math::Vector4 Pyx::Math::Vector4::operator-(const Vector4& v) const
+{
+#if PYX_MATH_SSE
+	return Vector4(_mm_sub_ps(Load(), v.Load()));
+#else
+	return Vector4(X - v.X, Y - v.Y, Z - v.Z, W - v.W);
+#endif
+}
+
+Pyx::Math::Vector4 Pyx::Math::Vector4::operator*(const Vector4& v) const
+{
+#if PYX_MATH_SSE
+	return Vector4(_mm_mul_ps(Load(), v.Load()));
+#else
+	return Vector4(X * v.X, Y * v.Y, Z * v.Z, W * v.W);
+#endif
+}
+
+Pyx::Math::Vector4 Pyx::Math::Vector4::operator/(const Vector4& v) const
+{
+#if PYX_MATH_SSE
+	return Vector4(_mm_div_ps(Load(), v.Load()));
+#else
+	return Vector4(X / v.X, Y / v.Y, Z / v.Z, W / v.W);
+#endif
+}
+
+Pyx::Math::Vector4 Pyx::Math::Vector4::operator*(float s) const
+{
+#if PYX_MATH_SSE
+	return Vector4(_mm_mul_ps(Load(), _mm_set1_ps(s)));
+#else
+	return Vector4(X * s, Y * s, Z * s, W * s);
+#endif
+}
+
+std::string Pyx::Math::Vector4::ToString() const
+{
+	std::stringstream ss;
+	ss << X << ", " << Y << ", " << Z << ", " << W;
+	return ss.str();
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Math/Simd.h>
+
+namespace Pyx
+{
+	namespace Math
+	{
+		struct Vector3;
+		struct PYX_MATH_ALIGN Vector4
+		{
+
+		public:
+			float X, Y, Z, W;
+
+		public:
+			static void BindWithScript(Pyx::Scripting::Script* pScript);
+			static float Dot(const Vector4& a, const Vector4& b);
+			static Vector4 Lerp(const Vector4& from, const Vector4& to, float amount);
+
+		public:
+			constexpr Vector4() : X(0.0f), Y(0.0f), Z(0.0f), W(0.0f) { }
+			constexpr Vector4(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) { }
+			Vector4(const Vector3& v, float w);
+#if PYX_MATH_SSE
+			explicit Vector4(__m128 v) { _mm_storeu_ps(&X, v); }
+			__m128 Load() const { return _mm_loadu_ps(&X); }
+#endif
+			Vector3 ToVector3() const;
+			float Length() const { return sqrtf(Dot(*this, *this)); }
+			float LengthSquared() const { return Dot(*this, *this); }
+			Vector4 Normalized() const;
+			void Normalize() { *this = Normalized(); }
+			bool operator==(const Vector4& rhs) const { return X == rhs.X && Y == rhs.Y && Z == rhs.Z && W == rhs.W; }
+			bool operator!=(const Vector4& rhs) const { return !operator==(rhs); }
+			Vector4 operator+(const Vector4& v) const;
+			Vector4 operator-(const Vector4& v) const;
+			Vector4 operator*(const Vector4& v) const;
+			Vector4 operator/(const Vector4& v) const;
+			Vector4 operator*(float s) const;
+			Vector4 operator-() const { return Vector4(-X, -Y, -Z, -W); }
+			Vector4& operator+=(const Vector4& v) { return *this = *this + v; }
+			Vector4& operator-=(const Vector4& v) { return *this = *this - v; }
+			Vector4& operator*=(const Vector4& v) { return *this = *this * v; }
+			Vector4& operator/=(const Vector4& v) { return *this = *this / v; }
+			Vector4& operator*=(float s) { return *this = *this * s; }
+			std::string ToString() const;
+
+		};
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+namespace Pyx
+{
+    namespace Memory
+    {
+        class MemoryContext;
+        class IMemoryProvider
+        {
+
+        public:
+            explicit IMemoryProvider() { }
+            virtual ~IMemoryProvider() { }
+            virtual const char* GetProviderName() const = 0;
+            virtual bool Read(uintptr_t address, void* pBuffer, size_t size) = 0;
+
+        };
+    }
+}
@@ -0,0 +1,49 @@
+#include <Pyx/Memory/MemoryContext.h>
+#include <Pyx/PyxContext.h>
+
+Pyx::Memory::MemoryContext& Pyx::Memory::MemoryContext::GetInstance()
+{
+    static MemoryContext ctx;
+    return ctx;
+}
+
+Pyx::Memory::MemoryContext::MemoryContext()
+    : m_pProvider(&m_processProvider)
+{
+}
+
+Pyx::Memory::MemoryContext::~MemoryContext()
+{
+}
+
+void Pyx::Memory::MemoryContext::Initialize()
+{
+    const auto& settings = PyxContext::GetInstance().GetSettings();
+    if (!settings.MemorySnapshotFile.empty())
+        LoadSnapshot(settings.RootDirectory + settings.MemorySnapshotFile);
+}
+
+void Pyx::Memory::MemoryContext::Shutdown()
+{
+    m_pProvider = &m_processProvider;
+    m_snapshotProvider.Close();
+}
+
+void Pyx::Memory::MemoryContext::SetProvider(IMemoryProvider* pProvider)
+{
+    m_pProvider = pProvider ? pProvider : &m_processProvider;
+    PYX_LOG_INFO(Memory, "[Memory] Using provider : %s", m_pProvider->GetProviderName());
+}
+
+bool Pyx::Memory::MemoryContext::LoadSnapshot(const std::wstring& fileName)
+{
+    if (!m_snapshotProvider.Open(fileName))
+    {
+        PYX_LOG_ERROR(Memory, L"[Memory] Unable to open snapshot \"%s\"", fileName.c_str());
+        return false;
+    }
+
+    PYX_LOG_INFO(Memory, L"[Memory] Loaded snapshot \"%s\" (%d regions)", fileName.c_str(), (int)m_snapshotProvider.GetRegionCount());
+    SetProvider(&m_snapshotProvider);
+    return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <Pyx/Memory/IMemoryProvider.h>
+#include <Pyx/Memory/ProcessMemoryProvider.h>
+#include <Pyx/Memory/SnapshotMemoryProvider.h>
+#include <string>
+
+namespace Pyx
+{
+    class PyxContext;
+    namespace Memory
+    {
+        class MemoryContext
+        {
+
+        public:
+            static MemoryContext& GetInstance();
+
+        private:
+            ProcessMemoryProvider m_processProvider;
+            SnapshotMemoryProvider m_snapshotProvider;
+            IMemoryProvider* m_pProvider;
+
+        public:
+            explicit MemoryContext();
+            ~MemoryContext();
+            void Initialize();
+            void Shutdown();
+            IMemoryProvider& GetProvider() const { return *m_pProvider; }
+            void SetProvider(IMemoryProvider* pProvider);
+            bool LoadSnapshot(const std::wstring& fileName);
+            bool Read(uintptr_t address, void* pBuffer, size_t size) const { return m_pProvider->Read(address, pBuffer, size); }
+
+        };
+    }
+}
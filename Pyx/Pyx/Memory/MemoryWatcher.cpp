@@ -0,0 +1,277 @@
+#include <Pyx/Memory/MemoryWatcher.h>
+#include <Pyx/Memory/MemoryContext.h>
+#include <Pyx/PyxContext.h>
+#include <Pyx/Scripting/Script.h>
+#include <algorithm>
+#include <emmintrin.h>
+
+Pyx::Memory::MemoryWatcher& Pyx::Memory::MemoryWatcher::GetInstance()
+{
+    static MemoryWatcher instance;
+    return instance;
+}
+
+Pyx::Memory::MemoryWatcher::MemoryWatcher()
+    : m_hWorkerThread(nullptr),
+    m_hStopEvent(nullptr),
+    m_nextWatchId(1)
+{
+}
+
+Pyx::Memory::MemoryWatcher::~MemoryWatcher()
+{
+}
+
+void Pyx::Memory::MemoryWatcher::Initialize()
+{
+    if (!m_hWorkerThread)
+    {
+        m_hStopEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        m_hWorkerThread = CreateThread(nullptr, 0, WorkerThread, this, NULL, nullptr);
+    }
+}
+
+void Pyx::Memory::MemoryWatcher::Shutdown()
+{
+    if (m_hWorkerThread)
+    {
+        SetEvent(m_hStopEvent);
+        WaitForSingleObject(m_hWorkerThread, INFINITE);
+        CloseHandle(m_hWorkerThread);
+        CloseHandle(m_hStopEvent);
+        m_hWorkerThread = nullptr;
+        m_hStopEvent = nullptr;
+    }
+
+    std::lock_guard<std::mutex> watchesLock(m_watchesMutex);
+    std::lock_guard<std::mutex> changesLock(m_changesMutex);
+    m_watches.clear();
+    m_pendingChanges.clear();
+}
+
+size_t Pyx::Memory::MemoryWatcher::WatchRange(Scripting::Script* pScript, uintptr_t address, uint32_t size, const std::wstring& eventName, DWORD intervalMs, uint32_t granularity)
+{
+    if (size == 0 || size > MaxWatchSize)
+        return 0;
+
+    if (granularity == 0)
+        granularity = 4;
+
+    if ((size - 1) / granularity + 1 > MaxFieldCount)
+        return 0;
+
+    std::vector<Field> fields;
+    for (uint32_t offset = 0; offset < size; offset += (std::min)(granularity, size - offset))
+        fields.push_back(Field{ "", offset, (std::min)(granularity, size - offset) });
+
+    return WatchFields(pScript, address, fields, eventName, intervalMs, true);
+}
+
+size_t Pyx::Memory::MemoryWatcher::WatchFields(Scripting::Script* pScript, uintptr_t address, const std::vector<Field>& fields, const std::wstring& eventName, DWORD intervalMs, bool coalesceFields)
+{
+    if (fields.empty() || fields.size() > MaxFieldCount)
+        return 0;
+
+    // Fields must be in the watch, the sum is done on 64 bits so a huge
+    // offset can't wrap around and make the watch smaller than its fields
+    uint64_t size = 0;
+    for (auto& field : fields)
+    {
+        uint64_t end = static_cast<uint64_t>(field.Offset) + field.Size;
+        if (field.Size == 0 || end > MaxWatchSize)
+            return 0;
+        size = (std::max)(size, end);
+    }
+
+    Watch watch;
+    watch.pScript = pScript;
+    watch.Address = address;
+    watch.Size = static_cast<uint32_t>(size);
+    watch.EventName = eventName;
+    watch.IntervalMs = intervalMs;
+    watch.LastSampleTick = 0;
+    watch.IsPrimed = false;
+    watch.CoalesceFields = coalesceFields;
+    watch.Fields = fields;
+    std::sort(watch.Fields.begin(), watch.Fields.end(), [](const Field& a, const Field& b) { return a.Offset < b.Offset; });
+
+    watch.Previous.resize(watch.Size);
+    watch.Current.resize(watch.Size);
+
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    watch.Id = m_nextWatchId++;
+    m_watches.push_back(std::move(watch));
+    return m_watches.back().Id;
+}
+
+void Pyx::Memory::MemoryWatcher::Unwatch(Scripting::Script* pScript, size_t id)
+{
+    std::lock_guard<std::mutex> watchesLock(m_watchesMutex);
+    std::lock_guard<std::mutex> changesLock(m_changesMutex);
+    m_watches.erase(std::remove_if(m_watches.begin(), m_watches.end(),
+        [pScript, id](const Watch& watch) { return watch.pScript == pScript && watch.Id == id; }), m_watches.end());
+    m_pendingChanges.erase(std::remove_if(m_pendingChanges.begin(), m_pendingChanges.end(),
+        [pScript, id](const Change& change) { return change.pScript == pScript && change.WatchId == id; }), m_pendingChanges.end());
+}
+
+void Pyx::Memory::MemoryWatcher::UnwatchAll(Scripting::Script* pScript)
+{
+    std::lock_guard<std::mutex> watchesLock(m_watchesMutex);
+    std::lock_guard<std::mutex> changesLock(m_changesMutex);
+    m_watches.erase(std::remove_if(m_watches.begin(), m_watches.end(),
+        [pScript](const Watch& watch) { return watch.pScript == pScript; }), m_watches.end());
+    m_pendingChanges.erase(std::remove_if(m_pendingChanges.begin(), m_pendingChanges.end(),
+        [pScript](const Change& change) { return change.pScript == pScript; }), m_pendingChanges.end());
+}
+
+void Pyx::Memory::MemoryWatcher::DispatchPendingChanges()
+{
+    // Called from the render thread, the changes of the scripts busy with a
+    // pulse stay queued for the next frame
+    Scripting::ScriptLockSet scriptLocks;
+    std::vector<Change> changes;
+    {
+        std::lock_guard<std::mutex> lock(m_changesMutex);
+        if (m_pendingChanges.empty())
+            return;
+
+        std::vector<Change> busyChanges;
+        for (auto& change : m_pendingChanges)
+        {
+            if (scriptLocks.TryLock(change.pScript))
+                changes.push_back(std::move(change));
+            else
+                busyChanges.push_back(std::move(change));
+        }
+        m_pendingChanges.swap(busyChanges);
+    }
+
+    for (auto& change : changes)
+    {
+        if (change.pScript->IsRunning())
+            change.pScript->FireCallback(change.EventName, change.WatchId, change.FieldName, change.Offset, change.Bytes);
+    }
+}
+
+DWORD Pyx::Memory::MemoryWatcher::WorkerThread(LPVOID pData)
+{
+    auto* pWatcher = static_cast<MemoryWatcher*>(pData);
+    DWORD waitMs = 0;
+
+    while (WaitForSingleObject(pWatcher->m_hStopEvent, waitMs) == WAIT_TIMEOUT)
+    {
+        std::vector<Change> changes;
+        auto now = GetTickCount();
+        waitMs = 50;
+
+        {
+            std::lock_guard<std::mutex> watchesLock(pWatcher->m_watchesMutex);
+            for (auto& watch : pWatcher->m_watches)
+            {
+                auto elapsed = now - watch.LastSampleTick;
+                if (!watch.IsPrimed || elapsed >= watch.IntervalMs)
+                {
+                    pWatcher->Sample(watch);
+                    pWatcher->Diff(watch, changes);
+                    watch.LastSampleTick = now;
+                    elapsed = 0;
+                }
+                waitMs = (std::min)(waitMs, watch.IntervalMs - elapsed);
+            }
+
+            // Published before the watches are released, so a script can't be
+            // unwatched (and deleted) between the sampling and the publication
+            if (!changes.empty())
+            {
+                std::lock_guard<std::mutex> changesLock(pWatcher->m_changesMutex);
+                for (auto& change : changes)
+                    pWatcher->m_pendingChanges.push_back(std::move(change));
+            }
+        }
+
+        if (waitMs == 0)
+            waitMs = 1;
+    }
+
+    return 0;
+}
+
+bool Pyx::Memory::MemoryWatcher::IsBlockEqual(const uint8_t* pLeft, const uint8_t* pRight, size_t size)
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        auto left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLeft + i));
+        auto right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRight + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(left, right)) != 0xFFFF)
+            return false;
+    }
+    return i == size || memcmp(pLeft + i, pRight + i, size - i) == 0;
+}
+
+void Pyx::Memory::MemoryWatcher::Sample(Watch& watch)
+{
+    if (!MemoryContext::GetInstance().Read(watch.Address, &watch.Current[0], watch.Size))
+    {
+        watch.Current = watch.Previous;
+    }
+}
+
+void Pyx::Memory::MemoryWatcher::Diff(Watch& watch, std::vector<Change>& changes) const
+{
+    if (!watch.IsPrimed)
+    {
+        watch.Previous.swap(watch.Current);
+        watch.IsPrimed = true;
+        return;
+    }
+
+    const uint8_t* pPrevious = &watch.Previous[0];
+    const uint8_t* pCurrent = &watch.Current[0];
+    const auto& fields = watch.Fields;
+    std::vector<bool> changedFields(fields.size(), false);
+    size_t firstField = 0;
+
+    // Most of the watched bytes don't move between two samples, so skip whole
+    // 16 bytes blocks first and only look at the fields of the blocks that changed
+    for (uint32_t block = 0; block < watch.Size; block += 16)
+    {
+        uint32_t blockEnd = (std::min)(block + 16, watch.Size);
+
+        while (firstField < fields.size() && fields[firstField].Offset + fields[firstField].Size <= block)
+            firstField++;
+
+        if (IsBlockEqual(pPrevious + block, pCurrent + block, blockEnd - block))
+            continue;
+
+        for (size_t i = firstField; i < fields.size() && fields[i].Offset < blockEnd; i++)
+        {
+            const auto& field = fields[i];
+            if (!changedFields[i] && !IsBlockEqual(pPrevious + field.Offset, pCurrent + field.Offset, field.Size))
+                changedFields[i] = true;
+        }
+    }
+
+    for (size_t i = 0; i < fields.size(); i++)
+    {
+        if (!changedFields[i])
+            continue;
+
+        uint32_t offset = fields[i].Offset;
+        uint32_t end = offset + fields[i].Size;
+
+        if (watch.CoalesceFields)
+        {
+            while (i + 1 < fields.size() && changedFields[i + 1] && fields[i + 1].Offset <= end)
+            {
+                i++;
+                end = (std::max)(end, fields[i].Offset + fields[i].Size);
+            }
+        }
+
+        changes.push_back(Change{ watch.pScript, watch.EventName, watch.Id, fields[i].Name, offset,
+            std::vector<uint8_t>(pCurrent + offset, pCurrent + end) });
+    }
+
+    watch.Previous.swap(watch.Current);
+}
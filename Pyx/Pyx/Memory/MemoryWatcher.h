@@ -0,0 +1,98 @@
+#pragma once
+#include <Windows.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace Pyx
+{
+    class PyxContext;
+    namespace Scripting
+    {
+        class Script;
+    }
+    namespace Memory
+    {
+        // Samples the watched memory of the scripts on its own thread and queues
+        // the changes for the render thread. Sampling is a timed loop down to a
+        // millisecond, it isn't run on the JobSystem where it would hold a
+        // worker sleeping between two samples.
+        class MemoryWatcher
+        {
+
+        public:
+            struct Field
+            {
+                std::string Name;
+                uint32_t Offset;
+                uint32_t Size;
+            };
+
+        private:
+            struct Watch
+            {
+                size_t Id;
+                Scripting::Script* pScript;
+                uintptr_t Address;
+                uint32_t Size;
+                std::wstring EventName;
+                DWORD IntervalMs;
+                DWORD LastSampleTick;
+                bool IsPrimed;
+                bool CoalesceFields;
+                std::vector<Field> Fields;
+                std::vector<uint8_t> Previous;
+                std::vector<uint8_t> Current;
+            };
+
+            struct Change
+            {
+                Scripting::Script* pScript;
+                std::wstring EventName;
+                size_t WatchId;
+                std::string FieldName;
+                uint32_t Offset;
+                std::vector<uint8_t> Bytes;
+            };
+
+        private:
+            // Offsets and sizes come from scripts, watches are bounded so a bad
+            // layout can't make the worker allocate or scan without limit
+            static const uint32_t MaxWatchSize = 1024 * 1024;
+            static const size_t MaxFieldCount = 64 * 1024;
+
+        private:
+            static DWORD WINAPI WorkerThread(LPVOID pData);
+            static bool IsBlockEqual(const uint8_t* pLeft, const uint8_t* pRight, size_t size);
+
+        public:
+            static MemoryWatcher& GetInstance();
+
+        private:
+            HANDLE m_hWorkerThread;
+            HANDLE m_hStopEvent;
+            std::mutex m_watchesMutex;
+            std::mutex m_changesMutex;
+            std::vector<Watch> m_watches;
+            std::vector<Change> m_pendingChanges;
+            size_t m_nextWatchId;
+
+        private:
+            void Sample(Watch& watch);
+            void Diff(Watch& watch, std::vector<Change>& changes) const;
+
+        public:
+            explicit MemoryWatcher();
+            ~MemoryWatcher();
+            void Initialize();
+            void Shutdown();
+            size_t WatchRange(Scripting::Script* pScript, uintptr_t address, uint32_t size, const std::wstring& eventName, DWORD intervalMs, uint32_t granularity);
+            size_t WatchFields(Scripting::Script* pScript, uintptr_t address, const std::vector<Field>& fields, const std::wstring& eventName, DWORD intervalMs, bool coalesceFields = false);
+            void Unwatch(Scripting::Script* pScript, size_t id);
+            void UnwatchAll(Scripting::Script* pScript);
+            void DispatchPendingChanges();
+
+        };
+    }
+}
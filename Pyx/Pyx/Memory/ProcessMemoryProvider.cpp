@@ -0,0 +1,10 @@
+#include <Pyx/Memory/ProcessMemoryProvider.h>
+#include <Windows.h>
+
+bool Pyx::Memory::ProcessMemoryProvider::Read(uintptr_t address, void* pBuffer, size_t size)
+{
+    // Using ReadProcessMemory here because I don't want script to crash the game :p
+    SIZE_T bytesRead = 0;
+    return ReadProcessMemory(GetCurrentProcess(), (LPCVOID)address, pBuffer, size, &bytesRead) == TRUE
+        && bytesRead == size;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <Pyx/Memory/IMemoryProvider.h>
+
+namespace Pyx
+{
+    namespace Memory
+    {
+        class ProcessMemoryProvider : public IMemoryProvider
+        {
+
+        public:
+            explicit ProcessMemoryProvider() { }
+            ~ProcessMemoryProvider() override { }
+            const char* GetProviderName() const override { return "Process"; }
+            bool Read(uintptr_t address, void* pBuffer, size_t size) override;
+
+        };
+    }
+}
@@ -0,0 +1,254 @@
+#include <Pyx/Memory/SnapshotMemoryProvider.h>
+#include <Pyx/Memory/ProcessMemoryProvider.h>
+#include <algorithm>
+#include <fstream>
+
+typedef LONG(NTAPI *tRtlGetCompressionWorkSpaceSize)(USHORT CompressionFormatAndEngine, PULONG CompressBufferWorkSpaceSize, PULONG CompressFragmentWorkSpaceSize);
+typedef LONG(NTAPI *tRtlCompressBuffer)(USHORT CompressionFormatAndEngine, PUCHAR UncompressedBuffer, ULONG UncompressedBufferSize, PUCHAR CompressedBuffer, ULONG CompressedBufferSize, ULONG UncompressedChunkSize, PULONG FinalCompressedSize, PVOID WorkSpace);
+typedef LONG(NTAPI *tRtlDecompressBuffer)(USHORT CompressionFormat, PUCHAR UncompressedBuffer, ULONG UncompressedBufferSize, PUCHAR CompressedBuffer, ULONG CompressedBufferSize, PULONG FinalUncompressedSize);
+
+Pyx::Memory::SnapshotMemoryProvider::SnapshotMemoryProvider()
+    : m_hFile(INVALID_HANDLE_VALUE),
+    m_hMapping(nullptr),
+    m_pView(nullptr),
+    m_viewSize(0)
+{
+}
+
+Pyx::Memory::SnapshotMemoryProvider::~SnapshotMemoryProvider()
+{
+    Close();
+}
+
+bool Pyx::Memory::SnapshotMemoryProvider::Open(const std::wstring& fileName)
+{
+    Close();
+
+    m_hFile = CreateFileW(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(m_hFile, &fileSize) == FALSE || fileSize.QuadPart < sizeof(FileHeader))
+    {
+        Close();
+        return false;
+    }
+
+    m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_hMapping)
+        m_pView = static_cast<const uint8_t*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (!m_pView)
+    {
+        Close();
+        return false;
+    }
+
+    m_viewSize = static_cast<size_t>(fileSize.QuadPart);
+    m_fileName = fileName;
+
+    // The file is not trusted, the table has to fit in the file before it is read
+    auto* pHeader = reinterpret_cast<const FileHeader*>(m_pView);
+    if (pHeader->Magic != Magic || pHeader->Version != Version
+        || pHeader->RegionCount > (m_viewSize - sizeof(FileHeader)) / sizeof(FileRegion))
+    {
+        Close();
+        return false;
+    }
+
+    auto* pTable = reinterpret_cast<const FileRegion*>(m_pView + sizeof(FileHeader));
+    for (uint32_t i = 0; i < pHeader->RegionCount; i++)
+    {
+        if (!IsRegionValid(pTable[i], m_viewSize))
+        {
+            Close();
+            return false;
+        }
+        LoadedRegion region;
+        region.Header = pTable[i];
+        region.pData = pTable[i].CompressionType == Compression::None ? m_pView + pTable[i].FileOffset : nullptr;
+        m_regions.push_back(std::move(region));
+    }
+
+    std::sort(m_regions.begin(), m_regions.end(), [](const LoadedRegion& a, const LoadedRegion& b)
+    {
+        return a.Header.Address < b.Header.Address;
+    });
+
+    return true;
+}
+
+bool Pyx::Memory::SnapshotMemoryProvider::IsRegionValid(const FileRegion& region, size_t fileSize)
+{
+    if (region.Size == 0 || region.Address > UINTPTR_MAX || region.Size - 1 > UINTPTR_MAX - region.Address)
+        return false;
+
+    if (region.FileOffset > fileSize || region.StoredSize > fileSize - region.FileOffset)
+        return false;
+
+    switch (region.CompressionType)
+    {
+    case Compression::None:
+        return region.StoredSize == region.Size;
+    case Compression::LZNT1:
+        return region.Size <= MAXULONG && region.StoredSize <= MAXULONG;
+    default:
+        return false;
+    }
+}
+
+void Pyx::Memory::SnapshotMemoryProvider::Close()
+{
+    m_regions.clear();
+
+    if (m_pView)
+    {
+        UnmapViewOfFile(m_pView);
+        m_pView = nullptr;
+    }
+
+    if (m_hMapping)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+
+    if (m_hFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+
+    m_viewSize = 0;
+}
+
+const uint8_t* Pyx::Memory::SnapshotMemoryProvider::GetRegionData(LoadedRegion& region)
+{
+    std::lock_guard<std::mutex> lock(m_decompressMutex);
+
+    if (region.pData)
+        return region.pData;
+
+    static auto pRtlDecompressBuffer = reinterpret_cast<tRtlDecompressBuffer>(GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "RtlDecompressBuffer"));
+    if (!pRtlDecompressBuffer)
+        return nullptr;
+
+    ULONG finalSize = 0;
+    region.Decompressed.resize(static_cast<size_t>(region.Header.Size));
+    if (pRtlDecompressBuffer(COMPRESSION_FORMAT_LZNT1, &region.Decompressed[0], static_cast<ULONG>(region.Header.Size),
+        const_cast<PUCHAR>(m_pView + region.Header.FileOffset), static_cast<ULONG>(region.Header.StoredSize), &finalSize) != 0
+        || finalSize != region.Header.Size)
+    {
+        region.Decompressed.clear();
+        return nullptr;
+    }
+
+    region.pData = &region.Decompressed[0];
+    return region.pData;
+}
+
+bool Pyx::Memory::SnapshotMemoryProvider::Read(uintptr_t address, void* pBuffer, size_t size)
+{
+    auto* pOut = static_cast<uint8_t*>(pBuffer);
+
+    while (size > 0)
+    {
+        auto it = std::upper_bound(m_regions.begin(), m_regions.end(), address, [](uintptr_t value, const LoadedRegion& region)
+        {
+            return value < region.Header.Address;
+        });
+
+        if (it == m_regions.begin())
+            return false;
+
+        auto& region = *(--it);
+        auto offset = static_cast<size_t>(address - region.Header.Address);
+        if (offset >= region.Header.Size)
+            return false;
+
+        auto* pData = GetRegionData(region);
+        if (!pData)
+            return false;
+
+        auto count = (std::min)(size, static_cast<size_t>(region.Header.Size) - offset);
+        memcpy(pOut, pData + offset, count);
+        pOut += count;
+        address += count;
+        size -= count;
+    }
+
+    return true;
+}
+
+bool Pyx::Memory::SnapshotMemoryProvider::Capture(const std::wstring& fileName, const std::vector<Region>& regions, bool compress)
+{
+    ProcessMemoryProvider process;
+    std::vector<FileRegion> table;
+    std::vector<std::vector<uint8_t>> blobs;
+
+    static auto hNtdll = GetModuleHandleW(L"ntdll.dll");
+    static auto pRtlGetCompressionWorkSpaceSize = reinterpret_cast<tRtlGetCompressionWorkSpaceSize>(GetProcAddress(hNtdll, "RtlGetCompressionWorkSpaceSize"));
+    static auto pRtlCompressBuffer = reinterpret_cast<tRtlCompressBuffer>(GetProcAddress(hNtdll, "RtlCompressBuffer"));
+    std::vector<uint8_t> workSpace;
+
+    if (compress && pRtlGetCompressionWorkSpaceSize && pRtlCompressBuffer)
+    {
+        ULONG workSpaceSize = 0, fragmentWorkSpaceSize = 0;
+        if (pRtlGetCompressionWorkSpaceSize(COMPRESSION_FORMAT_LZNT1 | COMPRESSION_ENGINE_STANDARD, &workSpaceSize, &fragmentWorkSpaceSize) == 0)
+            workSpace.resize(workSpaceSize);
+    }
+
+    uint64_t fileOffset = sizeof(FileHeader) + regions.size() * sizeof(FileRegion);
+
+    for (auto& region : regions)
+    {
+        std::vector<uint8_t> data(region.Size);
+        if (region.Size == 0 || !process.Read(region.Address, &data[0], region.Size))
+            continue;
+
+        FileRegion entry = {};
+        entry.Address = region.Address;
+        entry.Size = region.Size;
+        entry.CompressionType = Compression::None;
+
+        if (!workSpace.empty())
+        {
+            // LZNT1 can grow incompressible data a little, keep the raw bytes in that case
+            std::vector<uint8_t> compressed(region.Size + region.Size / 8 + 4096);
+            ULONG compressedSize = 0;
+            if (pRtlCompressBuffer(COMPRESSION_FORMAT_LZNT1 | COMPRESSION_ENGINE_STANDARD, &data[0], static_cast<ULONG>(data.size()),
+                &compressed[0], static_cast<ULONG>(compressed.size()), 4096, &compressedSize, &workSpace[0]) == 0
+                && compressedSize < data.size())
+            {
+                compressed.resize(compressedSize);
+                data.swap(compressed);
+                entry.CompressionType = Compression::LZNT1;
+            }
+        }
+
+        entry.FileOffset = fileOffset;
+        entry.StoredSize = data.size();
+        fileOffset += data.size();
+        table.push_back(entry);
+        blobs.push_back(std::move(data));
+    }
+
+    std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file || !file.is_open())
+        return false;
+
+    // Regions that couldn't be read were dropped, shift the offsets accordingly
+    uint64_t missingEntries = regions.size() - table.size();
+    for (auto& entry : table)
+        entry.FileOffset -= missingEntries * sizeof(FileRegion);
+
+    FileHeader header = { Magic, Version, static_cast<uint32_t>(table.size()), 0 };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!table.empty())
+        file.write(reinterpret_cast<const char*>(&table[0]), table.size() * sizeof(FileRegion));
+    for (auto& blob : blobs)
+        file.write(reinterpret_cast<const char*>(&blob[0]), blob.size());
+
+    return file.good();
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <Windows.h>
+#include <Pyx/Memory/IMemoryProvider.h>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace Pyx
+{
+    namespace Memory
+    {
+        class SnapshotMemoryProvider : public IMemoryProvider
+        {
+
+        public:
+            static const uint32_t Magic = 0x53585950; // "PYXS"
+            static const uint32_t Version = 1;
+
+            enum class Compression : uint32_t
+            {
+                None = 0,
+                LZNT1 = 1
+            };
+
+#pragma pack(push, 1)
+            struct FileHeader
+            {
+                uint32_t Magic;
+                uint32_t Version;
+                uint32_t RegionCount;
+                uint32_t Reserved;
+            };
+
+            struct FileRegion
+            {
+                uint64_t Address;
+                uint64_t Size;
+                uint64_t FileOffset;
+                uint64_t StoredSize;
+                Compression CompressionType;
+                uint32_t Reserved;
+            };
+#pragma pack(pop)
+
+            struct Region
+            {
+                uintptr_t Address;
+                size_t Size;
+            };
+
+        private:
+            struct LoadedRegion
+            {
+                FileRegion Header;
+                const uint8_t* pData;
+                std::vector<uint8_t> Decompressed;
+            };
+
+        public:
+            static bool Capture(const std::wstring& fileName, const std::vector<Region>& regions, bool compress);
+
+        private:
+            static bool IsRegionValid(const FileRegion& region, size_t fileSize);
+
+        private:
+            std::wstring m_fileName;
+            HANDLE m_hFile;
+            HANDLE m_hMapping;
+            const uint8_t* m_pView;
+            size_t m_viewSize;
+            std::vector<LoadedRegion> m_regions;
+            std::mutex m_decompressMutex;
+
+        private:
+            const uint8_t* GetRegionData(LoadedRegion& region);
+
+        public:
+            explicit SnapshotMemoryProvider();
+            ~SnapshotMemoryProvider() override;
+            const char* GetProviderName() const override { return "Snapshot"; }
+            bool Read(uintptr_t address, void* pBuffer, size_t size) override;
+            bool Open(const std::wstring& fileName);
+            void Close();
+            bool IsOpen() const { return m_pView != nullptr; }
+            const std::wstring& GetFileName() const { return m_fileName; }
+            size_t GetRegionCount() const { return m_regions.size(); }
+
+        };
+    }
+}
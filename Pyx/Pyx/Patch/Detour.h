@@ -16,6 +16,7 @@ namespace Pyx
             T m_target;
             T m_detour;
             bool m_isEnabled = false;
+            bool m_isQueuedEnabled = false;
             char m_hookBuffer[20];
 
         public:
@@ -34,7 +35,18 @@ namespace Pyx
             {
                 if (!m_isEnabled)
                 {
+                    // Inside a batch the hook is written when the batch is committed
+                    if (this->GetPatchContext()->IsBatching())
+                    {
+                        if (MH_QueueEnableHook(m_target) == MH_OK)
+                        {
+                            m_isQueuedEnabled = true;
+                            this->GetPatchContext()->QueueBatchPatch(this);
+                        }
+                        return;
+                    }
                     m_isEnabled = MH_EnableHook(m_target) == MH_OK;
+                    m_isQueuedEnabled = m_isEnabled;
                     if (m_isEnabled)
                         memcpy(m_hookBuffer, m_target, sizeof(m_hookBuffer));
                 }
@@ -42,7 +54,25 @@ namespace Pyx
             
             void Remove() override
             {
+                if ((m_isEnabled || m_isQueuedEnabled) && this->GetPatchContext()->IsBatching())
+                {
+                    if (MH_QueueDisableHook(m_target) == MH_OK)
+                    {
+                        m_isQueuedEnabled = false;
+                        this->GetPatchContext()->QueueBatchPatch(this);
+                    }
+                    return;
+                }
                 m_isEnabled = !(m_isEnabled && MH_DisableHook(m_target) == MH_OK);
+                m_isQueuedEnabled = m_isEnabled;
+            }
+            void OnBatchCommitted(bool isSuccess) override
+            {
+                if (!isSuccess)
+                    return;
+                m_isEnabled = m_isQueuedEnabled;
+                if (m_isEnabled)
+                    memcpy(m_hookBuffer, m_target, sizeof(m_hookBuffer));
             }
             void EnsureApply()
             {
@@ -19,6 +19,8 @@ namespace Pyx
             virtual bool IsApplied() const = 0;
             virtual void Apply() = 0;
             virtual void Remove() = 0;
+            // Called by PatchContext::CommitBatch for the patches queued during the batch
+            virtual void OnBatchCommitted(bool isSuccess) { }
 
         };
     }
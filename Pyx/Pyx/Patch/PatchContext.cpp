@@ -1,15 +1,29 @@
 #include <Pyx/Patch/PatchContext.h>
+#include <Pyx/Threading/ThreadContext.h>
 
 bool g_mhInitialized = false;
 
+namespace
+{
+    UINT WINAPI EnumerateThreads(LPDWORD pThreadIds, UINT capacity)
+    {
+        return static_cast<UINT>(Pyx::Threading::ThreadContext::GetInstance().GetOtherThreadIds(pThreadIds, capacity));
+    }
+}
+
 Pyx::Patch::PatchContext& Pyx::Patch::PatchContext::GetInstance()
 {
-	if (!g_mhInitialized) g_mhInitialized = MH_Initialize() == MH_OK;
+	if (!g_mhInitialized)
+	{
+		g_mhInitialized = MH_Initialize() == MH_OK;
+		if (g_mhInitialized) MH_SetThreadEnumerator(EnumerateThreads);
+	}
     static PatchContext ctx;
     return ctx;
 }
 
 Pyx::Patch::PatchContext::PatchContext()
+    : m_batchDepth(0)
 {
 }
 
@@ -18,9 +32,34 @@ Pyx::Patch::PatchContext::~PatchContext()
 
 }
 
+void Pyx::Patch::PatchContext::BeginBatch()
+{
+    if (m_batchDepth++ == 0)
+        Threading::ThreadContext::GetInstance().Freeze();
+}
+
+void Pyx::Patch::PatchContext::CommitBatch()
+{
+    if (m_batchDepth == 0 || --m_batchDepth > 0)
+        return;
+
+    bool isSuccess = m_batchPatches.empty() || MH_ApplyQueued() == MH_OK;
+    for (auto* pPatch : m_batchPatches)
+        pPatch->OnBatchCommitted(isSuccess);
+    m_batchPatches.clear();
+
+    Threading::ThreadContext::GetInstance().Unfreeze();
+}
+
 void Pyx::Patch::PatchContext::Shutdown()
 {
 
+    // Hooks are all removed in one go instead of freezing for each of them
+    BeginBatch();
+    for (auto* pPatch : m_patches)
+        pPatch->Remove();
+    CommitBatch();
+
     for (auto* pPatch : m_patches)
         delete pPatch;
 
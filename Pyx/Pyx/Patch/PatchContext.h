@@ -16,11 +16,19 @@ namespace Pyx
 
         private:
             std::set<IPatch*> m_patches;
+            std::set<IPatch*> m_batchPatches;
+            int m_batchDepth;
 
         public:
             explicit PatchContext();
             ~PatchContext();
             void Shutdown();
+            // Patches applied or removed between BeginBatch and CommitBatch are
+            // written at once, the process stays frozen for the whole batch
+            void BeginBatch();
+            void CommitBatch();
+            bool IsBatching() const { return m_batchDepth > 0; }
+            void QueueBatchPatch(IPatch* pPatch) { m_batchPatches.insert(pPatch); }
             template<typename T> Detour<T>* CreateDetour(T target, T detour)
             {
                 auto pDetour = new Detour<T>(this, target, detour);
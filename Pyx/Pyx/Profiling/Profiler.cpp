@@ -0,0 +1,247 @@
+#include <Pyx/Profiling/Profiler.h>
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+    void WriteJsonString(std::ofstream& stream, const char* text)
+    {
+        stream << '"';
+        for (const char* p = text; *p; p++)
+        {
+            switch (*p)
+            {
+            case '"': stream << "\\\""; break;
+            case '\\': stream << "\\\\"; break;
+            case '\n': stream << "\\n"; break;
+            case '\r': stream << "\\r"; break;
+            case '\t': stream << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*p) < 0x20)
+                {
+                    char buffer[8];
+                    sprintf_s(buffer, "\\u%04x", static_cast<unsigned char>(*p));
+                    stream << buffer;
+                }
+                else
+                {
+                    stream << *p;
+                }
+                break;
+            }
+        }
+        stream << '"';
+    }
+}
+
+Pyx::Profiling::Profiler& Pyx::Profiling::Profiler::GetInstance()
+{
+    static Profiler ctx;
+    return ctx;
+}
+
+Pyx::Profiling::Profiler::Profiler()
+    : m_isEnabled(false),
+    m_frameCount(0)
+{
+    m_calibrationTicks = GetTicks();
+    QueryPerformanceCounter(&m_calibrationCounter);
+}
+
+Pyx::Profiling::Profiler::~Profiler()
+{
+}
+
+Pyx::Profiling::Profiler::ThreadRing& Pyx::Profiling::Profiler::GetThreadRing()
+{
+    // Rings are never released, like the log buffers the threads of the
+    // process are expected to be long lived
+    static thread_local ThreadRing* t_pRing = nullptr;
+    if (!t_pRing)
+    {
+        std::unique_ptr<ThreadRing> pRing(new ThreadRing());
+        pRing->ThreadId = GetCurrentThreadId();
+        pRing->pEvents.reset(new EventSlot[ThreadRingSize]);
+        pRing->WritePosition = 0;
+        pRing->Depth = 0;
+        t_pRing = pRing.get();
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        m_rings.push_back(std::move(pRing));
+    }
+    return *t_pRing;
+}
+
+void Pyx::Profiling::Profiler::EndScope(const char* name, uint64_t begin)
+{
+    uint64_t end = GetTicks();
+    auto& ring = GetThreadRing();
+    uint64_t position = ring.WritePosition.load(std::memory_order_relaxed);
+    auto& slot = ring.pEvents[position % ThreadRingSize];
+    slot.Name.store(name, std::memory_order_relaxed);
+    slot.Begin.store(begin, std::memory_order_relaxed);
+    slot.End.store(end, std::memory_order_relaxed);
+    slot.Depth.store(--ring.Depth, std::memory_order_relaxed);
+    ring.WritePosition.store(position + 1, std::memory_order_release);
+}
+
+void Pyx::Profiling::Profiler::MarkFrame()
+{
+    // Only called from the render thread
+    uint64_t frameCount = m_frameCount.load(std::memory_order_relaxed);
+    m_frameTicks[frameCount % FrameHistorySize] = GetTicks();
+    m_frameCount.store(frameCount + 1, std::memory_order_release);
+}
+
+const char* Pyx::Profiling::Profiler::InternName(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(m_namesMutex);
+    return m_names.insert(name).first->c_str();
+}
+
+double Pyx::Profiling::Profiler::GetTicksPerMicrosecond()
+{
+    // The TSC is invariant on the processors we run on, it is calibrated
+    // against the performance counter over the lifetime of the profiler
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    uint64_t ticks = GetTicks();
+    double elapsedMicroseconds = static_cast<double>(counter.QuadPart - m_calibrationCounter.QuadPart) * 1000000.0 / frequency.QuadPart;
+    if (elapsedMicroseconds < 1000.0)
+    {
+        Sleep(1);
+        return GetTicksPerMicrosecond();
+    }
+    return static_cast<double>(ticks - m_calibrationTicks) / elapsedMicroseconds;
+}
+
+void Pyx::Profiling::Profiler::CopyEvents(const ThreadRing& ring, uint64_t begin, uint64_t end, std::vector<ProfileEvent>& events)
+{
+    uint64_t writePosition = ring.WritePosition.load(std::memory_order_acquire);
+    uint64_t firstPosition = writePosition > ThreadRingSize ? writePosition - ThreadRingSize : 0;
+    size_t firstIndex = events.size();
+    for (uint64_t position = firstPosition; position < writePosition; position++)
+    {
+        auto& slot = ring.pEvents[position % ThreadRingSize];
+        ProfileEvent event;
+        event.Name = slot.Name.load(std::memory_order_relaxed);
+        event.Begin = slot.Begin.load(std::memory_order_relaxed);
+        event.End = slot.End.load(std::memory_order_relaxed);
+        event.Depth = slot.Depth.load(std::memory_order_relaxed);
+        events.push_back(event);
+    }
+
+    // The owner kept writing during the copy, the oldest slots may have been
+    // overwritten and are dropped
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t lastWritePosition = ring.WritePosition.load(std::memory_order_acquire);
+    uint64_t validPosition = lastWritePosition > ThreadRingSize ? lastWritePosition - ThreadRingSize : 0;
+    if (validPosition > firstPosition)
+    {
+        size_t overwrittenCount = static_cast<size_t>(std::min<uint64_t>(validPosition - firstPosition, writePosition - firstPosition));
+        events.erase(events.begin() + firstIndex, events.begin() + firstIndex + overwrittenCount);
+    }
+
+    events.erase(std::remove_if(events.begin() + firstIndex, events.end(), [begin, end](const ProfileEvent& event)
+    {
+        return event.End < begin || event.Begin > end;
+    }), events.end());
+    std::sort(events.begin() + firstIndex, events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+    {
+        return a.Begin < b.Begin || (a.Begin == b.Begin && a.Depth < b.Depth);
+    });
+}
+
+bool Pyx::Profiling::Profiler::CaptureLastFrame(ProfileCapture& capture)
+{
+    uint64_t frameCount = m_frameCount.load(std::memory_order_acquire);
+    if (frameCount < 2)
+        return false;
+
+    capture.Begin = m_frameTicks[(frameCount - 2) % FrameHistorySize];
+    capture.End = m_frameTicks[(frameCount - 1) % FrameHistorySize];
+    capture.TicksPerMicrosecond = GetTicksPerMicrosecond();
+    capture.Threads.clear();
+
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    for (auto& pRing : m_rings)
+    {
+        ProfileThread thread;
+        thread.ThreadId = pRing->ThreadId;
+        CopyEvents(*pRing, capture.Begin, capture.End, thread.Events);
+        if (!thread.Events.empty())
+            capture.Threads.push_back(std::move(thread));
+    }
+    return true;
+}
+
+void Pyx::Profiling::Profiler::CaptureAll(ProfileCapture& capture)
+{
+    capture.Begin = UINT64_MAX;
+    capture.End = 0;
+    capture.TicksPerMicrosecond = GetTicksPerMicrosecond();
+    capture.Threads.clear();
+
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    for (auto& pRing : m_rings)
+    {
+        ProfileThread thread;
+        thread.ThreadId = pRing->ThreadId;
+        CopyEvents(*pRing, 0, UINT64_MAX, thread.Events);
+        for (auto& event : thread.Events)
+        {
+            capture.Begin = (std::min)(capture.Begin, event.Begin);
+            capture.End = (std::max)(capture.End, event.End);
+        }
+        if (!thread.Events.empty())
+            capture.Threads.push_back(std::move(thread));
+    }
+}
+
+bool Pyx::Profiling::Profiler::ExportChromeTrace(const std::wstring& fileName)
+{
+    ProfileCapture capture;
+    CaptureAll(capture);
+
+    std::ofstream stream(fileName, std::ios::out | std::ios::trunc);
+    if (!stream.is_open())
+        return false;
+
+    // Complete events ("X") in microseconds relative to the oldest event,
+    // loadable by chrome://tracing and Perfetto
+    char buffer[128];
+    DWORD processId = GetCurrentProcessId();
+    bool isFirst = true;
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (auto& thread : capture.Threads)
+    {
+        for (auto& event : thread.Events)
+        {
+            stream << (isFirst ? "\n" : ",\n") << "{\"name\":";
+            WriteJsonString(stream, event.Name);
+            sprintf_s(buffer, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%u,\"tid\":%u}",
+                (event.Begin - capture.Begin) / capture.TicksPerMicrosecond,
+                (event.End - event.Begin) / capture.TicksPerMicrosecond,
+                static_cast<unsigned int>(processId),
+                static_cast<unsigned int>(thread.ThreadId));
+            stream << buffer;
+            isFirst = false;
+        }
+    }
+
+    uint64_t frameCount = m_frameCount.load(std::memory_order_acquire);
+    for (uint64_t frame = frameCount > FrameHistorySize ? frameCount - FrameHistorySize : 0; frame < frameCount; frame++)
+    {
+        uint64_t ticks = m_frameTicks[frame % FrameHistorySize];
+        if (capture.Threads.empty() || ticks < capture.Begin)
+            continue;
+        sprintf_s(buffer, "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":%u,\"tid\":0}",
+            (ticks - capture.Begin) / capture.TicksPerMicrosecond,
+            static_cast<unsigned int>(processId));
+        stream << (isFirst ? "\n" : ",\n") << buffer;
+        isFirst = false;
+    }
+    stream << "\n]}\n";
+    return stream.good();
+}
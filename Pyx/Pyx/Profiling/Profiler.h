@@ -0,0 +1,151 @@
+#pragma once
+#include <Windows.h>
+#include <intrin.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Pyx
+{
+    namespace Profiling
+    {
+        struct ProfileEvent
+        {
+            const char* Name;
+            uint64_t Begin;     // TSC ticks
+            uint64_t End;       // TSC ticks
+            uint32_t Depth;     // Number of enclosing scopes on the same thread
+        };
+
+        struct ProfileThread
+        {
+            DWORD ThreadId;
+            std::vector<ProfileEvent> Events;
+        };
+
+        struct ProfileCapture
+        {
+            uint64_t Begin;
+            uint64_t End;
+            double TicksPerMicrosecond;
+            std::vector<ProfileThread> Threads;
+        };
+
+        // Scopes are written when they end to a ring owned by their thread, so
+        // recording never takes a lock. Old events are overwritten, readers
+        // copy a ring and drop what may have been overwritten during the copy.
+        class Profiler
+        {
+
+        public:
+            static const size_t ThreadRingSize = 16 * 1024;
+            static const size_t FrameHistorySize = 64;
+
+        private:
+            // Slots are read while their owner may overwrite them, the reader
+            // checks the write position again once it is done
+            struct EventSlot
+            {
+                std::atomic<const char*> Name;
+                std::atomic<uint64_t> Begin;
+                std::atomic<uint64_t> End;
+                std::atomic<uint32_t> Depth;
+            };
+
+            struct ThreadRing
+            {
+                DWORD ThreadId;
+                std::unique_ptr<EventSlot[]> pEvents;
+                std::atomic<uint64_t> WritePosition;
+                uint32_t Depth;
+            };
+
+        public:
+            static Profiler& GetInstance();
+            static uint64_t GetTicks() { return __rdtsc(); }
+
+        private:
+            std::atomic<bool> m_isEnabled;
+            std::mutex m_ringsMutex;
+            std::vector<std::unique_ptr<ThreadRing>> m_rings;
+            std::mutex m_namesMutex;
+            std::unordered_set<std::string> m_names;
+            uint64_t m_frameTicks[FrameHistorySize];
+            std::atomic<uint64_t> m_frameCount;
+            uint64_t m_calibrationTicks;
+            LARGE_INTEGER m_calibrationCounter;
+
+        private:
+            ThreadRing& GetThreadRing();
+            void CopyEvents(const ThreadRing& ring, uint64_t begin, uint64_t end, std::vector<ProfileEvent>& events);
+
+        public:
+            explicit Profiler();
+            ~Profiler();
+            bool IsEnabled() const { return m_isEnabled.load(std::memory_order_relaxed); }
+            void SetEnabled(bool enabled) { m_isEnabled = enabled; }
+            void BeginScope() { GetThreadRing().Depth++; }
+            void EndScope(const char* name, uint64_t begin);
+            void MarkFrame();
+            // Returns a pointer that stays valid for the lifetime of the process,
+            // scope names are only referenced by the events
+            const char* InternName(const std::string& name);
+            double GetTicksPerMicrosecond();
+            // Events overlapping the last complete frame
+            bool CaptureLastFrame(ProfileCapture& capture);
+            // Every event still in the rings
+            void CaptureAll(ProfileCapture& capture);
+            bool ExportChromeTrace(const std::wstring& fileName);
+
+        };
+
+        class ProfileScope
+        {
+
+        private:
+            const char* m_name;
+            uint64_t m_begin;
+            bool m_isActive;
+
+        public:
+            explicit ProfileScope(const char* name)
+                : m_name(name), m_begin(0), m_isActive(Profiler::GetInstance().IsEnabled())
+            {
+                if (m_isActive)
+                {
+                    Profiler::GetInstance().BeginScope();
+                    m_begin = Profiler::GetTicks();
+                }
+            }
+            ~ProfileScope()
+            {
+                if (m_isActive)
+                    Profiler::GetInstance().EndScope(m_name, m_begin);
+            }
+            ProfileScope(const ProfileScope&) = delete;
+            ProfileScope& operator=(const ProfileScope&) = delete;
+
+        };
+    }
+}
+
+// Instrumentation, removed at compile time when PYX_PROFILE is 0. Names must
+// outlive the process (literals or Profiler::InternName).
+#ifndef PYX_PROFILE
+#define PYX_PROFILE 1
+#endif
+
+#define PYX_PROFILE_CONCAT_(a, b) a##b
+#define PYX_PROFILE_CONCAT(a, b) PYX_PROFILE_CONCAT_(a, b)
+
+#if PYX_PROFILE
+#define PYX_PROFILE_SCOPE(name) Pyx::Profiling::ProfileScope PYX_PROFILE_CONCAT(pyxProfileScope, __LINE__)(name)
+#define PYX_PROFILE_FRAME() Pyx::Profiling::Profiler::GetInstance().MarkFrame()
+#else
+#define PYX_PROFILE_SCOPE(name) do { } while (0)
+#define PYX_PROFILE_FRAME() do { } while (0)
+#endif
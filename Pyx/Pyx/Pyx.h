@@ -23,4 +23,45 @@ namespace Pyx
         ImGui
     };
 
+    enum class LogOverflowPolicy
+    {
+        Drop,
+        Wait
+    };
+
+    enum class LogFileFormat
+    {
+        Text,
+        Binary
+    };
+
+    enum class LogLevel
+    {
+        Trace,
+        Debug,
+        Info,
+        Warning,
+        Error,
+        None
+    };
+
+    enum class LogCategory
+    {
+        General,
+        Scripting,  // Script management
+        Script,     // Output of the scripts themselves
+        Graphics,
+        Gui,
+        Input,
+        Patch,
+        Memory,
+        Count
+    };
+
+    enum class PulsePolicy
+    {
+        CatchUp,    // Missed pulses are run back to back, up to PulseMaxCatchUp of them
+        Skip        // Missed pulses are dropped, the next one gets the whole elapsed time
+    };
+
 }
\ No newline at end of file
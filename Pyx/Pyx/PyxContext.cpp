@@ -4,13 +4,22 @@
 #include <Pyx/Graphics/Renderer/DXGI.h>
 #include <Pyx/Graphics/GuiContext.h>
 #include <Pyx/Graphics/Gui/IGui.h>
+#include <Pyx/Graphics/Gui/ConsoleLog.h>
 #include <Pyx/Threading/ThreadContext.h>
 #include <Pyx/Threading/Thread.h>
+#include <Pyx/Threading/JobSystem.h>
+#include <Pyx/Threading/StageGraph.h>
 #include <Pyx/Input/InputContext.h>
 #include <Pyx/Graphics/Renderer/D3D11Renderer.h>
 #include <Pyx/Scripting/ScriptingContext.h>
-#include <iomanip>
-#include <ctime>
+#include <Pyx/Scripting/PulseScheduler.h>
+#include <Pyx/Memory/MemoryContext.h>
+#include <Pyx/Memory/MemoryWatcher.h>
+#include <Pyx/Math/PathfindingContext.h>
+#include <Pyx/Logging/LogContext.h>
+#include <Pyx/Profiling/Profiler.h>
+#include <Pyx/Telemetry/TelemetryContext.h>
+#include <Pyx/Utility/String.h>
 
 Pyx::PyxContext* s_pPyxContext = nullptr;
 
@@ -46,23 +55,43 @@ void Pyx::PyxContext::Initialize(const PyxInitSettings& settings)
 
     m_settings = settings;
 
-    if (m_settings.LogToFile)
+    Logging::LogContext::GetInstance().Initialize(m_settings);
+    Threading::JobSystem::GetInstance().Initialize(m_settings.JobWorkerCount);
+    Profiling::Profiler::GetInstance().SetEnabled(m_settings.ProfileEnabled);
+
+    // Everything that doesn't need the process to be frozen runs in parallel,
+    // the renderers only create their dummy devices to find what to hook
+    Threading::StageGraph graph;
+    graph.AddStage("Memory", []() { Memory::MemoryContext::GetInstance().Initialize(); });
+    graph.AddStage("Scripts", []() { Scripting::ScriptingContext::GetInstance().Initialize(); });
+    graph.AddStage("D3D9", []() { Graphics::Renderer::D3D9Renderer::GetInstance().Prepare(); });
+    graph.AddStage("DXGI", []() { Graphics::Renderer::DXGI::GetInstance().Prepare(); });
+    graph.Run();
+
+    for (const auto& stage : graph.GetStages())
     {
-        std::wstring logsDirectory = m_settings.RootDirectory + m_settings.LogDirectory;
-        std::wstring logFileName = logsDirectory + L"\\logs_" + std::to_wstring(GetCurrentProcessId()) + L".log";
-        CreateDirectoryW(logsDirectory.c_str(), nullptr);
-        m_logFileStream.open(logFileName.c_str(), std::ofstream::out);
+        if (stage.State == Threading::StageState::Completed)
+            PYX_LOG_INFO(General, "[Pyx] Stage %s : started at %.2f ms, took %.2f ms", stage.Name.c_str(), stage.StartTime, stage.Duration);
+        else
+            PYX_LOG_ERROR(General, "[Pyx] Stage %s %s : %s", stage.Name.c_str(), stage.State == Threading::StageState::Failed ? "failed" : "skipped", stage.Error.c_str());
     }
+    PYX_LOG_INFO(General, "[Pyx] Stages completed in %.2f ms", graph.GetDuration());
 
-    auto suspendedThreads = Threading::ThreadContext::GetInstance().SuspendAllThreads();
+    // The hooks are written from this thread once every stage is done, a
+    // worker frozen in the middle of a job could hold a lock we need
+    Patch::PatchContext::GetInstance().BeginBatch();
 
     Graphics::Renderer::D3D9Renderer::GetInstance().Initialize();
     Graphics::Renderer::DXGI::GetInstance().Initialize();
     Input::InputContext::GetInstance().Initialize();
-    Scripting::ScriptingContext::GetInstance().Initialize();
 
-    for (auto thread : suspendedThreads)
-        thread->ResumeThread();
+    Patch::PatchContext::GetInstance().CommitBatch();
+
+    Logging::LogContext::GetInstance().StartWorker();
+    Graphics::Gui::ConsoleLog::GetInstance().StartWorker();
+    Memory::MemoryWatcher::GetInstance().Initialize();
+    Scripting::PulseScheduler::GetInstance().Initialize(m_settings);
+    Telemetry::TelemetryContext::GetInstance().Initialize(m_settings);
 
 }
 
@@ -83,7 +112,18 @@ void Pyx::PyxContext::Shutdown()
     if (!IsShutdownedRequested())
         RequestShutdown();
 
-    auto suspendedThreads = Threading::ThreadContext::GetInstance().SuspendAllThreads();
+    Telemetry::TelemetryContext::GetInstance().Shutdown();
+
+    // Must be stopped before freezing the process, it would never exit otherwise
+    Scripting::PulseScheduler::GetInstance().Shutdown();
+    Threading::JobSystem::GetInstance().Shutdown();
+    Math::PathfindingContext::GetInstance().Shutdown();
+    Memory::MemoryWatcher::GetInstance().Shutdown();
+    Memory::MemoryContext::GetInstance().Shutdown();
+    Logging::LogContext::GetInstance().StopWorker();
+    Graphics::Gui::ConsoleLog::GetInstance().StopWorker();
+
+    Threading::ThreadContext::GetInstance().Freeze();
 
     GetOnPyxShutdownStartingCallbacks().Run();
     Scripting::ScriptingContext::GetInstance().Shutdown();
@@ -94,37 +134,20 @@ void Pyx::PyxContext::Shutdown()
     Input::InputContext::GetInstance().Shutdown();
     Patch::PatchContext::GetInstance().Shutdown();
 
-    for (auto thread : suspendedThreads)
-        thread->ResumeThread();
+    Threading::ThreadContext::GetInstance().Unfreeze();
 
-    if (m_logFileStream.is_open())
-        m_logFileStream.close();
+    Logging::LogContext::GetInstance().Shutdown();
 
     SetEvent(m_hShutdownCompletedEvent);
 
 }
 
-void Pyx::PyxContext::Log(const std::wstring& line)
+void Pyx::PyxContext::Log(LogLevel level, const std::wstring& line)
 {
-
-    auto t = std::time(nullptr);
-    auto tm = *std::localtime(&t);
-    wchar_t buffer[256];
-    wcsftime(buffer, sizeof(buffer), L"[%H:%M:%S] ", &tm);
-    std::wstring timedLine = std::wstring(buffer) + line;
-
-    if (GetSettings().LogToFile && m_logFileStream.is_open())
-    {
-		m_logFileStream << timedLine.c_str() << std::endl;
-		m_logFileStream.flush();
-    }
-
-    auto* pGui = Graphics::GuiContext::GetInstance().GetGui();
-    if (pGui) pGui->Logger_OnWriteLine(timedLine);
-
+    Logging::LogContext::GetInstance().Write(level, line);
 }
 
-void Pyx::PyxContext::Log(const std::string& line)
+void Pyx::PyxContext::Log(LogLevel level, const std::string& line)
 {
-    Log(std::wstring(line.begin(), line.end()));
+    Logging::LogContext::GetInstance().Write(level, Utility::String::utf8_decode(line));
 }
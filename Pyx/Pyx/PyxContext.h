@@ -1,10 +1,10 @@
 #pragma once
 #include <Pyx/Pyx.h>
 #include <Pyx/PyxInitSettings.h>
+#include <Pyx/Logging/LogContext.h>
 #include <Pyx/Utility/Callbacks.h>
 #include <memory>
 #include <iostream>
-#include <fstream>
 
 namespace Pyx
 {
@@ -25,7 +25,6 @@ namespace Pyx
         PyxInitSettings m_settings;
         bool m_ShutdownRequested;
         HANDLE m_hShutdownCompletedEvent;
-        std::wofstream m_logFileStream;
         Utility::Callbacks<tOnPyxShutdownStartingCallback> m_OnPyxShutdownStartingCallbacks;
         Utility::Callbacks<tOnPyxShutdownCompletedCallback> m_OnPyxShutdownCompletedCallbacks;
 
@@ -39,28 +38,94 @@ namespace Pyx
         void Shutdown();
         bool IsShutdownedRequested() const { return m_ShutdownRequested; }
         const PyxInitSettings& GetSettings() const { return m_settings; }
-        void Log(const std::wstring& line);
-        void Log(const std::string& line);
+        void Log(LogLevel level, const std::wstring& line);
+        void Log(LogLevel level, const std::string& line);
+        template<typename Arg, typename ... Args>
+        void Log(LogLevel level, const char* format, Arg arg, Args ... args)
+        {
+            if (Logging::LogContext::GetInstance().IsBinary())
+                Logging::LogContext::GetInstance().WriteBinary(level, format, arg, args...);
+            else
+                Log(level, std::string(format), arg, args...);
+        }
         template<typename ... Args>
-        void Log(const std::string& format, Args ... args)
+        void Log(LogLevel level, const std::string& format, Args ... args)
         {
+            if (Logging::LogContext::GetInstance().IsBinary())
+                return Logging::LogContext::GetInstance().WriteBinary(level, format.c_str(), args...);
             size_t size = snprintf(nullptr, 0, format.c_str(), args ...) + 1; // Extra space for '\0'
             std::unique_ptr<char[]> buf(new char[size]);
             snprintf(buf.get(), size, format.c_str(), args ...);
             auto str = std::string(buf.get(), buf.get() + size - 1); // We don't want the '\0' inside
-            Log(str);
+            Log(level, str);
         }
         template<typename ... Args>
-        void Log(const std::wstring& format, Args ... args)
+        void Log(LogLevel level, const std::wstring& format, Args ... args)
         {
+            if (Logging::LogContext::GetInstance().IsBinary())
+                return Logging::LogContext::GetInstance().WriteBinary(level, format.c_str(), args...);
             size_t size = _snwprintf(nullptr, 0, format.c_str(), args ...) + 2; // Extra space for '\0\0'
             std::unique_ptr<wchar_t[]> buf(new wchar_t[size]);
             _snwprintf(buf.get(), size, format.c_str(), args ...);
             auto str = std::wstring(buf.get(), buf.get() + size - 2); // We don't want the '\0\0' inside
-            Log(str);
+            Log(level, str);
         }
+        void Log(const std::wstring& line) { Log(LogLevel::Info, line); }
+        void Log(const std::string& line) { Log(LogLevel::Info, line); }
+        template<typename Arg, typename ... Args>
+        void Log(const char* format, Arg arg, Args ... args) { Log(LogLevel::Info, format, arg, args...); }
+        template<typename ... Args>
+        void Log(const std::string& format, Args ... args) { Log(LogLevel::Info, format, args...); }
+        template<typename ... Args>
+        void Log(const std::wstring& format, Args ... args) { Log(LogLevel::Info, format, args...); }
         Utility::Callbacks<tOnPyxShutdownStartingCallback>& GetOnPyxShutdownStartingCallbacks() { return m_OnPyxShutdownStartingCallbacks; }
         Utility::Callbacks<tOnPyxShutdownCompletedCallback>& GetOnPyxShutdownCompletedCallbacks() { return m_OnPyxShutdownCompletedCallbacks; }
 
     };
-}
\ No newline at end of file
+}
+
+// Leveled logging, category is a Pyx::LogCategory name. Levels below
+// PYX_LOG_MIN_LEVEL are removed at compile time, the others are filtered
+// per category at runtime before any argument is evaluated.
+#define PYX_LOG_LEVEL_TRACE 0
+#define PYX_LOG_LEVEL_DEBUG 1
+#define PYX_LOG_LEVEL_INFO 2
+#define PYX_LOG_LEVEL_WARNING 3
+#define PYX_LOG_LEVEL_ERROR 4
+
+#ifndef PYX_LOG_MIN_LEVEL
+#define PYX_LOG_MIN_LEVEL PYX_LOG_LEVEL_TRACE
+#endif
+
+#define PYX_LOG(level, category, ...) \
+    do { if (Pyx::Logging::LogContext::GetInstance().IsEnabled(Pyx::LogCategory::category, level)) Pyx::PyxContext::GetInstance().Log(level, __VA_ARGS__); } while (0)
+
+#if PYX_LOG_MIN_LEVEL <= PYX_LOG_LEVEL_TRACE
+#define PYX_LOG_TRACE(category, ...) PYX_LOG(Pyx::LogLevel::Trace, category, __VA_ARGS__)
+#else
+#define PYX_LOG_TRACE(category, ...) do { } while (0)
+#endif
+
+#if PYX_LOG_MIN_LEVEL <= PYX_LOG_LEVEL_DEBUG
+#define PYX_LOG_DEBUG(category, ...) PYX_LOG(Pyx::LogLevel::Debug, category, __VA_ARGS__)
+#else
+#define PYX_LOG_DEBUG(category, ...) do { } while (0)
+#endif
+
+#if PYX_LOG_MIN_LEVEL <= PYX_LOG_LEVEL_INFO
+#define PYX_LOG_INFO(category, ...) PYX_LOG(Pyx::LogLevel::Info, category, __VA_ARGS__)
+#else
+#define PYX_LOG_INFO(category, ...) do { } while (0)
+#endif
+
+#if PYX_LOG_MIN_LEVEL <= PYX_LOG_LEVEL_WARNING
+#define PYX_LOG_WARNING(category, ...) PYX_LOG(Pyx::LogLevel::Warning, category, __VA_ARGS__)
+#else
+#define PYX_LOG_WARNING(category, ...) do { } while (0)
+#endif
+
+#if PYX_LOG_MIN_LEVEL <= PYX_LOG_LEVEL_ERROR
+#define PYX_LOG_ERROR(category, ...) PYX_LOG(Pyx::LogLevel::Error, category, __VA_ARGS__)
+#else
+#define PYX_LOG_ERROR(category, ...) do { } while (0)
+#endif
\ No newline at end of file
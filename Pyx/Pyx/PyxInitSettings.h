@@ -14,6 +14,20 @@ namespace Pyx
         std::vector<int> ImGuiToggleConsoleHotkeys      = { VK_F12 };
         bool LogToFile                                  = true;
         std::wstring LogDirectory                       = L"\\Logs";
+        Pyx::LogOverflowPolicy LogOverflowPolicy        = Pyx::LogOverflowPolicy::Drop;
+        Pyx::LogFileFormat LogFileFormat                = Pyx::LogFileFormat::Text;
+        Pyx::LogLevel LogLevel                          = Pyx::LogLevel::Info;
+        uint32_t LogSegmentSize                         = 0; // Memory mapped segments of this size, 0 for a single unbounded file
+        uint32_t LogSegmentCount                        = 8;
         std::wstring ScriptsDirectory                   = L"\\Scripts";
+        std::wstring MemorySnapshotFile                 = L"";
+        uint32_t JobWorkerCount                         = 0; // 0 for one less than the number of processors
+        uint32_t PulseRate                              = 20; // Pyx.OnPulse per second, 0 to disable it
+        Pyx::PulsePolicy PulsePolicy                    = Pyx::PulsePolicy::Skip;
+        uint32_t PulseMaxCatchUp                        = 4;
+        bool ProfileEnabled                             = false; // Can also be toggled from the debug window
+        std::wstring ProfileTraceFile                   = L"\\Pyx.trace.json";
+        bool TelemetryEnabled                           = true; // Shared memory metrics read by PyxCli stats
+        uint32_t TelemetryUpdateInterval                = 250; // Milliseconds between updates of everything but the frame times
     };
 }
@@ -1,6 +1,9 @@
 #pragma once
 #include <Pyx/Scripting/Script.h>
+#include <Pyx/Graphics/Gui/ImGuiImpl.h>
 #include <ImGui/imgui.h>    
+#include <string>
+#include <vector>
 
 #define _def_float(f) _def<float, long((f) * 1000000), 1000000>
 
@@ -11,6 +14,48 @@ namespace LuaModules
 
         using namespace LuaIntf;
 
+        inline int lua_CallInFrame(lua_State* L)
+        {
+            if (!Pyx::Graphics::Gui::ImGuiImpl::IsBuildingFrame())
+                return luaL_error(L, "ImGui can only be used from the render callbacks, not from Pyx.OnPulse");
+            lua_pushvalue(L, lua_upvalueindex(1));
+            lua_insert(L, 1);
+            lua_call(L, lua_gettop(L) - 1, LUA_MULTRET);
+            return lua_gettop(L);
+        }
+
+        // Pyx.OnPulse runs on its own thread while the render thread may be
+        // building a frame, so every function of the module checks it is
+        // called during the frame instead of corrupting the ImGui context
+        inline void RestrictToFrame(lua_State* L, const char* moduleName)
+        {
+            Lua::pushGlobal(L, moduleName);
+            if (!lua_istable(L, -1))
+            {
+                lua_pop(L, 1);
+                return;
+            }
+
+            std::vector<std::string> names;
+            lua_pushnil(L);
+            while (lua_next(L, -2) != 0)
+            {
+                if (lua_type(L, -2) == LUA_TSTRING && lua_isfunction(L, -1) && lua_tostring(L, -2)[0] != '_')
+                    names.push_back(lua_tostring(L, -2));
+                lua_pop(L, 1);
+            }
+
+            for (auto& name : names)
+            {
+                lua_pushstring(L, name.c_str());
+                lua_pushstring(L, name.c_str());
+                lua_rawget(L, -3);
+                lua_pushcclosure(L, &lua_CallInFrame, 1);
+                lua_rawset(L, -3);
+            }
+            lua_pop(L, 1);
+        }
+
 
         inline void BindToScript(Pyx::Scripting::Script* pScript)
         {
@@ -626,6 +671,7 @@ namespace LuaModules
             */
 
             module.endModule();
+            RestrictToFrame(pScript->GetLuaState(), "ImGui");
 
         }
 
@@ -7,6 +7,10 @@ namespace LuaModules
     {
         inline void lua_Print(Pyx::Scripting::Script* pScript, lua_State* L)
         {
+            // Filtered before converting anything, print is often used for debugging
+            if (!pScript->IsLogEnabled(Pyx::LogLevel::Info))
+                return;
+
             int num = lua_gettop(L);
             for (int i = 1; i <= num; i++)
             {
@@ -50,9 +54,9 @@ namespace LuaModules
                 }
                 
                 if (num == 1)
-                    Pyx::PyxContext::GetInstance().Log(L"[%s] %s", pScript->GetName().c_str(), Pyx::Utility::String::utf8_decode(luaStrValue).c_str());
+                    PYX_LOG_INFO(Script, L"[%s] %s", pScript->GetName().c_str(), Pyx::Utility::String::utf8_decode(luaStrValue).c_str());
                 else
-                    Pyx::PyxContext::GetInstance().Log(L"[%s] [%d] %s", pScript->GetName().c_str(), i, Pyx::Utility::String::utf8_decode(luaStrValue).c_str());
+                    PYX_LOG_INFO(Script, L"[%s] [%d] %s", pScript->GetName().c_str(), i, Pyx::Utility::String::utf8_decode(luaStrValue).c_str());
             }
         }
         
@@ -1,5 +1,6 @@
 #pragma once
 #include <Pyx/Scripting/Script.h>
+#include <Pyx/Threading/Future.h>
 #include <Shlwapi.h>
 
 namespace LuaModules
@@ -30,13 +31,11 @@ namespace LuaModules
 
         }
 
-        inline std::string lua_ReadFile(Pyx::Scripting::Script* script, const std::string file)
+        inline std::string ReadFileContent(const std::wstring& fileName)
         {
 
             std::string content;
-            std::wstringstream ssFile;
-            ssFile << script->GetScriptDirectory() << L"\\" << Pyx::Utility::String::utf8_decode(file);
-            std::ifstream  myfile(ssFile.str(), std::ios::in);
+            std::ifstream  myfile(fileName, std::ios::in);
             myfile.imbue(std::locale(std::locale::empty(), new std::codecvt_utf8<wchar_t>));
 
             if (myfile &&
@@ -52,6 +51,17 @@ namespace LuaModules
 
         }
 
+        inline std::string lua_ReadFile(Pyx::Scripting::Script* script, const std::string file)
+        {
+            return ReadFileContent(script->GetScriptDirectory() + L"\\" + Pyx::Utility::String::utf8_decode(file));
+        }
+
+        inline std::shared_ptr<Pyx::Threading::Future> lua_ReadFileAsync(Pyx::Scripting::Script* script, const std::string file)
+        {
+            auto fileName = script->GetScriptDirectory() + L"\\" + Pyx::Utility::String::utf8_decode(file);
+            return Pyx::Threading::Future::Run(script, [fileName]() { return ReadFileContent(fileName); }, Pyx::Threading::JobPriority::Low);
+        }
+
         inline std::vector<std::string> lua_GetFiles(Pyx::Scripting::Script* script, const std::string directory)
         {
             std::vector<std::string> result;
@@ -83,6 +93,7 @@ namespace LuaModules
                 .beginModule("FileSystem")
                 .addFunction("WriteFile", [pScript](const std::string file, const std::string content) { lua_WriteFile(pScript, file, content); })
                 .addFunction("ReadFile", [pScript](const std::string file) { return lua_ReadFile(pScript, file); })
+                .addFunction("ReadFileAsync", [pScript](const std::string file) { return lua_ReadFileAsync(pScript, file); })
                 .addFunction("GetFiles", [pScript](const std::string directory) { return lua_GetFiles(pScript, directory); });
 
         }
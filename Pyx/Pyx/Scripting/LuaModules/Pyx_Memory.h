@@ -1,26 +1,29 @@
 #pragma once
 #include <Pyx/Scripting/Script.h>
+#include <Pyx/Memory/MemoryContext.h>
+#include <Pyx/Memory/MemoryWatcher.h>
 #include <Shlwapi.h>
 
 namespace LuaModules
 {
-    // Using Read/WriteProcessMemory here because I don't want script to crash the game :p
+    // Reads go through the memory context provider, which is the live process
+    // (ReadProcessMemory, so scripts can't crash the game) unless a snapshot is loaded
     namespace Pyx_Memory
     {
 
         template <typename T>
         T Read(uintptr_t ptr)
         {
-            T result;
-            ReadProcessMemory(GetCurrentProcess(), (LPCVOID)ptr, (LPVOID)&result, sizeof(T), nullptr);
+            T result = T();
+            Pyx::Memory::MemoryContext::GetInstance().Read(ptr, &result, sizeof(T));
             return result;
         }
 
         inline std::string ReadASCIIString(uintptr_t ptr, size_t length = 128)
         {
-            auto* buffer = new char[length];
-            ReadProcessMemory(GetCurrentProcess(), (LPCVOID)ptr, (LPVOID)buffer, length, nullptr);
-			auto strLength = strlen(buffer);
+            auto* buffer = new char[length]();
+            Pyx::Memory::MemoryContext::GetInstance().Read(ptr, buffer, length);
+			auto strLength = strnlen(buffer, length);
             auto result = std::string(buffer, strLength < length ? strLength : length);
             delete[] buffer;
             return result;
@@ -28,9 +31,9 @@ namespace LuaModules
 
         inline std::wstring ReadUTF16String(uintptr_t ptr, size_t length = 128)
         {
-            auto* buffer = new wchar_t[length];
-            ReadProcessMemory(GetCurrentProcess(), (LPCVOID)ptr, (LPVOID)buffer, length * sizeof(wchar_t), nullptr);
-			auto strLength = wcslen(buffer);
+            auto* buffer = new wchar_t[length]();
+            Pyx::Memory::MemoryContext::GetInstance().Read(ptr, buffer, length * sizeof(wchar_t));
+			auto strLength = wcsnlen(buffer, length);
             auto result = std::wstring(buffer, strLength < length ? strLength : length);
             delete[] buffer;
             return result;
@@ -39,10 +42,33 @@ namespace LuaModules
         inline std::vector<uint8_t> ReadBytes(uintptr_t ptr, size_t length)
         {
             std::vector<uint8_t> results = std::vector<uint8_t>(length);
-            ReadProcessMemory(GetCurrentProcess(), (LPCVOID)ptr, (LPVOID)&results[0], length, nullptr);
+            if (length > 0)
+                Pyx::Memory::MemoryContext::GetInstance().Read(ptr, &results[0], length);
             return results;
         }
 
+        inline bool lua_CaptureSnapshot(Pyx::Scripting::Script* pScript, const std::string& file, const std::vector<std::vector<uintptr_t>>& regions, bool compress)
+        {
+            std::vector<Pyx::Memory::SnapshotMemoryProvider::Region> snapshotRegions;
+            for (auto& region : regions)
+            {
+                if (region.size() >= 2)
+                    snapshotRegions.push_back(Pyx::Memory::SnapshotMemoryProvider::Region{ region[0], region[1] });
+            }
+            return Pyx::Memory::SnapshotMemoryProvider::Capture(pScript->GetScriptDirectory() + L"\\" + Pyx::Utility::String::utf8_decode(file), snapshotRegions, compress);
+        }
+
+        inline size_t lua_WatchFields(Pyx::Scripting::Script* pScript, uintptr_t ptr, const std::map<std::string, std::vector<uint32_t>>& layout, const std::wstring& eventName, DWORD intervalMs)
+        {
+            std::vector<Pyx::Memory::MemoryWatcher::Field> fields;
+            for (auto& pair : layout)
+            {
+                if (pair.second.size() >= 2)
+                    fields.push_back(Pyx::Memory::MemoryWatcher::Field{ pair.first, pair.second[0], pair.second[1] });
+            }
+            return Pyx::Memory::MemoryWatcher::GetInstance().WatchFields(pScript, ptr, fields, eventName, intervalMs);
+        }
+
         inline void BindToScript(Pyx::Scripting::Script* pScript)
         {
 
@@ -60,7 +86,18 @@ namespace LuaModules
                 .addFunction("ReadFloat", [](uintptr_t ptr) { return Read<float>(ptr); })
                 .addFunction("ReadBytes", ReadBytes)
                 .addFunction("ReadASCIIString", ReadASCIIString, LUA_ARGS(uintptr_t, _def<size_t, 128>))
-                .addFunction("ReadUTF16String", ReadUTF16String, LUA_ARGS(uintptr_t, _def<size_t, 128>));
+                .addFunction("ReadUTF16String", ReadUTF16String, LUA_ARGS(uintptr_t, _def<size_t, 128>))
+                .addFunction("Watch", [pScript](uintptr_t ptr, uint32_t size, const std::wstring& eventName, DWORD intervalMs, uint32_t granularity)
+                    { return Pyx::Memory::MemoryWatcher::GetInstance().WatchRange(pScript, ptr, size, eventName, intervalMs, granularity); },
+                    LUA_ARGS(uintptr_t, uint32_t, const std::wstring&, _def<DWORD, 100>, _def<uint32_t, 4>))
+                .addFunction("WatchFields", [pScript](uintptr_t ptr, const std::map<std::string, std::vector<uint32_t>>& layout, const std::wstring& eventName, DWORD intervalMs)
+                    { return lua_WatchFields(pScript, ptr, layout, eventName, intervalMs); },
+                    LUA_ARGS(uintptr_t, const std::map<std::string, std::vector<uint32_t>>&, const std::wstring&, _def<DWORD, 100>))
+                .addFunction("Unwatch", [pScript](size_t id) { Pyx::Memory::MemoryWatcher::GetInstance().Unwatch(pScript, id); })
+                .addFunction("CaptureSnapshot", [pScript](const std::string& file, const std::vector<std::vector<uintptr_t>>& regions, bool compress)
+                    { return lua_CaptureSnapshot(pScript, file, regions, compress); },
+                    LUA_ARGS(const std::string&, const std::vector<std::vector<uintptr_t>>&, _def<bool, true>))
+                .addProperty("ProviderName", []() -> std::string { return Pyx::Memory::MemoryContext::GetInstance().GetProvider().GetProviderName(); });
 
         }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include <Pyx/Scripting/Script.h>
+#include <Pyx/Scripting/PulseScheduler.h>
 
 namespace LuaModules
 {
@@ -24,7 +25,8 @@ namespace LuaModules
 
             LuaBinding(pScript->GetLuaState()).beginModule("Pyx")
                 .beginModule("Scripting")
-                .addProperty("CurrentScript", [pScript]() -> Pyx::Scripting::Script* { return pScript; });
+                .addProperty("CurrentScript", [pScript]() -> Pyx::Scripting::Script* { return pScript; })
+                .addProperty("PulseRate", []() { return Pyx::Scripting::PulseScheduler::GetInstance().GetRate(); });
 
         }
 
@@ -0,0 +1,115 @@
+#include <Pyx/Scripting/PulseScheduler.h>
+#include <Pyx/Scripting/ScriptingContext.h>
+#include <Pyx/Profiling/Profiler.h>
+#include <algorithm>
+
+Pyx::Scripting::PulseScheduler& Pyx::Scripting::PulseScheduler::GetInstance()
+{
+    static PulseScheduler ctx;
+    return ctx;
+}
+
+Pyx::Scripting::PulseScheduler::PulseScheduler()
+    : m_hPulseThread(nullptr),
+    m_hStopEvent(nullptr),
+    m_rate(0),
+    m_policy(PulsePolicy::Skip),
+    m_maxCatchUp(0),
+    m_pulseCount(0),
+    m_droppedCount(0)
+{
+}
+
+Pyx::Scripting::PulseScheduler::~PulseScheduler()
+{
+}
+
+void Pyx::Scripting::PulseScheduler::Initialize(const PyxInitSettings& settings)
+{
+    if (m_hPulseThread || settings.PulseRate == 0)
+        return;
+
+    m_rate = settings.PulseRate;
+    m_policy = settings.PulsePolicy;
+    m_maxCatchUp = settings.PulseMaxCatchUp;
+    m_hStopEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+    m_hPulseThread = CreateThread(nullptr, 0, PulseThread, this, NULL, nullptr);
+}
+
+void Pyx::Scripting::PulseScheduler::Shutdown()
+{
+    if (m_hPulseThread)
+    {
+        SetEvent(m_hStopEvent);
+        WaitForSingleObject(m_hPulseThread, INFINITE);
+        CloseHandle(m_hPulseThread);
+        CloseHandle(m_hStopEvent);
+        m_hPulseThread = nullptr;
+        m_hStopEvent = nullptr;
+    }
+}
+
+void Pyx::Scripting::PulseScheduler::Pulse(float deltaTime)
+{
+    PYX_PROFILE_SCOPE("Pyx.OnPulse");
+    auto& scriptingContext = ScriptingContext::GetInstance();
+    std::lock_guard<std::recursive_mutex> lock(scriptingContext.GetMutex());
+    scriptingContext.FireCallbacks(L"Pyx.OnPulse", deltaTime);
+    m_pulseCount++;
+}
+
+DWORD Pyx::Scripting::PulseScheduler::PulseThread(LPVOID pData)
+{
+    auto* pScheduler = static_cast<PulseScheduler*>(pData);
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    const int64_t period = std::max<int64_t>(frequency.QuadPart / pScheduler->m_rate, 1);
+    int64_t nextPulse = counter.QuadPart + period;
+    int64_t lastPulse = counter.QuadPart;
+
+    for (;;)
+    {
+        // The stop event is also checked when late, pulses may constantly take
+        // longer than the period
+        QueryPerformanceCounter(&counter);
+        int64_t now = counter.QuadPart;
+        DWORD waitMs = now < nextPulse ? static_cast<DWORD>(((nextPulse - now) * 1000 + frequency.QuadPart - 1) / frequency.QuadPart) : 0;
+        if (WaitForSingleObject(pScheduler->m_hStopEvent, waitMs) != WAIT_TIMEOUT)
+            break;
+
+        QueryPerformanceCounter(&counter);
+        now = counter.QuadPart;
+        if (now < nextPulse)
+            continue;
+
+        // Pulses stay on a fixed grid, the ones missed while the previous pulse
+        // (or a stall of the process) took longer than the period are either
+        // run back to back with a fixed delta or dropped
+        uint64_t missedCount = static_cast<uint64_t>((now - nextPulse) / period);
+        nextPulse += static_cast<int64_t>(missedCount + 1) * period;
+
+        if (pScheduler->m_policy == PulsePolicy::CatchUp)
+        {
+            uint64_t catchUpCount = std::min<uint64_t>(missedCount, pScheduler->m_maxCatchUp);
+            pScheduler->m_droppedCount += missedCount - catchUpCount;
+            float deltaTime = static_cast<float>(period) / frequency.QuadPart;
+            for (uint64_t i = 0; i <= catchUpCount; i++)
+            {
+                if (WaitForSingleObject(pScheduler->m_hStopEvent, 0) != WAIT_TIMEOUT)
+                    return 0;
+                pScheduler->Pulse(deltaTime);
+            }
+        }
+        else
+        {
+            pScheduler->m_droppedCount += missedCount;
+            pScheduler->Pulse(static_cast<float>(now - lastPulse) / frequency.QuadPart);
+        }
+        lastPulse = now;
+    }
+
+    return 0;
+}
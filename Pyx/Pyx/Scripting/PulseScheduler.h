@@ -0,0 +1,47 @@
+#pragma once
+#include <Windows.h>
+#include <Pyx/PyxInitSettings.h>
+#include <atomic>
+#include <cstdint>
+
+namespace Pyx
+{
+    namespace Scripting
+    {
+        // Fires Pyx.OnPulse at a fixed rate from its own thread so that script
+        // logic doesn't run on every frame in the Present hook. Pulses and the
+        // render callbacks of a script are serialized by the script mutex, the
+        // render thread only has to draw what the pulses computed.
+        class PulseScheduler
+        {
+
+        private:
+            static DWORD WINAPI PulseThread(LPVOID pData);
+
+        public:
+            static PulseScheduler& GetInstance();
+
+        private:
+            HANDLE m_hPulseThread;
+            HANDLE m_hStopEvent;
+            uint32_t m_rate;
+            PulsePolicy m_policy;
+            uint32_t m_maxCatchUp;
+            std::atomic<uint64_t> m_pulseCount;
+            std::atomic<uint64_t> m_droppedCount;
+
+        private:
+            void Pulse(float deltaTime);
+
+        public:
+            explicit PulseScheduler();
+            ~PulseScheduler();
+            void Initialize(const PyxInitSettings& settings);
+            void Shutdown();
+            uint32_t GetRate() const { return m_rate; }
+            uint64_t GetPulseCount() const { return m_pulseCount.load(std::memory_order_relaxed); }
+            uint64_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+        };
+    }
+}
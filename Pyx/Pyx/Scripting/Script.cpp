@@ -9,11 +9,28 @@
 #include <Pyx/Scripting/LuaModules/Pyx_Memory.h>
 #include <Pyx/Scripting/LuaModules/Pyx_Input.h>
 #include <Pyx/Scripting/LuaModules/ImGui.h>
+#include <Pyx/Math/Vector2.h>
 #include <Pyx/Math/Vector3.h>
+#include <Pyx/Math/Vector3Array.h>
+#include <Pyx/Math/Vector4.h>
+#include <Pyx/Math/Matrix4.h>
+#include <Pyx/Math/Quaternion.h>
+#include <Pyx/Math/SpatialIndex.h>
+#include <Pyx/Math/NavGraph.h>
+#include <Pyx/Math/HeightGrid.h>
+#include <Pyx/Math/MotionTracker.h>
+#include <Pyx/Math/PathfindingContext.h>
+#include <Pyx/Graphics/Overlay.h>
+#include <Pyx/Graphics/GraphicsContext.h>
+#include <Pyx/Logging/LogContext.h>
+#include <Pyx/Memory/MemoryWatcher.h>
+#include <Pyx/Threading/Future.h>
+#include <algorithm>
 
 
 Pyx::Scripting::Script::Script(const std::wstring& name, const std::wstring& defFileName)
- : m_name(name), m_defFileName(defFileName)
+ : m_name(name), m_defFileName(defFileName), m_logLevel(static_cast<int>(LogLevel::Trace)),
+ m_profileName(Profiling::Profiler::GetInstance().InternName(Utility::String::utf8_encode(name)))
 {
     wchar_t buffer[MAX_PATH];
     m_defFileName.copy(buffer, MAX_PATH);
@@ -28,98 +45,128 @@ Pyx::Scripting::Script::~Script()
 
 void Pyx::Scripting::Script::Stop(bool fireEvent)
 {
-    if (m_Mutex.try_lock())
+    // Waits for the pulse or the frame running the script, since both threads
+    // call into scripts a stop can't just be skipped when the script is busy
+    std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+    if (IsRunning())
     {
-        if (IsRunning())
-        {
-            PyxContext::GetInstance().Log(L"Stopping script \"%s\" ...", m_name.c_str());
-            if (fireEvent) FireCallback(L"Pyx.OnScriptStop");
-            m_isRunning = false;
-            m_callbacks.clear();
-        }
-        m_Mutex.unlock();
+        PYX_LOG_INFO(Scripting, L"Stopping script \"%s\" ...", m_name.c_str());
+        if (fireEvent) FireCallback(L"Pyx.OnScriptStop");
+        Memory::MemoryWatcher::GetInstance().UnwatchAll(this);
+        Math::SpatialIndex::UnshareAll(this);
+        Math::PathfindingContext::GetInstance().CancelAll(this);
+        Threading::Future::CancelAll(this);
+        m_isRunning = false;
+        m_callbacks.clear();
     }
 }
 
 void Pyx::Scripting::Script::Start()
 {
-    if (m_Mutex.try_lock())
+    std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+    if (!IsRunning())
     {
-        if (!IsRunning())
+
+        DWORD dwAttrib = GetFileAttributesW(m_defFileName.c_str());
+        if (dwAttrib != INVALID_FILE_ATTRIBUTES && !(dwAttrib & FILE_ATTRIBUTE_DIRECTORY))
         {
 
-            DWORD dwAttrib = GetFileAttributesW(m_defFileName.c_str());
-            if (dwAttrib != INVALID_FILE_ATTRIBUTES && !(dwAttrib & FILE_ATTRIBUTE_DIRECTORY))
+            ScriptDef scriptDef(m_defFileName);
+            std::wstring errorMessage;
+            if (scriptDef.Validate(errorMessage))
             {
 
-                ScriptDef scriptDef(m_defFileName);
-                std::wstring errorMessage;
-                if (scriptDef.Validate(errorMessage))
-                {
+                PYX_LOG_INFO(Scripting, L"Starting script \"%s\" ...", m_name.c_str());
+                m_pLuaState = luaL_newstate();
+                m_luaState = LuaState(m_pLuaState);
+                m_luaState.openLibs();
+
+                LuaModules::Override::BindToScript(this);
+                LuaModules::ImGuiLua::BindToScript(this);
+                LuaModules::Pyx_Scripting::BindToScript(this);
+                LuaModules::Pyx_FileSystem::BindToScript(this);
+                LuaModules::Pyx_Win32::BindToScript(this);
+                LuaModules::Pyx_Memory::BindToScript(this);
+                LuaModules::Pyx_Input::BindToScript(this);
+                Pyx::Math::Vector2::BindWithScript(this);
+                Pyx::Math::Vector3::BindWithScript(this);
+                Pyx::Math::Vector3Array::BindWithScript(this);
+                Pyx::Math::Vector4::BindWithScript(this);
+                Pyx::Math::Matrix4::BindWithScript(this);
+                Pyx::Math::Quaternion::BindWithScript(this);
+                Pyx::Math::SpatialIndex::BindWithScript(this);
+                Pyx::Math::NavGraph::BindWithScript(this);
+                Pyx::Math::HeightGrid::BindWithScript(this);
+                Pyx::Math::MotionTracker::BindWithScript(this);
+                Pyx::Graphics::Overlay::BindWithScript(this);
+                Pyx::Graphics::GraphicsContext::BindWithScript(this);
+                Pyx::Logging::LogContext::BindWithScript(this);
+                Pyx::Threading::Future::BindWithScript(this);
 
-                    PyxContext::GetInstance().Log(L"Starting script \"%s\" ...", m_name.c_str());
-                    m_pLuaState = luaL_newstate();
-                    m_luaState = LuaState(m_pLuaState);
-                    m_luaState.openLibs();
-
-                    LuaModules::Override::BindToScript(this);
-                    LuaModules::ImGuiLua::BindToScript(this);
-                    LuaModules::Pyx_Scripting::BindToScript(this);
-                    LuaModules::Pyx_FileSystem::BindToScript(this);
-                    LuaModules::Pyx_Win32::BindToScript(this);
-                    LuaModules::Pyx_Memory::BindToScript(this);
-                    LuaModules::Pyx_Input::BindToScript(this);
-                    Pyx::Math::Vector3::BindWithScript(this);
-
-                    ScriptingContext::GetInstance().GetOnStartScriptCallbacks().Run(this);
-                    m_isRunning = true;
-
-                    if (scriptDef.Run(m_luaState))
-                    {
-                        FireCallback(L"Pyx.OnScriptStart");
-                    }
-                    else
-                        m_isRunning = false;
+                ScriptingContext::GetInstance().GetOnStartScriptCallbacks().Run(this);
+                m_isRunning = true;
 
+                if (scriptDef.Run(m_luaState))
+                {
+                    FireCallback(L"Pyx.OnScriptStart");
                 }
                 else
                 {
-                    PyxContext::GetInstance().Log(L"Error starting script \"%s\"", m_name.c_str());
-                    PyxContext::GetInstance().Log(errorMessage);
+                    m_isRunning = false;
+                    IncrementErrorCount();
                 }
 
             }
+            else
+            {
+                PYX_LOG_ERROR(Scripting, L"Error starting script \"%s\"", m_name.c_str());
+                PYX_LOG_ERROR(Scripting, errorMessage);
+                IncrementErrorCount();
+            }
+
         }
-        m_Mutex.unlock();
     }
 }
 
 void Pyx::Scripting::Script::RegisterCallback(const std::wstring& name, LuaRef func)
 {
-    if (m_Mutex.try_lock())
-    {
-        if (m_callbacks.find(name) == m_callbacks.end())
-            m_callbacks.insert(make_pair(name, std::vector<LuaRef>()));
-        m_callbacks[name].push_back(func);
-        m_Mutex.unlock();
-    }
+    std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+    m_callbacks[name].push_back(func);
 }
 
 void Pyx::Scripting::Script::UnregisterCallback(const std::wstring& name, LuaRef func)
 {
-    if (m_Mutex.try_lock())
+    std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+    auto find = m_callbacks.find(name);
+    if (find == m_callbacks.end())
+        return;
+
+    auto& callbacks = find->second;
+    for (size_t i = 0; i < callbacks.size(); i++)
     {
-        for (auto& pair : m_callbacks)
+        if (callbacks[i].isIdenticalTo(func))
         {
-            for (int i = 0; i < pair.second.size(); i++)
-            {
-                if (pair.first == name && pair.second[i].isIdenticalTo(func))
-                {
-                    pair.second.erase(pair.second.begin() + i);
-                    return;
-                }
-            }
+            callbacks.erase(callbacks.begin() + i);
+            return;
         }
-        m_Mutex.unlock();
     }
 }
+
+bool Pyx::Scripting::ScriptLockSet::TryLock(Script* pScript)
+{
+    if (std::find(m_lockedScripts.begin(), m_lockedScripts.end(), pScript) != m_lockedScripts.end())
+        return true;
+    if (std::find(m_busyScripts.begin(), m_busyScripts.end(), pScript) != m_busyScripts.end())
+        return false;
+
+    std::unique_lock<std::recursive_mutex> lock(pScript->GetMutex(), std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        m_busyScripts.push_back(pScript);
+        return false;
+    }
+
+    m_locks.push_back(std::move(lock));
+    m_lockedScripts.push_back(pScript);
+    return true;
+}
@@ -1,11 +1,14 @@
 #pragma once
+#include <atomic>
 #include <map>
+#include <memory>
 #include <vector>
 #include <mutex>
 #include <Pyx/PyxContext.h>
 #include <Lua/lua.hpp>
 #include <Lua/LuaIntf.h>
 #include <Pyx/Utility/String.h>
+#include <Pyx/Profiling/Profiler.h>
 #include <string>
 #include <windows.h>
 
@@ -19,6 +22,7 @@ namespace LuaIntf
 {
     LUA_USING_LIST_TYPE(std::vector)
     LUA_USING_MAP_TYPE(std::map)
+    LUA_USING_SHARED_PTR_TYPE(std::shared_ptr)
 }
 
 namespace Pyx
@@ -32,11 +36,17 @@ namespace Pyx
             std::wstring m_name;
             std::wstring m_defFileName;
             std::wstring m_directory;
-            bool m_isRunning = false;
+            std::atomic<bool> m_isRunning{ false };
             std::map<std::wstring, std::vector<LuaRef>> m_callbacks;
             LuaState m_luaState;
             lua_State* m_pLuaState = nullptr;
             std::recursive_mutex m_Mutex;
+            std::atomic<int> m_logLevel;
+            const char* m_profileName;
+            std::atomic<uint64_t> m_errorCount{ 0 };
+            std::atomic<uint64_t> m_callbackCount{ 0 };
+            std::atomic<uint64_t> m_callbackTicks{ 0 };
+            std::atomic<uint64_t> m_luaMemory{ 0 };
 
         public:
             Script(const std::wstring& name, const std::wstring& defFileName);
@@ -47,10 +57,20 @@ namespace Pyx
             const std::wstring& GetName() const { return m_name; }
             std::map<std::wstring, std::vector<LuaRef>>& GetCallbacks() { return m_callbacks; }
             LuaState& GetLuaState() { return m_luaState; }
+            std::recursive_mutex& GetMutex() { return m_Mutex; }
             const std::wstring& GetDefFileName() const { return m_defFileName; }
             const std::wstring& GetScriptDirectory() const { return m_directory; }
             void RegisterCallback(const std::wstring& name, LuaRef func);
             void UnregisterCallback(const std::wstring& name, LuaRef func);
+            LogLevel GetLogLevel() const { return static_cast<LogLevel>(m_logLevel.load()); }
+            void SetLogLevel(LogLevel level) { m_logLevel = static_cast<int>(level); }
+            bool IsLogEnabled(LogLevel level) const { return static_cast<int>(level) >= m_logLevel.load(std::memory_order_relaxed) && Logging::LogContext::GetInstance().IsEnabled(LogCategory::Script, level); }
+            // Statistics read by the telemetry from other threads
+            void IncrementErrorCount() { m_errorCount.fetch_add(1, std::memory_order_relaxed); }
+            uint64_t GetErrorCount() const { return m_errorCount.load(std::memory_order_relaxed); }
+            uint64_t GetCallbackCount() const { return m_callbackCount.load(std::memory_order_relaxed); }
+            uint64_t GetCallbackTicks() const { return m_callbackTicks.load(std::memory_order_relaxed); } // Profiler ticks
+            uint64_t GetLuaMemory() const { return m_luaMemory.load(std::memory_order_relaxed); }
 
         public:
             template <typename P0, typename... P>
@@ -63,39 +83,84 @@ namespace Pyx
             {
                 // template terminate function
             }
+            // Waits for the callbacks being run on the other thread (render or
+            // pulse) since the Lua state can only be used by one thread at a time
             template<typename... Args>
             void FireCallback(const std::wstring& name, Args... args)
             {
-                if (m_Mutex.try_lock())
+                std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+                CallCallbacks(name, args...);
+            }
+            // Used by the render thread, which must not wait for a pulse : nothing
+            // is called and false is returned while another thread runs the script
+            template<typename... Args>
+            bool TryFireCallback(const std::wstring& name, Args... args)
+            {
+                std::unique_lock<std::recursive_mutex> lock(m_Mutex, std::try_to_lock);
+                if (!lock.owns_lock())
+                    return false;
+                CallCallbacks(name, args...);
+                return true;
+            }
+
+        private:
+            template<typename... Args>
+            void CallCallbacks(const std::wstring& name, const Args&... args)
+            {
+                PYX_PROFILE_SCOPE(m_profileName);
+                auto find = m_callbacks.find(name);
+                if (find != m_callbacks.end())
                 {
-                    auto find = m_callbacks.find(name);
-                    if (find != m_callbacks.end())
+                    // Callbacks can register, unregister or stop the script
+                    auto callbacks = find->second;
+                    uint64_t beginTicks = Profiling::Profiler::GetTicks();
+                    for (auto& f : callbacks)
                     {
-                        for (auto& f : find->second)
-                        {
-                            lua_State* L = m_luaState;
-                            lua_pushcfunction(L, &LuaException::traceback);
-                            f.pushToStack();
-                            pushArg(L, std::forward<Args>(args)...);
-                            if (lua_pcall(L, sizeof...(Args), 0, -int(sizeof...(Args)+2)) != LUA_OK) {
-                                lua_remove(L, -2);
-                                std::string luaError;
-                                if (lua_gettop(L) > 0) {
-                                    luaError = lua_tostring(L, -1);
-                                }
-                                else {
-                                    luaError = "Unknown error";
-                                }
-                                PyxContext::GetInstance().Log(XorStringW(L"Error in script \"%s\" in callback \"%s\""), m_name.c_str(), name.c_str());
-                                PyxContext::GetInstance().Log(luaError);
+                        if (!IsRunning())
+                            break;
+                        lua_State* L = m_luaState;
+                        lua_pushcfunction(L, &LuaException::traceback);
+                        f.pushToStack();
+                        pushArg(L, args...);
+                        if (lua_pcall(L, sizeof...(Args), 0, -int(sizeof...(Args)+2)) != LUA_OK) {
+                            lua_remove(L, -2);
+                            std::string luaError;
+                            if (lua_gettop(L) > 0) {
+                                luaError = lua_tostring(L, -1);
+                            }
+                            else {
+                                luaError = "Unknown error";
                             }
-                            lua_pop(L, 1);
+                            PYX_LOG_ERROR(Script, XorStringStaticW(L"Error in script \"%s\" in callback \"%s\""), m_name.c_str(), name.c_str());
+                            PYX_LOG_ERROR(Script, luaError);
+                            IncrementErrorCount();
                         }
+                        lua_pop(L, 1);
                     }
-                    m_Mutex.unlock();
+                    lua_State* L = m_luaState;
+                    m_luaMemory.store(static_cast<uint64_t>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0), std::memory_order_relaxed);
+                    m_callbackCount.fetch_add(callbacks.size(), std::memory_order_relaxed);
+                    m_callbackTicks.fetch_add(Profiling::Profiler::GetTicks() - beginTicks, std::memory_order_relaxed);
                 }
             }
 
         };
+
+        // Script locks taken by the render thread without waiting, for the
+        // events queued by the workers. A script busy with a pulse stays busy
+        // for the whole dispatch so its events are never reordered, and the
+        // locked scripts can't be stopped until the set is released.
+        class ScriptLockSet
+        {
+
+        private:
+            std::vector<std::unique_lock<std::recursive_mutex>> m_locks;
+            std::vector<Script*> m_lockedScripts;
+            std::vector<Script*> m_busyScripts;
+
+        public:
+            bool TryLock(Script* pScript);
+
+        };
     }
 }
\ No newline at end of file
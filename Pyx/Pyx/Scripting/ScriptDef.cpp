@@ -113,9 +113,9 @@ bool Pyx::Scripting::ScriptDef::Run(LuaIntf::LuaState& luaState)
         std::string content((std::istreambuf_iterator<char>(fs)), (std::istreambuf_iterator<char>()));
         if (luaState.doString(content.c_str()))
         {
-            PyxContext::GetInstance().Log(L"Error in file : \"" + file + L"\" :");
+            PYX_LOG_ERROR(Scripting, L"Error in file : \"" + file + L"\" :");
             std::string error = luaState.getString(-1);
-            PyxContext::GetInstance().Log(error);
+            PYX_LOG_ERROR(Scripting, error);
             return false;
         }
 
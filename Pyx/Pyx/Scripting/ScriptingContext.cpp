@@ -23,6 +23,7 @@ void Pyx::Scripting::ScriptingContext::Initialize()
 
 void Pyx::Scripting::ScriptingContext::Shutdown()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     for (auto* pScript : m_scripts)
     {
         pScript->Stop();
@@ -37,9 +38,10 @@ bool compareStudents(Pyx::Scripting::Script* a, Pyx::Scripting::Script* b) {
 
 void Pyx::Scripting::ScriptingContext::ReloadScripts()
 {
-    PyxContext::GetInstance().Log(XorStringA("[Scripting] Reloading scripts ..."));
+    PYX_LOG_INFO(Scripting, XorStringStaticA("[Scripting] Reloading scripts ..."));
 
     const auto& pyxSettings = PyxContext::GetInstance().GetSettings();
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
     for (auto* pScript : m_scripts)
     {
@@ -71,7 +73,7 @@ void Pyx::Scripting::ScriptingContext::ReloadScripts()
                 ScriptDef scriptDef(fileName);
                 if (scriptDef.IsScript())
                 {
-                    PyxContext::GetInstance().Log(XorStringW(L"[Scripting] Found script \"%s\""), scriptDef.GetName().c_str());
+                    PYX_LOG_DEBUG(Scripting, XorStringStaticW(L"[Scripting] Found script \"%s\""), scriptDef.GetName().c_str());
                     m_scripts.push_back(new Script(scriptDef.GetName(), fileName));
                 }
             }
@@ -1,4 +1,5 @@
 #pragma once
+#include <mutex>
 #include <set>
 #include <Pyx/Scripting/Script.h>
 
@@ -19,6 +20,7 @@ namespace Pyx
 
         private:
             std::vector<Script*> m_scripts;
+            std::recursive_mutex m_mutex;
             Utility::Callbacks<OnStartScriptCallback> m_OnStartScriptCallbacks;
 
         public:
@@ -28,6 +30,9 @@ namespace Pyx
             void Shutdown();
             void ReloadScripts();
             std::vector<Script*> GetScripts() const { return m_scripts; }
+            // Held by the pulse thread while it runs the scripts, scripts can't
+            // be started, stopped or deleted by other threads meanwhile
+            std::recursive_mutex& GetMutex() { return m_mutex; }
             Utility::Callbacks<OnStartScriptCallback>& GetOnStartScriptCallbacks() { return m_OnStartScriptCallbacks; };
             template<typename... Args>
             void FireCallbacks(const std::wstring& name, Args&&... args)
@@ -36,7 +41,20 @@ namespace Pyx
                 {
                     if (pScript->IsRunning())
                     {
-                        pScript->FireCallback(name, std::forward<Args>(args)...);
+                        pScript->FireCallback(name, args...);
+                    }
+                }
+            }
+            // Render thread version : the scripts busy with a pulse are skipped
+            // for this frame instead of stalling it
+            template<typename... Args>
+            void TryFireCallbacks(const std::wstring& name, Args&&... args)
+            {
+                for (Script* pScript : m_scripts)
+                {
+                    if (pScript->IsRunning())
+                    {
+                        pScript->TryFireCallback(name, args...);
                     }
                 }
             }
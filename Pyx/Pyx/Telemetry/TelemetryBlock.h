@@ -0,0 +1,150 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace Pyx
+{
+    namespace Telemetry
+    {
+        // Metrics published by every instance in a named shared memory block,
+        // external tools map it read only. The data is protected by a seqlock :
+        // the sequence is odd while the single writer (the render thread)
+        // updates it, readers retry until they copied it between two equal
+        // even sequences. This header is shared with PyxCli and must only
+        // depend on the STL.
+        class TelemetryBlock
+        {
+
+        public:
+            static const uint32_t Magic = 0x54585950; // "PYXT"
+            static const uint32_t Version = 1;
+            static const size_t MaxScripts = 64;
+            static const size_t ScriptNameLength = 48;
+            // Frame times in microseconds, 4 buckets per power of two up to ~2s
+            static const size_t SubBucketBits = 2;
+            static const size_t SubBucketCount = 1 << SubBucketBits;
+            static const size_t BucketCount = 80;
+
+            struct ScriptStats
+            {
+                char Name[ScriptNameLength];    // UTF-8, truncated
+                uint32_t IsRunning;
+                uint32_t Reserved;
+                uint64_t ErrorCount;
+                uint64_t CallbackCount;
+                uint64_t CallbackTime;          // Microseconds spent in callbacks
+                uint64_t LuaMemory;             // Bytes
+            };
+
+            struct Data
+            {
+                uint64_t UpdateTime;            // FILETIME of the last update
+                uint64_t FrameCount;
+                uint64_t LastFrameTime;         // Microseconds
+                uint64_t FrameTimeHistogram[BucketCount];
+                uint64_t ScriptErrorCount;
+                uint64_t PulseCount;
+                uint64_t DroppedPulseCount;
+                uint64_t LogWrittenCount;
+                uint64_t LogDroppedCount;
+                uint64_t WorkingSetSize;        // Bytes
+                uint64_t PrivateUsage;          // Bytes
+                uint32_t ScriptCount;
+                uint32_t Reserved;
+                ScriptStats Scripts[MaxScripts];
+            };
+
+            struct Header
+            {
+                uint32_t Magic;
+                uint32_t Version;
+                uint32_t ProcessId;
+                uint32_t Size;                  // Of the whole block
+                uint64_t StartTime;             // FILETIME
+                std::atomic<uint32_t> Sequence;
+                uint32_t Reserved;
+            };
+
+            struct Block
+            {
+                TelemetryBlock::Header Header;
+                TelemetryBlock::Data Data;
+            };
+
+        public:
+            static std::wstring GetMappingName(uint32_t processId)
+            {
+                return L"Local\\Pyx.Telemetry." + std::to_wstring(processId);
+            }
+
+            static size_t GetBucket(uint64_t value)
+            {
+                if (value < SubBucketCount)
+                    return static_cast<size_t>(value);
+                size_t octave = SubBucketBits;
+                while (octave < 63 && (value >> (octave + 1)) != 0)
+                    octave++;
+                size_t bucket = (octave - SubBucketBits + 1) * SubBucketCount + static_cast<size_t>((value >> (octave - SubBucketBits)) & (SubBucketCount - 1));
+                return bucket < BucketCount ? bucket : BucketCount - 1;
+            }
+
+            // Smallest value of a bucket, the bucket ends where the next one starts
+            static uint64_t GetBucketLowerBound(size_t bucket)
+            {
+                if (bucket < SubBucketCount)
+                    return bucket;
+                size_t octave = bucket / SubBucketCount - 1 + SubBucketBits;
+                return static_cast<uint64_t>(SubBucketCount + bucket % SubBucketCount) << (octave - SubBucketBits);
+            }
+
+            static uint64_t GetPercentile(const uint64_t* pHistogram, double percentile)
+            {
+                uint64_t totalCount = 0;
+                for (size_t i = 0; i < BucketCount; i++)
+                    totalCount += pHistogram[i];
+                if (totalCount == 0)
+                    return 0;
+
+                uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * (totalCount - 1));
+                uint64_t count = 0;
+                for (size_t i = 0; i < BucketCount; i++)
+                {
+                    count += pHistogram[i];
+                    if (count > rank)
+                        return GetBucketLowerBound(i + 1);
+                }
+                return GetBucketLowerBound(BucketCount);
+            }
+
+            static void BeginWrite(Block* pBlock)
+            {
+                pBlock->Header.Sequence.store(pBlock->Header.Sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+
+            static void EndWrite(Block* pBlock)
+            {
+                pBlock->Header.Sequence.store(pBlock->Header.Sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            // Fails when the writer kept updating the block during every attempt
+            static bool Read(const Block* pBlock, Data& data, size_t maxAttempts = 1000)
+            {
+                for (size_t attempt = 0; attempt < maxAttempts; attempt++)
+                {
+                    uint32_t sequence = pBlock->Header.Sequence.load(std::memory_order_acquire);
+                    if (sequence & 1)
+                        continue;
+                    memcpy(&data, &pBlock->Data, sizeof(Data));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (pBlock->Header.Sequence.load(std::memory_order_relaxed) == sequence)
+                        return true;
+                }
+                return false;
+            }
+
+        };
+    }
+}
@@ -0,0 +1,159 @@
+#include <Pyx/Telemetry/TelemetryContext.h>
+#include <Pyx/Scripting/ScriptingContext.h>
+#include <Pyx/Scripting/PulseScheduler.h>
+#include <Pyx/Logging/LogContext.h>
+#include <Pyx/Profiling/Profiler.h>
+#include <Pyx/Utility/String.h>
+#include <Psapi.h>
+#pragma comment(lib, "psapi.lib")
+
+namespace
+{
+    uint64_t GetFileTime()
+    {
+        FILETIME fileTime;
+        GetSystemTimeAsFileTime(&fileTime);
+        return (static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime;
+    }
+}
+
+Pyx::Telemetry::TelemetryContext& Pyx::Telemetry::TelemetryContext::GetInstance()
+{
+    static TelemetryContext ctx;
+    return ctx;
+}
+
+Pyx::Telemetry::TelemetryContext::TelemetryContext()
+    : m_hMapping(nullptr),
+    m_pBlock(nullptr),
+    m_lastPresent(0),
+    m_lastUpdate(0),
+    m_updateInterval(0)
+{
+    m_frequency.QuadPart = 0;
+}
+
+Pyx::Telemetry::TelemetryContext::~TelemetryContext()
+{
+}
+
+void Pyx::Telemetry::TelemetryContext::Initialize(const PyxInitSettings& settings)
+{
+    if (m_pBlock || !settings.TelemetryEnabled)
+        return;
+
+    // Backed by the paging file, the block disappears with the last handle
+    DWORD processId = GetCurrentProcessId();
+    m_hMapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(TelemetryBlock::Block), TelemetryBlock::GetMappingName(processId).c_str());
+    if (!m_hMapping)
+        return;
+
+    auto* pBlock = static_cast<TelemetryBlock::Block*>(MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, sizeof(TelemetryBlock::Block)));
+    if (!pBlock)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+        return;
+    }
+
+    memset(pBlock, 0, sizeof(TelemetryBlock::Block));
+    pBlock->Header.ProcessId = processId;
+    pBlock->Header.Size = sizeof(TelemetryBlock::Block);
+    pBlock->Header.StartTime = GetFileTime();
+    pBlock->Header.Version = TelemetryBlock::Version;
+    // Readers check the magic first, it is only set once the header is valid
+    std::atomic_thread_fence(std::memory_order_release);
+    pBlock->Header.Magic = TelemetryBlock::Magic;
+
+    QueryPerformanceFrequency(&m_frequency);
+    m_updateInterval = m_frequency.QuadPart * settings.TelemetryUpdateInterval / 1000;
+    m_lastPresent = 0;
+    m_lastUpdate = 0;
+    m_pBlock = pBlock;
+}
+
+void Pyx::Telemetry::TelemetryContext::Shutdown()
+{
+    auto* pBlock = m_pBlock;
+    m_pBlock = nullptr;
+    if (pBlock)
+        UnmapViewOfFile(pBlock);
+    if (m_hMapping)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+}
+
+void Pyx::Telemetry::TelemetryContext::OnPresent()
+{
+    auto* pBlock = m_pBlock;
+    if (!pBlock)
+        return;
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    int64_t now = counter.QuadPart;
+    int64_t lastPresent = m_lastPresent;
+    m_lastPresent = now;
+    if (lastPresent == 0)
+        return;
+
+    uint64_t frameTime = static_cast<uint64_t>((now - lastPresent) * 1000000 / m_frequency.QuadPart);
+    TelemetryBlock::BeginWrite(pBlock);
+    pBlock->Data.FrameCount++;
+    pBlock->Data.LastFrameTime = frameTime;
+    pBlock->Data.FrameTimeHistogram[TelemetryBlock::GetBucket(frameTime)]++;
+    if (now - m_lastUpdate >= m_updateInterval)
+    {
+        UpdateStats();
+        m_lastUpdate = now;
+    }
+    pBlock->Data.UpdateTime = GetFileTime();
+    TelemetryBlock::EndWrite(pBlock);
+}
+
+void Pyx::Telemetry::TelemetryContext::UpdateStats()
+{
+    auto& data = m_pBlock->Data;
+
+    PROCESS_MEMORY_COUNTERS_EX memoryCounters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&memoryCounters), sizeof(memoryCounters)))
+    {
+        data.WorkingSetSize = memoryCounters.WorkingSetSize;
+        data.PrivateUsage = memoryCounters.PrivateUsage;
+    }
+
+    auto& pulseScheduler = Scripting::PulseScheduler::GetInstance();
+    data.PulseCount = pulseScheduler.GetPulseCount();
+    data.DroppedPulseCount = pulseScheduler.GetDroppedCount();
+    auto logStats = Logging::LogContext::GetInstance().GetStats();
+    data.LogWrittenCount = logStats.Written;
+    data.LogDroppedCount = logStats.Dropped;
+
+    // The list of scripts can only be read while they can't be reloaded, the
+    // previous values are kept when the pulse thread is running them
+    auto& scriptingContext = Scripting::ScriptingContext::GetInstance();
+    if (!scriptingContext.GetMutex().try_lock())
+        return;
+
+    double ticksPerMicrosecond = Profiling::Profiler::GetInstance().GetTicksPerMicrosecond();
+    auto scripts = scriptingContext.GetScripts();
+    size_t scriptCount = scripts.size() < TelemetryBlock::MaxScripts ? scripts.size() : TelemetryBlock::MaxScripts;
+    uint64_t errorCount = 0;
+    for (size_t i = 0; i < scriptCount; i++)
+    {
+        auto* pScript = scripts[i];
+        auto& stats = data.Scripts[i];
+        strncpy_s(stats.Name, Utility::String::utf8_encode(pScript->GetName()).c_str(), _TRUNCATE);
+        stats.IsRunning = pScript->IsRunning() ? 1 : 0;
+        stats.ErrorCount = pScript->GetErrorCount();
+        stats.CallbackCount = pScript->GetCallbackCount();
+        stats.CallbackTime = static_cast<uint64_t>(pScript->GetCallbackTicks() / ticksPerMicrosecond);
+        stats.LuaMemory = pScript->GetLuaMemory();
+        errorCount += stats.ErrorCount;
+    }
+    data.ScriptCount = static_cast<uint32_t>(scriptCount);
+    data.ScriptErrorCount = errorCount;
+    scriptingContext.GetMutex().unlock();
+}
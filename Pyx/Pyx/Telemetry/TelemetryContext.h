@@ -0,0 +1,43 @@
+#pragma once
+#include <Windows.h>
+#include <Pyx/PyxInitSettings.h>
+#include <Pyx/Telemetry/TelemetryBlock.h>
+#include <cstdint>
+
+namespace Pyx
+{
+    namespace Telemetry
+    {
+        // Publishes the TelemetryBlock of this process. Everything is written
+        // from the render thread on present : the frame time every frame, the
+        // rest (scripts, memory, counters) at the update interval. Nothing
+        // here waits on a lock, the scripts are skipped until their mutex is
+        // free.
+        class TelemetryContext
+        {
+
+        public:
+            static TelemetryContext& GetInstance();
+
+        private:
+            HANDLE m_hMapping;
+            TelemetryBlock::Block* m_pBlock;
+            LARGE_INTEGER m_frequency;
+            int64_t m_lastPresent;
+            int64_t m_lastUpdate;
+            int64_t m_updateInterval;
+
+        private:
+            void UpdateStats();
+
+        public:
+            explicit TelemetryContext();
+            ~TelemetryContext();
+            void Initialize(const PyxInitSettings& settings);
+            void Shutdown();
+            void OnPresent();
+            bool IsPublishing() const { return m_pBlock != nullptr; }
+
+        };
+    }
+}
@@ -0,0 +1,161 @@
+#include <Pyx/Threading/Future.h>
+#include <algorithm>
+
+void Pyx::Threading::Future::BindWithScript(Pyx::Scripting::Script* pScript)
+{
+    LuaBinding(pScript->GetLuaState())
+        .beginModule("Pyx")
+        .beginModule("Threading")
+        .addFunction("GetWorkerCount", []() { return JobSystem::GetInstance().GetWorkerCount(); })
+        .beginClass<Future>("Future")
+        .addPropertyReadOnly("IsCompleted", &Future::IsCompleted)
+        .addPropertyReadOnly("IsCancelled", &Future::IsCancelled)
+        .addFunction("GetResult", [](const Future* pFuture, lua_State* L) { return pFuture->GetResult(L); }, LUA_ARGS(lua_State*))
+        .addFunction("Then", &Future::Then)
+        .addFunction("Cancel", &Future::Cancel)
+        .endClass();
+}
+
+Pyx::Threading::Future::PendingFutures& Pyx::Threading::Future::GetPendingFutures()
+{
+    static PendingFutures pendingFutures;
+    return pendingFutures;
+}
+
+void Pyx::Threading::Future::DispatchCompleted()
+{
+    // Called from the render thread, the futures of the scripts busy with a
+    // pulse stay pending until the next frame
+    Scripting::ScriptLockSet scriptLocks;
+    std::vector<std::shared_ptr<Future>> completedFutures;
+    {
+        auto& pendingFutures = GetPendingFutures();
+        std::lock_guard<std::mutex> lock(pendingFutures.Mutex);
+        auto& futures = pendingFutures.Futures;
+        if (futures.empty())
+            return;
+
+        auto it = std::stable_partition(futures.begin(), futures.end(), [&scriptLocks](const std::shared_ptr<Future>& pFuture)
+        {
+            return !pFuture->IsCompleted() || !scriptLocks.TryLock(pFuture->m_pScript);
+        });
+        completedFutures.assign(std::make_move_iterator(it), std::make_move_iterator(futures.end()));
+        futures.erase(it, futures.end());
+    }
+
+    for (auto& pFuture : completedFutures)
+    {
+        auto callbacks = std::move(pFuture->m_callbacks);
+        pFuture->m_callbacks.clear();
+        if (pFuture->IsCancelled() || !pFuture->m_pScript->IsRunning())
+            continue;
+
+        for (auto& callback : callbacks)
+        {
+            lua_State* L = callback.state();
+            lua_pushcfunction(L, &LuaException::traceback);
+            callback.pushToStack();
+            pFuture->m_pushResult(L);
+            if (lua_pcall(L, 1, 0, -3) != LUA_OK)
+            {
+                std::string luaError = lua_gettop(L) > 0 ? lua_tostring(L, -1) : "Unknown error";
+                PYX_LOG_ERROR(Script, XorStringStaticW(L"Error in script \"%s\" in future callback"), pFuture->m_pScript->GetName().c_str());
+                PYX_LOG_ERROR(Script, luaError);
+                pFuture->m_pScript->IncrementErrorCount();
+                lua_pop(L, 1);
+            }
+            lua_pop(L, 1);
+        }
+    }
+}
+
+void Pyx::Threading::Future::CancelAll(Pyx::Scripting::Script* pScript)
+{
+    std::vector<std::shared_ptr<Future>> cancelledFutures;
+    {
+        auto& pendingFutures = GetPendingFutures();
+        std::lock_guard<std::mutex> lock(pendingFutures.Mutex);
+        auto& futures = pendingFutures.Futures;
+        auto it = std::stable_partition(futures.begin(), futures.end(), [pScript](const std::shared_ptr<Future>& pFuture) { return pFuture->m_pScript != pScript; });
+        cancelledFutures.assign(std::make_move_iterator(it), std::make_move_iterator(futures.end()));
+        futures.erase(it, futures.end());
+    }
+
+    // The callbacks reference the Lua state of the script, they must be
+    // released before it is closed
+    for (auto& pFuture : cancelledFutures)
+    {
+        pFuture->Cancel();
+        pFuture->m_callbacks.clear();
+    }
+}
+
+Pyx::Threading::Future::Future(Pyx::Scripting::Script* pScript)
+    : m_pScript(pScript),
+    m_isCompleted(false),
+    m_isCancelled(false)
+{
+}
+
+Pyx::Threading::Future::~Future()
+{
+}
+
+void Pyx::Threading::Future::SetResult(tPushResult pushResult)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pushResult = std::move(pushResult);
+    m_isCompleted = true;
+    m_pJob.reset();
+}
+
+void Pyx::Threading::Future::SetJob(const std::shared_ptr<Job>& pJob)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_isCompleted)
+        m_pJob = pJob;
+}
+
+bool Pyx::Threading::Future::IsCompleted() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isCompleted || (m_pJob && m_pJob->IsCancelled());
+}
+
+bool Pyx::Threading::Future::IsCancelled() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isCancelled || (m_pJob && m_pJob->IsCancelled());
+}
+
+LuaRef Pyx::Threading::Future::GetResult(lua_State* L) const
+{
+    // The result is never modified once the future is completed
+    if (!IsCompleted() || IsCancelled())
+        return LuaRef(L, nullptr);
+
+    m_pushResult(L);
+    return LuaRef::popFromStack(L);
+}
+
+void Pyx::Threading::Future::Then(LuaRef callback)
+{
+    if (IsCancelled() || !callback.isFunction())
+        return;
+
+    // Callbacks are always called from DispatchCompleted, even when the
+    // future is already completed
+    m_callbacks.push_back(callback);
+    if (m_callbacks.size() == 1)
+    {
+        auto& pendingFutures = GetPendingFutures();
+        std::lock_guard<std::mutex> lock(pendingFutures.Mutex);
+        pendingFutures.Futures.push_back(shared_from_this());
+    }
+}
+
+void Pyx::Threading::Future::Cancel()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isCancelled = true;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <Pyx/Scripting/Script.h>
+#include <Pyx/Threading/JobSystem.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Pyx
+{
+    namespace Threading
+    {
+        // Result of a job for the scripts. The job computes a native value on a
+        // worker, scripts poll the future or register callbacks which are called
+        // with the converted result on the render thread.
+        class Future : public std::enable_shared_from_this<Future>
+        {
+
+        public:
+            typedef Utility::Delegate<void(lua_State*)> tPushResult;
+
+        private:
+            struct PendingFutures
+            {
+                std::mutex Mutex;
+                std::vector<std::shared_ptr<Future>> Futures;
+            };
+
+        public:
+            static void BindWithScript(Pyx::Scripting::Script* pScript);
+            static void DispatchCompleted();
+            static void CancelAll(Pyx::Scripting::Script* pScript);
+
+            template <typename F>
+            static std::shared_ptr<Future> Run(Pyx::Scripting::Script* pScript, F function, JobPriority priority = JobPriority::Normal)
+            {
+                auto pFuture = std::make_shared<Future>(pScript);
+                auto pJob = JobSystem::GetInstance().Schedule([pFuture, function]()
+                {
+                    auto result = function();
+                    pFuture->SetResult([result](lua_State* L) { Lua::push(L, result); });
+                }, priority);
+                pFuture->SetJob(pJob);
+                return pFuture;
+            }
+
+        private:
+            static PendingFutures& GetPendingFutures();
+
+        private:
+            Pyx::Scripting::Script* m_pScript;
+            mutable std::mutex m_mutex;
+            bool m_isCompleted;
+            bool m_isCancelled;
+            tPushResult m_pushResult;
+            // A job cancelled by the shutdown of the JobSystem completes the
+            // future as cancelled, it will never set a result
+            std::shared_ptr<Job> m_pJob;
+            std::vector<LuaRef> m_callbacks;
+
+        private:
+            void SetResult(tPushResult pushResult);
+            void SetJob(const std::shared_ptr<Job>& pJob);
+
+        public:
+            explicit Future(Pyx::Scripting::Script* pScript);
+            ~Future();
+            Future(const Future&) = delete;
+            Future& operator=(const Future&) = delete;
+            Pyx::Scripting::Script* GetScript() const { return m_pScript; }
+            bool IsCompleted() const;
+            bool IsCancelled() const;
+            LuaRef GetResult(lua_State* L) const;
+            void Then(LuaRef callback);
+            void Cancel();
+
+        };
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <Pyx/Utility/Delegate.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Pyx
+{
+    namespace Threading
+    {
+        class JobSystem;
+
+        enum class JobPriority
+        {
+            High,
+            Normal,
+            Low
+        };
+
+        // Unit of work of the JobSystem. A job becomes ready once all of the
+        // jobs it continues have completed, it is then queued on a worker.
+        // Jobs still queued when the system shuts down complete as cancelled
+        // without running, and so do their continuations.
+        class Job
+        {
+            friend class JobSystem;
+
+        private:
+            Utility::Delegate<void()> m_function;
+            JobPriority m_priority;
+            std::atomic<size_t> m_pendingDependencies;
+            std::atomic<bool> m_isCompleted;
+            std::atomic<bool> m_isCancelled;
+            std::mutex m_continuationsMutex;
+            std::vector<std::shared_ptr<Job>> m_continuations;
+
+        public:
+            explicit Job(Utility::Delegate<void()> function, JobPriority priority)
+                : m_function(std::move(function)), m_priority(priority), m_pendingDependencies(1), m_isCompleted(false), m_isCancelled(false) { }
+            Job(const Job&) = delete;
+            Job& operator=(const Job&) = delete;
+            JobPriority GetPriority() const { return m_priority; }
+            bool IsCompleted() const { return m_isCompleted.load(std::memory_order_acquire); }
+            bool IsCancelled() const { return m_isCancelled.load(std::memory_order_acquire); }
+
+            // Runs other queued jobs on the calling thread until this one completes
+            void Wait();
+
+        };
+    }
+}
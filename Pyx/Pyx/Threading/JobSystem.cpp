@@ -0,0 +1,280 @@
+#include <Pyx/Threading/JobSystem.h>
+#include <chrono>
+#include <cstdint>
+
+namespace
+{
+    // Index of the worker running on the current thread, SIZE_MAX elsewhere
+    thread_local size_t t_workerIndex = SIZE_MAX;
+}
+
+void Pyx::Threading::Job::Wait()
+{
+    auto& jobSystem = JobSystem::GetInstance();
+    size_t idleCount = 0;
+    while (!IsCompleted())
+    {
+        if (jobSystem.RunPendingJob())
+        {
+            idleCount = 0;
+            continue;
+        }
+        if (!jobSystem.IsRunning())
+            return;
+        if (++idleCount < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+Pyx::Threading::JobSystem& Pyx::Threading::JobSystem::GetInstance()
+{
+    static JobSystem ctx;
+    return ctx;
+}
+
+Pyx::Threading::JobSystem::JobSystem()
+    : m_isInitialized(false),
+    m_wakeCount(0),
+    m_nextWorker(0),
+    m_isRunning(false)
+{
+}
+
+Pyx::Threading::JobSystem::~JobSystem()
+{
+}
+
+void Pyx::Threading::JobSystem::Initialize(size_t workerCount)
+{
+    if (m_isInitialized)
+        return;
+    m_isInitialized = true;
+
+    // One processor is left to the render thread by default
+    if (workerCount == 0)
+    {
+        size_t processorCount = std::thread::hardware_concurrency();
+        workerCount = processorCount > 1 ? processorCount - 1 : 1;
+    }
+    m_wakeCount = 0;
+
+    // Every worker exists before the first thread starts stealing from them
+    m_workers.clear();
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        std::unique_ptr<Worker> pWorker(new Worker());
+        pWorker->pSystem = this;
+        pWorker->Index = i;
+        m_workers.push_back(std::move(pWorker));
+    }
+
+    m_isRunning.store(true, std::memory_order_release);
+    for (auto& pWorker : m_workers)
+        pWorker->Thread = std::thread(WorkerThread, pWorker.get());
+}
+
+void Pyx::Threading::JobSystem::Shutdown()
+{
+    if (!m_isInitialized)
+        return;
+    m_isInitialized = false;
+
+    // The jobs being run are waited for, the ones still queued complete as
+    // cancelled so that nothing waits on them forever
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_isRunning.store(false, std::memory_order_release);
+    }
+    m_wakeCondition.notify_all();
+    std::vector<std::shared_ptr<Job>> cancelledJobs;
+    for (auto& pWorker : m_workers)
+    {
+        if (pWorker->Thread.joinable())
+            pWorker->Thread.join();
+
+        std::lock_guard<std::mutex> lock(pWorker->Mutex);
+        for (auto& jobs : pWorker->Jobs)
+        {
+            cancelledJobs.insert(cancelledJobs.end(), jobs.begin(), jobs.end());
+            jobs.clear();
+        }
+    }
+
+    for (auto& pJob : cancelledJobs)
+    {
+        pJob->m_isCancelled.store(true, std::memory_order_release);
+        Execute(pJob);
+    }
+}
+
+std::shared_ptr<Pyx::Threading::Job> Pyx::Threading::JobSystem::Schedule(Utility::Delegate<void()> function, JobPriority priority)
+{
+    auto pJob = std::make_shared<Job>(std::move(function), priority);
+    pJob->m_pendingDependencies = 0;
+    Enqueue(pJob);
+    return pJob;
+}
+
+std::shared_ptr<Pyx::Threading::Job> Pyx::Threading::JobSystem::ScheduleAfter(const std::shared_ptr<Job>& pDependency, Utility::Delegate<void()> function, JobPriority priority)
+{
+    return ScheduleAfter(std::vector<std::shared_ptr<Job>>{ pDependency }, std::move(function), priority);
+}
+
+std::shared_ptr<Pyx::Threading::Job> Pyx::Threading::JobSystem::ScheduleAfter(const std::vector<std::shared_ptr<Job>>& dependencies, Utility::Delegate<void()> function, JobPriority priority)
+{
+    auto pJob = std::make_shared<Job>(std::move(function), priority);
+
+    // The extra dependency keeps the job from being queued by a dependency
+    // completing before all of them have been registered
+    pJob->m_pendingDependencies = dependencies.size() + 1;
+    for (auto& pDependency : dependencies)
+    {
+        bool isCompleted = true;
+        if (pDependency)
+        {
+            std::lock_guard<std::mutex> lock(pDependency->m_continuationsMutex);
+            isCompleted = pDependency->IsCompleted();
+            if (!isCompleted)
+                pDependency->m_continuations.push_back(pJob);
+        }
+        if (isCompleted)
+        {
+            if (pDependency && pDependency->IsCancelled())
+                pJob->m_isCancelled.store(true, std::memory_order_release);
+            pJob->m_pendingDependencies--;
+        }
+    }
+
+    if (--pJob->m_pendingDependencies == 0)
+        Enqueue(pJob);
+    return pJob;
+}
+
+bool Pyx::Threading::JobSystem::RunPendingJob()
+{
+    if (!IsRunning())
+        return false;
+
+    auto pJob = TakeJob(t_workerIndex);
+    if (!pJob)
+        return false;
+    Execute(pJob);
+    return true;
+}
+
+void Pyx::Threading::JobSystem::Enqueue(const std::shared_ptr<Job>& pJob)
+{
+    // Without workers the job is run right away so that waiting on it or on
+    // its continuations can't block forever
+    if (!IsRunning())
+    {
+        Execute(pJob);
+        return;
+    }
+
+    size_t index = t_workerIndex < m_workers.size() ? t_workerIndex : m_nextWorker++ % m_workers.size();
+    auto& worker = *m_workers[index];
+    {
+        std::lock_guard<std::mutex> lock(worker.Mutex);
+        worker.Jobs[static_cast<size_t>(pJob->m_priority)].push_back(pJob);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakeCount++;
+    }
+    m_wakeCondition.notify_one();
+}
+
+void Pyx::Threading::JobSystem::Execute(const std::shared_ptr<Job>& pJob)
+{
+    const bool isCancelled = pJob->IsCancelled();
+    if (!isCancelled)
+        pJob->m_function();
+    pJob->m_function.Reset();
+
+    std::vector<std::shared_ptr<Job>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(pJob->m_continuationsMutex);
+        pJob->m_isCompleted.store(true, std::memory_order_release);
+        continuations.swap(pJob->m_continuations);
+    }
+
+    for (auto& pContinuation : continuations)
+    {
+        if (isCancelled)
+            pContinuation->m_isCancelled.store(true, std::memory_order_release);
+        if (--pContinuation->m_pendingDependencies == 0)
+            Enqueue(pContinuation);
+    }
+}
+
+std::shared_ptr<Pyx::Threading::Job> Pyx::Threading::JobSystem::TakeJob(size_t workerIndex)
+{
+    const size_t workerCount = m_workers.size();
+    if (workerCount == 0)
+        return nullptr;
+
+    // Higher priorities first, the own deque from its back before stealing
+    // from the front of the other ones
+    for (size_t priority = 0; priority < PriorityCount; priority++)
+    {
+        if (workerIndex < workerCount)
+        {
+            auto& worker = *m_workers[workerIndex];
+            std::lock_guard<std::mutex> lock(worker.Mutex);
+            auto& jobs = worker.Jobs[priority];
+            if (!jobs.empty())
+            {
+                auto pJob = std::move(jobs.back());
+                jobs.pop_back();
+                return pJob;
+            }
+        }
+
+        size_t first = workerIndex < workerCount ? workerIndex + 1 : 0;
+        for (size_t i = 0; i < workerCount; i++)
+        {
+            size_t victimIndex = (first + i) % workerCount;
+            if (victimIndex == workerIndex)
+                continue;
+
+            auto& victim = *m_workers[victimIndex];
+            std::lock_guard<std::mutex> lock(victim.Mutex);
+            auto& jobs = victim.Jobs[priority];
+            if (!jobs.empty())
+            {
+                auto pJob = std::move(jobs.front());
+                jobs.pop_front();
+                return pJob;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void Pyx::Threading::JobSystem::WorkerThread(Worker* pWorker)
+{
+    auto* pSystem = pWorker->pSystem;
+    t_workerIndex = pWorker->Index;
+
+    while (pSystem->IsRunning())
+    {
+        auto pJob = pSystem->TakeJob(pWorker->Index);
+        if (pJob)
+        {
+            pSystem->Execute(pJob);
+            continue;
+        }
+
+        // Every queued job is counted once it is in a deque, a job queued
+        // after the search above can't be missed
+        std::unique_lock<std::mutex> lock(pSystem->m_wakeMutex);
+        pSystem->m_wakeCondition.wait(lock, [pSystem]() { return pSystem->m_wakeCount != 0 || !pSystem->IsRunning(); });
+        if (!pSystem->IsRunning())
+            break;
+        pSystem->m_wakeCount--;
+    }
+}
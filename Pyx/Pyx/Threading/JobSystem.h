@@ -0,0 +1,70 @@
+#pragma once
+#include <Pyx/Threading/Job.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Pyx
+{
+    namespace Threading
+    {
+        // Shared pool of worker threads for native background work. Each worker
+        // owns a deque per priority, it takes its newest jobs first while idle
+        // workers steal the oldest ones of the others. Jobs scheduled from other
+        // threads are spread over the workers.
+        class JobSystem
+        {
+
+        public:
+            static const size_t PriorityCount = 3;
+
+        private:
+            struct Worker
+            {
+                JobSystem* pSystem;
+                size_t Index;
+                std::thread Thread;
+                std::mutex Mutex;
+                std::deque<std::shared_ptr<Job>> Jobs[PriorityCount];
+            };
+
+        private:
+            static void WorkerThread(Worker* pWorker);
+
+        public:
+            static JobSystem& GetInstance();
+
+        private:
+            std::vector<std::unique_ptr<Worker>> m_workers;
+            bool m_isInitialized;
+            // Counts the queued jobs no idle worker has been woken for yet
+            std::mutex m_wakeMutex;
+            std::condition_variable m_wakeCondition;
+            size_t m_wakeCount;
+            std::atomic<size_t> m_nextWorker;
+            std::atomic<bool> m_isRunning;
+
+        private:
+            void Enqueue(const std::shared_ptr<Job>& pJob);
+            void Execute(const std::shared_ptr<Job>& pJob);
+            std::shared_ptr<Job> TakeJob(size_t workerIndex);
+
+        public:
+            explicit JobSystem();
+            ~JobSystem();
+            void Initialize(size_t workerCount = 0);
+            void Shutdown();
+            bool IsRunning() const { return m_isRunning.load(std::memory_order_acquire); }
+            size_t GetWorkerCount() const { return m_workers.size(); }
+            std::shared_ptr<Job> Schedule(Utility::Delegate<void()> function, JobPriority priority = JobPriority::Normal);
+            std::shared_ptr<Job> ScheduleAfter(const std::shared_ptr<Job>& pDependency, Utility::Delegate<void()> function, JobPriority priority = JobPriority::Normal);
+            std::shared_ptr<Job> ScheduleAfter(const std::vector<std::shared_ptr<Job>>& dependencies, Utility::Delegate<void()> function, JobPriority priority = JobPriority::Normal);
+            bool RunPendingJob();
+
+        };
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Pyx
+{
+    namespace Threading
+    {
+        // Bounded lock free ring for any number of producers and a single
+        // consumer (D. Vyukov's sequence numbered cells). Pushing never blocks,
+        // it fails when the ring is full and the caller decides what to do.
+        template<typename T>
+        class MpscRing
+        {
+
+        private:
+            struct Cell
+            {
+                std::atomic<size_t> Sequence;
+                T Value;
+            };
+
+        private:
+            std::unique_ptr<Cell[]> m_pCells;
+            size_t m_mask;
+            alignas(64) std::atomic<size_t> m_enqueuePosition;
+            alignas(64) size_t m_dequeuePosition;
+
+        public:
+            explicit MpscRing(size_t capacity)
+                : m_enqueuePosition(0),
+                m_dequeuePosition(0)
+            {
+                size_t size = 2;
+                while (size < capacity)
+                    size <<= 1;
+                m_pCells.reset(new Cell[size]);
+                m_mask = size - 1;
+                for (size_t i = 0; i < size; i++)
+                    m_pCells[i].Sequence.store(i, std::memory_order_relaxed);
+            }
+
+            size_t GetCapacity() const { return m_mask + 1; }
+
+            bool TryPush(T&& value)
+            {
+                size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    Cell& cell = m_pCells[position & m_mask];
+                    size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+                    intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                    if (difference == 0)
+                    {
+                        if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            cell.Value = std::move(value);
+                            cell.Sequence.store(position + 1, std::memory_order_release);
+                            return true;
+                        }
+                    }
+                    else if (difference < 0)
+                        return false;
+                    else
+                        position = m_enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            // Must only be called by one thread at a time
+            bool TryPop(T& value)
+            {
+                Cell& cell = m_pCells[m_dequeuePosition & m_mask];
+                size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+                if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(m_dequeuePosition + 1) < 0)
+                    return false;
+                value = std::move(cell.Value);
+                cell.Sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+                m_dequeuePosition++;
+                return true;
+            }
+
+        };
+    }
+}
@@ -0,0 +1,106 @@
+#include <Pyx/Threading/StageGraph.h>
+#include <Pyx/Threading/JobSystem.h>
+#include <chrono>
+#include <exception>
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    double GetElapsedMs(const Clock::time_point& startTime)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+    }
+}
+
+Pyx::Threading::StageGraph::StageGraph()
+    : m_duration(0)
+{
+}
+
+size_t Pyx::Threading::StageGraph::AddStage(const std::string& name, Utility::Delegate<void()> function, const std::vector<size_t>& dependencies)
+{
+    size_t index = m_stages.size();
+    std::vector<size_t> validDependencies;
+    for (auto dependency : dependencies)
+    {
+        if (dependency < index)
+            validDependencies.push_back(dependency);
+    }
+    m_stages.push_back(Stage{ name, std::move(function), std::move(validDependencies), StageState::Pending, std::string(), 0, 0 });
+    return index;
+}
+
+bool Pyx::Threading::StageGraph::Run()
+{
+    auto startTime = Clock::now();
+
+    // Stages only reference earlier ones, creating the jobs in order gives
+    // every stage the jobs of its dependencies
+    auto& jobSystem = JobSystem::GetInstance();
+    std::vector<std::shared_ptr<Job>> jobs;
+    jobs.reserve(m_stages.size());
+    for (auto& stage : m_stages)
+    {
+        std::vector<std::shared_ptr<Job>> dependencies;
+        for (auto dependency : stage.Dependencies)
+            dependencies.push_back(jobs[dependency]);
+
+        stage.State = StageState::Pending;
+        stage.Error.clear();
+        auto* pStage = &stage;
+        auto* pStages = &m_stages;
+        jobs.push_back(jobSystem.ScheduleAfter(dependencies, [pStage, pStages, startTime]()
+        {
+            // The dependencies are written before their job completes, which
+            // happens before this one is queued
+            pStage->StartTime = GetElapsedMs(startTime);
+            for (auto dependency : pStage->Dependencies)
+            {
+                if ((*pStages)[dependency].State != StageState::Completed)
+                {
+                    pStage->State = StageState::Skipped;
+                    pStage->Error = "depends on " + (*pStages)[dependency].Name;
+                    pStage->Duration = 0;
+                    return;
+                }
+            }
+
+            // An exception must not leave a worker thread, it fails the stage
+            try
+            {
+                if (pStage->Function)
+                    pStage->Function();
+                pStage->State = StageState::Completed;
+            }
+            catch (const std::exception& exception)
+            {
+                pStage->State = StageState::Failed;
+                pStage->Error = exception.what();
+            }
+            catch (...)
+            {
+                pStage->State = StageState::Failed;
+                pStage->Error = "unknown exception";
+            }
+            pStage->Duration = GetElapsedMs(startTime) - pStage->StartTime;
+        }, JobPriority::High));
+    }
+
+    for (auto& pJob : jobs)
+        pJob->Wait();
+    m_duration = GetElapsedMs(startTime);
+
+    bool isSuccess = true;
+    for (size_t i = 0; i < m_stages.size(); i++)
+    {
+        // A job cancelled by a shutdown never ran its function
+        if (jobs[i]->IsCancelled() && m_stages[i].State == StageState::Pending)
+        {
+            m_stages[i].State = StageState::Skipped;
+            m_stages[i].Error = "cancelled";
+        }
+        isSuccess &= m_stages[i].State == StageState::Completed;
+    }
+    return isSuccess;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <Pyx/Utility/Delegate.h>
+#include <string>
+#include <vector>
+
+namespace Pyx
+{
+    namespace Threading
+    {
+        enum class StageState
+        {
+            Pending,
+            Completed,
+            Failed,     // The function threw, Error holds the reason
+            Skipped     // A dependency didn't complete, the function wasn't run
+        };
+
+        // Named steps run on the JobSystem once the stages they depend on are
+        // done, independent stages run in parallel. Dependencies can only be
+        // stages added before, the graph can't have cycles.
+        class StageGraph
+        {
+
+        public:
+            struct Stage
+            {
+                std::string Name;
+                Utility::Delegate<void()> Function;
+                std::vector<size_t> Dependencies;
+                StageState State;
+                std::string Error;
+                double StartTime;   // Milliseconds since the start of Run
+                double Duration;    // Milliseconds
+            };
+
+        private:
+            std::vector<Stage> m_stages;
+            double m_duration;
+
+        public:
+            explicit StageGraph();
+            size_t AddStage(const std::string& name, Utility::Delegate<void()> function, const std::vector<size_t>& dependencies = {});
+            // Returns false when a stage failed or was skipped
+            bool Run();
+            const std::vector<Stage>& GetStages() const { return m_stages; }
+            double GetDuration() const { return m_duration; }
+
+        };
+    }
+}
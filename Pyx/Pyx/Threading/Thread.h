@@ -1,27 +1,43 @@
 #pragma once
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <sys/types.h>
+#endif
 
 namespace Pyx
 {
     namespace Threading
     {
+#ifdef _WIN32
+        typedef DWORD ThreadId;
+#else
+        typedef pid_t ThreadId;
+#endif
+
         class Thread
         {
 
         private:
+#ifdef _WIN32
             HANDLE m_hThread;
-            DWORD m_threadId;
+#endif
+            ThreadId m_threadId;
             bool m_isSuspended;
 
         public:
+#ifdef _WIN32
             explicit Thread(DWORD threadId)
                 : m_isSuspended(false)
             {
                 m_hThread = OpenThread(THREAD_ALL_ACCESS, FALSE, threadId);
                 m_threadId = threadId;
             }
+            explicit Thread(DWORD threadId, HANDLE hThread)
+                : m_hThread(hThread), m_threadId(threadId), m_isSuspended(false)
+            {
+            }
             ~Thread() { CloseHandle(m_hThread); }
-            DWORD GetThreadId() const { return m_threadId; }
             HANDLE GetThreadHandle() const { return m_hThread; }
             bool SuspendThread()
             {
@@ -33,6 +49,18 @@ namespace Pyx
                 m_isSuspended = ::ResumeThread(m_hThread) == (DWORD)-1;
                 return !m_isSuspended;
             }
+#else
+            // Threads are stopped by a signal whose handler waits for the
+            // resume signal, see ThreadContext.cpp
+            explicit Thread(ThreadId threadId)
+                : m_threadId(threadId), m_isSuspended(false)
+            {
+            }
+            bool SuspendThread();
+            bool ResumeThread();
+#endif
+            ThreadId GetThreadId() const { return m_threadId; }
+            bool IsSuspended() const { return m_isSuspended; }
 
         };
     }
@@ -1,7 +1,129 @@
 #include <Pyx/Threading/ThreadContext.h>
 #include <Pyx/Threading/Thread.h>
+#include <unordered_set>
+
+#ifdef _WIN32
+
 #include <tlhelp32.h>
 
+namespace
+{
+    const ACCESS_MASK ThreadAccess = THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_SET_CONTEXT | THREAD_QUERY_INFORMATION;
+
+    typedef LONG(NTAPI* tNtGetNextThread)(HANDLE hProcess, HANDLE hThread, ACCESS_MASK desiredAccess, ULONG handleAttributes, ULONG flags, PHANDLE phNewThread);
+
+    tNtGetNextThread GetNtGetNextThread()
+    {
+        static auto pNtGetNextThread = reinterpret_cast<tNtGetNextThread>(GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtGetNextThread"));
+        return pNtGetNextThread;
+    }
+}
+
+#else
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <dirent.h>
+#include <mutex>
+#include <semaphore.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+    // Real-time signals queue and are delivered lowest first, a suspend
+    // always runs before a resume sent after it
+    int GetSuspendSignal() { return SIGRTMIN + 3; }
+    int GetResumeSignal() { return SIGRTMIN + 4; }
+
+    // Posted by a thread once it is stopped in the suspend handler
+    sem_t g_suspendedSemaphore;
+
+    Pyx::Threading::ThreadId GetCurrentThreadId()
+    {
+        return static_cast<Pyx::Threading::ThreadId>(syscall(SYS_gettid));
+    }
+
+    void OnSuspendSignal(int)
+    {
+        int savedErrno = errno;
+        sem_post(&g_suspendedSemaphore);
+
+        // Only the resume signal wakes the thread, it is blocked while the
+        // handler runs so that one sent before the wait isn't lost
+        sigset_t mask;
+        sigfillset(&mask);
+        sigdelset(&mask, GetResumeSignal());
+        sigsuspend(&mask);
+        errno = savedErrno;
+    }
+
+    void OnResumeSignal(int)
+    {
+    }
+
+    void InstallSignalHandlers()
+    {
+        static std::once_flag installFlag;
+        std::call_once(installFlag, []()
+        {
+            sem_init(&g_suspendedSemaphore, 0, 0);
+
+            struct sigaction action = {};
+            action.sa_flags = SA_RESTART;
+            action.sa_handler = OnResumeSignal;
+            sigemptyset(&action.sa_mask);
+            sigaction(GetResumeSignal(), &action, nullptr);
+
+            action.sa_handler = OnSuspendSignal;
+            sigaddset(&action.sa_mask, GetResumeSignal());
+            sigaction(GetSuspendSignal(), &action, nullptr);
+        });
+    }
+}
+
+bool Pyx::Threading::Thread::SuspendThread()
+{
+    InstallSignalHandlers();
+
+    // Calls are serialized by the ThreadContext, a late acknowledgement of a
+    // thread which timed out before is dropped
+    while (sem_trywait(&g_suspendedSemaphore) == 0)
+        ;
+
+    m_isSuspended = false;
+    if (syscall(SYS_tgkill, getpid(), m_threadId, GetSuspendSignal()) != 0)
+        return false;
+
+    timespec timeout;
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_sec += 1;
+    int result;
+    while ((result = sem_timedwait(&g_suspendedSemaphore, &timeout)) != 0 && errno == EINTR)
+        ;
+    if (result != 0)
+    {
+        // The thread blocks the signal, it is released as soon as it gets it
+        syscall(SYS_tgkill, getpid(), m_threadId, GetResumeSignal());
+        return false;
+    }
+
+    m_isSuspended = true;
+    return true;
+}
+
+bool Pyx::Threading::Thread::ResumeThread()
+{
+    if (m_isSuspended && syscall(SYS_tgkill, getpid(), m_threadId, GetResumeSignal()) != 0)
+        return false;
+    m_isSuspended = false;
+    return true;
+}
+
+#endif
+
 Pyx::Threading::ThreadContext& Pyx::Threading::ThreadContext::GetInstance()
 {
     static ThreadContext ctx;
@@ -9,53 +131,206 @@ Pyx::Threading::ThreadContext& Pyx::Threading::ThreadContext::GetInstance()
 }
 
 Pyx::Threading::ThreadContext::ThreadContext()
+    : m_freezeCount(0)
 {
 
 }
 
-std::vector<std::shared_ptr<Pyx::Threading::Thread>> Pyx::Threading::ThreadContext::GetThreads() const
+#ifdef _WIN32
+
+void Pyx::Threading::ThreadContext::UpdateThreads() const
 {
-    std::vector<std::shared_ptr<Thread>> results;
+    auto pNtGetNextThread = GetNtGetNextThread();
+    if (!pNtGetNextThread)
+    {
+        UpdateThreadsFromSnapshot();
+        return;
+    }
+
+    // Every call returns a new handle, the ones of already known threads are
+    // closed once they have been used to get the next thread
+    std::unordered_set<ThreadId> threadIds;
+    HANDLE hThread = nullptr;
+    HANDLE hNextThread = nullptr;
+    bool isKnown = false;
+    while (pNtGetNextThread(GetCurrentProcess(), hThread, ThreadAccess, 0, 0, &hNextThread) >= 0)
+    {
+        if (isKnown)
+            CloseHandle(hThread);
+        hThread = hNextThread;
+
+        DWORD threadId = GetThreadId(hThread);
+        threadIds.insert(threadId);
+        isKnown = m_threads.count(threadId) != 0;
+        if (!isKnown)
+            m_threads[threadId] = std::make_shared<Thread>(threadId, hThread);
+    }
+    if (isKnown)
+        CloseHandle(hThread);
+
+    // A thread id can't be reused while a handle to the thread is open, the
+    // threads which weren't enumerated have exited
+    for (auto it = m_threads.begin(); it != m_threads.end();)
+    {
+        if (threadIds.count(it->first) == 0)
+            it = m_threads.erase(it);
+        else
+            ++it;
+    }
+}
+
+void Pyx::Threading::ThreadContext::UpdateThreadsFromSnapshot() const
+{
+    std::unordered_set<ThreadId> threadIds;
     THREADENTRY32 te32;
     DWORD currentProcessId = GetCurrentProcessId();
     HANDLE hThreadSnap = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
-    if (hThreadSnap != NULL)
-    {
+    if (hThreadSnap == INVALID_HANDLE_VALUE)
+        return;
 
-        // Fill in the size of the structure before using it. 
-        te32.dwSize = sizeof(THREADENTRY32);
-
-        // Retrieve information about the first thread,
-        // and exit if unsuccessful
-        if (Thread32First(hThreadSnap, &te32))
+    te32.dwSize = sizeof(THREADENTRY32);
+    if (Thread32First(hThreadSnap, &te32))
+    {
+        do
         {
-            do
+            if (te32.th32OwnerProcessID == currentProcessId)
             {
-                if (te32.th32OwnerProcessID == currentProcessId)
-                {
-                    results.push_back(std::make_shared<Thread>(te32.th32ThreadID));
-                }
-            } 
-            while (Thread32Next(hThreadSnap, &te32));
+                threadIds.insert(te32.th32ThreadID);
+                if (m_threads.count(te32.th32ThreadID) == 0)
+                    m_threads[te32.th32ThreadID] = std::make_shared<Thread>(te32.th32ThreadID);
+            }
         }
+        while (Thread32Next(hThreadSnap, &te32));
+    }
+    CloseHandle(hThreadSnap);
 
-        //  Don't forget to clean up the snapshot object.
-        CloseHandle(hThreadSnap);
+    for (auto it = m_threads.begin(); it != m_threads.end();)
+    {
+        if (threadIds.count(it->first) == 0)
+            it = m_threads.erase(it);
+        else
+            ++it;
     }
+}
+
+#else
+
+void Pyx::Threading::ThreadContext::UpdateThreads() const
+{
+    std::unordered_set<ThreadId> threadIds;
+    DIR* pDirectory = opendir("/proc/self/task");
+    if (!pDirectory)
+        return;
+    while (auto* pEntry = readdir(pDirectory))
+    {
+        ThreadId threadId = static_cast<ThreadId>(atoi(pEntry->d_name));
+        if (threadId <= 0)
+            continue;
+        threadIds.insert(threadId);
+        if (m_threads.count(threadId) == 0)
+            m_threads[threadId] = std::make_shared<Thread>(threadId);
+    }
+    closedir(pDirectory);
+
+    for (auto it = m_threads.begin(); it != m_threads.end();)
+    {
+        if (threadIds.count(it->first) == 0)
+            it = m_threads.erase(it);
+        else
+            ++it;
+    }
+}
+
+#endif
+
+std::vector<std::shared_ptr<Pyx::Threading::Thread>> Pyx::Threading::ThreadContext::GetThreads() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    UpdateThreads();
+
+    std::vector<std::shared_ptr<Thread>> results;
+    results.reserve(m_threads.size());
+    for (auto& thread : m_threads)
+        results.push_back(thread.second);
     return results;
 }
 
+void Pyx::Threading::ThreadContext::SuspendOtherThreads(std::vector<std::shared_ptr<Thread>>& threads) const
+{
+    UpdateThreads();
+
+    // Room is made before the first thread is suspended, nothing can be
+    // allocated or freed afterwards since a suspended thread may own the heap lock
+    threads.clear();
+    threads.reserve(m_threads.size());
+    for (auto& thread : m_threads)
+    {
+        if (thread.first != GetCurrentThreadId() && thread.second->SuspendThread())
+            threads.push_back(thread.second);
+    }
+}
+
 std::vector<std::shared_ptr<Pyx::Threading::Thread>> Pyx::Threading::ThreadContext::SuspendAllThreads() const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     std::vector<std::shared_ptr<Thread>> results;
-    for (auto thread : GetThreads())
+    SuspendOtherThreads(results);
+    return results;
+}
+
+size_t Pyx::Threading::ThreadContext::GetOtherThreadIds(ThreadId* pThreadIds, size_t capacity) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // While frozen nothing is allocated, a suspended thread may own the heap lock
+    size_t count = 0;
+    if (m_freezeCount > 0)
     {
-        if (thread->GetThreadId() != GetCurrentThreadId() && thread->SuspendThread())
+        for (auto& thread : m_frozenThreads)
         {
-            results.push_back(thread);
+            if (count < capacity)
+                pThreadIds[count] = thread->GetThreadId();
+            count++;
         }
+        return count;
     }
-    return results;
+
+    UpdateThreads();
+    for (auto& thread : m_threads)
+    {
+        if (thread.first == GetCurrentThreadId())
+            continue;
+        if (count < capacity)
+            pThreadIds[count] = thread.first;
+        count++;
+    }
+    return count;
+}
+
+void Pyx::Threading::ThreadContext::Freeze()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_freezeCount++ == 0)
+        SuspendOtherThreads(m_frozenThreads);
+}
+
+void Pyx::Threading::ThreadContext::Unfreeze()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_freezeCount == 0 || --m_freezeCount > 0)
+        return;
+
+    for (auto& thread : m_frozenThreads)
+        thread->ResumeThread();
+
+    // Released once every thread runs again, see SuspendOtherThreads
+    std::vector<std::shared_ptr<Thread>>().swap(m_frozenThreads);
+}
+
+bool Pyx::Threading::ThreadContext::IsFrozen() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_freezeCount > 0;
 }
 
 Pyx::Threading::ThreadContext::~ThreadContext()
@@ -1,24 +1,50 @@
 #pragma once
+#include <Pyx/Threading/Thread.h>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace Pyx
 {
     class PyxContext;
     namespace Threading
     {
-        class Thread;
+        // Registry of the threads of the process. Threads are enumerated with
+        // NtGetNextThread which only walks the current process (Toolhelp32 on
+        // systems without it), their handles are kept until they exit. Other
+        // systems list /proc/self/task and suspend threads with signals.
+        // Freeze / Unfreeze suspend every other thread once for nested callers,
+        // the patch layer shares the same freeze for a batch of hooks.
         class ThreadContext
         {
 
         public:
             static ThreadContext& GetInstance();
 
+        private:
+            mutable std::mutex m_mutex;
+            mutable std::unordered_map<ThreadId, std::shared_ptr<Thread>> m_threads;
+            int m_freezeCount;
+            std::vector<std::shared_ptr<Thread>> m_frozenThreads;
+
+        private:
+            void UpdateThreads() const;
+#ifdef _WIN32
+            void UpdateThreadsFromSnapshot() const;
+#endif
+            void SuspendOtherThreads(std::vector<std::shared_ptr<Thread>>& threads) const;
+
         public:
             explicit ThreadContext();
             ~ThreadContext();
             std::vector<std::shared_ptr<Thread>> GetThreads() const;
             std::vector<std::shared_ptr<Thread>> SuspendAllThreads() const;
+            size_t GetOtherThreadIds(ThreadId* pThreadIds, size_t capacity) const;
+            void Freeze();
+            void Unfreeze();
+            bool IsFrozen() const;
+
         };
     }
 }
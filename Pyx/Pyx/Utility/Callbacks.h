@@ -1,46 +1,227 @@
 #pragma once
-#include <functional>
-#include <map>
+#include <Pyx/Utility/Delegate.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Pyx
 {
     namespace Utility
     {
+        enum class CallbacksMode
+        {
+            // Register, Unregister and Run from a single thread, changes made by
+            // a callback while running are applied once Run returns
+            Default,
+            // Register and Unregister from any thread, Run works on an immutable
+            // snapshot of the list which every change replaces
+            Snapshot
+        };
+
         // Credits RaptorFactor <3
-        template <typename Func> class Callbacks
+        // Callbacks are stored contiguously in registration order. Handles hold a
+        // slot index tagged with the slot generation, unregistering an already
+        // unregistered handle does nothing even after its slot has been reused.
+        // Unregistered callbacks are only marked, the list is compacted once
+        // they make up half of it.
+        template <typename Func, CallbacksMode Mode = CallbacksMode::Default> class Callbacks
         {
+
         public:
-            using Callback = std::function<Func>;
+            using Callback = Delegate<Func>;
+
+        private:
+            static const size_t IndexBits = sizeof(size_t) * 4;
+            static const size_t IndexMask = (size_t(1) << IndexBits) - 1;
+
+            struct RunScope
+            {
+                const Callbacks& Owner;
+                explicit RunScope(const Callbacks& owner) : Owner(owner) { Owner.m_runDepth++; }
+                ~RunScope()
+                {
+                    if (--Owner.m_runDepth == 0 && (Owner.HasTooManyRemovedEntries() || !Owner.m_pendingEntries.empty()))
+                        Owner.ApplyPendingChanges();
+                }
+            };
+
+            struct Entry
+            {
+                Callback Target;
+                size_t Handle;
+                bool IsRemoved;
+            };
+
+            typedef std::vector<Entry> Entries;
+
+        private:
+            std::vector<uint32_t> m_slotGenerations;
+            std::vector<uint32_t> m_freeSlots;
+            mutable std::vector<uint32_t> m_slotPositions;
+            mutable Entries m_entries;
+            mutable Entries m_pendingEntries;
+            mutable int m_runDepth = 0;
+            mutable size_t m_removedCount = 0;
+            std::shared_ptr<const Entries> m_pSnapshot;
+            std::mutex m_mutex;
+
+        private:
+            size_t AllocateHandle()
+            {
+                uint32_t slot;
+                if (!m_freeSlots.empty())
+                {
+                    slot = m_freeSlots.back();
+                    m_freeSlots.pop_back();
+                }
+                else
+                {
+                    slot = static_cast<uint32_t>(m_slotGenerations.size());
+                    m_slotGenerations.push_back(0);
+                    m_slotPositions.push_back(0);
+                }
+                return (static_cast<size_t>(m_slotGenerations[slot]) << IndexBits) | slot;
+            }
+
+            bool ReleaseHandle(size_t handle)
+            {
+                size_t slot = handle & IndexMask;
+                if (slot >= m_slotGenerations.size() || m_slotGenerations[slot] != static_cast<uint32_t>(handle >> IndexBits))
+                    return false;
+                m_slotGenerations[slot] = (m_slotGenerations[slot] + 1) & static_cast<uint32_t>(IndexMask);
+                m_freeSlots.push_back(static_cast<uint32_t>(slot));
+                return true;
+            }
+
+            static bool EraseEntry(Entries& entries, size_t handle)
+            {
+                for (auto it = entries.begin(); it != entries.end(); ++it)
+                {
+                    if (it->Handle == handle && !it->IsRemoved)
+                    {
+                        entries.erase(it);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void PushEntry(Entry&& entry) const
+            {
+                m_slotPositions[entry.Handle & IndexMask] = static_cast<uint32_t>(m_entries.size());
+                m_entries.push_back(std::move(entry));
+            }
+
+            bool HasTooManyRemovedEntries() const
+            {
+                return m_removedCount > 0 && m_removedCount * 2 >= m_entries.size();
+            }
+
+            void ApplyPendingChanges() const
+            {
+                if (HasTooManyRemovedEntries())
+                {
+                    auto it = std::remove_if(m_entries.begin(), m_entries.end(), [](const Entry& entry) { return entry.IsRemoved; });
+                    m_entries.erase(it, m_entries.end());
+                    for (size_t i = 0; i < m_entries.size(); i++)
+                        m_slotPositions[m_entries[i].Handle & IndexMask] = static_cast<uint32_t>(i);
+                    m_removedCount = 0;
+                }
+                for (auto& entry : m_pendingEntries)
+                    PushEntry(std::move(entry));
+                m_pendingEntries.clear();
+            }
 
+        public:
             Callbacks()
             {
             }
 
-            size_t Register(Callback const& callback)
+            size_t Register(Callback callback)
             {
-                auto const cur_id = next_id_++;
-                callbacks_[cur_id] = callback;
-                return cur_id;
+                if (Mode == CallbacksMode::Snapshot)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    size_t handle = AllocateHandle();
+                    auto pSnapshot = std::atomic_load(&m_pSnapshot);
+                    auto pEntries = pSnapshot ? std::make_shared<Entries>(*pSnapshot) : std::make_shared<Entries>();
+                    pEntries->push_back(Entry{ std::move(callback), handle, false });
+                    std::atomic_store(&m_pSnapshot, std::shared_ptr<const Entries>(std::move(pEntries)));
+                    return handle;
+                }
+
+                // A callback being run must not be moved, the new one is only
+                // added once the outermost Run returns
+                size_t handle = AllocateHandle();
+                if (m_runDepth > 0)
+                    m_pendingEntries.push_back(Entry{ std::move(callback), handle, false });
+                else
+                    PushEntry(Entry{ std::move(callback), handle, false });
+                return handle;
             }
 
             void Unregister(size_t id)
             {
-                auto const num_removed = callbacks_.erase(id);
-                (void)num_removed;
+                if (Mode == CallbacksMode::Snapshot)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!ReleaseHandle(id))
+                        return;
+                    auto pSnapshot = std::atomic_load(&m_pSnapshot);
+                    auto pEntries = std::make_shared<Entries>(*pSnapshot);
+                    EraseEntry(*pEntries, id);
+                    std::atomic_store(&m_pSnapshot, std::shared_ptr<const Entries>(std::move(pEntries)));
+                    return;
+                }
+
+                if (!ReleaseHandle(id))
+                    return;
+                if (EraseEntry(m_pendingEntries, id))
+                    return;
+                size_t position = m_slotPositions[id & IndexMask];
+                if (position >= m_entries.size() || m_entries[position].Handle != id || m_entries[position].IsRemoved)
+                    return;
+
+                // Entries aren't moved or destroyed while running, the list is
+                // compacted by the outermost Run once it returns
+                m_entries[position].IsRemoved = true;
+                m_removedCount++;
+                if (m_runDepth == 0)
+                {
+                    m_entries[position].Target.Reset();
+                    if (HasTooManyRemovedEntries())
+                        ApplyPendingChanges();
+                }
             }
 
             template <typename... Args>
             void Run(Args&&... args) const
             {
-                for (auto const& callback : callbacks_)
+                if (Mode == CallbacksMode::Snapshot)
                 {
-                    callback.second(std::forward<Args&&>(args)...);
+                    // The snapshot stays alive until the loop ends, whatever
+                    // the callbacks register or unregister meanwhile
+                    auto pSnapshot = std::atomic_load(&m_pSnapshot);
+                    if (pSnapshot)
+                    {
+                        for (auto& entry : *pSnapshot)
+                            entry.Target(args...);
+                    }
+                    return;
+                }
+
+                RunScope scope(*this);
+                size_t count = m_entries.size();
+                for (size_t i = 0; i < count; i++)
+                {
+                    if (!m_entries[i].IsRemoved)
+                        m_entries[i].Target(args...);
                 }
             }
 
-        private:
-            size_t next_id_ = size_t{};
-            std::map<size_t, Callback> callbacks_;
         };
     }
-}
\ No newline at end of file
+}
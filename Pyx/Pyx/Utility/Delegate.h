@@ -0,0 +1,154 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Pyx
+{
+    namespace Utility
+    {
+        template <typename Func> class Delegate;
+
+        // Copyable callable wrapper like std::function, targets up to InlineSize
+        // bytes (lambdas capturing a few pointers) are stored in place instead of
+        // being allocated. Moves never throw (inline targets must be nothrow
+        // movable) so vectors of delegates move them when they grow.
+        template <typename R, typename... Args> class Delegate<R(Args...)>
+        {
+
+        public:
+            static const size_t InlineSize = 4 * sizeof(void*);
+
+        private:
+            enum class Operation { Copy, Move, Destroy };
+            typedef R(*tInvoke)(void* pStorage, Args&&... args);
+            typedef void(*tManage)(Operation operation, void* pDestination, void* pSource);
+            typedef typename std::aligned_storage<InlineSize, alignof(std::max_align_t)>::type Storage;
+
+            template <typename T> struct InlineTarget
+            {
+                static T* Get(void* pStorage) { return static_cast<T*>(pStorage); }
+                static R Invoke(void* pStorage, Args&&... args) { return (*Get(pStorage))(std::forward<Args>(args)...); }
+                static void Manage(Operation operation, void* pDestination, void* pSource)
+                {
+                    switch (operation)
+                    {
+                    case Operation::Copy: new (pDestination) T(*Get(pSource)); break;
+                    case Operation::Move: new (pDestination) T(std::move(*Get(pSource))); Get(pSource)->~T(); break;
+                    case Operation::Destroy: Get(pDestination)->~T(); break;
+                    }
+                }
+            };
+
+            template <typename T> struct HeapTarget
+            {
+                static T*& Get(void* pStorage) { return *static_cast<T**>(pStorage); }
+                static R Invoke(void* pStorage, Args&&... args) { return (*Get(pStorage))(std::forward<Args>(args)...); }
+                static void Manage(Operation operation, void* pDestination, void* pSource)
+                {
+                    switch (operation)
+                    {
+                    case Operation::Copy: new (pDestination) T*(new T(*Get(pSource))); break;
+                    case Operation::Move: new (pDestination) T*(Get(pSource)); break;
+                    case Operation::Destroy: delete Get(pDestination); break;
+                    }
+                }
+            };
+
+            template <typename T> struct IsInline
+            {
+                static const bool value = sizeof(T) <= InlineSize
+                    && alignof(std::max_align_t) % alignof(T) == 0
+                    && std::is_nothrow_move_constructible<T>::value;
+            };
+
+        private:
+            Storage m_storage;
+            tInvoke m_pInvoke;
+            tManage m_pManage;
+
+        private:
+            void* GetStorage() const { return const_cast<Storage*>(&m_storage); }
+
+            template <typename T> void Construct(T&& target, std::true_type)
+            {
+                typedef typename std::decay<T>::type Target;
+                new (GetStorage()) Target(std::forward<T>(target));
+                m_pInvoke = &InlineTarget<Target>::Invoke;
+                m_pManage = &InlineTarget<Target>::Manage;
+            }
+
+            template <typename T> void Construct(T&& target, std::false_type)
+            {
+                typedef typename std::decay<T>::type Target;
+                new (GetStorage()) Target*(new Target(std::forward<T>(target)));
+                m_pInvoke = &HeapTarget<Target>::Invoke;
+                m_pManage = &HeapTarget<Target>::Manage;
+            }
+
+            void CopyFrom(const Delegate& other)
+            {
+                if (other.m_pManage)
+                    other.m_pManage(Operation::Copy, GetStorage(), other.GetStorage());
+                m_pInvoke = other.m_pInvoke;
+                m_pManage = other.m_pManage;
+            }
+
+            void MoveFrom(Delegate& other) noexcept
+            {
+                if (other.m_pManage)
+                    other.m_pManage(Operation::Move, GetStorage(), other.GetStorage());
+                m_pInvoke = other.m_pInvoke;
+                m_pManage = other.m_pManage;
+                other.m_pInvoke = nullptr;
+                other.m_pManage = nullptr;
+            }
+
+        public:
+            Delegate() : m_pInvoke(nullptr), m_pManage(nullptr) { }
+            Delegate(std::nullptr_t) : Delegate() { }
+            Delegate(const Delegate& other) : Delegate() { CopyFrom(other); }
+            Delegate(Delegate&& other) noexcept : Delegate() { MoveFrom(other); }
+            ~Delegate() { Reset(); }
+
+            template <typename T, typename = typename std::enable_if<!std::is_same<typename std::decay<T>::type, Delegate>::value>::type>
+            Delegate(T&& target) : Delegate()
+            {
+                Construct(std::forward<T>(target), std::integral_constant<bool, IsInline<typename std::decay<T>::type>::value>());
+            }
+
+            Delegate& operator=(const Delegate& other)
+            {
+                if (this != &other)
+                {
+                    Reset();
+                    CopyFrom(other);
+                }
+                return *this;
+            }
+
+            Delegate& operator=(Delegate&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    Reset();
+                    MoveFrom(other);
+                }
+                return *this;
+            }
+
+            void Reset() noexcept
+            {
+                if (m_pManage)
+                    m_pManage(Operation::Destroy, GetStorage(), nullptr);
+                m_pInvoke = nullptr;
+                m_pManage = nullptr;
+            }
+
+            explicit operator bool() const { return m_pInvoke != nullptr; }
+            R operator()(Args... args) const { return m_pInvoke(GetStorage(), std::forward<Args>(args)...); }
+
+        };
+    }
+}
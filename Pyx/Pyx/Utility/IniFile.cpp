@@ -0,0 +1,395 @@
+#include <Pyx/Utility/IniFile.h>
+#include <Pyx/Utility/Utf8.h>
+#include <algorithm>
+#include <cstring>
+#include <cwctype>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <climits>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Smaller files are read, mapping them costs more than copying them
+    const uint64_t SmallFileSize = 4096;
+
+    struct CachedDocument
+    {
+        uint64_t LastWriteTime;
+        uint64_t Size;
+        std::shared_ptr<const Pyx::Utility::IniFile::Document> pDocument;
+    };
+
+    std::mutex g_cacheMutex;
+    std::unordered_map<std::wstring, CachedDocument> g_cache;
+
+    std::wstring ToLower(const wchar_t* pFirst, const wchar_t* pLast)
+    {
+        std::wstring result(pFirst, pLast);
+        for (auto& c : result)
+            c = static_cast<wchar_t>(towlower(c));
+        return result;
+    }
+
+    bool IsSpace(wchar_t c)
+    {
+        return c == L' ' || (c >= L'\t' && c <= L'\r') || (c > 0x7F && iswspace(c));
+    }
+
+    void Trim(const wchar_t*& pFirst, const wchar_t*& pLast)
+    {
+        while (pFirst < pLast && IsSpace(*pFirst))
+            pFirst++;
+        while (pLast > pFirst && IsSpace(pLast[-1]))
+            pLast--;
+    }
+
+    // Open addressing table of the indexes of the interned strings, looked up
+    // with the range of the text so that only new strings are allocated
+    class StringTable
+    {
+
+    private:
+        static size_t Hash(const wchar_t* pFirst, const wchar_t* pLast)
+        {
+            uint32_t hash = 2166136261u;
+            for (; pFirst < pLast; pFirst++)
+                hash = (hash ^ static_cast<uint32_t>(*pFirst)) * 16777619u;
+            return hash;
+        }
+
+    private:
+        std::vector<std::wstring>& m_strings;
+        std::vector<uint32_t> m_slots; // Index of the string plus one, zero when empty
+
+    private:
+        void Grow()
+        {
+            std::vector<uint32_t> slots(m_slots.size() * 2, 0);
+            size_t mask = slots.size() - 1;
+            for (uint32_t i = 0; i < m_strings.size(); i++)
+            {
+                size_t slot = Hash(m_strings[i].data(), m_strings[i].data() + m_strings[i].size()) & mask;
+                while (slots[slot] != 0)
+                    slot = (slot + 1) & mask;
+                slots[slot] = i + 1;
+            }
+            m_slots.swap(slots);
+        }
+
+    public:
+        explicit StringTable(std::vector<std::wstring>& strings)
+            : m_strings(strings), m_slots(64, 0)
+        {
+        }
+
+        uint32_t Intern(const wchar_t* pFirst, const wchar_t* pLast)
+        {
+            if ((m_strings.size() + 1) * 2 > m_slots.size())
+                Grow();
+
+            size_t mask = m_slots.size() - 1;
+            size_t length = static_cast<size_t>(pLast - pFirst);
+            for (size_t slot = Hash(pFirst, pLast) & mask;; slot = (slot + 1) & mask)
+            {
+                uint32_t index = m_slots[slot];
+                if (index == 0)
+                {
+                    m_strings.emplace_back(pFirst, pLast);
+                    m_slots[slot] = static_cast<uint32_t>(m_strings.size());
+                    return m_slots[slot] - 1;
+                }
+
+                auto& text = m_strings[index - 1];
+                if (text.size() == length && std::equal(pFirst, pLast, text.begin()))
+                    return index - 1;
+            }
+        }
+
+    };
+
+    std::wstring ToWideString(const std::u16string& text)
+    {
+#ifdef _WIN32
+        return std::wstring(text.begin(), text.end());
+#else
+        // wchar_t holds UTF-32 here, surrogate pairs are combined
+        std::wstring result;
+        result.reserve(text.size());
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            uint32_t c = text[i];
+            if (c >= 0xD800 && c <= 0xDBFF && i + 1 < text.size() && text[i + 1] >= 0xDC00 && text[i + 1] <= 0xDFFF)
+                c = 0x10000 + ((c - 0xD800) << 10) + (text[++i] - 0xDC00);
+            result.push_back(static_cast<wchar_t>(c));
+        }
+        return result;
+#endif
+    }
+
+#ifndef _WIN32
+    std::u16string ToUtf16String(const std::wstring& text)
+    {
+        std::u16string result;
+        result.reserve(text.size());
+        for (auto c : text)
+        {
+            if (static_cast<uint32_t>(c) >= 0x10000)
+            {
+                result.push_back(static_cast<char16_t>(0xD800 + ((c - 0x10000) >> 10)));
+                result.push_back(static_cast<char16_t>(0xDC00 + ((c - 0x10000) & 0x3FF)));
+            }
+            else
+            {
+                result.push_back(static_cast<char16_t>(c));
+            }
+        }
+        return result;
+    }
+#endif
+
+    std::wstring DecodeAnsi(const char* pText, size_t size)
+    {
+#ifdef _WIN32
+        int length = MultiByteToWideChar(CP_ACP, 0, pText, static_cast<int>(size), nullptr, 0);
+        std::wstring result(length, L'\0');
+        if (length > 0)
+            MultiByteToWideChar(CP_ACP, 0, pText, static_cast<int>(size), &result[0], length);
+        return result;
+#else
+        // No ANSI code page outside of Windows, bytes are read as Latin-1
+        std::wstring result(size, L'\0');
+        for (size_t i = 0; i < size; i++)
+            result[i] = static_cast<unsigned char>(pText[i]);
+        return result;
+#endif
+    }
+}
+
+std::shared_ptr<const Pyx::Utility::IniFile::Document> Pyx::Utility::IniFile::Parse(const wchar_t* pText, size_t length)
+{
+    auto pDocument = std::make_shared<Document>();
+    StringTable strings(pDocument->Strings);
+
+    // Lines before the first section belong to an unnamed one
+    uint32_t section = strings.Intern(pText, pText);
+    const wchar_t* pEnd = pText + length;
+    const wchar_t* pLine = pText;
+    while (pLine < pEnd)
+    {
+        const wchar_t* pLineEnd = std::find_if(pLine, pEnd, [](wchar_t c) { return c == L'\r' || c == L'\n'; });
+        const wchar_t* pFirst = pLine;
+        const wchar_t* pLast = pLineEnd;
+        pLine = pLineEnd < pEnd ? pLineEnd + 1 : pEnd;
+
+        Trim(pFirst, pLast);
+        if (pFirst == pLast || *pFirst == L';' || *pFirst == L'#')
+            continue;
+
+        if (*pFirst == L'[')
+        {
+            const wchar_t* pClose = std::find(pFirst, pLast, L']');
+            if (pClose != pLast)
+            {
+                pFirst++;
+                Trim(pFirst, pClose);
+                std::wstring name = ToLower(pFirst, pClose);
+                section = strings.Intern(name.data(), name.data() + name.size());
+            }
+            continue;
+        }
+
+        const wchar_t* pEqual = std::find(pFirst, pLast, L'=');
+        if (pEqual == pLast)
+            continue;
+        const wchar_t* pKeyLast = pEqual;
+        const wchar_t* pValueFirst = pEqual + 1;
+        Trim(pFirst, pKeyLast);
+        Trim(pValueFirst, pLast);
+        pDocument->Entries.push_back(Document::Entry{ section, strings.Intern(pFirst, pKeyLast), strings.Intern(pValueFirst, pLast) });
+    }
+
+    return pDocument;
+}
+
+std::wstring Pyx::Utility::IniFile::Decode(const uint8_t* pData, size_t size)
+{
+    if (size >= 2 && pData[0] == 0xFF && pData[1] == 0xFE)
+    {
+        std::u16string text((size - 2) / 2, u'\0');
+        for (size_t i = 0; i < text.size(); i++)
+            text[i] = static_cast<char16_t>(pData[2 + i * 2] | pData[3 + i * 2] << 8);
+        return ToWideString(text);
+    }
+
+    // Files without a byte order mark are read as UTF-8 when valid, as the
+    // ANSI code page otherwise like the profile functions did
+    auto* pText = reinterpret_cast<const char*>(pData);
+    bool isUtf8 = false;
+    if (size >= 3 && pData[0] == 0xEF && pData[1] == 0xBB && pData[2] == 0xBF)
+    {
+        pText += 3;
+        size -= 3;
+        isUtf8 = true;
+    }
+    if (size == 0)
+        return std::wstring();
+
+    if (!isUtf8 && !Utility::Utf8::IsValid(pText, size))
+        return DecodeAnsi(pText, size);
+    std::u16string text(Utility::Utf8::GetMaxDecodedLength(size), u'\0');
+    text.resize(Utility::Utf8::Decode(pText, size, &text[0], text.size()));
+    return ToWideString(text);
+}
+
+void Pyx::Utility::IniFile::ClearCache()
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    g_cache.clear();
+}
+
+#ifdef _WIN32
+
+std::shared_ptr<const Pyx::Utility::IniFile::Document> Pyx::Utility::IniFile::Load(const std::wstring& fileName)
+{
+    static const std::shared_ptr<const Document> pEmptyDocument = std::make_shared<Document>();
+
+    wchar_t fullPathName[MAX_PATH];
+    if (GetFullPathNameW(fileName.c_str(), MAX_PATH, fullPathName, nullptr) == 0)
+        return pEmptyDocument;
+    std::wstring key = ToLower(fullPathName, fullPathName + wcslen(fullPathName));
+
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(fullPathName, GetFileExInfoStandard, &attributes))
+        return pEmptyDocument;
+    uint64_t size = static_cast<uint64_t>(attributes.nFileSizeHigh) << 32 | attributes.nFileSizeLow;
+    uint64_t lastWriteTime = static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32 | attributes.ftLastWriteTime.dwLowDateTime;
+
+    {
+        std::lock_guard<std::mutex> lock(g_cacheMutex);
+        auto it = g_cache.find(key);
+        if (it != g_cache.end() && it->second.Size == size && it->second.LastWriteTime == lastWriteTime)
+            return it->second.pDocument;
+    }
+
+    std::wstring text;
+    HANDLE hFile = CreateFileW(fullPathName, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return pEmptyDocument;
+    if (size != 0 && size <= SmallFileSize)
+    {
+        uint8_t buffer[SmallFileSize];
+        DWORD read = 0;
+        if (ReadFile(hFile, buffer, static_cast<DWORD>(size), &read, nullptr))
+            text = Decode(buffer, read);
+    }
+    else if (size != 0)
+    {
+        HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (hMapping)
+        {
+            auto* pView = static_cast<const uint8_t*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+            if (pView)
+            {
+                text = Decode(pView, static_cast<size_t>(size));
+                UnmapViewOfFile(pView);
+            }
+            CloseHandle(hMapping);
+        }
+    }
+    CloseHandle(hFile);
+
+    auto pDocument = Parse(text.data(), text.size());
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    g_cache[key] = CachedDocument{ lastWriteTime, size, pDocument };
+    return pDocument;
+}
+
+#else
+
+std::shared_ptr<const Pyx::Utility::IniFile::Document> Pyx::Utility::IniFile::Load(const std::wstring& fileName)
+{
+    static const std::shared_ptr<const Document> pEmptyDocument = std::make_shared<Document>();
+
+    char fullPathName[PATH_MAX];
+    if (!realpath(Utility::Utf8::Encode(ToUtf16String(fileName)).c_str(), fullPathName))
+        return pEmptyDocument;
+    std::wstring key(fullPathName, fullPathName + strlen(fullPathName));
+
+    struct stat attributes;
+    if (stat(fullPathName, &attributes) != 0)
+        return pEmptyDocument;
+    uint64_t size = static_cast<uint64_t>(attributes.st_size);
+    uint64_t lastWriteTime = static_cast<uint64_t>(attributes.st_mtim.tv_sec) * 1000000000 + attributes.st_mtim.tv_nsec;
+
+    {
+        std::lock_guard<std::mutex> lock(g_cacheMutex);
+        auto it = g_cache.find(key);
+        if (it != g_cache.end() && it->second.Size == size && it->second.LastWriteTime == lastWriteTime)
+            return it->second.pDocument;
+    }
+
+    std::wstring text;
+    int file = open(fullPathName, O_RDONLY);
+    if (file < 0)
+        return pEmptyDocument;
+    if (size != 0 && size <= SmallFileSize)
+    {
+        uint8_t buffer[SmallFileSize];
+        ssize_t result = read(file, buffer, static_cast<size_t>(size));
+        if (result > 0)
+            text = Decode(buffer, static_cast<size_t>(result));
+    }
+    else if (size != 0)
+    {
+        void* pView = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (pView != MAP_FAILED)
+        {
+            text = Decode(static_cast<const uint8_t*>(pView), static_cast<size_t>(size));
+            munmap(pView, static_cast<size_t>(size));
+        }
+    }
+    close(file);
+
+    auto pDocument = Parse(text.data(), text.size());
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    g_cache[key] = CachedDocument{ lastWriteTime, size, pDocument };
+    return pDocument;
+}
+
+#endif
+
+Pyx::Utility::IniFile::IniFile(const std::wstring& fileName)
+    : m_fileName(fileName), m_pDocument(Load(fileName))
+{
+}
+
+std::vector<Pyx::Utility::IniFile::SectionValue> Pyx::Utility::IniFile::GetSectionValues(const std::wstring& sectionName) const
+{
+    std::vector<SectionValue> results;
+    if (sectionName.empty())
+        return results;
+    std::wstring name = ToLower(sectionName.data(), sectionName.data() + sectionName.size());
+
+    auto& strings = m_pDocument->Strings;
+    auto it = std::find(strings.begin(), strings.end(), name);
+    if (it == strings.end())
+        return results;
+
+    uint32_t section = static_cast<uint32_t>(it - strings.begin());
+    for (auto& entry : m_pDocument->Entries)
+    {
+        if (entry.Section == section)
+            results.push_back(SectionValue{ sectionName, strings[entry.Key], strings[entry.Value] });
+    }
+    return results;
+}
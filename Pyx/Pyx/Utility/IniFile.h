@@ -1,5 +1,6 @@
 #pragma once
-#include <Windows.h>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -7,6 +8,9 @@ namespace Pyx
 {
     namespace Utility
     {
+        // The whole file is parsed once when opened, every section is then read
+        // from memory. Parsed files are shared by path and last write time, a
+        // file only changed on disk is parsed again.
         class IniFile
         {
 
@@ -17,39 +21,39 @@ namespace Pyx
                 std::wstring Key;
                 std::wstring Value;
             };
-            
+
+            // Sections, keys and values are indexes in a table of the distinct
+            // strings of the file, section names are interned in lower case
+            struct Document
+            {
+                struct Entry
+                {
+                    uint32_t Section;
+                    uint32_t Key;
+                    uint32_t Value;
+                };
+
+                std::vector<std::wstring> Strings;
+                std::vector<Entry> Entries;
+            };
+
+        public:
+            static std::shared_ptr<const Document> Parse(const wchar_t* pText, size_t length);
+            static std::wstring Decode(const uint8_t* pData, size_t size);
+            static void ClearCache();
+
+        private:
+            static std::shared_ptr<const Document> Load(const std::wstring& fileName);
+
         private:
             std::wstring m_fileName;
+            std::shared_ptr<const Document> m_pDocument;
 
         public:
-            IniFile(const std::wstring& fileName) : m_fileName(fileName) { }
-            std::vector<SectionValue> GetSectionValues( const std::wstring& sectionName) const
-            {
-                std::vector<SectionValue> results;
-
-                wchar_t buffer[4096];
-                int charsRead = 0;
-                charsRead = GetPrivateProfileSectionW(sectionName.c_str(), buffer, sizeof(buffer), m_fileName.c_str());
-                if (0 < charsRead && sizeof(buffer) - 2 > charsRead) 
-                {
-                    const wchar_t* pSubstr = buffer;
-                    while (L'\0' != *pSubstr) {
-                        size_t substrLen = wcslen(pSubstr);
-                        const wchar_t* pos = wcschr(pSubstr, '=');
-                        if (pos) 
-                        {
-                            wchar_t name[256] = L"";
-                            wchar_t value[256] = L"";
-                            wcsncpy_s(name, _countof(name), pSubstr, pos - pSubstr);
-                            wcsncpy_s(value, _countof(value), pos + 1, substrLen - (pos - pSubstr));
-                            results.push_back(SectionValue{ sectionName, name, value });
-                        }
-
-                        pSubstr += (substrLen + 1);
-                    }
-                }
-                return results;
-            }
+            IniFile(const std::wstring& fileName);
+            // Keys found before the first section have no section and can't be
+            // read, an empty name returns no value
+            std::vector<SectionValue> GetSectionValues(const std::wstring& sectionName) const;
 
         };
     }
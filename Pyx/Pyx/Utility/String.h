@@ -1,5 +1,6 @@
 #pragma once
 #include "XorString.h"
+#include <Pyx/Utility/Utf8.h>
 #include <cstdlib>
 #include <string>
 #include <locale>
@@ -25,19 +26,15 @@ namespace Pyx
 
             static std::string utf8_encode(const std::wstring &wstr)
             {
-                if (wstr.empty()) return std::string();
-                int size_needed = WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), NULL, 0, NULL, NULL);
-                std::string strTo(size_needed, 0);
-                WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), &strTo[0], size_needed, NULL, NULL);
+                std::string strTo(Utf8::GetMaxEncodedSize(wstr.size()), 0);
+                strTo.resize(Utf8::Encode(wstr.data(), wstr.size(), &strTo[0], strTo.size()));
                 return strTo;
             }
 
             static std::wstring utf8_decode(const std::string &str)
             {
-                if (str.empty()) return std::wstring();
-                int size_needed = MultiByteToWideChar(CP_UTF8, 0, &str[0], (int)str.size(), NULL, 0);
-                std::wstring wstrTo(size_needed, 0);
-                MultiByteToWideChar(CP_UTF8, 0, &str[0], (int)str.size(), &wstrTo[0], size_needed);
+                std::wstring wstrTo(Utf8::GetMaxDecodedLength(str.size()), 0);
+                wstrTo.resize(Utf8::Decode(str.data(), str.size(), &wstrTo[0], wstrTo.size()));
                 return wstrTo;
             }
 
@@ -0,0 +1,246 @@
+#include <Pyx/Utility/Utf8.h>
+#include <limits>
+
+#if (defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)) && !defined(PYX_UTF8_NO_SIMD)
+#include <emmintrin.h>
+#define PYX_UTF8_SSE2
+#endif
+
+#ifdef _WIN32
+static_assert(sizeof(wchar_t) == sizeof(char16_t), "The wchar_t overloads expect UTF-16");
+#endif
+
+namespace
+{
+    const uint32_t ReplacementCodePoint = 0xFFFD;
+
+    bool IsHighSurrogate(uint32_t c) { return c >= 0xD800 && c <= 0xDBFF; }
+    bool IsLowSurrogate(uint32_t c) { return c >= 0xDC00 && c <= 0xDFFF; }
+
+    // Returns the length of the sequence at pText, or of its maximal invalid
+    // subpart in which case codePoint is set to the replacement character
+    size_t DecodeSequence(const uint8_t* pText, size_t size, uint32_t& codePoint)
+    {
+        uint8_t lead = pText[0];
+        if (lead < 0x80)
+        {
+            codePoint = lead;
+            return 1;
+        }
+
+        size_t length;
+        uint8_t lower = 0x80;
+        uint8_t upper = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            length = 2;
+            codePoint = lead & 0x1F;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            length = 3;
+            codePoint = lead & 0x0F;
+            if (lead == 0xE0) lower = 0xA0; // overlong
+            if (lead == 0xED) upper = 0x9F; // surrogates
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            length = 4;
+            codePoint = lead & 0x07;
+            if (lead == 0xF0) lower = 0x90; // overlong
+            if (lead == 0xF4) upper = 0x8F; // above U+10FFFF
+        }
+        else
+        {
+            codePoint = ReplacementCodePoint;
+            return 1;
+        }
+
+        for (size_t i = 1; i < length; i++)
+        {
+            if (i >= size || pText[i] < lower || pText[i] > upper)
+            {
+                codePoint = ReplacementCodePoint;
+                return i;
+            }
+            codePoint = codePoint << 6 | (pText[i] & 0x3F);
+            lower = 0x80;
+            upper = 0xBF;
+        }
+        return length;
+    }
+
+    template <bool IsWriting> size_t EncodeText(const char16_t* pText, size_t length, char* pBuffer, size_t bufferSize)
+    {
+        size_t position = 0;
+        size_t written = 0;
+        while (position < length)
+        {
+#ifdef PYX_UTF8_SSE2
+            // Only tried from an ASCII character, text with few of them would
+            // otherwise pay for a failed block after every character
+            const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+            while (pText[position] < 0x80 && length - position >= 8 && bufferSize - written >= 8)
+            {
+                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pText + position));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chars, nonAsciiMask), _mm_setzero_si128())) != 0xFFFF)
+                    break;
+                if (IsWriting)
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(pBuffer + written), _mm_packus_epi16(chars, chars));
+                position += 8;
+                written += 8;
+            }
+            if (position == length)
+                break;
+#endif
+
+            uint32_t codePoint = pText[position];
+            size_t consumed = 1;
+            if (IsHighSurrogate(codePoint) && position + 1 < length && IsLowSurrogate(pText[position + 1]))
+            {
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (pText[position + 1] - 0xDC00);
+                consumed = 2;
+            }
+            else if (IsHighSurrogate(codePoint) || IsLowSurrogate(codePoint))
+            {
+                codePoint = ReplacementCodePoint;
+            }
+
+            size_t size = codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+            if (bufferSize - written < size)
+                break;
+
+            if (IsWriting)
+            {
+                char* pOutput = pBuffer + written;
+                switch (size)
+                {
+                case 1:
+                    pOutput[0] = static_cast<char>(codePoint);
+                    break;
+                case 2:
+                    pOutput[0] = static_cast<char>(0xC0 | codePoint >> 6);
+                    pOutput[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    break;
+                case 3:
+                    pOutput[0] = static_cast<char>(0xE0 | codePoint >> 12);
+                    pOutput[1] = static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+                    pOutput[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    break;
+                default:
+                    pOutput[0] = static_cast<char>(0xF0 | codePoint >> 18);
+                    pOutput[1] = static_cast<char>(0x80 | (codePoint >> 12 & 0x3F));
+                    pOutput[2] = static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+                    pOutput[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    break;
+                }
+            }
+            position += consumed;
+            written += size;
+        }
+        return written;
+    }
+
+    template <bool IsWriting> size_t DecodeText(const uint8_t* pText, size_t size, char16_t* pBuffer, size_t bufferLength)
+    {
+        size_t position = 0;
+        size_t written = 0;
+        while (position < size)
+        {
+#ifdef PYX_UTF8_SSE2
+            while (pText[position] < 0x80 && size - position >= 16 && bufferLength - written >= 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pText + position));
+                if (_mm_movemask_epi8(bytes) != 0)
+                    break;
+                if (IsWriting)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(pBuffer + written), _mm_unpacklo_epi8(bytes, _mm_setzero_si128()));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(pBuffer + written + 8), _mm_unpackhi_epi8(bytes, _mm_setzero_si128()));
+                }
+                position += 16;
+                written += 16;
+            }
+            if (position == size)
+                break;
+#endif
+
+            uint32_t codePoint;
+            size_t consumed = DecodeSequence(pText + position, size - position, codePoint);
+            size_t length = codePoint < 0x10000 ? 1 : 2;
+            if (bufferLength - written < length)
+                break;
+
+            if (IsWriting)
+            {
+                if (length == 1)
+                {
+                    pBuffer[written] = static_cast<char16_t>(codePoint);
+                }
+                else
+                {
+                    pBuffer[written] = static_cast<char16_t>(0xD800 + ((codePoint - 0x10000) >> 10));
+                    pBuffer[written + 1] = static_cast<char16_t>(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+                }
+            }
+            position += consumed;
+            written += length;
+        }
+        return written;
+    }
+}
+
+size_t Pyx::Utility::Utf8::GetEncodedSize(const char16_t* pText, size_t length)
+{
+    return EncodeText<false>(pText, length, nullptr, std::numeric_limits<size_t>::max());
+}
+
+size_t Pyx::Utility::Utf8::GetDecodedLength(const char* pText, size_t size)
+{
+    return DecodeText<false>(reinterpret_cast<const uint8_t*>(pText), size, nullptr, std::numeric_limits<size_t>::max());
+}
+
+size_t Pyx::Utility::Utf8::Encode(const char16_t* pText, size_t length, char* pBuffer, size_t bufferSize)
+{
+    return EncodeText<true>(pText, length, pBuffer, bufferSize);
+}
+
+size_t Pyx::Utility::Utf8::Decode(const char* pText, size_t size, char16_t* pBuffer, size_t bufferLength)
+{
+    return DecodeText<true>(reinterpret_cast<const uint8_t*>(pText), size, pBuffer, bufferLength);
+}
+
+std::string Pyx::Utility::Utf8::Encode(const std::u16string& text)
+{
+    std::string result(GetMaxEncodedSize(text.size()), '\0');
+    result.resize(Encode(text.data(), text.size(), &result[0], result.size()));
+    return result;
+}
+
+std::u16string Pyx::Utility::Utf8::Decode(const std::string& text)
+{
+    std::u16string result(GetMaxDecodedLength(text.size()), u'\0');
+    result.resize(Decode(text.data(), text.size(), &result[0], result.size()));
+    return result;
+}
+
+bool Pyx::Utility::Utf8::IsValid(const char* pText, size_t size)
+{
+    auto* pBytes = reinterpret_cast<const uint8_t*>(pText);
+    size_t position = 0;
+    while (position < size)
+    {
+#ifdef PYX_UTF8_SSE2
+        while (pBytes[position] < 0x80 && size - position >= 16 && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pBytes + position))) == 0)
+            position += 16;
+        if (position == size)
+            break;
+#endif
+        uint32_t codePoint;
+        size_t consumed = DecodeSequence(pBytes + position, size - position, codePoint);
+        if (codePoint == ReplacementCodePoint && !(consumed == 3 && pBytes[position] == 0xEF))
+            return false;
+        position += consumed;
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Pyx
+{
+    namespace Utility
+    {
+        // UTF-8 <-> UTF-16 conversion into caller provided buffers. Invalid input
+        // (lone surrogates, malformed or overlong sequences) is replaced by
+        // U+FFFD, one per maximal invalid subpart like the Windows conversions.
+        // Runs of ASCII characters are converted 16 bytes at a time. The
+        // wchar_t overloads are only there on Windows where it is UTF-16.
+        class Utf8
+        {
+
+        public:
+            static const char16_t ReplacementCharacter = 0xFFFD;
+
+        public:
+            static size_t GetMaxEncodedSize(size_t length) { return length * 3; }
+            static size_t GetMaxDecodedLength(size_t size) { return size; }
+
+            static size_t GetEncodedSize(const char16_t* pText, size_t length);
+            static size_t GetDecodedLength(const char* pText, size_t size);
+
+            // Return the number of bytes or characters written, conversion stops
+            // before the first character which doesn't entirely fit
+            static size_t Encode(const char16_t* pText, size_t length, char* pBuffer, size_t bufferSize);
+            static size_t Decode(const char* pText, size_t size, char16_t* pBuffer, size_t bufferLength);
+
+            static std::string Encode(const std::u16string& text);
+            static std::u16string Decode(const std::string& text);
+
+            static bool IsValid(const char* pText, size_t size);
+
+#ifdef _WIN32
+            static size_t GetEncodedSize(const wchar_t* pText, size_t length)
+            {
+                return GetEncodedSize(reinterpret_cast<const char16_t*>(pText), length);
+            }
+            static size_t Encode(const wchar_t* pText, size_t length, char* pBuffer, size_t bufferSize)
+            {
+                return Encode(reinterpret_cast<const char16_t*>(pText), length, pBuffer, bufferSize);
+            }
+            static size_t Decode(const char* pText, size_t size, wchar_t* pBuffer, size_t bufferLength)
+            {
+                return Decode(pText, size, reinterpret_cast<char16_t*>(pBuffer), bufferLength);
+            }
+#endif
+
+        };
+    }
+}
@@ -111,5 +111,19 @@ public:
 };
 
 #define XorStringA( String ) ( CXorStringA<ConstructIndexList<sizeof( String ) - 1>::Result>( String ).decrypt() )  
-#define XorStringW( String ) ( CXorStringW<ConstructIndexList<sizeof( String ) - 1>::Result>( String ).decrypt() )  
+#define XorStringW( String ) ( CXorStringW<ConstructIndexList<( sizeof( String ) / sizeof( wchar_t ) ) - 1>::Result>( String ).decrypt() )  
+
+// Decrypt once variants for call sites evaluated repeatedly : the encrypted
+// string is constant initialized in static storage and decrypted in place the
+// first time the call site runs, initialization of local statics is thread
+// safe. Adjacent literals are concatenated before being encrypted, so an icon
+// and a label give a precomposed constant label.
+#define XorStringStaticA( String ) ( []() -> const char* { \
+    static CXorStringA<ConstructIndexList<sizeof( String ) - 1>::Result> s_value( String ); \
+    static const char* const s_pValue = s_value.decrypt(); \
+    return s_pValue; }() )
+#define XorStringStaticW( String ) ( []() -> const wchar_t* { \
+    static CXorStringW<ConstructIndexList<( sizeof( String ) / sizeof( wchar_t ) ) - 1>::Result> s_value( String ); \
+    static const wchar_t* const s_pValue = s_value.decrypt(); \
+    return s_pValue; }() )
 ////////////////////////////////////////////////////////////////////
\ No newline at end of file
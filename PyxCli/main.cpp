@@ -0,0 +1,398 @@
+#include <Windows.h>
+#include <Pyx/Logging/BinaryLog.h>
+#include <Pyx/Logging/LogSegmentFile.h>
+#include <Pyx/Telemetry/TelemetryBlock.h>
+#include <TlHelp32.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using Pyx::Logging::BinaryLog;
+using Pyx::Logging::LogSegmentFile;
+using Pyx::Telemetry::TelemetryBlock;
+
+typedef std::unordered_map<uint64_t, std::string> FormatMap;
+
+static std::string FormatTime(uint64_t time)
+{
+    FILETIME fileTime{ static_cast<DWORD>(time), static_cast<DWORD>(time >> 32) };
+    FILETIME localFileTime;
+    SYSTEMTIME systemTime;
+    FileTimeToLocalFileTime(&fileTime, &localFileTime);
+    FileTimeToSystemTime(&localFileTime, &systemTime);
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "[%02u:%02u:%02u] ", systemTime.wHour, systemTime.wMinute, systemTime.wSecond);
+    return buffer;
+}
+
+// Returns true when the record was a message and a line was written
+static bool RenderBinaryRecord(FormatMap& formats, const BinaryLog::RecordHeader& header, const uint8_t* pPayload, size_t payloadSize, FILE* pOutput)
+{
+    if (header.Type == BinaryLog::RecordType::Format)
+    {
+        const char* pFormat = reinterpret_cast<const char*>(pPayload);
+        formats[header.FormatId].assign(pFormat, strnlen(pFormat, payloadSize));
+        return false;
+    }
+    if (header.Type != BinaryLog::RecordType::Message)
+        return false;
+
+    std::string format = "%s";
+    if (header.FormatId != BinaryLog::TextFormatId)
+    {
+        auto it = formats.find(header.FormatId);
+        format = it != formats.end() ? it->second : "<unknown format>";
+    }
+    std::string line = FormatTime(header.Time) + BinaryLog::RenderMessage(format.c_str(), pPayload, payloadSize) + "\n";
+    fwrite(line.data(), 1, line.size(), pOutput);
+    return true;
+}
+
+static FILE* OpenOutput(const char* outputFileName)
+{
+    FILE* pOutput = stdout;
+    if (outputFileName && fopen_s(&pOutput, outputFileName, "wb") != 0)
+    {
+        fprintf(stderr, "Unable to create \"%s\"\n", outputFileName);
+        return nullptr;
+    }
+    return pOutput;
+}
+
+static int Decode(const char* inputFileName, const char* outputFileName)
+{
+    std::ifstream input(inputFileName, std::ifstream::in | std::ifstream::binary);
+    if (!input.is_open())
+    {
+        fprintf(stderr, "Unable to open \"%s\"\n", inputFileName);
+        return 1;
+    }
+
+    BinaryLog::FileHeader fileHeader;
+    if (!input.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader)) || fileHeader.Magic != BinaryLog::Magic)
+    {
+        fprintf(stderr, "\"%s\" is not a binary log\n", inputFileName);
+        return 1;
+    }
+    if (fileHeader.Version != BinaryLog::Version)
+    {
+        fprintf(stderr, "Unsupported binary log version %u\n", fileHeader.Version);
+        return 1;
+    }
+
+    FILE* pOutput = OpenOutput(outputFileName);
+    if (!pOutput)
+        return 1;
+
+    FormatMap formats;
+    std::vector<uint8_t> payload;
+    BinaryLog::RecordHeader header;
+    size_t messageCount = 0;
+
+    while (input.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        if (header.Size < sizeof(header))
+        {
+            fprintf(stderr, "Corrupted record after %zu messages\n", messageCount);
+            break;
+        }
+        payload.resize(header.Size - sizeof(header));
+        if (!payload.empty() && !input.read(reinterpret_cast<char*>(payload.data()), payload.size()))
+        {
+            fprintf(stderr, "Truncated record after %zu messages\n", messageCount);
+            break;
+        }
+
+        if (RenderBinaryRecord(formats, header, payload.data(), payload.size(), pOutput))
+            messageCount++;
+    }
+
+    if (pOutput != stdout)
+        fclose(pOutput);
+    fprintf(stderr, "Decoded %zu messages (%zu formats)\n", messageCount, formats.size());
+    return 0;
+}
+
+struct Segment
+{
+    std::string FileName;
+    std::vector<uint8_t> Data;
+    const LogSegmentFile::SegmentHeader* pHeader;
+};
+
+static int ReadSegments(const char* baseFileName, const char* outputFileName)
+{
+    // Segments are named <base>.<sequence>.pyxseg, the sequence from the header is
+    // used for the order since a crashed process can leave older sets behind
+    std::string directory = baseFileName;
+    size_t separator = directory.find_last_of("\\/");
+    directory = separator != std::string::npos ? directory.substr(0, separator + 1) : std::string();
+
+    std::vector<Segment> segments;
+    WIN32_FIND_DATAA findData;
+    HANDLE hFind = FindFirstFileA((std::string(baseFileName) + ".*.pyxseg").c_str(), &findData);
+    if (hFind != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            Segment segment;
+            segment.FileName = directory + findData.cFileName;
+            std::ifstream input(segment.FileName.c_str(), std::ifstream::in | std::ifstream::binary);
+            segment.Data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+            segment.pHeader = reinterpret_cast<const LogSegmentFile::SegmentHeader*>(segment.Data.data());
+            if (segment.Data.size() < sizeof(LogSegmentFile::SegmentHeader) || segment.pHeader->Magic != LogSegmentFile::Magic || segment.pHeader->Version != LogSegmentFile::Version)
+            {
+                fprintf(stderr, "Skipping \"%s\", not a log segment\n", segment.FileName.c_str());
+                continue;
+            }
+            segments.push_back(std::move(segment));
+        } while (FindNextFileA(hFind, &findData));
+        FindClose(hFind);
+    }
+
+    if (segments.empty())
+    {
+        fprintf(stderr, "No segment found for \"%s\"\n", baseFileName);
+        return 1;
+    }
+
+    std::sort(segments.begin(), segments.end(), [](const Segment& lhs, const Segment& rhs)
+    {
+        return lhs.pHeader->Sequence < rhs.pHeader->Sequence;
+    });
+
+    FILE* pOutput = OpenOutput(outputFileName);
+    if (!pOutput)
+        return 1;
+
+    FormatMap formats;
+    size_t messageCount = 0;
+    for (auto& segment : segments)
+    {
+        const uint8_t* pData = segment.Data.data();
+        size_t position = sizeof(LogSegmentFile::SegmentHeader);
+        size_t segmentMessageCount = 0;
+
+        // The header write position is only a hint, chunks are read up to the
+        // first invalid one so lines written right before a crash are kept
+        while (position + sizeof(LogSegmentFile::ChunkHeader) <= segment.Data.size())
+        {
+            LogSegmentFile::ChunkHeader chunk;
+            memcpy(&chunk, pData + position, sizeof(chunk));
+            const uint8_t* pPayload = pData + position + sizeof(chunk);
+            if (chunk.Checksum == 0 || chunk.Size > segment.Data.size() - position - sizeof(chunk) || LogSegmentFile::GetChecksum(pPayload, chunk.Size) != chunk.Checksum)
+                break;
+            position += sizeof(chunk) + chunk.Size;
+
+            if (segment.pHeader->ChunkFormat == LogSegmentFile::Format::Text)
+            {
+                fwrite(pPayload, 1, chunk.Size, pOutput);
+                fputc('\n', pOutput);
+                segmentMessageCount++;
+            }
+            else if (chunk.Size >= sizeof(BinaryLog::RecordHeader))
+            {
+                BinaryLog::RecordHeader header;
+                memcpy(&header, pPayload, sizeof(header));
+                if (RenderBinaryRecord(formats, header, pPayload + sizeof(header), chunk.Size - sizeof(header), pOutput))
+                    segmentMessageCount++;
+            }
+        }
+
+        const char* pStatus = "";
+        if (position > segment.pHeader->WritePosition)
+            pStatus = " (recovered past the last committed chunk)";
+        else if (position < segment.pHeader->WritePosition)
+            pStatus = " (stopped at a corrupted chunk)";
+        fprintf(stderr, "Segment %u : %zu messages%s\n", segment.pHeader->Sequence, segmentMessageCount, pStatus);
+        messageCount += segmentMessageCount;
+    }
+
+    if (pOutput != stdout)
+        fclose(pOutput);
+    fprintf(stderr, "Read %zu messages from %zu segments\n", messageCount, segments.size());
+    return 0;
+}
+
+struct TelemetryInstance
+{
+    HANDLE hMapping;
+    const TelemetryBlock::Block* pBlock;
+    TelemetryBlock::Data Previous;
+    bool HasPrevious;
+};
+
+static void CloseTelemetryInstance(TelemetryInstance& instance)
+{
+    UnmapViewOfFile(instance.pBlock);
+    CloseHandle(instance.hMapping);
+}
+
+// Maps the block of every running process publishing one, the views of the
+// processes that exited are released
+static void RefreshTelemetryInstances(std::map<DWORD, TelemetryInstance>& instances)
+{
+    std::vector<DWORD> processIds;
+    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (hSnapshot != INVALID_HANDLE_VALUE)
+    {
+        PROCESSENTRY32W entry;
+        entry.dwSize = sizeof(entry);
+        if (Process32FirstW(hSnapshot, &entry))
+        {
+            do
+            {
+                processIds.push_back(entry.th32ProcessID);
+            } while (Process32NextW(hSnapshot, &entry));
+        }
+        CloseHandle(hSnapshot);
+    }
+
+    for (auto it = instances.begin(); it != instances.end();)
+    {
+        if (std::find(processIds.begin(), processIds.end(), it->first) == processIds.end())
+        {
+            CloseTelemetryInstance(it->second);
+            it = instances.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    for (auto processId : processIds)
+    {
+        if (instances.count(processId))
+            continue;
+        HANDLE hMapping = OpenFileMappingW(FILE_MAP_READ, FALSE, TelemetryBlock::GetMappingName(processId).c_str());
+        if (!hMapping)
+            continue;
+        auto* pBlock = static_cast<const TelemetryBlock::Block*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, sizeof(TelemetryBlock::Block)));
+        if (!pBlock || pBlock->Header.Magic != TelemetryBlock::Magic || pBlock->Header.Version != TelemetryBlock::Version || pBlock->Header.Size != sizeof(TelemetryBlock::Block))
+        {
+            if (pBlock)
+                UnmapViewOfFile(pBlock);
+            CloseHandle(hMapping);
+            continue;
+        }
+        instances[processId] = TelemetryInstance{ hMapping, pBlock, {}, false };
+    }
+}
+
+// Counters of an instance restart from zero when its scripts are reloaded
+static uint64_t GetCounterDelta(uint64_t current, uint64_t previous)
+{
+    return current >= previous ? current - previous : current;
+}
+
+static int PrintStats(DWORD interval, uint32_t count)
+{
+    // Rates and percentiles are computed over the interval, from the counters
+    // read at the end of the previous one
+    std::map<DWORD, TelemetryInstance> instances;
+    RefreshTelemetryInstances(instances);
+    for (auto& instance : instances)
+        instance.second.HasPrevious = TelemetryBlock::Read(instance.second.pBlock, instance.second.Previous);
+
+    for (uint32_t round = 0; count == 0 || round < count; round++)
+    {
+        Sleep(interval);
+        RefreshTelemetryInstances(instances);
+
+        uint64_t totalHistogram[TelemetryBlock::BucketCount] = {};
+        uint64_t totalFrameCount = 0;
+        uint64_t totalErrorCount = 0;
+        uint64_t totalPrivateUsage = 0;
+        size_t activeCount = 0;
+
+        printf("%8s %8s %8s %8s %8s %8s %12s %10s %10s\n", "PID", "FPS", "p50 ms", "p99 ms", "Max ms", "Errors", "Pulses/drop", "WS MB", "Priv MB");
+        for (auto& it : instances)
+        {
+            auto& instance = it.second;
+            TelemetryBlock::Data data;
+            if (!TelemetryBlock::Read(instance.pBlock, data))
+            {
+                printf("%8u (busy)\n", it.first);
+                continue;
+            }
+
+            uint64_t histogram[TelemetryBlock::BucketCount];
+            for (size_t i = 0; i < TelemetryBlock::BucketCount; i++)
+            {
+                histogram[i] = GetCounterDelta(data.FrameTimeHistogram[i], instance.HasPrevious ? instance.Previous.FrameTimeHistogram[i] : 0);
+                totalHistogram[i] += histogram[i];
+            }
+            uint64_t frameCount = GetCounterDelta(data.FrameCount, instance.HasPrevious ? instance.Previous.FrameCount : 0);
+            uint64_t errorCount = GetCounterDelta(data.ScriptErrorCount, instance.HasPrevious ? instance.Previous.ScriptErrorCount : 0);
+            totalFrameCount += frameCount;
+            totalErrorCount += errorCount;
+            totalPrivateUsage += data.PrivateUsage;
+            activeCount++;
+
+            char pulses[32];
+            snprintf(pulses, sizeof(pulses), "%llu/%llu", data.PulseCount, data.DroppedPulseCount);
+            printf("%8u %8.1f %8.2f %8.2f %8.2f %8llu %12s %10.1f %10.1f\n", it.first,
+                frameCount * 1000.0 / interval,
+                TelemetryBlock::GetPercentile(histogram, 50.0) / 1000.0,
+                TelemetryBlock::GetPercentile(histogram, 99.0) / 1000.0,
+                TelemetryBlock::GetPercentile(histogram, 100.0) / 1000.0,
+                errorCount, pulses,
+                data.WorkingSetSize / (1024.0 * 1024.0),
+                data.PrivateUsage / (1024.0 * 1024.0));
+
+            size_t scriptCount = data.ScriptCount < TelemetryBlock::MaxScripts ? data.ScriptCount : TelemetryBlock::MaxScripts;
+            for (size_t i = 0; i < scriptCount; i++)
+            {
+                auto& stats = data.Scripts[i];
+                if (!stats.IsRunning)
+                    continue;
+                printf("%8s   %-32.*s %8llu errors %10llu calls %8.1f us/call %10.1f KB\n", "",
+                    static_cast<int>(TelemetryBlock::ScriptNameLength), stats.Name,
+                    stats.ErrorCount, stats.CallbackCount,
+                    stats.CallbackCount ? static_cast<double>(stats.CallbackTime) / stats.CallbackCount : 0.0,
+                    stats.LuaMemory / 1024.0);
+            }
+
+            instance.Previous = data;
+            instance.HasPrevious = true;
+        }
+
+        printf("Total : %zu instances, %.1f frames/s, p50 %.2f ms, p99 %.2f ms, %llu errors, %.1f MB private\n\n",
+            activeCount,
+            totalFrameCount * 1000.0 / interval,
+            TelemetryBlock::GetPercentile(totalHistogram, 50.0) / 1000.0,
+            TelemetryBlock::GetPercentile(totalHistogram, 99.0) / 1000.0,
+            totalErrorCount,
+            totalPrivateUsage / (1024.0 * 1024.0));
+        fflush(stdout);
+    }
+
+    for (auto& instance : instances)
+        CloseTelemetryInstance(instance.second);
+    return 0;
+}
+
+static void PrintUsage()
+{
+    fprintf(stderr, "Usage :\n");
+    fprintf(stderr, "  PyxCli decode <file.pyxlog> [output.txt]\n");
+    fprintf(stderr, "  PyxCli read <Logs\\logs_pid> [output.txt]\n");
+    fprintf(stderr, "  PyxCli stats [interval_ms] [count, 0 to repeat forever]\n");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 3 && strcmp(argv[1], "decode") == 0)
+        return Decode(argv[2], argc >= 4 ? argv[3] : nullptr);
+    if (argc >= 3 && strcmp(argv[1], "read") == 0)
+        return ReadSegments(argv[2], argc >= 4 ? argv[3] : nullptr);
+    if (argc >= 2 && strcmp(argv[1], "stats") == 0)
+        return PrintStats(argc >= 3 ? (std::max)(atoi(argv[2]), 100) : 1000, argc >= 4 ? static_cast<uint32_t>(atoi(argv[3])) : 1);
+
+    PrintUsage();
+    return 1;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+// Benchmarks print the time per run of each measure, they aren't run by ctest
+namespace Pyx
+{
+    namespace Tests
+    {
+        // Keeps the compiler from dropping a computation whose result is unused
+        template <typename T> void KeepValue(const T& value)
+        {
+#if defined(__GNUC__)
+            asm volatile("" : : "g"(&value) : "memory");
+#else
+            static volatile const void* pSink;
+            pSink = &value;
+#endif
+        }
+
+        // Runs the function for about minDuration seconds and returns the
+        // average time of a run in nanoseconds, bytes is the size processed
+        // by a run when a throughput is to be printed
+        template <typename Function> double Measure(const char* name, Function function, double bytes = 0.0, double minDuration = 0.25)
+        {
+            typedef std::chrono::steady_clock Clock;
+            function();
+
+            size_t runCount = 0;
+            size_t batchSize = 1;
+            auto start = Clock::now();
+            double elapsed = 0.0;
+            while (elapsed < minDuration)
+            {
+                for (size_t i = 0; i < batchSize; i++)
+                    function();
+                runCount += batchSize;
+                batchSize *= 2;
+                elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            }
+
+            double nanoseconds = elapsed * 1e9 / runCount;
+            if (bytes > 0.0)
+                std::printf("%-48s %12.1f ns %10.1f MB/s\n", name, nanoseconds, bytes / nanoseconds * 1e3);
+            else
+                std::printf("%-48s %12.1f ns\n", name, nanoseconds);
+            return nanoseconds;
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include "Benchmark.h"
+#include <Pyx/Utility/Callbacks.h>
+#include <functional>
+#include <map>
+
+using Pyx::Tests::KeepValue;
+using Pyx::Tests::Measure;
+using Pyx::Utility::Callbacks;
+using Pyx::Utility::CallbacksMode;
+
+namespace
+{
+    // The std::map of std::function Callbacks replaced by the contiguous one
+    template <typename Func> class MapCallbacks
+    {
+    public:
+        using Callback = std::function<Func>;
+
+        size_t Register(Callback const& callback)
+        {
+            auto const cur_id = next_id_++;
+            callbacks_[cur_id] = callback;
+            return cur_id;
+        }
+
+        void Unregister(size_t id)
+        {
+            callbacks_.erase(id);
+        }
+
+        template <typename... Args>
+        void Run(Args&&... args) const
+        {
+            for (auto const& callback : callbacks_)
+                callback.second(std::forward<Args&&>(args)...);
+        }
+
+    private:
+        size_t next_id_ = size_t{};
+        std::map<size_t, Callback> callbacks_;
+    };
+
+    typedef void tOnRender(int frame);
+
+    // Callbacks capture a couple of pointers like the ImGui render callbacks
+    template <typename T> void Fill(T& callbacks, size_t count, uint64_t* pTotal)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            uint64_t* pValue = pTotal + (i & 1);
+            callbacks.Register([pTotal, pValue](int frame) { *pValue += static_cast<uint64_t>(frame); });
+        }
+    }
+
+    template <typename T> void MeasureRun(const char* name, size_t count)
+    {
+        T callbacks;
+        uint64_t totals[2] = {};
+        Fill(callbacks, count, totals);
+        int frame = 0;
+        Measure(name, [&]() { callbacks.Run(++frame); KeepValue(totals); });
+    }
+
+    template <typename T> void MeasureChurn(const char* name, size_t count)
+    {
+        // Registers a callback and unregisters the oldest one, the list
+        // keeps its size like menus opened and closed every few frames
+        T callbacks;
+        uint64_t totals[2] = {};
+        std::vector<size_t> handles;
+        for (size_t i = 0; i < count; i++)
+            handles.push_back(callbacks.Register([&totals](int frame) { totals[0] += frame; }));
+        size_t oldest = 0;
+        Measure(name, [&]()
+        {
+            callbacks.Unregister(handles[oldest]);
+            handles[oldest] = callbacks.Register([&totals](int frame) { totals[1] += frame; });
+            oldest = (oldest + 1) % handles.size();
+        });
+    }
+}
+
+int main()
+{
+    const size_t counts[] = { 1, 8, 64, 1024 };
+    for (size_t count : counts)
+    {
+        std::printf("Run, %zu callbacks\n", count);
+        MeasureRun<MapCallbacks<tOnRender>>("  std::map of std::function", count);
+        MeasureRun<Callbacks<tOnRender>>("  Callbacks", count);
+        MeasureRun<Callbacks<tOnRender, CallbacksMode::Snapshot>>("  Callbacks (snapshot)", count);
+    }
+    for (size_t count : counts)
+    {
+        std::printf("Register + Unregister, %zu callbacks\n", count);
+        MeasureChurn<MapCallbacks<tOnRender>>("  std::map of std::function", count);
+        MeasureChurn<Callbacks<tOnRender>>("  Callbacks", count);
+        MeasureChurn<Callbacks<tOnRender, CallbacksMode::Snapshot>>("  Callbacks (snapshot)", count);
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "Benchmark.h"
+#include <Pyx/Utility/IniFile.h>
+#include <cstdlib>
+#include <cwctype>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+using Pyx::Tests::KeepValue;
+using Pyx::Tests::Measure;
+using Pyx::Utility::IniFile;
+
+// Reading the three sections of every script.def of a script tree, as
+// ScriptDef does on every reload, with IniFile and with a stand-in for
+// GetPrivateProfileSectionW which reads and scans the file for each section
+namespace
+{
+    const size_t ScriptCount = 1000;
+    const wchar_t* Sections[] = { L"script", L"files", L"dependencies" };
+
+    std::wstring ToLower(std::wstring text)
+    {
+        for (auto& c : text)
+            c = static_cast<wchar_t>(towlower(c));
+        return text;
+    }
+
+    std::wstring Trim(const std::wstring& text)
+    {
+        size_t first = text.find_first_not_of(L" \t");
+        size_t last = text.find_last_not_of(L" \t\r");
+        return first == std::wstring::npos ? std::wstring() : text.substr(first, last - first + 1);
+    }
+
+    // Reads the file again for each section and copies "key=value\0" pairs
+    // into a fixed 4096 characters buffer, then splits them like the old
+    // IniFile::GetSectionValues did
+    std::vector<IniFile::SectionValue> ReadProfileSection(const std::string& fileName, const std::wstring& sectionName)
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        std::string bytes = stream.str();
+        std::wstring text(bytes.begin(), bytes.end());
+
+        wchar_t buffer[4096];
+        size_t length = 0;
+        bool isInSection = false;
+        std::wistringstream lines(text);
+        std::wstring line;
+        while (std::getline(lines, line))
+        {
+            line = Trim(line);
+            if (line.empty() || line[0] == L';')
+                continue;
+            if (line[0] == L'[')
+            {
+                isInSection = ToLower(Trim(line.substr(1, line.find(L']') - 1))) == sectionName;
+                continue;
+            }
+            if (!isInSection || line.size() + 1 > 4096 - 1 - length)
+                continue;
+            std::copy(line.begin(), line.end(), buffer + length);
+            length += line.size();
+            buffer[length++] = L'\0';
+        }
+        buffer[length] = L'\0';
+
+        std::vector<IniFile::SectionValue> results;
+        for (const wchar_t* pEntry = buffer; *pEntry; pEntry += wcslen(pEntry) + 1)
+        {
+            std::wstring entry(pEntry);
+            size_t equal = entry.find(L'=');
+            if (equal != std::wstring::npos)
+                results.push_back(IniFile::SectionValue{ sectionName, Trim(entry.substr(0, equal)), Trim(entry.substr(equal + 1)) });
+        }
+        return results;
+    }
+}
+
+int main()
+{
+    char directory[] = "/tmp/PyxIniFileBenchmarkXXXXXX";
+    if (!mkdtemp(directory))
+        return 1;
+
+    std::vector<std::string> fileNames;
+    size_t totalSize = 0;
+    for (size_t i = 0; i < ScriptCount; i++)
+    {
+        std::ostringstream content;
+        content << "; Generated script " << i << "\n[Script]\nName = Script" << i << "\nType = " << (i % 4 == 0 ? "lib" : "script")
+            << "\nAuthor = Pyx\nVersion = 1." << i % 10 << "\n\n[Files]\n";
+        for (size_t file = 0; file < 12; file++)
+            content << file << " = Sources/Module" << file << "/File" << i << ".lua\n";
+        content << "\n[Dependencies]\n";
+        for (size_t dependency = 0; dependency < 3; dependency++)
+            content << dependency << " = Script" << (i + dependency * 7) % ScriptCount << "\n";
+
+        std::string fileName = std::string(directory) + "/script" + std::to_string(i) + ".def";
+        std::ofstream(fileName, std::ios::binary) << content.str();
+        fileNames.push_back(fileName);
+        totalSize += content.str().size();
+    }
+    std::printf("%zu script.def files, %zu bytes\n", ScriptCount, totalSize);
+
+    std::vector<std::wstring> wideFileNames;
+    for (auto& fileName : fileNames)
+        wideFileNames.push_back(std::wstring(fileName.begin(), fileName.end()));
+
+    Measure("reload, file read for each section", [&]()
+    {
+        for (auto& fileName : fileNames)
+            for (auto pSection : Sections)
+                KeepValue(ReadProfileSection(fileName, pSection));
+    }, static_cast<double>(totalSize));
+
+    Measure("reload, IniFile parsed once per file", [&]()
+    {
+        IniFile::ClearCache();
+        for (auto& fileName : wideFileNames)
+        {
+            IniFile iniFile(fileName);
+            KeepValue(iniFile.GetSectionValues(L"script"));
+            KeepValue(iniFile.GetSectionValues(L"files"));
+            KeepValue(iniFile.GetSectionValues(L"dependencies"));
+        }
+    }, static_cast<double>(totalSize));
+
+    Measure("reload, IniFile unchanged files", [&]()
+    {
+        for (auto& fileName : wideFileNames)
+        {
+            IniFile iniFile(fileName);
+            KeepValue(iniFile.GetSectionValues(L"script"));
+            KeepValue(iniFile.GetSectionValues(L"files"));
+            KeepValue(iniFile.GetSectionValues(L"dependencies"));
+        }
+    }, static_cast<double>(totalSize));
+
+    std::system(("rm -rf '" + std::string(directory) + "'").c_str());
+    return 0;
+}
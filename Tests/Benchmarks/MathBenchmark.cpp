@@ -0,0 +1,340 @@
+#include "Benchmark.h"
+#include <Pyx/Math/Matrix4.h>
+#include <Pyx/Math/Quaternion.h>
+#include <Pyx/Math/Vector3.h>
+#include <Pyx/Math/Vector3Array.h>
+#include <Pyx/Math/Vector4.h>
+#include <Pyx/Scripting/Script.h>
+#include <cmath>
+#include <vector>
+
+using Pyx::Math::Matrix4;
+using Pyx::Math::Quaternion;
+using Pyx::Math::Vector3;
+using Pyx::Math::Vector3Array;
+using Pyx::Math::Vector4;
+using Pyx::Scripting::Script;
+using Pyx::Tests::KeepValue;
+using Pyx::Tests::Measure;
+
+// The math types against the same operations written in Lua the way scripts
+// did, on plain tables, and called from Lua through the bindings. Every run
+// does an operation on each of the Count inputs.
+namespace
+{
+    const int Count = 1024;
+    const float Width = 1920.0f;
+    const float Height = 1080.0f;
+
+    const char* LuaMath = R"(
+        local Count = Count
+        local sin, cos, sqrt, acos = math.sin, math.cos, math.sqrt, math.acos
+        local M = Pyx.Math
+
+        -- Inputs are built with the bindings and copied to plain tables
+        local vectors, points, matrices, quaternions = {}, {}, {}, {}
+        local plainVectors, plainPoints, plainMatrices, plainQuaternions = {}, {}, {}, {}
+        local projection = M.Matrix4.LookAtLH(M.Vector3(0, 10, -20), M.Vector3(), M.Vector3(0, 1, 0)) * M.Matrix4.PerspectiveFovLH(1.0, 16 / 9, 0.1, 1000)
+        local plainProjection = {}
+        for i = 1, Count do
+            vectors[i] = M.Vector4(sin(i), cos(i * 0.7), sin(i * 1.3), cos(i * 0.3))
+            points[i] = M.Vector3(sin(i * 0.9) * 30, cos(i * 1.1) * 5, sin(i * 0.4) * 30)
+            quaternions[i] = M.Quaternion.FromAxisAngle(M.Vector3(sin(i), cos(i), 0.5), i * 0.1)
+            matrices[i] = M.Matrix4.RotationQuaternion(quaternions[i]) * M.Matrix4.Translation(points[i])
+            local v, p, q, m = vectors[i], points[i], quaternions[i], matrices[i]
+            plainVectors[i] = { X = v.X, Y = v.Y, Z = v.Z, W = v.W }
+            plainPoints[i] = { X = p.X, Y = p.Y, Z = p.Z }
+            plainQuaternions[i] = { X = q.X, Y = q.Y, Z = q.Z, W = q.W }
+            local plain = {}
+            for row = 1, 4 do
+                for col = 1, 4 do
+                    plain[(row - 1) * 4 + col] = m:Get(row, col)
+                end
+            end
+            plainMatrices[i] = plain
+        end
+        for row = 1, 4 do
+            for col = 1, 4 do
+                plainProjection[(row - 1) * 4 + col] = projection:Get(row, col)
+            end
+        end
+
+        local function Dot(a, b)
+            return a.X * b.X + a.Y * b.Y + a.Z * b.Z + a.W * b.W
+        end
+
+        local function Lerp(a, b, t)
+            return { X = a.X + (b.X - a.X) * t, Y = a.Y + (b.Y - a.Y) * t, Z = a.Z + (b.Z - a.Z) * t, W = a.W + (b.W - a.W) * t }
+        end
+
+        local function Multiply(a, b)
+            local r = {}
+            for i = 0, 12, 4 do
+                local a0, a1, a2, a3 = a[i + 1], a[i + 2], a[i + 3], a[i + 4]
+                for j = 1, 4 do
+                    r[i + j] = a0 * b[j] + a1 * b[4 + j] + a2 * b[8 + j] + a3 * b[12 + j]
+                end
+            end
+            return r
+        end
+
+        local function Transform(m, p)
+            local x = p.X * m[1] + p.Y * m[5] + p.Z * m[9] + m[13]
+            local y = p.X * m[2] + p.Y * m[6] + p.Z * m[10] + m[14]
+            local z = p.X * m[3] + p.Y * m[7] + p.Z * m[11] + m[15]
+            local w = p.X * m[4] + p.Y * m[8] + p.Z * m[12] + m[16]
+            return x, y, z, w
+        end
+
+        local function TransformCoord(m, p)
+            local x, y, z, w = Transform(m, p)
+            if math.abs(w) < 1e-6 then return { X = x, Y = y, Z = z } end
+            return { X = x / w, Y = y / w, Z = z / w }
+        end
+
+        local function Invert(m)
+            local s0 = m[1] * m[6] - m[5] * m[2]
+            local s1 = m[1] * m[7] - m[5] * m[3]
+            local s2 = m[1] * m[8] - m[5] * m[4]
+            local s3 = m[2] * m[7] - m[6] * m[3]
+            local s4 = m[2] * m[8] - m[6] * m[4]
+            local s5 = m[3] * m[8] - m[7] * m[4]
+            local c5 = m[11] * m[16] - m[15] * m[12]
+            local c4 = m[10] * m[16] - m[14] * m[12]
+            local c3 = m[10] * m[15] - m[14] * m[11]
+            local c2 = m[9] * m[16] - m[13] * m[12]
+            local c1 = m[9] * m[15] - m[13] * m[11]
+            local c0 = m[9] * m[14] - m[13] * m[10]
+            local det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0
+            if det == 0 then return nil end
+            local d = 1 / det
+            return {
+                (m[6] * c5 - m[7] * c4 + m[8] * c3) * d, (-m[2] * c5 + m[3] * c4 - m[4] * c3) * d,
+                (m[14] * s5 - m[15] * s4 + m[16] * s3) * d, (-m[10] * s5 + m[11] * s4 - m[12] * s3) * d,
+                (-m[5] * c5 + m[7] * c2 - m[8] * c1) * d, (m[1] * c5 - m[3] * c2 + m[4] * c1) * d,
+                (-m[13] * s5 + m[15] * s2 - m[16] * s1) * d, (m[9] * s5 - m[11] * s2 + m[12] * s1) * d,
+                (m[5] * c4 - m[6] * c2 + m[8] * c0) * d, (-m[1] * c4 + m[2] * c2 - m[4] * c0) * d,
+                (m[13] * s4 - m[14] * s2 + m[16] * s0) * d, (-m[9] * s4 + m[10] * s2 - m[12] * s0) * d,
+                (-m[5] * c3 + m[6] * c1 - m[7] * c0) * d, (m[1] * c3 - m[2] * c1 + m[3] * c0) * d,
+                (-m[13] * s3 + m[14] * s1 - m[15] * s0) * d, (m[9] * s3 - m[10] * s1 + m[11] * s0) * d
+            }
+        end
+
+        local function QuaternionMultiply(a, b)
+            return {
+                X = b.W * a.X + b.X * a.W + b.Y * a.Z - b.Z * a.Y,
+                Y = b.W * a.Y - b.X * a.Z + b.Y * a.W + b.Z * a.X,
+                Z = b.W * a.Z + b.X * a.Y - b.Y * a.X + b.Z * a.W,
+                W = b.W * a.W - b.X * a.X - b.Y * a.Y - b.Z * a.Z
+            }
+        end
+
+        local function Rotate(q, v)
+            local tx = 2 * (q.Y * v.Z - q.Z * v.Y)
+            local ty = 2 * (q.Z * v.X - q.X * v.Z)
+            local tz = 2 * (q.X * v.Y - q.Y * v.X)
+            return {
+                X = v.X + tx * q.W + q.Y * tz - q.Z * ty,
+                Y = v.Y + ty * q.W + q.Z * tx - q.X * tz,
+                Z = v.Z + tz * q.W + q.X * ty - q.Y * tx
+            }
+        end
+
+        local function Slerp(from, to, t)
+            local cosTheta = Dot(from, to)
+            local sign = 1
+            if cosTheta < 0 then cosTheta, sign = -cosTheta, -1 end
+            local a, b
+            if cosTheta > 1 - 1e-6 then
+                a, b = 1 - t, t
+            else
+                local theta = acos(cosTheta)
+                local invSin = 1 / sin(theta)
+                a, b = sin((1 - t) * theta) * invSin, sin(t * theta) * invSin
+            end
+            b = b * sign
+            local x, y, z, w = a * from.X + b * to.X, a * from.Y + b * to.Y, a * from.Z + b * to.Z, a * from.W + b * to.W
+            local length = sqrt(x * x + y * y + z * z + w * w)
+            return { X = x / length, Y = y / length, Z = z / length, W = w / length }
+        end
+
+        local function Project(m, p, width, height)
+            local x, y, z, w = Transform(m, p)
+            if w < 1e-6 then return false end
+            x, y, z = x / w, y / w, z / w
+            local screen = { X = (x + 1) * 0.5 * width, Y = (1 - y) * 0.5 * height, Z = z }
+            return x >= -1 and x <= 1 and y >= -1 and y <= 1 and z >= 0 and z <= 1, screen
+        end
+
+        local function Next(i)
+            return i % Count + 1
+        end
+
+        Lua = {
+            Dot = function() local s = 0 for i = 1, Count do s = s + Dot(plainVectors[i], plainVectors[Next(i)]) end return s end,
+            Lerp = function() local r for i = 1, Count do r = Lerp(plainVectors[i], plainVectors[Next(i)], 0.25) end return r end,
+            Multiply = function() local r for i = 1, Count do r = Multiply(plainMatrices[i], plainMatrices[Next(i)]) end return r end,
+            TransformCoord = function() local r for i = 1, Count do r = TransformCoord(plainMatrices[i], plainPoints[i]) end return r end,
+            Invert = function() local r for i = 1, Count do r = Invert(plainMatrices[i]) end return r end,
+            QuaternionMultiply = function() local r for i = 1, Count do r = QuaternionMultiply(plainQuaternions[i], plainQuaternions[Next(i)]) end return r end,
+            Rotate = function() local r for i = 1, Count do r = Rotate(plainQuaternions[i], plainPoints[i]) end return r end,
+            Slerp = function() local r for i = 1, Count do r = Slerp(plainQuaternions[i], plainQuaternions[Next(i)], 0.25) end return r end,
+            Project = function() local n = 0 for i = 1, Count do if Project(plainProjection, plainPoints[i], 1920, 1080) then n = n + 1 end end return n end
+        }
+
+        local Vector4, Quaternion = M.Vector4, M.Quaternion
+        Bindings = {
+            Dot = function() local s = 0 for i = 1, Count do s = s + Vector4.Dot(vectors[i], vectors[Next(i)]) end return s end,
+            Lerp = function() local r for i = 1, Count do r = Vector4.Lerp(vectors[i], vectors[Next(i)], 0.25) end return r end,
+            Multiply = function() local r for i = 1, Count do r = matrices[i] * matrices[Next(i)] end return r end,
+            TransformCoord = function() local r for i = 1, Count do r = matrices[i]:TransformCoord(points[i]) end return r end,
+            Invert = function() local r for i = 1, Count do r = matrices[i]:Inverted() end return r end,
+            QuaternionMultiply = function() local r for i = 1, Count do r = quaternions[i] * quaternions[Next(i)] end return r end,
+            Rotate = function() local r for i = 1, Count do r = quaternions[i]:Rotate(points[i]) end return r end,
+            Slerp = function() local r for i = 1, Count do r = Quaternion.Slerp(quaternions[i], quaternions[Next(i)], 0.25) end return r end,
+            Project = function() local n = 0 for i = 1, Count do if projection:Project(points[i], 1920, 1080) then n = n + 1 end end return n end
+        }
+    )";
+
+    // Same inputs as the Lua side
+    struct Inputs
+    {
+        std::vector<Vector4> Vectors;
+        std::vector<Vector3> Points;
+        std::vector<Quaternion> Quaternions;
+        std::vector<Matrix4> Matrices;
+        Vector3Array WorldPoints;
+        Matrix4 Projection;
+    };
+
+    Inputs BuildInputs()
+    {
+        Inputs inputs;
+        for (int i = 1; i <= Count; i++)
+        {
+            float f = static_cast<float>(i);
+            inputs.Vectors.push_back(Vector4(sinf(f), cosf(f * 0.7f), sinf(f * 1.3f), cosf(f * 0.3f)));
+            inputs.Points.push_back(Vector3(sinf(f * 0.9f) * 30.0f, cosf(f * 1.1f) * 5.0f, sinf(f * 0.4f) * 30.0f));
+            inputs.Quaternions.push_back(Quaternion::FromAxisAngle(Vector3(sinf(f), cosf(f), 0.5f), f * 0.1f));
+            inputs.Matrices.push_back(Matrix4::RotationQuaternion(inputs.Quaternions.back()) * Matrix4::Translation(inputs.Points.back()));
+            inputs.WorldPoints.Push(inputs.Points.back());
+        }
+        inputs.Projection = Matrix4::LookAtLH(Vector3(0.0f, 10.0f, -20.0f), Vector3(), Vector3(0.0f, 1.0f, 0.0f)) * Matrix4::PerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+        return inputs;
+    }
+
+    int Next(int i)
+    {
+        return (i + 1) % Count;
+    }
+
+    void MeasureLua(Script& script, const char* operation)
+    {
+        LuaRef luaFunction = LuaRef(script.GetLuaState(), "Lua").get(operation);
+        LuaRef bindingFunction = LuaRef(script.GetLuaState(), "Bindings").get(operation);
+        Measure("  Lua tables", [&]() { luaFunction(); });
+        Measure("  Lua with the bindings", [&]() { bindingFunction(); });
+    }
+}
+
+int main()
+{
+    Script script;
+    Vector3::BindWithScript(&script);
+    Vector4::BindWithScript(&script);
+    Quaternion::BindWithScript(&script);
+    Matrix4::BindWithScript(&script);
+    Lua::setGlobal(script.GetLuaState(), "Count", Count);
+    script.GetLuaState().doString(LuaMath);
+
+    const Inputs inputs = BuildInputs();
+#if PYX_MATH_SSE
+    std::printf("SSE build, ns per %d operations\n", Count);
+#else
+    std::printf("Scalar build, ns per %d operations\n", Count);
+#endif
+
+    std::printf("Vector4 Dot\n");
+    MeasureLua(script, "Dot");
+    Measure("  native", [&]()
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < Count; i++)
+            sum += Vector4::Dot(inputs.Vectors[i], inputs.Vectors[Next(i)]);
+        KeepValue(sum);
+    });
+
+    std::printf("Vector4 Lerp\n");
+    MeasureLua(script, "Lerp");
+    Measure("  native", [&]()
+    {
+        for (int i = 0; i < Count; i++)
+            KeepValue(Vector4::Lerp(inputs.Vectors[i], inputs.Vectors[Next(i)], 0.25f));
+    });
+
+    std::printf("Matrix4 multiply\n");
+    MeasureLua(script, "Multiply");
+    Measure("  native", [&]()
+    {
+        for (int i = 0; i < Count; i++)
+            KeepValue(inputs.Matrices[i] * inputs.Matrices[Next(i)]);
+    });
+
+    std::printf("Matrix4 TransformCoord\n");
+    MeasureLua(script, "TransformCoord");
+    Measure("  native", [&]()
+    {
+        for (int i = 0; i < Count; i++)
+            KeepValue(inputs.Matrices[i].TransformCoord(inputs.Points[i]));
+    });
+
+    std::printf("Matrix4 Inverted\n");
+    MeasureLua(script, "Invert");
+    Measure("  native", [&]()
+    {
+        for (int i = 0; i < Count; i++)
+            KeepValue(inputs.Matrices[i].Inverted());
+    });
+
+    std::printf("Quaternion multiply\n");
+    MeasureLua(script, "QuaternionMultiply");
+    Measure("  native", [&]()
+    {
+        for (int i = 0; i < Count; i++)
+            KeepValue(inputs.Quaternions[i] * inputs.Quaternions[Next(i)]);
+    });
+
+    std::printf("Quaternion Rotate\n");
+    MeasureLua(script, "Rotate");
+    Measure("  native", [&]()
+    {
+        for (int i = 0; i < Count; i++)
+            KeepValue(inputs.Quaternions[i].Rotate(inputs.Points[i]));
+    });
+
+    std::printf("Quaternion Slerp\n");
+    MeasureLua(script, "Slerp");
+    Measure("  native", [&]()
+    {
+        for (int i = 0; i < Count; i++)
+            KeepValue(Quaternion::Slerp(inputs.Quaternions[i], inputs.Quaternions[Next(i)], 0.25f));
+    });
+
+    std::printf("Matrix4 Project\n");
+    MeasureLua(script, "Project");
+    Measure("  native", [&]()
+    {
+        int visibleCount = 0;
+        Vector3 screen;
+        for (int i = 0; i < Count; i++)
+            visibleCount += inputs.Projection.Project(inputs.Points[i], Width, Height, screen) ? 1 : 0;
+        KeepValue(visibleCount);
+    });
+    Vector3Array screenPoints;
+    std::vector<uint8_t> flags;
+    Measure("  native ProjectArray", [&]()
+    {
+        KeepValue(inputs.Projection.ProjectArray(inputs.WorldPoints, Vector3(), Width, Height, screenPoints, flags));
+    });
+    return 0;
+}
@@ -0,0 +1,267 @@
+#include "Benchmark.h"
+#include <Pyx/Math/NavGraph.h>
+#include <Pyx/Math/PathFinder.h>
+#include <Pyx/Math/PathfindingContext.h>
+#include <Pyx/Math/Vector3.h>
+#include <Pyx/Scripting/Script.h>
+#include <cstdint>
+#include <vector>
+
+using Pyx::Math::NavGraph;
+using Pyx::Math::PathFinder;
+using Pyx::Math::Vector3;
+using Pyx::Scripting::Script;
+using Pyx::Tests::KeepValue;
+using Pyx::Tests::Measure;
+
+// PathFinder against the A* the movement scripts ran in Lua, on grids with a
+// fifth of the cells blocked and edge costs up to half above the distance
+namespace
+{
+    // A* over the graph arrays with a binary heap, the heuristic goes through
+    // the Vector3 bindings like the scripts did
+    const char* LuaPathFinder = R"(
+        local positions, firstEdges, edgeCounts, targets, costs = Positions, FirstEdges, EdgeCounts, Targets, Costs
+
+        function FindPath(startNode, endNode)
+            local goal = positions[endNode]
+            local nodeCosts, parents, isClosed = {}, {}, {}
+            local heapNodes, heapScores, heapSize = {}, {}, 0
+
+            local function Push(node, score)
+                heapSize = heapSize + 1
+                local i = heapSize
+                while i > 1 do
+                    local parent = i // 2
+                    if heapScores[parent] <= score then break end
+                    heapNodes[i], heapScores[i] = heapNodes[parent], heapScores[parent]
+                    i = parent
+                end
+                heapNodes[i], heapScores[i] = node, score
+            end
+
+            local function Pop()
+                local top = heapNodes[1]
+                local node, score = heapNodes[heapSize], heapScores[heapSize]
+                heapNodes[heapSize], heapScores[heapSize] = nil, nil
+                heapSize = heapSize - 1
+                local i = 1
+                while true do
+                    local child = i * 2
+                    if child > heapSize then break end
+                    if child < heapSize and heapScores[child + 1] < heapScores[child] then child = child + 1 end
+                    if score <= heapScores[child] then break end
+                    heapNodes[i], heapScores[i] = heapNodes[child], heapScores[child]
+                    i = child
+                end
+                if heapSize > 0 then heapNodes[i], heapScores[i] = node, score end
+                return top
+            end
+
+            nodeCosts[startNode] = 0
+            Push(startNode, positions[startNode]:GetDistance3D(goal))
+            while heapSize > 0 do
+                local node = Pop()
+                if node == endNode then
+                    local length = 0
+                    while node do
+                        length = length + 1
+                        node = parents[node]
+                    end
+                    return length
+                end
+                if not isClosed[node] then
+                    isClosed[node] = true
+                    local cost = nodeCosts[node]
+                    local first = firstEdges[node]
+                    for edge = first, first + edgeCounts[node] - 1 do
+                        local target = targets[edge]
+                        local targetCost = cost + costs[edge]
+                        local previousCost = nodeCosts[target]
+                        if not isClosed[target] and (previousCost == nil or targetCost < previousCost) then
+                            nodeCosts[target] = targetCost
+                            parents[target] = node
+                            Push(target, targetCost + positions[target]:GetDistance3D(goal))
+                        end
+                    end
+                end
+            end
+            return 0
+        end
+
+        function FindNativePath(graph, start, goal, smooth)
+            return #graph:FindPath(start, goal, smooth)
+        end
+    )";
+
+    class Random
+    {
+
+    private:
+        uint32_t m_state;
+
+    public:
+        explicit Random(uint32_t seed) : m_state(seed) { }
+        uint32_t Next()
+        {
+            m_state = m_state * 1664525 + 1013904223;
+            return m_state >> 8;
+        }
+        float NextFloat() { return static_cast<float>(Next()) / static_cast<float>(1 << 24); }
+
+    };
+
+    struct Grid
+    {
+        std::shared_ptr<NavGraph> pWaypoints;
+        std::shared_ptr<NavGraph> pNavMesh;
+        std::vector<std::pair<uint32_t, uint32_t>> Queries;
+    };
+
+    // Cells are both waypoints linked to their 8 neighbours and square
+    // polygons sharing a portal with their 4 neighbours
+    Grid BuildGrid(int size)
+    {
+        Random random(static_cast<uint32_t>(size));
+        std::vector<bool> isBlocked(size * size);
+        for (size_t i = 0; i < isBlocked.size(); i++)
+            isBlocked[i] = random.Next() % 5 == 0;
+
+        std::vector<Vector3> positions;
+        std::vector<uint32_t> nodes(size * size, NavGraph::InvalidNode);
+        for (int z = 0; z < size; z++)
+        {
+            for (int x = 0; x < size; x++)
+            {
+                if (isBlocked[z * size + x])
+                    continue;
+                nodes[z * size + x] = static_cast<uint32_t>(positions.size());
+                positions.push_back(Vector3(x + 0.5f, random.NextFloat(), z + 0.5f));
+            }
+        }
+
+        std::vector<NavGraph::Link> waypointLinks;
+        std::vector<NavGraph::Link> navMeshLinks;
+        for (int z = 0; z < size; z++)
+        {
+            for (int x = 0; x < size; x++)
+            {
+                uint32_t from = nodes[z * size + x];
+                if (from == NavGraph::InvalidNode)
+                    continue;
+                for (int dz = -1; dz <= 1; dz++)
+                {
+                    for (int dx = -1; dx <= 1; dx++)
+                    {
+                        if ((dx == 0 && dz == 0) || x + dx < 0 || x + dx >= size || z + dz < 0 || z + dz >= size)
+                            continue;
+                        uint32_t to = nodes[(z + dz) * size + x + dx];
+                        if (to == NavGraph::InvalidNode)
+                            continue;
+                        float distance = static_cast<float>(positions[from].GetDistance3D(positions[to]));
+                        waypointLinks.push_back(NavGraph::Link{ from, to, distance * (1.0f + random.NextFloat() * 0.5f), NavGraph::Portal() });
+                        if (dx != 0 && dz != 0)
+                            continue;
+
+                        // The edge shared by the two squares
+                        float edgeX = x + 0.5f + dx * 0.5f;
+                        float edgeZ = z + 0.5f + dz * 0.5f;
+                        NavGraph::Portal portal{ Vector3(edgeX - dz * 0.5f, 0.0f, edgeZ - dx * 0.5f), Vector3(edgeX + dz * 0.5f, 0.0f, edgeZ + dx * 0.5f) };
+                        navMeshLinks.push_back(NavGraph::Link{ from, to, distance, portal });
+                    }
+                }
+            }
+        }
+
+        Grid grid;
+        grid.pWaypoints = NavGraph::Build(positions, std::move(waypointLinks), false);
+        grid.pNavMesh = NavGraph::Build(positions, std::move(navMeshLinks), true);
+        for (int i = 0; i < 16; i++)
+        {
+            uint32_t start = random.Next() % positions.size();
+            uint32_t end = random.Next() % positions.size();
+            grid.Queries.push_back(std::make_pair(start, end));
+        }
+        return grid;
+    }
+
+    void LoadGraph(Script& script, const NavGraph& graph)
+    {
+        // Lua arrays start at 1
+        std::vector<Vector3> positions;
+        std::vector<uint32_t> firstEdges;
+        std::vector<uint32_t> edgeCounts;
+        for (uint32_t i = 0; i < graph.GetNodeCount(); i++)
+        {
+            auto& node = graph.GetNode(i);
+            positions.push_back(node.Position);
+            firstEdges.push_back(node.FirstEdge + 1);
+            edgeCounts.push_back(node.EdgeCount);
+        }
+        std::vector<uint32_t> targets;
+        std::vector<float> costs;
+        for (uint32_t i = 0; i < graph.GetEdgeCount(); i++)
+        {
+            targets.push_back(graph.GetEdge(i).Target + 1);
+            costs.push_back(graph.GetEdge(i).Cost);
+        }
+
+        auto& luaState = script.GetLuaState();
+        Lua::setGlobal(luaState, "Positions", positions);
+        Lua::setGlobal(luaState, "FirstEdges", firstEdges);
+        Lua::setGlobal(luaState, "EdgeCounts", edgeCounts);
+        Lua::setGlobal(luaState, "Targets", targets);
+        Lua::setGlobal(luaState, "Costs", costs);
+        luaState.doString(LuaPathFinder);
+    }
+
+    void Run(int size)
+    {
+        Grid grid = BuildGrid(size);
+        auto& waypoints = *grid.pWaypoints;
+        auto& navMesh = *grid.pNavMesh;
+        std::printf("%dx%d grid, %zu nodes, %zu waypoint edges, %zu portals\n", size, size, waypoints.GetNodeCount(), waypoints.GetEdgeCount(), navMesh.GetEdgeCount());
+
+        Script script;
+        Vector3::BindWithScript(&script);
+        NavGraph::BindWithScript(&script);
+        LoadGraph(script, waypoints);
+        LuaRef findLuaPath(script.GetLuaState(), "FindPath");
+        LuaRef findNativePath(script.GetLuaState(), "FindNativePath");
+
+        size_t query = 0;
+        auto nextQuery = [&]() { return grid.Queries[query++ % grid.Queries.size()]; };
+        PathFinder pathFinder;
+        std::vector<Vector3> path;
+        const double minDuration = size > 256 ? 2.0 : 0.5;
+
+        Measure("  A* in Lua", [&]()
+        {
+            auto nodes = nextQuery();
+            KeepValue(findLuaPath.call<int>(nodes.first + 1, nodes.second + 1));
+        }, 0.0, minDuration);
+        Measure("  NavGraph:FindPath from Lua", [&]()
+        {
+            auto nodes = nextQuery();
+            KeepValue(findNativePath.call<int>(grid.pWaypoints, waypoints.GetNode(nodes.first).Position, waypoints.GetNode(nodes.second).Position, false));
+        }, 0.0, minDuration);
+        Measure("  PathFinder", [&]()
+        {
+            auto nodes = nextQuery();
+            KeepValue(pathFinder.FindPath(waypoints, waypoints.GetNode(nodes.first).Position, waypoints.GetNode(nodes.second).Position, false, path));
+        }, 0.0, minDuration);
+        Measure("  PathFinder, navmesh with funnel", [&]()
+        {
+            auto nodes = nextQuery();
+            KeepValue(pathFinder.FindPath(navMesh, navMesh.GetNode(nodes.first).Position, navMesh.GetNode(nodes.second).Position, true, path));
+        }, 0.0, minDuration);
+    }
+}
+
+int main()
+{
+    Run(64);
+    Run(256);
+    Run(1024);
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "Benchmark.h"
+#include <Pyx/Utility/Utf8.h>
+#include <codecvt>
+#include <locale>
+#include <vector>
+
+using Pyx::Tests::KeepValue;
+using Pyx::Tests::Measure;
+using Pyx::Utility::Utf8;
+
+// Utf8 against std::codecvt, the portable stand-in for the two pass
+// WideCharToMultiByte / MultiByteToWideChar conversions it replaced
+namespace
+{
+    std::u16string Repeat(const std::u16string& text, size_t length)
+    {
+        std::u16string result;
+        while (result.size() < length)
+            result += text;
+        result.resize(length);
+        return result;
+    }
+
+    void Run(const char* name, const std::u16string& text)
+    {
+        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
+        const std::string encoded = converter.to_bytes(text);
+        const double size = static_cast<double>(encoded.size());
+        std::vector<char> encodeBuffer(Utf8::GetMaxEncodedSize(text.size()));
+        std::vector<char16_t> decodeBuffer(Utf8::GetMaxDecodedLength(encoded.size()));
+        std::printf("%s, %zu characters, %zu bytes\n", name, text.size(), encoded.size());
+
+        Measure("  encode std::codecvt", [&]() { KeepValue(converter.to_bytes(text)); }, size);
+        Measure("  encode Utf8 (std::string)", [&]() { KeepValue(Utf8::Encode(text)); }, size);
+        Measure("  encode Utf8 (caller buffer)", [&]() { KeepValue(Utf8::Encode(text.data(), text.size(), encodeBuffer.data(), encodeBuffer.size())); }, size);
+        Measure("  decode std::codecvt", [&]() { KeepValue(converter.from_bytes(encoded)); }, size);
+        Measure("  decode Utf8 (std::u16string)", [&]() { KeepValue(Utf8::Decode(encoded)); }, size);
+        Measure("  decode Utf8 (caller buffer)", [&]() { KeepValue(Utf8::Decode(encoded.data(), encoded.size(), decodeBuffer.data(), decodeBuffer.size())); }, size);
+        Measure("  validate Utf8", [&]() { KeepValue(Utf8::IsValid(encoded.data(), encoded.size())); }, size);
+    }
+}
+
+int main()
+{
+    Run("Log line", u"[12:34:56] [Scripting] Found script MyScript in Scripts/MyScript");
+    Run("ASCII", Repeat(u"Pyx.Graphics.Overlay draws every entity of the current frame. ", 64 * 1024));
+    Run("Latin", Repeat(u"Le déplacement du personnage est calculé à chaque étape. ", 64 * 1024));
+    Run("CJK", Repeat(u"日本語のテキストを変換します。", 64 * 1024));
+    Run("Emoji", Repeat(u"\U0001F600\U0001F680 ok ", 64 * 1024));
+    return 0;
+}
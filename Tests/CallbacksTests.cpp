@@ -0,0 +1,174 @@
+#include "Test.h"
+#include <Pyx/Utility/Callbacks.h>
+#include <string>
+#include <vector>
+
+using Pyx::Utility::Callbacks;
+using Pyx::Utility::CallbacksMode;
+
+namespace
+{
+    typedef void tOnEvent(int value);
+}
+
+PYX_TEST(RunsCallbacksInRegistrationOrder)
+{
+    Callbacks<tOnEvent> callbacks;
+    std::vector<int> calls;
+    for (int i = 0; i < 4; i++)
+        callbacks.Register([&calls, i](int value) { calls.push_back(i * 10 + value); });
+    callbacks.Run(1);
+    PYX_CHECK_EQUAL(4u, calls.size());
+    for (int i = 0; i < 4; i++)
+        PYX_CHECK_EQUAL(i * 10 + 1, calls[i]);
+}
+
+PYX_TEST(UnregisterKeepsTheOrderOfTheOthers)
+{
+    Callbacks<tOnEvent> callbacks;
+    std::string calls;
+    std::vector<size_t> handles;
+    for (char name = 'a'; name <= 'f'; name++)
+        handles.push_back(callbacks.Register([&calls, name](int) { calls += name; }));
+    callbacks.Unregister(handles[1]);
+    callbacks.Unregister(handles[4]);
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("acdf"), calls);
+
+    // Compacted once half of the callbacks are removed
+    callbacks.Unregister(handles[0]);
+    calls.clear();
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("cdf"), calls);
+    handles.push_back(callbacks.Register([&calls](int) { calls += 'g'; }));
+    callbacks.Unregister(handles[3]);
+    calls.clear();
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("cfg"), calls);
+}
+
+PYX_TEST(StaleHandlesAreIgnored)
+{
+    Callbacks<tOnEvent> callbacks;
+    int first = 0;
+    int second = 0;
+    size_t handle = callbacks.Register([&first](int) { first++; });
+    callbacks.Unregister(handle);
+    // The slot is reused with a new generation
+    size_t otherHandle = callbacks.Register([&second](int) { second++; });
+    PYX_CHECK(handle != otherHandle);
+    callbacks.Unregister(handle);
+    callbacks.Unregister(12345);
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(0, first);
+    PYX_CHECK_EQUAL(1, second);
+}
+
+PYX_TEST(UnregisteredCallbacksAreReleased)
+{
+    Callbacks<tOnEvent> callbacks;
+    auto pState = std::make_shared<int>(0);
+    callbacks.Register([](int) {});
+    size_t handle = callbacks.Register([pState](int) {});
+    callbacks.Register([](int) {});
+    PYX_CHECK_EQUAL(2l, pState.use_count());
+    callbacks.Unregister(handle);
+    PYX_CHECK_EQUAL(1l, pState.use_count());
+}
+
+PYX_TEST(CallbacksCanUnregisterThemselves)
+{
+    Callbacks<tOnEvent> callbacks;
+    std::string calls;
+    size_t handle = 0;
+    callbacks.Register([&calls](int) { calls += 'a'; });
+    handle = callbacks.Register([&](int) { calls += 'b'; callbacks.Unregister(handle); });
+    callbacks.Register([&calls](int) { calls += 'c'; });
+    callbacks.Run(0);
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("abcac"), calls);
+}
+
+PYX_TEST(CallbacksRegisteredWhileRunningRunNextTime)
+{
+    Callbacks<tOnEvent> callbacks;
+    std::string calls;
+    bool isRegistered = false;
+    callbacks.Register([&](int)
+    {
+        calls += 'a';
+        if (!isRegistered)
+        {
+            isRegistered = true;
+            size_t handle = callbacks.Register([&calls](int) { calls += 'x'; });
+            callbacks.Register([&calls](int) { calls += 'b'; });
+            // Unregistered before it was ever added
+            callbacks.Unregister(handle);
+        }
+    });
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("a"), calls);
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("aab"), calls);
+}
+
+PYX_TEST(CallbacksCanUnregisterLaterCallbacks)
+{
+    Callbacks<tOnEvent> callbacks;
+    std::string calls;
+    std::vector<size_t> handles;
+    handles.push_back(callbacks.Register([&](int)
+    {
+        calls += 'a';
+        callbacks.Unregister(handles[1]);
+        callbacks.Unregister(handles[2]);
+    }));
+    handles.push_back(callbacks.Register([&calls](int) { calls += 'b'; }));
+    handles.push_back(callbacks.Register([&calls](int) { calls += 'c'; }));
+    handles.push_back(callbacks.Register([&calls](int) { calls += 'd'; }));
+    callbacks.Run(0);
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("adad"), calls);
+}
+
+PYX_TEST(NestedRunsSeeRemovedCallbacksOnce)
+{
+    Callbacks<tOnEvent> callbacks;
+    std::string calls;
+    size_t handle = 0;
+    callbacks.Register([&](int depth)
+    {
+        calls += 'a';
+        if (depth == 0)
+        {
+            callbacks.Unregister(handle);
+            callbacks.Run(1);
+        }
+    });
+    handle = callbacks.Register([&calls](int) { calls += 'b'; });
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("aa"), calls);
+}
+
+PYX_TEST(SnapshotModeRunsTheListItStartedWith)
+{
+    Callbacks<tOnEvent, CallbacksMode::Snapshot> callbacks;
+    std::string calls;
+    size_t handle = 0;
+    callbacks.Register([&](int)
+    {
+        calls += 'a';
+        callbacks.Unregister(handle);
+        callbacks.Register([&calls](int) { calls += 'c'; });
+    });
+    handle = callbacks.Register([&calls](int) { calls += 'b'; });
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("ab"), calls);
+    // Each run adds a callback for the next one
+    calls.clear();
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("ac"), calls);
+    calls.clear();
+    callbacks.Run(0);
+    PYX_CHECK_EQUAL(std::string("acc"), calls);
+}
@@ -0,0 +1,253 @@
+#include "Test.h"
+#include <Pyx/Graphics/FrameStats.h>
+#include <memory>
+
+using Pyx::Graphics::FrameHistogram;
+using Pyx::Graphics::FrameStats;
+
+namespace
+{
+    // Presents frameCount frames of the given duration after time, returns the time of the last one
+    uint64_t PresentFrames(FrameStats& frameStats, uint64_t time, uint64_t interval, size_t frameCount)
+    {
+        for (size_t i = 0; i < frameCount; i++)
+        {
+            time += interval;
+            frameStats.OnPresent(time);
+        }
+        return time;
+    }
+}
+
+PYX_TEST(BucketsAreExactForSmallValues)
+{
+    for (uint64_t value = 0; value < FrameHistogram::SubBucketCount; value++)
+    {
+        PYX_CHECK_EQUAL(static_cast<size_t>(value), FrameHistogram::GetBucket(value));
+        PYX_CHECK_EQUAL(value, FrameHistogram::GetBucketLowerBound(static_cast<size_t>(value)));
+    }
+}
+
+PYX_TEST(BucketBoundsMatchBucketMapping)
+{
+    for (size_t bucket = 0; bucket < FrameHistogram::BucketCount; bucket++)
+    {
+        uint64_t lowerBound = FrameHistogram::GetBucketLowerBound(bucket);
+        uint64_t upperBound = FrameHistogram::GetBucketLowerBound(bucket + 1);
+        PYX_CHECK(lowerBound < upperBound);
+        PYX_CHECK_EQUAL(bucket, FrameHistogram::GetBucket(lowerBound));
+        PYX_CHECK_EQUAL(bucket, FrameHistogram::GetBucket(upperBound - 1));
+    }
+}
+
+PYX_TEST(BucketsKeepRelativeError)
+{
+    for (uint64_t value = FrameHistogram::SubBucketCount; value < (1ull << FrameHistogram::MaxValueBits); value = value * 17 / 16 + 1)
+    {
+        size_t bucket = FrameHistogram::GetBucket(value);
+        uint64_t lowerBound = FrameHistogram::GetBucketLowerBound(bucket);
+        uint64_t upperBound = FrameHistogram::GetBucketLowerBound(bucket + 1);
+        PYX_CHECK(lowerBound <= value && value < upperBound);
+        PYX_CHECK((upperBound - lowerBound) * FrameHistogram::SubBucketCount <= lowerBound);
+    }
+}
+
+PYX_TEST(BucketsClampLargeValues)
+{
+    PYX_CHECK_EQUAL(FrameHistogram::BucketCount - 1, FrameHistogram::GetBucket(1ull << FrameHistogram::MaxValueBits << 1));
+    PYX_CHECK_EQUAL(FrameHistogram::BucketCount - 1, FrameHistogram::GetBucket(UINT64_MAX));
+}
+
+PYX_TEST(PercentileOfEmptyHistogramIsZero)
+{
+    uint64_t counts[FrameHistogram::BucketCount] = {};
+    PYX_CHECK_EQUAL(0u, FrameHistogram::GetPercentile(counts, 50.0));
+    PYX_CHECK_EQUAL(0u, FrameHistogram::GetPercentile(counts, 100.0));
+}
+
+PYX_TEST(PercentileReturnsUpperBoundOfRankBucket)
+{
+    std::unique_ptr<FrameHistogram> pHistogram(new FrameHistogram());
+    for (int i = 0; i < 99; i++)
+        pHistogram->Record(10);
+    pHistogram->Record(1000);
+
+    uint64_t counts[FrameHistogram::BucketCount] = {};
+    pHistogram->AddCounts(counts);
+    PYX_CHECK_EQUAL(100u, pHistogram->GetCount());
+    PYX_CHECK_EQUAL(1000u, pHistogram->GetMax());
+    PYX_CHECK_EQUAL(11u, FrameHistogram::GetPercentile(counts, 0.0));
+    PYX_CHECK_EQUAL(11u, FrameHistogram::GetPercentile(counts, 50.0));
+    PYX_CHECK_EQUAL(11u, FrameHistogram::GetPercentile(counts, 99.0));
+    PYX_CHECK_EQUAL(1024u, FrameHistogram::GetPercentile(counts, 100.0));
+    // Out of range percentiles are clamped
+    PYX_CHECK_EQUAL(11u, FrameHistogram::GetPercentile(counts, -5.0));
+    PYX_CHECK_EQUAL(1024u, FrameHistogram::GetPercentile(counts, 250.0));
+}
+
+PYX_TEST(PercentilesOfUniformFrames)
+{
+    std::unique_ptr<FrameHistogram> pHistogram(new FrameHistogram());
+    for (uint64_t value = 1; value <= 1000; value++)
+        pHistogram->Record(value * 100);
+
+    uint64_t counts[FrameHistogram::BucketCount] = {};
+    pHistogram->AddCounts(counts);
+    const double percentiles[] = { 50.0, 95.0, 99.0 };
+    for (auto percentile : percentiles)
+    {
+        double expected = percentile * 1000.0;
+        double actual = static_cast<double>(FrameHistogram::GetPercentile(counts, percentile));
+        PYX_CHECK(actual >= expected);
+        PYX_CHECK(actual <= expected * (1.0 + 1.0 / FrameHistogram::SubBucketCount) + 100.0);
+    }
+}
+
+PYX_TEST(SummaryOfSteadyFrames)
+{
+    std::unique_ptr<FrameStats> pFrameStats(new FrameStats());
+    uint64_t time = 1000;
+    pFrameStats->OnPresent(time);
+    for (int i = 0; i < 100; i++)
+    {
+        time += 16000;
+        pFrameStats->AddOverhead(4000);
+        pFrameStats->OnPresent(time);
+    }
+
+    auto summary = pFrameStats->GetSummary();
+    PYX_CHECK_EQUAL(100u, summary.FrameCount);
+    PYX_CHECK_NEAR(16.0, summary.Average, 1e-9);
+    PYX_CHECK_NEAR(16.0, summary.Max, 1e-9);
+    PYX_CHECK(summary.P50 >= 16.0 && summary.P50 <= 17.0);
+    PYX_CHECK(summary.P99 >= 16.0 && summary.P99 <= 17.0);
+    PYX_CHECK_NEAR(0.25, summary.OverheadShare, 1e-9);
+    PYX_CHECK_EQUAL(0u, summary.HitchCount);
+}
+
+PYX_TEST(FirstPresentOnlyStartsTheWindow)
+{
+    std::unique_ptr<FrameStats> pFrameStats(new FrameStats());
+    pFrameStats->OnPresent(5000);
+    PYX_CHECK_EQUAL(0u, pFrameStats->GetSummary().FrameCount);
+    pFrameStats->OnPresent(21000);
+    PYX_CHECK_EQUAL(1u, pFrameStats->GetSummary().FrameCount);
+
+    // Time going backwards restarts the measure instead of recording a huge frame
+    pFrameStats->OnPresent(1000);
+    PYX_CHECK_EQUAL(1u, pFrameStats->GetSummary().FrameCount);
+    PYX_CHECK_NEAR(16.0, pFrameStats->GetSummary().Max, 1e-9);
+}
+
+PYX_TEST(WindowRotationDropsOldFrames)
+{
+    const uint64_t windowDuration = 1000000;
+    std::unique_ptr<FrameStats> pFrameStats(new FrameStats(windowDuration));
+    uint64_t time = 1000;
+    pFrameStats->OnPresent(time);
+    time = PresentFrames(*pFrameStats, time, 10000, 300);
+
+    // Summaries cover between one and two windows
+    auto summary = pFrameStats->GetSummary();
+    PYX_CHECK(summary.FrameCount >= windowDuration / 10000);
+    PYX_CHECK(summary.FrameCount <= 2 * windowDuration / 10000);
+
+    // Two windows later only the new frame time is left
+    time = PresentFrames(*pFrameStats, time, 20000, 125);
+    summary = pFrameStats->GetSummary();
+    PYX_CHECK_NEAR(20.0, summary.Average, 1e-9);
+    PYX_CHECK_NEAR(20.0, summary.Max, 1e-9);
+    PYX_CHECK(summary.P50 >= 20.0 && summary.P50 <= 20.0 * (1.0 + 1.0 / FrameHistogram::SubBucketCount));
+    PYX_CHECK(summary.FrameCount >= windowDuration / 20000);
+    PYX_CHECK(summary.FrameCount <= 2 * windowDuration / 20000);
+}
+
+PYX_TEST(WindowRotationDropsOldOverhead)
+{
+    const uint64_t windowDuration = 1000000;
+    std::unique_ptr<FrameStats> pFrameStats(new FrameStats(windowDuration));
+    uint64_t time = 1000;
+    pFrameStats->OnPresent(time);
+    for (int i = 0; i < 100; i++)
+    {
+        pFrameStats->AddOverhead(10000);
+        time += 10000;
+        pFrameStats->OnPresent(time);
+    }
+    PYX_CHECK_NEAR(1.0, pFrameStats->GetSummary().OverheadShare, 1e-9);
+
+    time = PresentFrames(*pFrameStats, time, 10000, 250);
+    PYX_CHECK_NEAR(0.0, pFrameStats->GetSummary().OverheadShare, 1e-9);
+}
+
+PYX_TEST(SingleLongFrameIsAHitch)
+{
+    std::unique_ptr<FrameStats> pFrameStats(new FrameStats());
+    uint64_t time = 1000;
+    pFrameStats->OnPresent(time);
+    time = PresentFrames(*pFrameStats, time, 16000, 100);
+    time = PresentFrames(*pFrameStats, time, 50000, 1);
+    time = PresentFrames(*pFrameStats, time, 16000, 100);
+    PYX_CHECK_EQUAL(1u, pFrameStats->GetSummary().HitchCount);
+}
+
+PYX_TEST(SteadyLowFramerateIsNotAHitch)
+{
+    std::unique_ptr<FrameStats> pFrameStats(new FrameStats());
+    uint64_t time = 1000;
+    pFrameStats->OnPresent(time);
+    time = PresentFrames(*pFrameStats, time, 100000, 40);
+    PYX_CHECK_EQUAL(0u, pFrameStats->GetSummary().HitchCount);
+}
+
+PYX_TEST(NoHitchDuringWarmUp)
+{
+    std::unique_ptr<FrameStats> pFrameStats(new FrameStats());
+    uint64_t time = 1000;
+    pFrameStats->OnPresent(time);
+    time = PresentFrames(*pFrameStats, time, 16000, FrameStats::WarmUpFrameCount - 1);
+    time = PresentFrames(*pFrameStats, time, 100000, 1);
+    PYX_CHECK_EQUAL(0u, pFrameStats->GetSummary().HitchCount);
+
+    time = PresentFrames(*pFrameStats, time, 16000, 100);
+    time = PresentFrames(*pFrameStats, time, 100000, 1);
+    PYX_CHECK_EQUAL(1u, pFrameStats->GetSummary().HitchCount);
+}
+
+PYX_TEST(HistoryKeepsLatestFramesInOrder)
+{
+    std::unique_ptr<FrameStats> pFrameStats(new FrameStats());
+    std::vector<float> history;
+    pFrameStats->GetHistory(history);
+    PYX_CHECK(history.empty());
+
+    uint64_t time = 1000;
+    pFrameStats->OnPresent(time);
+    for (size_t i = 1; i <= FrameStats::HistorySize + 10; i++)
+    {
+        time += i * 1000;
+        pFrameStats->OnPresent(time);
+    }
+
+    pFrameStats->GetHistory(history);
+    PYX_CHECK_EQUAL(FrameStats::HistorySize, history.size());
+    PYX_CHECK_NEAR(11.0, history.front(), 1e-6);
+    PYX_CHECK_NEAR(static_cast<double>(FrameStats::HistorySize + 10), history.back(), 1e-6);
+}
+
+PYX_TEST(ResetClearsEverything)
+{
+    std::unique_ptr<FrameStats> pFrameStats(new FrameStats());
+    uint64_t time = 1000;
+    pFrameStats->OnPresent(time);
+    time = PresentFrames(*pFrameStats, time, 16000, 100);
+    pFrameStats->AddOverhead(1000);
+    pFrameStats->Reset();
+
+    auto summary = pFrameStats->GetSummary();
+    std::vector<float> history;
+    pFrameStats->GetHistory(history);
+    PYX_CHECK_EQUAL(0u, summary.FrameCount);
+    PYX_CHECK_NEAR(0.0, summary.OverheadShare, 1e-9);
+    PYX_CHECK(history.empty());
+}
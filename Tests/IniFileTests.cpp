@@ -0,0 +1,216 @@
+#include "Test.h"
+#include <Pyx/Utility/IniFile.h>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using Pyx::Utility::IniFile;
+
+namespace
+{
+    std::shared_ptr<const IniFile::Document> Parse(const std::wstring& text)
+    {
+        return IniFile::Parse(text.data(), text.size());
+    }
+
+    std::wstring GetString(const std::shared_ptr<const IniFile::Document>& pDocument, uint32_t index)
+    {
+        return index < pDocument->Strings.size() ? pDocument->Strings[index] : L"<invalid>";
+    }
+
+    std::string ToString(const std::wstring& text)
+    {
+        return std::string(text.begin(), text.end());
+    }
+
+    // Section, key and value of every entry as "section/key=value"
+    std::vector<std::string> GetEntries(const std::shared_ptr<const IniFile::Document>& pDocument)
+    {
+        std::vector<std::string> entries;
+        for (auto& entry : pDocument->Entries)
+            entries.push_back(ToString(GetString(pDocument, entry.Section) + L"/" + GetString(pDocument, entry.Key) + L"=" + GetString(pDocument, entry.Value)));
+        return entries;
+    }
+
+    std::string GetValues(const IniFile& iniFile, const std::wstring& section)
+    {
+        std::string result;
+        for (auto& value : iniFile.GetSectionValues(section))
+            result += ToString(value.Key + L"=" + value.Value + L";");
+        return result;
+    }
+
+    class TemporaryDirectory
+    {
+
+    private:
+        std::string m_path;
+
+    public:
+        TemporaryDirectory()
+        {
+            char path[] = "/tmp/PyxIniFileTestsXXXXXX";
+            m_path = mkdtemp(path) ? path : "";
+        }
+        ~TemporaryDirectory() { std::system(("rm -rf '" + m_path + "'").c_str()); }
+        std::wstring Write(const std::string& fileName, const std::string& content) const
+        {
+            std::string path = m_path + "/" + fileName;
+            std::ofstream(path, std::ios::binary) << content;
+            return std::wstring(path.begin(), path.end());
+        }
+
+    };
+}
+
+PYX_TEST(ParsesSectionsInOrder)
+{
+    auto pDocument = Parse(L"[Script]\nName=Test\nType = script \n\n[Files]\n1=main.lua\n2=util.lua\n");
+    std::vector<std::string> expected = { "script/Name=Test", "script/Type=script", "files/1=main.lua", "files/2=util.lua" };
+    PYX_CHECK(GetEntries(pDocument) == expected);
+}
+
+PYX_TEST(SkipsCommentsAndInvalidLines)
+{
+    auto pDocument = Parse(L"; comment\n# comment\n[a]\n  ; indented comment\nno equal sign\nkey=value ; not a comment\n[unclosed\nother=1\n");
+    std::vector<std::string> expected = { "a/key=value ; not a comment", "a/other=1" };
+    PYX_CHECK(GetEntries(pDocument) == expected);
+}
+
+PYX_TEST(TrimsAndSplitsOnFirstEqualSign)
+{
+    auto pDocument = Parse(L"[ Section Name ]\r\n\t key one \t=  a = b  \r\nempty=\r\n=no key");
+    std::vector<std::string> expected = { "section name/key one=a = b", "section name/empty=", "section name/=no key" };
+    PYX_CHECK(GetEntries(pDocument) == expected);
+}
+
+PYX_TEST(KeysBeforeFirstSectionHaveNoSection)
+{
+    auto pDocument = Parse(L"orphan=1\n[a]\nkey=2");
+    std::vector<std::string> expected = { "/orphan=1", "a/key=2" };
+    PYX_CHECK(GetEntries(pDocument) == expected);
+}
+
+PYX_TEST(InternsStrings)
+{
+    auto pDocument = Parse(L"[A]\nx=same\n[a]\nsame=x\n");
+    PYX_CHECK_EQUAL(2u, pDocument->Entries.size());
+    PYX_CHECK_EQUAL(pDocument->Entries[0].Section, pDocument->Entries[1].Section);
+    PYX_CHECK_EQUAL(pDocument->Entries[0].Key, pDocument->Entries[1].Value);
+    PYX_CHECK_EQUAL(pDocument->Entries[0].Value, pDocument->Entries[1].Key);
+    // The unnamed section, "a", "x" and "same"
+    PYX_CHECK_EQUAL(4u, pDocument->Strings.size());
+}
+
+PYX_TEST(ParsesEmptyText)
+{
+    PYX_CHECK(Parse(L"").get() != nullptr);
+    PYX_CHECK(Parse(L"").get()->Entries.empty());
+    PYX_CHECK(Parse(L"\n\r\n  \n").get()->Entries.empty());
+}
+
+PYX_TEST(DecodesUtf8)
+{
+    const std::string text = "[a]\nname=\xC3\xA9t\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80";
+    std::wstring expected = L"[a]\nname=été € \U0001F600";
+    PYX_CHECK(IniFile::Decode(reinterpret_cast<const uint8_t*>(text.data()), text.size()) == expected);
+
+    const std::string withBom = "\xEF\xBB\xBF" + text;
+    PYX_CHECK(IniFile::Decode(reinterpret_cast<const uint8_t*>(withBom.data()), withBom.size()) == expected);
+}
+
+PYX_TEST(DecodesUtf16WithByteOrderMark)
+{
+    const uint8_t data[] = { 0xFF, 0xFE, 'a', 0, '=', 0, 0xAC, 0x20, 0x3D, 0xD8, 0x00, 0xDE };
+    PYX_CHECK(IniFile::Decode(data, sizeof(data)) == L"a=€\U0001F600");
+
+    // A trailing odd byte is ignored
+    const uint8_t oddData[] = { 0xFF, 0xFE, 'a', 0, 'b' };
+    PYX_CHECK(IniFile::Decode(oddData, sizeof(oddData)) == L"a");
+}
+
+PYX_TEST(DecodesInvalidUtf8AsAnsi)
+{
+    // Latin-1 "été", read with the ANSI code page on Windows
+    const std::string text = "k=\xE9t\xE9";
+    PYX_CHECK(IniFile::Decode(reinterpret_cast<const uint8_t*>(text.data()), text.size()) == L"k=été");
+}
+
+PYX_TEST(DecodesEmptyData)
+{
+    const uint8_t bom[] = { 0xEF, 0xBB, 0xBF };
+    PYX_CHECK(IniFile::Decode(bom, 0).empty());
+    PYX_CHECK(IniFile::Decode(bom, sizeof(bom)).empty());
+    PYX_CHECK(IniFile::Decode(bom, 2).size() == 2);
+}
+
+PYX_TEST(ReadsSectionValuesFromFile)
+{
+    TemporaryDirectory directory;
+    IniFile iniFile(directory.Write("script.def", "top=1\n[Script]\nname=Test\n[files]\n1=a.lua\n2=b.lua\n[SCRIPT]\ntype=lib\n"));
+    PYX_CHECK_EQUAL(std::string("name=Test;type=lib;"), GetValues(iniFile, L"script"));
+    PYX_CHECK_EQUAL(std::string("1=a.lua;2=b.lua;"), GetValues(iniFile, L"Files"));
+    PYX_CHECK_EQUAL(std::string(), GetValues(iniFile, L"dependencies"));
+    // Names of keys or values aren't sections
+    PYX_CHECK_EQUAL(std::string(), GetValues(iniFile, L"name"));
+    PYX_CHECK_EQUAL(std::string(), GetValues(iniFile, L"test"));
+
+    auto values = iniFile.GetSectionValues(L"Files");
+    PYX_CHECK_EQUAL(2u, values.size());
+    PYX_CHECK(values[0].Section == L"Files");
+}
+
+PYX_TEST(EmptySectionNameReturnsNoValue)
+{
+    TemporaryDirectory directory;
+    IniFile iniFile(directory.Write("leading.ini", "top=1\n[a]\nkey=2\n"));
+    PYX_CHECK(iniFile.GetSectionValues(L"").empty());
+    PYX_CHECK_EQUAL(std::string("key=2;"), GetValues(iniFile, L"a"));
+}
+
+PYX_TEST(MissingFileHasNoValue)
+{
+    TemporaryDirectory directory;
+    IniFile iniFile(directory.Write("missing/none.ini", ""));
+    PYX_CHECK(iniFile.GetSectionValues(L"a").empty());
+}
+
+PYX_TEST(ParsedFilesAreCachedUntilChanged)
+{
+    TemporaryDirectory directory;
+    IniFile::ClearCache();
+    auto fileName = directory.Write("cached.ini", "[a]\nkey=1\n");
+    PYX_CHECK_EQUAL(std::string("key=1;"), GetValues(IniFile(fileName), L"a"));
+
+    // Same size and last write time, the cached document is still used
+    struct stat attributes;
+    std::string path(fileName.begin(), fileName.end());
+    PYX_CHECK(stat(path.c_str(), &attributes) == 0);
+    directory.Write("cached.ini", "[a]\nkey=9\n");
+    const timespec times[2] = { attributes.st_atim, attributes.st_mtim };
+    PYX_CHECK(utimensat(AT_FDCWD, path.c_str(), times, 0) == 0);
+    PYX_CHECK_EQUAL(std::string("key=1;"), GetValues(IniFile(fileName), L"a"));
+
+    directory.Write("cached.ini", "[a]\nkey=22\nother=3\n");
+    PYX_CHECK_EQUAL(std::string("key=22;other=3;"), GetValues(IniFile(fileName), L"a"));
+
+    IniFile::ClearCache();
+    PYX_CHECK_EQUAL(std::string("key=22;other=3;"), GetValues(IniFile(fileName), L"a"));
+}
+
+PYX_TEST(ReadsLargeFiles)
+{
+    // Large files are mapped instead of read
+    TemporaryDirectory directory;
+    std::string content = "[large]\n";
+    std::string expected;
+    for (int i = 0; i < 1000; i++)
+    {
+        content += "key" + std::to_string(i) + "=value" + std::to_string(i) + "\n";
+        expected += "key" + std::to_string(i) + "=value" + std::to_string(i) + ";";
+    }
+    PYX_CHECK(content.size() > 4096);
+    PYX_CHECK_EQUAL(expected, GetValues(IniFile(directory.Write("large.ini", content)), L"large"));
+}
@@ -0,0 +1,132 @@
+#include "Test.h"
+#include <Pyx/Math/Matrix4.h>
+#include <Pyx/Math/Quaternion.h>
+#include <Pyx/Math/Vector3.h>
+#include <Pyx/Math/Vector4.h>
+#include <Pyx/Scripting/Script.h>
+#include <cmath>
+
+using Pyx::Math::Matrix4;
+using Pyx::Math::Quaternion;
+using Pyx::Math::Vector3;
+using Pyx::Math::Vector4;
+using Pyx::Scripting::Script;
+
+namespace
+{
+    const float Tolerance = 1e-4f;
+
+    Matrix4 GetTestMatrix()
+    {
+        return Matrix4::RotationAxis(Vector3(1.0f, 2.0f, 3.0f), 0.7f) * Matrix4::Scaling(Vector3(2.0f, 3.0f, 0.5f)) * Matrix4::Translation(Vector3(4.0f, -5.0f, 6.0f));
+    }
+
+    void CheckNear(const Matrix4& expected, const Matrix4& actual)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+                PYX_CHECK_NEAR(expected.M[i][j], actual.M[i][j], Tolerance);
+        }
+    }
+
+    void CheckNear(const Vector3& expected, const Vector3& actual)
+    {
+        PYX_CHECK_NEAR(expected.X, actual.X, Tolerance);
+        PYX_CHECK_NEAR(expected.Y, actual.Y, Tolerance);
+        PYX_CHECK_NEAR(expected.Z, actual.Z, Tolerance);
+    }
+}
+
+PYX_TEST(Vector4Operations)
+{
+    Vector4 a(1.0f, 2.0f, 3.0f, 4.0f);
+    Vector4 b(-2.0f, 0.5f, 1.0f, 2.0f);
+    PYX_CHECK_NEAR(10.0f, Vector4::Dot(a, b), Tolerance);
+    PYX_CHECK(a + b == Vector4(-1.0f, 2.5f, 4.0f, 6.0f));
+    PYX_CHECK(a * 2.0f == Vector4(2.0f, 4.0f, 6.0f, 8.0f));
+    PYX_CHECK(Vector4::Lerp(a, b, 0.5f) == Vector4(-0.5f, 1.25f, 2.0f, 3.0f));
+    PYX_CHECK_NEAR(1.0f, a.Normalized().Length(), Tolerance);
+}
+
+PYX_TEST(MatrixMultiplyMatchesTheDefinition)
+{
+    Matrix4 a = GetTestMatrix();
+    Matrix4 b = Matrix4::RotationY(1.2f) * Matrix4::Translation(Vector3(1.0f, 2.0f, 3.0f));
+    Matrix4 expected;
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++)
+            expected.M[i][j] = a.M[i][0] * b.M[0][j] + a.M[i][1] * b.M[1][j] + a.M[i][2] * b.M[2][j] + a.M[i][3] * b.M[3][j];
+    }
+    CheckNear(expected, a * b);
+}
+
+PYX_TEST(InvertedMatrixGivesIdentity)
+{
+    Matrix4 m = GetTestMatrix();
+    CheckNear(Matrix4::Identity(), m * m.Inverted());
+    Matrix4 singular = Matrix4::Scaling(Vector3(1.0f, 0.0f, 1.0f));
+    Matrix4 result;
+    PYX_CHECK(!singular.Invert(result));
+}
+
+PYX_TEST(TransformUsesRowVectors)
+{
+    Matrix4 m = Matrix4::Translation(Vector3(1.0f, 2.0f, 3.0f));
+    CheckNear(Vector3(2.0f, 3.0f, 4.0f), m.TransformCoord(Vector3(1.0f, 1.0f, 1.0f)));
+    CheckNear(Vector3(1.0f, 1.0f, 1.0f), m.TransformNormal(Vector3(1.0f, 1.0f, 1.0f)));
+    Vector4 v = m.Transform(Vector4(1.0f, 1.0f, 1.0f, 0.5f));
+    PYX_CHECK(v == Vector4(1.5f, 2.0f, 2.5f, 0.5f));
+}
+
+PYX_TEST(QuaternionRotationMatchesTheMatrix)
+{
+    Quaternion q = Quaternion::FromAxisAngle(Vector3(1.0f, 2.0f, 3.0f), 0.7f);
+    Vector3 v(4.0f, -5.0f, 6.0f);
+    CheckNear(Matrix4::RotationQuaternion(q).TransformCoord(v), q.Rotate(v));
+    CheckNear(Matrix4::RotationAxis(Vector3(1.0f, 2.0f, 3.0f), 0.7f).TransformCoord(v), q.Rotate(v));
+
+    // a * b applies a then b
+    Quaternion r = Quaternion::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), 1.1f);
+    CheckNear(r.Rotate(q.Rotate(v)), (q * r).Rotate(v));
+}
+
+PYX_TEST(SlerpKeepsUnitLength)
+{
+    Quaternion from = Quaternion::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), 0.2f);
+    Quaternion to = Quaternion::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), 1.4f);
+    Quaternion middle = Quaternion::Slerp(from, to, 0.5f);
+    PYX_CHECK_NEAR(1.0f, middle.Length(), Tolerance);
+    PYX_CHECK_NEAR(0.8f, 2.0f * acosf(middle.W), Tolerance);
+    PYX_CHECK_NEAR(1.0f, Quaternion::Slerp(from, from, 0.3f).Length(), Tolerance);
+}
+
+PYX_TEST(ProjectMapsTheFrustumToTheScreen)
+{
+    Matrix4 viewProjection = Matrix4::LookAtLH(Vector3(0.0f, 0.0f, -10.0f), Vector3(), Vector3(0.0f, 1.0f, 0.0f)) * Matrix4::PerspectiveFovLH(1.0f, 2.0f, 0.1f, 100.0f);
+    Vector3 screen;
+    PYX_CHECK(viewProjection.Project(Vector3(), 200.0f, 100.0f, screen));
+    PYX_CHECK_NEAR(100.0f, screen.X, Tolerance);
+    PYX_CHECK_NEAR(50.0f, screen.Y, Tolerance);
+    PYX_CHECK(!viewProjection.Project(Vector3(0.0f, 0.0f, -20.0f), 200.0f, 100.0f, screen));
+}
+
+PYX_TEST(OutArgumentsAreReturnedToLua)
+{
+    // Output only Vector3 arguments used to be pushed as a reference to a
+    // temporary, or to crash when the holder was never set
+    Script script;
+    Vector3::BindWithScript(&script);
+    Matrix4::BindWithScript(&script);
+    script.GetLuaState().doString(R"(
+        local M = Pyx.Math
+        local viewProjection = M.Matrix4.LookAtLH(M.Vector3(0, 0, -10), M.Vector3(), M.Vector3(0, 1, 0)) * M.Matrix4.PerspectiveFovLH(1, 2, 0.1, 100)
+        local isVisible, screen = viewProjection:Project(M.Vector3(), 200, 100)
+        collectgarbage()
+        IsVisible, ScreenX, ScreenY = isVisible, screen.X, screen.Y
+    )");
+    PYX_CHECK(LuaRef(script.GetLuaState(), "IsVisible").toValue<bool>());
+    PYX_CHECK_NEAR(100.0f, LuaRef(script.GetLuaState(), "ScreenX").toValue<float>(), Tolerance);
+    PYX_CHECK_NEAR(50.0f, LuaRef(script.GetLuaState(), "ScreenY").toValue<float>(), Tolerance);
+}
@@ -0,0 +1,205 @@
+#include "Test.h"
+#include <Pyx/Threading/JobSystem.h>
+#include <Pyx/Threading/StageGraph.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using Pyx::Threading::JobSystem;
+using Pyx::Threading::StageGraph;
+using Pyx::Threading::StageState;
+
+namespace
+{
+    std::atomic<int> g_sequence(0);
+
+    // Stands for a subsystem of PyxContext::Initialize, records when it ran
+    class MockSubsystem
+    {
+
+    private:
+        int m_delay;
+        bool m_isFailing;
+        std::atomic<int> m_initializeCount;
+        int m_startSequence;
+        int m_endSequence;
+
+    public:
+        explicit MockSubsystem(int delay = 0, bool isFailing = false)
+            : m_delay(delay), m_isFailing(isFailing), m_initializeCount(0), m_startSequence(-1), m_endSequence(-1) { }
+        int GetInitializeCount() const { return m_initializeCount.load(); }
+        int GetStartSequence() const { return m_startSequence; }
+        int GetEndSequence() const { return m_endSequence; }
+        void Initialize()
+        {
+            m_initializeCount++;
+            m_startSequence = g_sequence++;
+            if (m_delay > 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_delay));
+            if (m_isFailing)
+                throw std::runtime_error("device creation failed");
+            m_endSequence = g_sequence++;
+        }
+        size_t AddTo(StageGraph& graph, const std::string& name, const std::vector<size_t>& dependencies = {})
+        {
+            return graph.AddStage(name, [this]() { Initialize(); }, dependencies);
+        }
+
+    };
+
+    // Workers are started for each test, some run without them
+    struct JobSystemScope
+    {
+        explicit JobSystemScope(size_t workerCount) { JobSystem::GetInstance().Initialize(workerCount); }
+        ~JobSystemScope() { JobSystem::GetInstance().Shutdown(); }
+    };
+}
+
+PYX_TEST(StagesRunAfterTheirDependencies)
+{
+    JobSystemScope jobSystem(3);
+    for (int iteration = 0; iteration < 50; iteration++)
+    {
+        MockSubsystem config, fonts(1), scripts, memory, hooks, gui;
+        StageGraph graph;
+        auto configStage = config.AddTo(graph, "Config");
+        auto fontsStage = fonts.AddTo(graph, "Fonts");
+        auto memoryStage = memory.AddTo(graph, "Memory");
+        auto scriptsStage = scripts.AddTo(graph, "Scripts", { configStage, memoryStage });
+        auto hooksStage = hooks.AddTo(graph, "Hooks", { memoryStage });
+        gui.AddTo(graph, "Gui", { fontsStage, scriptsStage, hooksStage });
+        PYX_CHECK(graph.Run());
+
+        for (auto* pSubsystem : { &config, &fonts, &scripts, &memory, &hooks, &gui })
+            PYX_CHECK_EQUAL(1, pSubsystem->GetInitializeCount());
+        PYX_CHECK(config.GetEndSequence() < scripts.GetStartSequence());
+        PYX_CHECK(memory.GetEndSequence() < scripts.GetStartSequence());
+        PYX_CHECK(memory.GetEndSequence() < hooks.GetStartSequence());
+        PYX_CHECK(fonts.GetEndSequence() < gui.GetStartSequence());
+        PYX_CHECK(scripts.GetEndSequence() < gui.GetStartSequence());
+        PYX_CHECK(hooks.GetEndSequence() < gui.GetStartSequence());
+        for (auto& stage : graph.GetStages())
+            PYX_CHECK(stage.State == StageState::Completed);
+    }
+}
+
+PYX_TEST(IndependentStagesRunInParallel)
+{
+    JobSystemScope jobSystem(3);
+
+    // Each stage waits for the other one to start, run in sequence they would time out
+    std::atomic<int> startedCount(0);
+    std::atomic<int> overlapCount(0);
+    auto waitForOther = [&]()
+    {
+        startedCount++;
+        auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (startedCount.load() < 2 && std::chrono::steady_clock::now() < timeout)
+            std::this_thread::yield();
+        if (startedCount.load() == 2)
+            overlapCount++;
+    };
+
+    StageGraph graph;
+    graph.AddStage("Scripts", waitForOther);
+    graph.AddStage("Fonts", waitForOther);
+    PYX_CHECK(graph.Run());
+    PYX_CHECK_EQUAL(2, overlapCount.load());
+}
+
+PYX_TEST(FailureSkipsDependentStages)
+{
+    JobSystemScope jobSystem(2);
+    MockSubsystem memory, d3d9(0, true), dxgi, hooks, gui, scripts;
+    StageGraph graph;
+    auto memoryStage = memory.AddTo(graph, "Memory");
+    auto d3d9Stage = d3d9.AddTo(graph, "D3D9");
+    auto dxgiStage = dxgi.AddTo(graph, "DXGI");
+    auto hooksStage = hooks.AddTo(graph, "Hooks", { memoryStage, d3d9Stage, dxgiStage });
+    gui.AddTo(graph, "Gui", { hooksStage });
+    scripts.AddTo(graph, "Scripts", { memoryStage });
+    PYX_CHECK(!graph.Run());
+
+    auto& stages = graph.GetStages();
+    PYX_CHECK(stages[0].State == StageState::Completed);
+    PYX_CHECK(stages[1].State == StageState::Failed);
+    PYX_CHECK_EQUAL(std::string("device creation failed"), stages[1].Error);
+    PYX_CHECK(stages[2].State == StageState::Completed);
+    PYX_CHECK(stages[3].State == StageState::Skipped);
+    PYX_CHECK_EQUAL(std::string("depends on D3D9"), stages[3].Error);
+    PYX_CHECK(stages[4].State == StageState::Skipped);
+    PYX_CHECK_EQUAL(std::string("depends on Hooks"), stages[4].Error);
+    PYX_CHECK(stages[5].State == StageState::Completed);
+
+    PYX_CHECK_EQUAL(0, hooks.GetInitializeCount());
+    PYX_CHECK_EQUAL(0, gui.GetInitializeCount());
+    PYX_CHECK_EQUAL(1, scripts.GetInitializeCount());
+}
+
+PYX_TEST(UnknownExceptionsFailTheStage)
+{
+    JobSystemScope jobSystem(1);
+    StageGraph graph;
+    graph.AddStage("Throwing", []() { throw 42; });
+    PYX_CHECK(!graph.Run());
+    PYX_CHECK(graph.GetStages()[0].State == StageState::Failed);
+    PYX_CHECK_EQUAL(std::string("unknown exception"), graph.GetStages()[0].Error);
+}
+
+PYX_TEST(RunsAgainAfterFailure)
+{
+    JobSystemScope jobSystem(2);
+    bool isFailing = true;
+    MockSubsystem dependent;
+    StageGraph graph;
+    auto stage = graph.AddStage("Flaky", [&isFailing]() { if (isFailing) throw std::runtime_error("not ready"); });
+    dependent.AddTo(graph, "Dependent", { stage });
+    PYX_CHECK(!graph.Run());
+    PYX_CHECK_EQUAL(0, dependent.GetInitializeCount());
+
+    isFailing = false;
+    PYX_CHECK(graph.Run());
+    PYX_CHECK(graph.GetStages()[0].Error.empty());
+    PYX_CHECK_EQUAL(1, dependent.GetInitializeCount());
+}
+
+PYX_TEST(LaterStagesAreIgnoredAsDependencies)
+{
+    JobSystemScope jobSystem(2);
+    MockSubsystem first, second;
+    StageGraph graph;
+    first.AddTo(graph, "First", { 0, 1, 5 });
+    second.AddTo(graph, "Second", { 0, 1 });
+    PYX_CHECK(graph.GetStages()[0].Dependencies.empty());
+    PYX_CHECK(graph.GetStages()[1].Dependencies == std::vector<size_t>{ 0 });
+    PYX_CHECK(graph.Run());
+    PYX_CHECK(first.GetEndSequence() < second.GetStartSequence());
+}
+
+PYX_TEST(RunsInOrderWithoutWorkers)
+{
+    MockSubsystem first, second, third;
+    StageGraph graph;
+    first.AddTo(graph, "First");
+    second.AddTo(graph, "Second");
+    third.AddTo(graph, "Third", { 0 });
+    PYX_CHECK(graph.Run());
+    PYX_CHECK(first.GetEndSequence() < second.GetStartSequence());
+    PYX_CHECK(second.GetEndSequence() < third.GetStartSequence());
+}
+
+PYX_TEST(StageTimingsAreMeasured)
+{
+    JobSystemScope jobSystem(2);
+    MockSubsystem slow(20), next;
+    StageGraph graph;
+    auto slowStage = slow.AddTo(graph, "Slow");
+    next.AddTo(graph, "Next", { slowStage });
+    PYX_CHECK(graph.Run());
+
+    auto& stages = graph.GetStages();
+    PYX_CHECK(stages[0].Duration >= 19.0);
+    PYX_CHECK(stages[1].StartTime >= stages[0].StartTime + stages[0].Duration);
+    PYX_CHECK(graph.GetDuration() >= stages[1].StartTime + stages[1].Duration);
+}
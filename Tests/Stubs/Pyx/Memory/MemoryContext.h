@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Pyx
+{
+    namespace Memory
+    {
+        // Stands in for the memory of the game process, nothing can be read
+        class MemoryContext
+        {
+
+        public:
+            static MemoryContext& GetInstance()
+            {
+                static MemoryContext instance;
+                return instance;
+            }
+            bool Read(uintptr_t, void*, size_t) const { return false; }
+
+        };
+    }
+}
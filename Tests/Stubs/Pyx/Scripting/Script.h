@@ -0,0 +1,52 @@
+#pragma once
+#include <Lua/lua.hpp>
+#include <Lua/LuaIntf.h>
+#include <string>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace LuaIntf;
+
+namespace LuaIntf
+{
+    LUA_USING_LIST_TYPE(std::vector)
+    LUA_USING_MAP_TYPE(std::map)
+    LUA_USING_SHARED_PTR_TYPE(std::shared_ptr)
+}
+
+namespace Pyx
+{
+    namespace Scripting
+    {
+        // Stands in for the script of the DLL in tests and benchmarks, it only
+        // owns a Lua state so that the Lua bindings of a class can be used
+        class Script
+        {
+
+        private:
+            LuaState m_luaState;
+
+        public:
+            explicit Script() : m_luaState(LuaState::newState()) { m_luaState.openLibs(); }
+            ~Script() { m_luaState.close(); }
+            Script(const Script&) = delete;
+            Script& operator=(const Script&) = delete;
+            bool IsRunning() const { return true; }
+            LuaState& GetLuaState() { return m_luaState; }
+            template <typename... Args>
+            void FireCallback(const std::wstring&, Args...)
+            {
+            }
+
+        };
+
+        class ScriptLockSet
+        {
+
+        public:
+            bool TryLock(Script*) { return true; }
+
+        };
+    }
+}
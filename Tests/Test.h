@@ -0,0 +1,94 @@
+#pragma once
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Minimal test harness for the parts of Pyx which don't depend on Win32,
+// every test executable links TestMain.cpp and runs all of its tests
+namespace Pyx
+{
+    namespace Tests
+    {
+        struct TestCase
+        {
+            const char* Name;
+            void(*Function)();
+        };
+
+        inline std::vector<TestCase>& GetTestCases()
+        {
+            static std::vector<TestCase> testCases;
+            return testCases;
+        }
+
+        inline int& GetFailureCount()
+        {
+            static int failureCount = 0;
+            return failureCount;
+        }
+
+        inline void ReportFailure(const char* file, int line, const std::string& message)
+        {
+            std::fprintf(stderr, "%s:%d: %s\n", file, line, message.c_str());
+            GetFailureCount()++;
+        }
+
+        template <typename T> std::string ToString(const T& value)
+        {
+            std::ostringstream stream;
+            stream << value;
+            return stream.str();
+        }
+
+        inline std::string ToString(const std::u16string& value)
+        {
+            std::ostringstream stream;
+            stream << "u\"";
+            for (auto c : value)
+            {
+                if (c >= 0x20 && c < 0x7F)
+                    stream << static_cast<char>(c);
+                else
+                    stream << "\\x" << std::hex << static_cast<unsigned>(c) << std::dec;
+            }
+            stream << "\"";
+            return stream.str();
+        }
+
+        struct TestRegistrar
+        {
+            TestRegistrar(const char* name, void(*function)())
+            {
+                GetTestCases().push_back(TestCase{ name, function });
+            }
+        };
+    }
+}
+
+#define PYX_TEST(name) \
+    static void name(); \
+    static Pyx::Tests::TestRegistrar name##Registrar(#name, &name); \
+    static void name()
+
+#define PYX_CHECK(condition) \
+    do { if (!(condition)) Pyx::Tests::ReportFailure(__FILE__, __LINE__, "check failed: " #condition); } while (0)
+
+#define PYX_CHECK_EQUAL(expected, actual) \
+    do \
+    { \
+        const auto expectedValue = (expected); \
+        const auto actualValue = (actual); \
+        if (!(expectedValue == actualValue)) \
+            Pyx::Tests::ReportFailure(__FILE__, __LINE__, std::string(#actual " is ") + Pyx::Tests::ToString(actualValue) + ", expected " + Pyx::Tests::ToString(expectedValue)); \
+    } while (0)
+
+#define PYX_CHECK_NEAR(expected, actual, tolerance) \
+    do \
+    { \
+        const double expectedValue = (expected); \
+        const double actualValue = (actual); \
+        if (!(std::fabs(expectedValue - actualValue) <= (tolerance))) \
+            Pyx::Tests::ReportFailure(__FILE__, __LINE__, std::string(#actual " is ") + Pyx::Tests::ToString(actualValue) + ", expected " + Pyx::Tests::ToString(expectedValue)); \
+    } while (0)
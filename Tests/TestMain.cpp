@@ -0,0 +1,22 @@
+#include "Test.h"
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    // An optional argument only runs the tests whose name contains it
+    const char* pFilter = argc > 1 ? argv[1] : nullptr;
+    int testCount = 0;
+    for (auto& testCase : Pyx::Tests::GetTestCases())
+    {
+        if (pFilter && !std::strstr(testCase.Name, pFilter))
+            continue;
+
+        int failureCount = Pyx::Tests::GetFailureCount();
+        testCase.Function();
+        std::printf("[%s] %s\n", Pyx::Tests::GetFailureCount() == failureCount ? "  OK  " : "FAILED", testCase.Name);
+        testCount++;
+    }
+
+    std::printf("%d tests, %d failed checks\n", testCount, Pyx::Tests::GetFailureCount());
+    return Pyx::Tests::GetFailureCount() == 0 ? 0 : 1;
+}
@@ -0,0 +1,300 @@
+#include "Test.h"
+#include <Pyx/Threading/Thread.h>
+#include <Pyx/Threading/ThreadContext.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+using Pyx::Threading::ThreadContext;
+using Pyx::Threading::ThreadId;
+
+namespace
+{
+    ThreadId GetCurrentThreadId()
+    {
+        return static_cast<ThreadId>(syscall(SYS_gettid));
+    }
+
+    void Sleep(int milliseconds)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    }
+
+    // Threads counting as fast as they can until stopped
+    class SpinningThreads
+    {
+
+    private:
+        std::atomic<bool> m_isStopping;
+        std::atomic<size_t> m_startedCount;
+        std::vector<std::atomic<uint64_t>> m_counters;
+        std::vector<std::atomic<ThreadId>> m_threadIds;
+        std::vector<std::thread> m_threads;
+
+    public:
+        explicit SpinningThreads(size_t count)
+            : m_isStopping(false), m_startedCount(0), m_counters(count), m_threadIds(count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                m_counters[i] = 0;
+                m_threads.emplace_back([this, i]()
+                {
+                    m_threadIds[i] = GetCurrentThreadId();
+                    m_startedCount++;
+                    while (!m_isStopping.load(std::memory_order_relaxed))
+                        m_counters[i].fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            while (m_startedCount.load() < count)
+                std::this_thread::yield();
+        }
+        ~SpinningThreads() { Stop(); }
+        void Stop()
+        {
+            m_isStopping = true;
+            for (auto& thread : m_threads)
+            {
+                if (thread.joinable())
+                    thread.join();
+            }
+        }
+        ThreadId GetThreadId(size_t index) const { return m_threadIds[index].load(); }
+        size_t GetCount() const { return m_threads.size(); }
+        // Copies the counters without allocating, the caller may have frozen the threads
+        void GetCounters(uint64_t* pCounters) const
+        {
+            for (size_t i = 0; i < m_counters.size(); i++)
+                pCounters[i] = m_counters[i].load(std::memory_order_relaxed);
+        }
+
+    };
+
+    std::vector<ThreadId> GetOtherThreadIds()
+    {
+        std::vector<ThreadId> threadIds(64);
+        threadIds.resize((std::min)(threadIds.size(), ThreadContext::GetInstance().GetOtherThreadIds(threadIds.data(), threadIds.size())));
+        return threadIds;
+    }
+
+    bool Contains(const std::vector<ThreadId>& threadIds, ThreadId threadId)
+    {
+        return std::find(threadIds.begin(), threadIds.end(), threadId) != threadIds.end();
+    }
+}
+
+PYX_TEST(EnumeratesThreadsOfTheProcess)
+{
+    SpinningThreads threads(3);
+    auto threadIds = GetOtherThreadIds();
+    PYX_CHECK(!Contains(threadIds, GetCurrentThreadId()));
+    for (size_t i = 0; i < threads.GetCount(); i++)
+        PYX_CHECK(Contains(threadIds, threads.GetThreadId(i)));
+
+    bool hasCurrentThread = false;
+    for (auto& pThread : ThreadContext::GetInstance().GetThreads())
+        hasCurrentThread |= pThread->GetThreadId() == GetCurrentThreadId();
+    PYX_CHECK(hasCurrentThread);
+}
+
+PYX_TEST(ExitedThreadsAreRemoved)
+{
+    ThreadId exitedThreadId = 0;
+    {
+        SpinningThreads threads(1);
+        exitedThreadId = threads.GetThreadId(0);
+        PYX_CHECK(Contains(GetOtherThreadIds(), exitedThreadId));
+    }
+    PYX_CHECK(!Contains(GetOtherThreadIds(), exitedThreadId));
+}
+
+PYX_TEST(KnownThreadsAreReused)
+{
+    SpinningThreads threads(2);
+    auto first = ThreadContext::GetInstance().GetThreads();
+    auto second = ThreadContext::GetInstance().GetThreads();
+    PYX_CHECK_EQUAL(first.size(), second.size());
+    for (auto& pThread : first)
+    {
+        bool isReused = false;
+        for (auto& pOtherThread : second)
+            isReused |= pThread == pOtherThread;
+        PYX_CHECK(isReused);
+    }
+}
+
+PYX_TEST(OtherThreadIdsReportsTheFullCount)
+{
+    SpinningThreads threads(4);
+    ThreadId threadIds[2] = {};
+    size_t count = ThreadContext::GetInstance().GetOtherThreadIds(threadIds, 2);
+    PYX_CHECK(count >= threads.GetCount());
+    PYX_CHECK(threadIds[0] != 0 && threadIds[1] != 0);
+    PYX_CHECK(ThreadContext::GetInstance().GetOtherThreadIds(nullptr, 0) == count);
+}
+
+PYX_TEST(FreezeStopsOtherThreads)
+{
+    SpinningThreads threads(3);
+    uint64_t before[3];
+    uint64_t frozen[3];
+    uint64_t after[3];
+
+    // Nothing is allocated until Unfreeze, a suspended thread may hold the heap lock
+    auto& threadContext = ThreadContext::GetInstance();
+    threadContext.Freeze();
+    bool isFrozen = threadContext.IsFrozen();
+    threads.GetCounters(before);
+    Sleep(50);
+    threads.GetCounters(frozen);
+    threadContext.Unfreeze();
+
+    Sleep(50);
+    threads.GetCounters(after);
+    PYX_CHECK(isFrozen);
+    PYX_CHECK(!threadContext.IsFrozen());
+    for (size_t i = 0; i < threads.GetCount(); i++)
+    {
+        PYX_CHECK_EQUAL(before[i], frozen[i]);
+        PYX_CHECK(after[i] > frozen[i]);
+    }
+}
+
+PYX_TEST(NestedFreezesResumeOnce)
+{
+    SpinningThreads threads(2);
+    uint64_t before[2];
+    uint64_t inner[2];
+    uint64_t outer[2];
+    uint64_t after[2];
+
+    auto& threadContext = ThreadContext::GetInstance();
+    threadContext.Freeze();
+    threadContext.Freeze();
+    threads.GetCounters(before);
+    threadContext.Unfreeze();
+    Sleep(30);
+    threads.GetCounters(inner);
+    bool isStillFrozen = threadContext.IsFrozen();
+    threadContext.Unfreeze();
+    Sleep(30);
+    threads.GetCounters(outer);
+    // An unbalanced Unfreeze is ignored
+    threadContext.Unfreeze();
+    bool isFrozenAfter = threadContext.IsFrozen();
+    Sleep(30);
+    threads.GetCounters(after);
+
+    PYX_CHECK(isStillFrozen);
+    PYX_CHECK(!isFrozenAfter);
+    for (size_t i = 0; i < threads.GetCount(); i++)
+    {
+        PYX_CHECK_EQUAL(before[i], inner[i]);
+        PYX_CHECK(outer[i] > inner[i]);
+        PYX_CHECK(after[i] > outer[i]);
+    }
+}
+
+PYX_TEST(FrozenThreadIdsAreTheSuspendedThreads)
+{
+    SpinningThreads threads(2);
+    ThreadId frozenThreadIds[64];
+    auto& threadContext = ThreadContext::GetInstance();
+    threadContext.Freeze();
+    size_t count = threadContext.GetOtherThreadIds(frozenThreadIds, 64);
+    threadContext.Unfreeze();
+
+    std::vector<ThreadId> threadIds(frozenThreadIds, frozenThreadIds + (std::min)(count, static_cast<size_t>(64)));
+    PYX_CHECK(!Contains(threadIds, GetCurrentThreadId()));
+    for (size_t i = 0; i < threads.GetCount(); i++)
+        PYX_CHECK(Contains(threadIds, threads.GetThreadId(i)));
+}
+
+PYX_TEST(BlockedThreadsResumeWhereTheyWere)
+{
+    // Threads sleeping or waiting on a condition are suspended in the
+    // middle of the call and carry on once resumed
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isNotified = false;
+    std::atomic<int> completedCount(0);
+    std::thread sleeping([&]()
+    {
+        Sleep(20);
+        completedCount++;
+    });
+    std::thread waiting([&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return isNotified; });
+        completedCount++;
+    });
+    Sleep(5);
+
+    auto& threadContext = ThreadContext::GetInstance();
+    threadContext.Freeze();
+    Sleep(40);
+    int frozenCompletedCount = completedCount.load();
+    threadContext.Unfreeze();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isNotified = true;
+    }
+    condition.notify_one();
+    sleeping.join();
+    waiting.join();
+    PYX_CHECK_EQUAL(0, frozenCompletedCount);
+    PYX_CHECK_EQUAL(2, completedCount.load());
+}
+
+PYX_TEST(SuspendAllThreadsReturnsSuspendedThreads)
+{
+    SpinningThreads threads(2);
+    uint64_t suspended[2];
+    uint64_t later[2];
+    uint64_t resumed[2];
+
+    auto suspendedThreads = ThreadContext::GetInstance().SuspendAllThreads();
+    threads.GetCounters(suspended);
+    Sleep(30);
+    threads.GetCounters(later);
+    bool isAllSuspended = true;
+    for (auto& pThread : suspendedThreads)
+        isAllSuspended &= pThread->IsSuspended() && pThread->GetThreadId() != GetCurrentThreadId();
+    for (auto& pThread : suspendedThreads)
+        pThread->ResumeThread();
+    Sleep(30);
+    threads.GetCounters(resumed);
+
+    PYX_CHECK(isAllSuspended);
+    PYX_CHECK(suspendedThreads.size() >= threads.GetCount());
+    for (size_t i = 0; i < threads.GetCount(); i++)
+    {
+        PYX_CHECK_EQUAL(suspended[i], later[i]);
+        PYX_CHECK(resumed[i] > later[i]);
+    }
+}
+
+PYX_TEST(RepeatedFreezesDontLoseThreads)
+{
+    SpinningThreads threads(3);
+    auto& threadContext = ThreadContext::GetInstance();
+    for (int i = 0; i < 200; i++)
+    {
+        threadContext.Freeze();
+        threadContext.Unfreeze();
+    }
+
+    uint64_t before[3];
+    uint64_t after[3];
+    threads.GetCounters(before);
+    Sleep(30);
+    threads.GetCounters(after);
+    for (size_t i = 0; i < threads.GetCount(); i++)
+        PYX_CHECK(after[i] > before[i]);
+}
@@ -0,0 +1,173 @@
+#include "Test.h"
+#include <Pyx/Utility/Utf8.h>
+
+using Pyx::Utility::Utf8;
+
+namespace
+{
+    const std::u16string Replacement(1, Utf8::ReplacementCharacter);
+
+    std::u16string FromCodePoint(uint32_t codePoint)
+    {
+        if (codePoint < 0x10000)
+            return std::u16string(1, static_cast<char16_t>(codePoint));
+        return std::u16string{ static_cast<char16_t>(0xD800 + ((codePoint - 0x10000) >> 10)), static_cast<char16_t>(0xDC00 + ((codePoint - 0x10000) & 0x3FF)) };
+    }
+
+    std::string ToBytes(std::initializer_list<int> bytes)
+    {
+        std::string result;
+        for (auto byte : bytes)
+            result.push_back(static_cast<char>(byte));
+        return result;
+    }
+
+    std::u16string Repeat(const std::u16string& text, size_t count)
+    {
+        std::u16string result;
+        for (size_t i = 0; i < count; i++)
+            result += text;
+        return result;
+    }
+}
+
+PYX_TEST(EncodesEverySequenceLength)
+{
+    PYX_CHECK_EQUAL(std::string("A"), Utf8::Encode(u"A"));
+    PYX_CHECK_EQUAL(ToBytes({ 0xC3, 0xA9 }), Utf8::Encode(u"é"));
+    PYX_CHECK_EQUAL(ToBytes({ 0xE2, 0x82, 0xAC }), Utf8::Encode(u"€"));
+    PYX_CHECK_EQUAL(ToBytes({ 0xF0, 0x9F, 0x98, 0x80 }), Utf8::Encode(u"\U0001F600"));
+    PYX_CHECK_EQUAL(std::string(), Utf8::Encode(std::u16string()));
+    PYX_CHECK_EQUAL(std::u16string(), Utf8::Decode(std::string()));
+}
+
+PYX_TEST(RoundTripsEveryCodePoint)
+{
+    for (uint32_t codePoint = 0; codePoint <= 0x10FFFF; codePoint++)
+    {
+        if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+            continue;
+        auto text = FromCodePoint(codePoint);
+        auto encoded = Utf8::Encode(text);
+        size_t expectedSize = codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+        if (encoded.size() != expectedSize || Utf8::Decode(encoded) != text || !Utf8::IsValid(encoded.data(), encoded.size()))
+        {
+            PYX_CHECK_EQUAL(text, Utf8::Decode(encoded));
+            PYX_CHECK_EQUAL(expectedSize, encoded.size());
+            break;
+        }
+    }
+}
+
+PYX_TEST(RoundTripsAcrossVectorBlocks)
+{
+    // ASCII runs of every length and alignment around the 8 and 16 character blocks
+    for (size_t prefix = 0; prefix < 20; prefix++)
+    {
+        for (size_t suffix = 0; suffix < 20; suffix++)
+        {
+            std::u16string text = std::u16string(prefix, u'a') + u"é€\U0001F600" + std::u16string(suffix, u'z');
+            auto encoded = Utf8::Encode(text);
+            PYX_CHECK_EQUAL(prefix + suffix + 9, encoded.size());
+            PYX_CHECK_EQUAL(text, Utf8::Decode(encoded));
+        }
+    }
+
+    auto text = Repeat(u"Pyx été € \U0001F600 ", 200) + Repeat(u"0123456789abcdef", 64);
+    PYX_CHECK_EQUAL(text, Utf8::Decode(Utf8::Encode(text)));
+}
+
+PYX_TEST(SizesMatchConversions)
+{
+    auto text = Repeat(u"ascii é€\U0001F600", 50);
+    auto encoded = Utf8::Encode(text);
+    PYX_CHECK_EQUAL(encoded.size(), Utf8::GetEncodedSize(text.data(), text.size()));
+    PYX_CHECK_EQUAL(text.size(), Utf8::GetDecodedLength(encoded.data(), encoded.size()));
+    PYX_CHECK(encoded.size() <= Utf8::GetMaxEncodedSize(text.size()));
+    PYX_CHECK(text.size() <= Utf8::GetMaxDecodedLength(encoded.size()));
+}
+
+PYX_TEST(LoneSurrogatesAreReplaced)
+{
+    const std::string replacement = ToBytes({ 0xEF, 0xBF, 0xBD });
+    PYX_CHECK_EQUAL(replacement, Utf8::Encode(std::u16string(1, 0xD800)));
+    PYX_CHECK_EQUAL(replacement, Utf8::Encode(std::u16string(1, 0xDC00)));
+    PYX_CHECK_EQUAL("a" + replacement + "b", Utf8::Encode(std::u16string{ u'a', 0xD83D, u'b' }));
+    PYX_CHECK_EQUAL(replacement + replacement, Utf8::Encode(std::u16string{ 0xDE00, 0xD83D }));
+}
+
+PYX_TEST(InvalidSequencesAreReplacedPerMaximalSubpart)
+{
+    struct InvalidSequence
+    {
+        std::string Text;
+        std::u16string Expected;
+    };
+    const InvalidSequence sequences[] =
+    {
+        { ToBytes({ 0x80 }), Replacement },                                                     // Lone continuation byte
+        { ToBytes({ 0xC0, 0x80 }), Replacement + Replacement },                                 // Overlong NUL
+        { ToBytes({ 0xC1, 0xBF }), Replacement + Replacement },                                 // Overlong
+        { ToBytes({ 0xE0, 0x80, 0x80 }), Replacement + Replacement + Replacement },             // Overlong
+        { ToBytes({ 0xED, 0xA0, 0x80 }), Replacement + Replacement + Replacement },             // Encoded surrogate
+        { ToBytes({ 0xF4, 0x90, 0x80, 0x80 }), Repeat(Replacement, 4) },                        // Above U+10FFFF
+        { ToBytes({ 0xF5, 0x80 }), Replacement + Replacement },                                 // Invalid lead byte
+        { ToBytes({ 0xFF }), Replacement },
+        { ToBytes({ 0xE2, 0x82 }), Replacement },                                               // Truncated sequence
+        { ToBytes({ 0xF0, 0x9F, 0x98 }), Replacement },
+        { ToBytes({ 0xE2, 0x82, 0x41 }), Replacement + u"A" },                                  // Interrupted sequence
+        { ToBytes({ 0x41, 0xF0, 0x9F, 0x42, 0x43 }), u"A" + Replacement + u"BC" },
+    };
+
+    for (auto& sequence : sequences)
+    {
+        PYX_CHECK_EQUAL(sequence.Expected, Utf8::Decode(sequence.Text));
+        PYX_CHECK(!Utf8::IsValid(sequence.Text.data(), sequence.Text.size()));
+
+        // Same result when the invalid bytes follow a vectorized ASCII run
+        std::string text = std::string(32, 'x') + sequence.Text;
+        PYX_CHECK_EQUAL(std::u16string(32, u'x') + sequence.Expected, Utf8::Decode(text));
+        PYX_CHECK(!Utf8::IsValid(text.data(), text.size()));
+    }
+}
+
+PYX_TEST(ReplacementCharacterItselfIsValid)
+{
+    const std::string text = ToBytes({ 0xEF, 0xBF, 0xBD });
+    PYX_CHECK(Utf8::IsValid(text.data(), text.size()));
+    PYX_CHECK_EQUAL(Replacement, Utf8::Decode(text));
+}
+
+PYX_TEST(ValidTextIsValid)
+{
+    auto text = Utf8::Encode(Repeat(u"abc é€\U0001F600 0123456789", 20));
+    PYX_CHECK(Utf8::IsValid(text.data(), text.size()));
+    PYX_CHECK(Utf8::IsValid(nullptr, 0));
+}
+
+PYX_TEST(EncodeStopsBeforePartialCharacter)
+{
+    std::u16string text = u"ab€";
+    char buffer[4] = {};
+    PYX_CHECK_EQUAL(2u, Utf8::Encode(text.data(), text.size(), buffer, 4));
+    PYX_CHECK_EQUAL(5u, Utf8::GetEncodedSize(text.data(), text.size()));
+
+    // A surrogate pair is written entirely or not at all
+    std::u16string emoji = u"\U0001F600";
+    PYX_CHECK_EQUAL(0u, Utf8::Encode(emoji.data(), emoji.size(), buffer, 3));
+    PYX_CHECK_EQUAL(4u, Utf8::Encode(emoji.data(), emoji.size(), buffer, 4));
+}
+
+PYX_TEST(DecodeStopsBeforePartialCharacter)
+{
+    std::string text = Utf8::Encode(u"a\U0001F600");
+    char16_t buffer[2] = {};
+    PYX_CHECK_EQUAL(1u, Utf8::Decode(text.data(), text.size(), buffer, 2));
+
+    // Vectorized runs never write past the buffer
+    std::string ascii(40, 'q');
+    char16_t asciiBuffer[24];
+    asciiBuffer[20] = u'!';
+    PYX_CHECK_EQUAL(20u, Utf8::Decode(ascii.data(), ascii.size(), asciiBuffer, 20));
+    PYX_CHECK_EQUAL(u'!', asciiBuffer[20]);
+}